@@ -30,14 +30,17 @@ function ProcessEditor(context)
     if(nil == textureMap) then
         context:SetMaterialPropertyVisibility("metallic.useTexture", MaterialPropertyVisibility_Hidden)
         context:SetMaterialPropertyVisibility("metallic.textureMapUv", MaterialPropertyVisibility_Hidden)
+        context:SetMaterialPropertyVisibility("metallic.textureChannel", MaterialPropertyVisibility_Hidden)
         context:SetMaterialPropertyVisibility("metallic.factor", MaterialPropertyVisibility_Enabled)
     elseif(not useTexture) then
         context:SetMaterialPropertyVisibility("metallic.useTexture", MaterialPropertyVisibility_Enabled)
         context:SetMaterialPropertyVisibility("metallic.textureMapUv", MaterialPropertyVisibility_Disabled)
+        context:SetMaterialPropertyVisibility("metallic.textureChannel", MaterialPropertyVisibility_Disabled)
         context:SetMaterialPropertyVisibility("metallic.factor", MaterialPropertyVisibility_Enabled)
     else
         context:SetMaterialPropertyVisibility("metallic.useTexture", MaterialPropertyVisibility_Enabled)
         context:SetMaterialPropertyVisibility("metallic.textureMapUv", MaterialPropertyVisibility_Enabled)
+        context:SetMaterialPropertyVisibility("metallic.textureChannel", MaterialPropertyVisibility_Enabled)
         context:SetMaterialPropertyVisibility("metallic.factor", MaterialPropertyVisibility_Hidden)
     end
 end
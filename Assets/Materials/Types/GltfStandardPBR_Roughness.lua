@@ -30,6 +30,7 @@ function ProcessEditor(context)
     if(nil == textureMap) then
         context:SetMaterialPropertyVisibility("roughness.useTexture", MaterialPropertyVisibility_Hidden)
         context:SetMaterialPropertyVisibility("roughness.textureMapUv", MaterialPropertyVisibility_Hidden)
+        context:SetMaterialPropertyVisibility("roughness.textureChannel", MaterialPropertyVisibility_Hidden)
 
         context:SetMaterialPropertyVisibility("roughness.lowerBound", MaterialPropertyVisibility_Hidden)
         context:SetMaterialPropertyVisibility("roughness.upperBound", MaterialPropertyVisibility_Hidden)
@@ -38,6 +39,7 @@ function ProcessEditor(context)
     elseif(not useTexture) then
         context:SetMaterialPropertyVisibility("roughness.useTexture", MaterialPropertyVisibility_Enabled)
         context:SetMaterialPropertyVisibility("roughness.textureMapUv", MaterialPropertyVisibility_Disabled)
+        context:SetMaterialPropertyVisibility("roughness.textureChannel", MaterialPropertyVisibility_Disabled)
 
         context:SetMaterialPropertyVisibility("roughness.lowerBound", MaterialPropertyVisibility_Disabled)
         context:SetMaterialPropertyVisibility("roughness.upperBound", MaterialPropertyVisibility_Disabled)
@@ -46,6 +48,7 @@ function ProcessEditor(context)
     else
         context:SetMaterialPropertyVisibility("roughness.useTexture", MaterialPropertyVisibility_Enabled)
         context:SetMaterialPropertyVisibility("roughness.textureMapUv", MaterialPropertyVisibility_Enabled)
+        context:SetMaterialPropertyVisibility("roughness.textureChannel", MaterialPropertyVisibility_Enabled)
 
         context:SetMaterialPropertyVisibility("roughness.lowerBound", MaterialPropertyVisibility_Enabled)
         context:SetMaterialPropertyVisibility("roughness.upperBound", MaterialPropertyVisibility_Enabled)
@@ -52,6 +52,10 @@ namespace Cesium
 
         double GetMovementSpeed() const override;
 
+        void SetPrefetchViewCount(std::uint32_t prefetchViewCount) override;
+
+        std::uint32_t GetPrefetchViewCount() const override;
+
         void FlyToECEFLocation(const glm::dvec3& location, const glm::dvec3& direction) override;
 
         void FlyToECEFLocationWithEulerAngle(const glm::dvec3& location, float pitchInRadians, float yawInRadians) override;
@@ -84,6 +88,8 @@ namespace Cesium
 
         void StopFly();
 
+        void PrefetchFlightPath();
+
         void ResetCameraMovement();
 
         void FlyToECEFLocationImpl(
@@ -93,6 +99,7 @@ namespace Cesium
         double m_mouseSensitivity;
         double m_movementSpeed;
         double m_panningSpeed;
+        std::uint32_t m_prefetchViewCount;
 
         AZStd::unique_ptr<Interpolator> m_ecefPositionInterpolator;
         CameraStopFlyEvent m_stopFlyEvent;
@@ -57,6 +57,12 @@ namespace Cesium
 
         void BindTilesetLoadedHandler(TilesetLoadedEvent::Handler& handler) override;
 
+        TilesetStatistics GetStatistics() const override;
+
+        void SetPrefetchViews(const AZStd::vector<TilesetPrefetchView>& views) override;
+
+        void ClearPrefetchViews() override;
+
         void Init() override;
 
         void Activate() override;
@@ -60,6 +60,11 @@ namespace Cesium
 
         virtual double GetMovementSpeed() const = 0;
 
+        // number of views along the remaining flight path whose tiles are loaded ahead of the camera. Zero disables it
+        virtual void SetPrefetchViewCount(std::uint32_t prefetchViewCount) = 0;
+
+        virtual std::uint32_t GetPrefetchViewCount() const = 0;
+
         virtual void FlyToECEFLocation(const glm::dvec3& location, const glm::dvec3& direction) = 0;
 
         virtual void FlyToECEFLocationWithEulerAngle(const glm::dvec3& location, float pitchInRadians, float yawInRadians) = 0;
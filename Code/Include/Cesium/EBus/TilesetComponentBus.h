@@ -4,9 +4,11 @@
 #include <AzCore/RTTI/ReflectContext.h>
 #include <AzCore/Component/ComponentBus.h>
 #include <AzCore/EBus/Event.h>
+#include <AzCore/std/containers/vector.h>
 #include <AzCore/std/string/string.h>
 #include <AzCore/std/utils.h>
 #include <AzCore/Memory/SystemAllocator.h>
+#include <glm/glm.hpp>
 #include <cstdint>
 
 namespace Cesium
@@ -26,6 +28,9 @@ namespace Cesium
             , m_preloadAncestors{ true }
             , m_preloadSiblings{ true }
             , m_forbidHole{ false }
+            , m_mainThreadLoadingTimeLimit{ 0.0 }
+            , m_prefetchMaximumRequests{ 4 }
+            , m_prefetchCacheShare{ 0.25 }
         {
         }
 
@@ -36,6 +41,125 @@ namespace Cesium
         bool m_preloadAncestors;
         bool m_preloadSiblings;
         bool m_forbidHole;
+
+        // milliseconds per frame spent turning loaded tiles into render resources. At least one tile is processed every
+        // frame. Zero processes every loaded tile in the frame it arrives
+        double m_mainThreadLoadingTimeLimit;
+
+        // Prefetch views are only added to the view update once the tiles of the current view are loaded and while the
+        // tileset has fewer http requests in flight than this, so prefetching takes the bandwidth the current view leaves.
+        // Zero disables prefetching
+        std::uint32_t m_prefetchMaximumRequests;
+
+        // share of the cache budget prefetched tiles may use on top of it, so they never evict tiles of the current view.
+        // Prefetching pauses while the cache is that full
+        double m_prefetchCacheShare;
+    };
+
+    // A view the camera is expected to have later, in ECEF. It uses the viewport and field of view of the current camera
+    struct TilesetPrefetchView final
+    {
+        AZ_RTTI(TilesetPrefetchView, "{5B0E3D62-8A1F-4C57-9E2B-71D4A6F0C3E8}");
+        AZ_CLASS_ALLOCATOR(TilesetPrefetchView, AZ::SystemAllocator);
+
+        static void Reflect(AZ::ReflectContext* context);
+
+        TilesetPrefetchView()
+            : m_position{ 0.0 }
+            , m_direction{ 0.0, 1.0, 0.0 }
+            , m_up{ 0.0, 0.0, 1.0 }
+        {
+        }
+
+        TilesetPrefetchView(const glm::dvec3& position, const glm::dvec3& direction, const glm::dvec3& up)
+            : m_position{ position }
+            , m_direction{ direction }
+            , m_up{ up }
+        {
+        }
+
+        glm::dvec3 m_position;
+        glm::dvec3 m_direction;
+        glm::dvec3 m_up;
+    };
+
+    // Tile streaming statistics of a tileset, to tune the screen space error and the cache size per deployment
+    struct TilesetStatistics final
+    {
+        AZ_RTTI(TilesetStatistics, "{7E8E8A5C-F1BE-4805-8D7D-FC7F2F5BEC5D}");
+        AZ_CLASS_ALLOCATOR(TilesetStatistics, AZ::SystemAllocator);
+
+        static void Reflect(AZ::ReflectContext* context);
+
+        TilesetStatistics()
+            : m_tilesVisited{ 0 }
+            , m_tilesRendered{ 0 }
+            , m_tilesCulled{ 0 }
+            , m_tilesContentLoading{ 0 }
+            , m_tilesContentLoaded{ 0 }
+            , m_tilesDone{ 0 }
+            , m_tilesFailed{ 0 }
+            , m_tilesFailedTemporarily{ 0 }
+            , m_tilesWaitingForMainThread{ 0 }
+            , m_cachedBytes{ 0 }
+            , m_maximumCachedBytes{ 0 }
+            , m_requestsInFlight{ 0 }
+            , m_requestsCompletedPerSecond{ 0.0 }
+            , m_updateViewTime{ 0.0 }
+            , m_prepareInMainThreadTime{ 0.0 }
+            , m_setVisibleTime{ 0.0 }
+            , m_attachRasterTime{ 0.0 }
+            , m_loadedModels{ 0 }
+            , m_gltfMaterialTime{ 0.0 }
+            , m_gltfAttributeTime{ 0.0 }
+            , m_gltfTangentTime{ 0.0 }
+            , m_gltfMeshAssetTime{ 0.0 }
+        {
+        }
+
+        // tiles visited, selected for rendering and culled by the last view update
+        std::uint32_t m_tilesVisited;
+        std::uint32_t m_tilesRendered;
+        std::uint32_t m_tilesCulled;
+
+        // loaded tiles in each load state. Unloaded tiles are not tracked by the tileset
+        std::uint32_t m_tilesContentLoading;
+        std::uint32_t m_tilesContentLoaded;
+        std::uint32_t m_tilesDone;
+        std::uint32_t m_tilesFailed;
+        std::uint32_t m_tilesFailedTemporarily;
+
+        // loaded tiles whose meshes wait for the main thread loading time limit
+        std::uint32_t m_tilesWaitingForMainThread;
+
+        // bytes of loaded tile content versus the cache budget. The budget is 0 while the tileset is out of view
+        std::uint64_t m_cachedBytes;
+        std::uint64_t m_maximumCachedBytes;
+
+        // http requests of the tileset. Local tilesets don't send any
+        std::uint32_t m_requestsInFlight;
+        double m_requestsCompletedPerSecond;
+
+        // main thread milliseconds spent in the last frame. updateView includes the prepareInMainThread and
+        // attachRaster calls Cesium Native makes during the view update
+        double m_updateViewTime;
+        double m_prepareInMainThreadTime;
+        double m_setVisibleTime;
+        double m_attachRasterTime;
+
+        // models built by the load threads since the tileset was loaded, and the milliseconds spent in each glTF stage
+        std::uint64_t m_loadedModels;
+        double m_gltfMaterialTime;
+        double m_gltfAttributeTime;
+        double m_gltfTangentTime;
+        double m_gltfMeshAssetTime;
+    };
+
+    enum class TilesetTextureCompression
+    {
+        None,
+        Fast,
+        Quality
     };
 
     struct TilesetRenderConfiguration final
@@ -47,10 +171,20 @@ namespace Cesium
 
         TilesetRenderConfiguration()
             : m_generateMissingNormalAsSmooth{ true }
+            , m_compactVertexLayout{ false }
+            , m_textureCompression{ TilesetTextureCompression::None }
         {
         }
 
         bool m_generateMissingNormalAsSmooth;
+
+        // store tile meshes with 16 bit positions relative to the mesh bounds, octahedral normals and tangents, and
+        // 16 bit normalized UVs instead of 32 bit floats
+        bool m_compactVertexLayout;
+
+        // block compress tile and raster textures into BC1, BC3 or BC4 on the load threads, trading load time for a 4:1 to
+        // 8:1 smaller GPU footprint. Any other value than None also keeps KTX2 textures of the tileset compressed
+        TilesetTextureCompression m_textureCompression;
     };
 
     struct TilesetLocalFileSource final
@@ -165,6 +299,14 @@ namespace Cesium
         virtual void ApplyTransformToRoot(const glm::dmat4& transform) = 0;
 
         virtual void BindTilesetLoadedHandler(TilesetLoadedEvent::Handler& handler) = 0;
+
+        virtual TilesetStatistics GetStatistics() const = 0;
+
+        // Replaces the views whose tiles are loaded ahead of the camera. The tiles are requested with a lower priority than
+        // the ones of the current view and stay hidden until the camera sees them
+        virtual void SetPrefetchViews(const AZStd::vector<TilesetPrefetchView>& views) = 0;
+
+        virtual void ClearPrefetchViews() = 0;
     };
 
     using TilesetRequestBus = AZ::EBus<TilesetRequest>;
@@ -30,6 +30,8 @@ namespace Cesium
         GeospatialHelper::Reflect(context);
 
         TilesetConfiguration::Reflect(context);
+        TilesetStatistics::Reflect(context);
+        TilesetPrefetchView::Reflect(context);
         TilesetRenderConfiguration::Reflect(context);
         TilesetSource::Reflect(context);
         TilesetRequest::Reflect(context);
@@ -1,5 +1,6 @@
 #include <Cesium/Components/GeoReferenceCameraFlyController.h>
 #include <Cesium/EBus/OriginShiftComponentBus.h>
+#include <Cesium/EBus/TilesetComponentBus.h>
 #include "Cesium/Math/MathHelper.h"
 #include "Cesium/Math/GeoReferenceInterpolator.h"
 #include "Cesium/Math/LinearInterpolator.h"
@@ -10,6 +11,7 @@
 #include <AzCore/Serialization/SerializeContext.h>
 #include <AzCore/Component/TransformBus.h>
 #include <AzCore/RTTI/BehaviorContext.h>
+#include <AzCore/std/algorithm.h>
 #include <CesiumGeospatial/Transforms.h>
 #include <glm/gtc/matrix_inverse.hpp>
 #include <glm/gtc/quaternion.hpp>
@@ -24,7 +26,8 @@ namespace Cesium
                 ->Version(0)
                 ->Field("MouseSensitivity", &GeoReferenceCameraFlyController::m_mouseSensitivity)
                 ->Field("MovementSpeed", &GeoReferenceCameraFlyController::m_movementSpeed)
-                ->Field("PanningSpeed", &GeoReferenceCameraFlyController::m_panningSpeed);
+                ->Field("PanningSpeed", &GeoReferenceCameraFlyController::m_panningSpeed)
+                ->Field("PrefetchViewCount", &GeoReferenceCameraFlyController::m_prefetchViewCount);
         }
     }
 
@@ -53,6 +56,7 @@ namespace Cesium
         , m_mouseSensitivity{ 1.0 }
         , m_movementSpeed{ 1.0 }
         , m_panningSpeed{ 1.0 }
+        , m_prefetchViewCount{ 4 }
         , m_cameraPitch{}
         , m_cameraHead{}
         , m_cameraMovement{}
@@ -118,6 +122,16 @@ namespace Cesium
         return m_movementSpeed;
     }
 
+    void GeoReferenceCameraFlyController::SetPrefetchViewCount(std::uint32_t prefetchViewCount)
+    {
+        m_prefetchViewCount = prefetchViewCount;
+    }
+
+    std::uint32_t GeoReferenceCameraFlyController::GetPrefetchViewCount() const
+    {
+        return m_prefetchViewCount;
+    }
+
     void GeoReferenceCameraFlyController::FlyToECEFLocation(const glm::dvec3& location, const glm::dvec3& direction)
     {
         FlyToECEFLocationImpl(location, direction, nullptr, nullptr);
@@ -201,6 +215,7 @@ namespace Cesium
         }
 
         AZ::TransformBus::Event(GetEntityId(), &AZ::TransformBus::Events::SetWorldTM, cameraTransform);
+        PrefetchFlightPath();
 
         // if the interpolator stops updating, then we transition to the end state
         if (m_ecefPositionInterpolator->IsStop())
@@ -378,6 +393,7 @@ namespace Cesium
             m_cameraHead = pitchHeadRoll.z;
 
             m_ecefPositionInterpolator = nullptr;
+            TilesetRequestBus::Broadcast(&TilesetRequestBus::Events::ClearPrefetchViews);
             m_stopFlyEvent.Signal(ecefCurrentPosition);
 
             // transition to no fly state
@@ -385,6 +401,30 @@ namespace Cesium
         }
     }
 
+    void GeoReferenceCameraFlyController::PrefetchFlightPath()
+    {
+        if (m_prefetchViewCount == 0 || !m_ecefPositionInterpolator)
+        {
+            return;
+        }
+
+        // the destination comes first, followed by points spread evenly over the rest of the flight
+        double progress = AZStd::clamp(m_ecefPositionInterpolator->GetProgress(), 0.0, 1.0);
+        AZStd::vector<TilesetPrefetchView> prefetchViews;
+        prefetchViews.reserve(m_prefetchViewCount);
+        for (std::uint32_t i = 0; i < m_prefetchViewCount; ++i)
+        {
+            double viewProgress = i == 0 ? 1.0 : progress + (1.0 - progress) * static_cast<double>(i) / m_prefetchViewCount;
+            glm::dvec3 position{};
+            glm::dquat orientation{};
+            m_ecefPositionInterpolator->Sample(viewProgress, position, orientation);
+            glm::dmat3 rotation = glm::mat3_cast(orientation);
+            prefetchViews.emplace_back(position, rotation[1], rotation[2]);
+        }
+
+        TilesetRequestBus::Broadcast(&TilesetRequestBus::Events::SetPrefetchViews, prefetchViews);
+    }
+
     void GeoReferenceCameraFlyController::ResetCameraMovement()
     {
         m_cameraMovement = glm::dvec3{ 0.0 };
@@ -409,6 +449,7 @@ namespace Cesium
         glm::dvec3 absCameraPosition = absCameraTransform[3];
         m_ecefPositionInterpolator = AZStd::make_unique<GeoReferenceInterpolator>(
             absCameraPosition, absCameraTransform[1], location, direction, duration, flyHeight);
+        PrefetchFlightPath();
 
         // transition to the new state
         m_cameraFlyState = CameraFlyState::MidFly;
@@ -3,6 +3,8 @@
 #include "Cesium/TilesetUtility/RenderResourcesPreparer.h"
 #include "Cesium/TilesetUtility/TilesetCameraConfigurations.h"
 #include "Cesium/Systems/CesiumSystem.h"
+#include "Cesium/Systems/HttpAssetAccessor.h"
+#include "Cesium/Systems/CesiumProfiler.h"
 #include "Cesium/Math/BoundingVolumeConverters.h"
 #include <Cesium/Math/MathHelper.h>
 #include <Cesium/Math/MathReflect.h>
@@ -10,6 +12,8 @@
 #include <AzCore/Serialization/SerializeContext.h>
 #include <AzCore/RTTI/BehaviorContext.h>
 #include <AzCore/JSON/rapidjson.h>
+#include <AzCore/std/algorithm.h>
+#include <AzCore/std/chrono/chrono.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_inverse.hpp>
 #include <vector>
@@ -25,6 +29,7 @@
 #include <Cesium3DTilesSelection/Tileset.h>
 #include <Cesium3DTilesSelection/TilesetExternals.h>
 #include <Cesium3DTilesSelection/RasterOverlay.h>
+#include <CesiumGltf/Ktx2TranscodeTargets.h>
 
 #ifdef AZ_COMPILER_MSVC
 #pragma pop_macro("OPAQUE")
@@ -48,6 +53,11 @@ namespace Cesium
             , m_absToRelWorld{ 1.0 }
             , m_configFlags{ ConfigurationDirtyFlags::None }
             , m_tilesetLoaded{ false }
+            , m_previousTilesToRenderDone{ false }
+            , m_previousTilesToRenderFiltered{ false }
+            , m_prefetchPriorityRequested{ false }
+            , m_requestRateSampleTime{ AZStd::chrono::steady_clock::now() }
+            , m_requestRateSampleCount{ 0 }
         {
             // mark all configs to be dirty so that tileset will be updated with the current config accordingly
             m_configFlags = Impl::ConfigurationDirtyFlags::AllChange;
@@ -62,6 +72,7 @@ namespace Cesium
         {
             RasterOverlayContainerRequestBus::Handler::BusDisconnect();
             m_rasterOverlayContainerUnloadedEvent.Signal();
+            CancelTileRequests();
             m_tileset.reset();
             m_renderResourcesPreparer.reset();
         }
@@ -73,7 +84,10 @@ namespace Cesium
             {
                 m_tilesetLoaded = false;
                 m_rasterOverlayContainerUnloadedEvent.Signal();
+                CancelTileRequests();
                 m_tileset.reset();
+                m_previousTilesToRender.clear();
+                m_previousTilesToRenderDone = false;
             }
 
             switch (type)
@@ -97,15 +111,51 @@ namespace Cesium
             }
         }
 
-        Cesium3DTilesSelection::TilesetExternals CreateTilesetExternal(IOKind kind)
+        static Cesium3DTilesSelection::TilesetOptions CreateTilesetOptions(const TilesetRenderConfiguration& renderConfiguration)
+        {
+            Cesium3DTilesSelection::TilesetOptions options;
+            options.contentOptions.generateMissingNormalsSmooth = renderConfiguration.m_generateMissingNormalAsSmooth;
+            if (renderConfiguration.m_textureCompression != TilesetTextureCompression::None)
+            {
+                // KTX2 textures are transcoded to a color block format instead of RGBA, and uploaded without decoding
+                CesiumGltf::SupportedGpuCompressedPixelFormats supportedFormats;
+                supportedFormats.BC1_RGB = true;
+                supportedFormats.BC3_RGBA = true;
+                supportedFormats.BC7_RGBA = true;
+                options.contentOptions.ktx2TranscodeTargets = CesiumGltf::Ktx2TranscodeTargets(supportedFormats, false);
+            }
+
+            return options;
+        }
+
+        static GltfTextureCompression ToGltfTextureCompression(TilesetTextureCompression textureCompression)
+        {
+            switch (textureCompression)
+            {
+            case TilesetTextureCompression::Fast:
+                return GltfTextureCompression::Fast;
+            case TilesetTextureCompression::Quality:
+                return GltfTextureCompression::Quality;
+            default:
+                return GltfTextureCompression::None;
+            }
+        }
+
+        Cesium3DTilesSelection::TilesetExternals CreateTilesetExternal(IOKind kind, const TilesetRenderConfiguration& renderConfiguration)
         {
             // create render resources preparer if not exist
             AZ::Render::MeshFeatureProcessorInterface* meshFeatureProcessor =
                 AZ::RPI::Scene::GetFeatureProcessorForEntity<AZ::Render::MeshFeatureProcessorInterface>(m_selfEntity);
-            m_renderResourcesPreparer = std::make_shared<RenderResourcesPreparer>(meshFeatureProcessor);
+            m_renderResourcesPreparer = std::make_shared<RenderResourcesPreparer>(
+                meshFeatureProcessor, renderConfiguration.m_compactVertexLayout,
+                ToGltfTextureCompression(renderConfiguration.m_textureCompression),
+                renderConfiguration.m_generateMissingNormalAsSmooth);
+
+            const std::shared_ptr<CesiumAsync::IAssetAccessor>& assetAccessor = CesiumInterface::Get()->GetAssetAccessor(kind);
+            m_httpAssetAccessor = std::dynamic_pointer_cast<HttpAssetAccessor>(assetAccessor);
 
             return Cesium3DTilesSelection::TilesetExternals{
-                CesiumInterface::Get()->GetAssetAccessor(kind),
+                assetAccessor,
                 m_renderResourcesPreparer,
                 CesiumAsync::AsyncSystem(CesiumInterface::Get()->GetTaskProcessor()),
                 CesiumInterface::Get()->GetCreditSystem(),
@@ -120,9 +170,8 @@ namespace Cesium
                 return;
             }
 
-            Cesium3DTilesSelection::TilesetExternals externals = CreateTilesetExternal(IOKind::LocalFile);
-            Cesium3DTilesSelection::TilesetOptions options;
-            options.contentOptions.generateMissingNormalsSmooth = renderConfiguration.m_generateMissingNormalAsSmooth;
+            Cesium3DTilesSelection::TilesetExternals externals = CreateTilesetExternal(IOKind::LocalFile, renderConfiguration);
+            Cesium3DTilesSelection::TilesetOptions options = CreateTilesetOptions(renderConfiguration);
             m_tileset = AZStd::make_unique<Cesium3DTilesSelection::Tileset>(externals, source.m_filePath.c_str(), options);
         }
 
@@ -133,9 +182,8 @@ namespace Cesium
                 return;
             }
 
-            Cesium3DTilesSelection::TilesetExternals externals = CreateTilesetExternal(IOKind::Http);
-            Cesium3DTilesSelection::TilesetOptions options;
-            options.contentOptions.generateMissingNormalsSmooth = renderConfiguration.m_generateMissingNormalAsSmooth;
+            Cesium3DTilesSelection::TilesetExternals externals = CreateTilesetExternal(IOKind::Http, renderConfiguration);
+            Cesium3DTilesSelection::TilesetOptions options = CreateTilesetOptions(renderConfiguration);
             m_tileset = AZStd::make_unique<Cesium3DTilesSelection::Tileset>(externals, source.m_url.c_str(), options);
         }
 
@@ -146,9 +194,8 @@ namespace Cesium
                 return;
             }
 
-            Cesium3DTilesSelection::TilesetExternals externals = CreateTilesetExternal(IOKind::Http);
-            Cesium3DTilesSelection::TilesetOptions options;
-            options.contentOptions.generateMissingNormalsSmooth = renderConfiguration.m_generateMissingNormalAsSmooth;
+            Cesium3DTilesSelection::TilesetExternals externals = CreateTilesetExternal(IOKind::Http, renderConfiguration);
+            Cesium3DTilesSelection::TilesetOptions options = CreateTilesetOptions(renderConfiguration);
             m_tileset = AZStd::make_unique<Cesium3DTilesSelection::Tileset>(
                 externals, source.m_cesiumIonAssetId, source.m_cesiumIonAssetToken.c_str(), options);
         }
@@ -157,11 +204,9 @@ namespace Cesium
         {
             if (m_tileset)
             {
-                if (m_renderResourcesPreparer->AddRasterLayer(rasterOverlay.get()))
-                {
-                    m_tileset->getOverlays().add(std::move(rasterOverlay));
-                    return true;
-                }
+                m_renderResourcesPreparer->AddRasterLayer(rasterOverlay.get());
+                m_tileset->getOverlays().add(std::move(rasterOverlay));
+                return true;
             }
 
             return false;
@@ -218,6 +263,7 @@ namespace Cesium
             glm::dmat4 relTransform = m_absToRelWorld * rootTransform;
             m_renderResourcesPreparer->SetTransform(relTransform);
             m_cameraConfigurations.SetTransform(glm::affineInverse(relTransform));
+            m_cameraConfigurations.SetEcefTransform(glm::affineInverse(rootTransform));
             m_configFlags = m_configFlags & ~ConfigurationDirtyFlags::TransformChange;
         }
 
@@ -244,6 +290,211 @@ namespace Cesium
             m_configFlags = m_configFlags & ~ConfigurationDirtyFlags::TilesetConfigChange;
         }
 
+        void BeginTileRequests(std::int64_t priority)
+        {
+            if (m_httpAssetAccessor)
+            {
+                m_httpAssetAccessor->BeginRequestScope(GetRequestScopeId(), priority);
+            }
+        }
+
+        void EndTileRequests()
+        {
+            if (m_httpAssetAccessor)
+            {
+                m_httpAssetAccessor->EndRequestScope();
+            }
+        }
+
+        void SetTileRequestsPriority(std::int64_t priority)
+        {
+            if (m_httpAssetAccessor)
+            {
+                m_httpAssetAccessor->SetRequestScopePriority(GetRequestScopeId(), priority);
+            }
+        }
+
+        void CancelTileRequests()
+        {
+            if (m_httpAssetAccessor)
+            {
+                m_httpAssetAccessor->CancelRequestScope(GetRequestScopeId());
+            }
+        }
+
+        bool IsPrefetchEnabled(const TilesetConfiguration& tilesetConfiguration) const
+        {
+            return !m_prefetchViews.empty() && tilesetConfiguration.m_prefetchMaximumRequests > 0;
+        }
+
+        std::int64_t GetPrefetchCacheBytes(const TilesetConfiguration& tilesetConfiguration) const
+        {
+            if (!IsPrefetchEnabled(tilesetConfiguration))
+            {
+                return 0;
+            }
+
+            return static_cast<std::int64_t>(
+                static_cast<double>(tilesetConfiguration.m_maximumCacheBytes) * AZStd::max(tilesetConfiguration.m_prefetchCacheShare, 0.0));
+        }
+
+        // prefetch views join the view update once the tiles of the current view are done, and only while the tileset leaves
+        // room for them in its request and cache budgets
+        bool CanPrefetch(const TilesetConfiguration& tilesetConfiguration) const
+        {
+            if (!IsPrefetchEnabled(tilesetConfiguration) || !m_previousTilesToRenderDone)
+            {
+                return false;
+            }
+
+            if (m_httpAssetAccessor)
+            {
+                HttpRequestScopeStatistics requestStatistics = m_httpAssetAccessor->GetRequestScopeStatistics(GetRequestScopeId());
+                if (requestStatistics.m_inFlightRequests >= tilesetConfiguration.m_prefetchMaximumRequests)
+                {
+                    return false;
+                }
+            }
+
+            std::int64_t cacheBytes =
+                static_cast<std::int64_t>(tilesetConfiguration.m_maximumCacheBytes) + GetPrefetchCacheBytes(tilesetConfiguration);
+            return m_tileset->getTotalDataBytes() < cacheBytes;
+        }
+
+        const Cesium3DTilesSelection::ViewUpdateResult& UpdateView(const std::vector<Cesium3DTilesSelection::ViewState>& viewStates)
+        {
+            CESIUM_PROFILE_SCOPE("TilesetComponent::UpdateView");
+            std::uint64_t updateViewNanoseconds = 0;
+            const Cesium3DTilesSelection::ViewUpdateResult* viewUpdate = nullptr;
+            {
+                StageTimer stageTimer(updateViewNanoseconds);
+                viewUpdate = &m_tileset->updateView(viewStates);
+            }
+
+            m_statistics.m_updateViewTime = NanosecondsToMilliseconds(updateViewNanoseconds);
+            m_statistics.m_tilesVisited = viewUpdate->tilesVisited;
+            m_statistics.m_tilesCulled = viewUpdate->tilesCulled;
+            m_statistics.m_tilesRendered = static_cast<std::uint32_t>(viewUpdate->tilesToRenderThisFrame.size());
+            return *viewUpdate;
+        }
+
+        // cameraViewStates is set when the view update included prefetch views. Tiles selected for those alone are loaded but
+        // kept hidden, so only the tiles inside a camera frustum are shown
+        void UpdateTilesVisibility(
+            const Cesium3DTilesSelection::ViewUpdateResult& viewUpdate,
+            const std::vector<Cesium3DTilesSelection::ViewState>* cameraViewStates)
+        {
+            CESIUM_PROFILE_SCOPE("TilesetComponent::SetVisible");
+            std::uint64_t setVisibleNanoseconds = 0;
+            {
+                StageTimer stageTimer(setVisibleNanoseconds);
+                m_renderResourcesToHide.clear();
+                for (Cesium3DTilesSelection::Tile* tile : viewUpdate.tilesToNoLongerRenderThisFrame)
+                {
+                    if (tile->getState() == Cesium3DTilesSelection::Tile::LoadState::Done)
+                    {
+                        m_renderResourcesToHide.emplace_back(tile->getRendererResources());
+                    }
+                }
+
+                // tilesToRenderThisFrame holds every rendered tile, not only the new ones. While the camera holds still it
+                // is the same list as last frame, and when every tile of it was done then, all of them are shown already.
+                // That doesn't hold after a frame with prefetch views, which left some of the tiles hidden
+                m_renderResourcesToShow.clear();
+                const std::vector<Cesium3DTilesSelection::Tile*>& tilesToRender = viewUpdate.tilesToRenderThisFrame;
+                bool sameTilesToRender = !cameraViewStates && !m_previousTilesToRenderFiltered && m_previousTilesToRenderDone &&
+                    tilesToRender.size() == m_previousTilesToRender.size() &&
+                    AZStd::equal(tilesToRender.begin(), tilesToRender.end(), m_previousTilesToRender.begin());
+                if (!sameTilesToRender)
+                {
+                    m_previousTilesToRenderDone = true;
+                    for (Cesium3DTilesSelection::Tile* tile : tilesToRender)
+                    {
+                        bool seenByCamera = !cameraViewStates || IsSeenByCamera(*tile, *cameraViewStates);
+                        if (tile->getState() != Cesium3DTilesSelection::Tile::LoadState::Done)
+                        {
+                            m_previousTilesToRenderDone = m_previousTilesToRenderDone && !seenByCamera;
+                        }
+                        else if (seenByCamera)
+                        {
+                            m_renderResourcesToShow.emplace_back(tile->getRendererResources());
+                        }
+                        else
+                        {
+                            m_renderResourcesToHide.emplace_back(tile->getRendererResources());
+                        }
+                    }
+
+                    m_previousTilesToRender.assign(tilesToRender.begin(), tilesToRender.end());
+                    m_previousTilesToRenderFiltered = cameraViewStates != nullptr;
+                }
+
+                m_renderResourcesPreparer->UpdateVisibility(m_renderResourcesToHide, m_renderResourcesToShow);
+            }
+
+            m_statistics.m_setVisibleTime = NanosecondsToMilliseconds(setVisibleNanoseconds);
+        }
+
+        static bool IsSeenByCamera(
+            const Cesium3DTilesSelection::Tile& tile, const std::vector<Cesium3DTilesSelection::ViewState>& cameraViewStates)
+        {
+            for (const Cesium3DTilesSelection::ViewState& viewState : cameraViewStates)
+            {
+                if (viewState.isBoundingVolumeVisible(tile.getBoundingVolume()))
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        void UpdateFrameStatistics()
+        {
+            RenderResourcesPreparerStatistics preparerStatistics = m_renderResourcesPreparer->GetStatistics();
+            m_renderResourcesPreparer->ResetMainThreadStatistics();
+            m_statistics.m_prepareInMainThreadTime = NanosecondsToMilliseconds(preparerStatistics.m_prepareInMainThreadNanoseconds);
+            m_statistics.m_attachRasterTime = NanosecondsToMilliseconds(preparerStatistics.m_attachRasterNanoseconds);
+            m_statistics.m_loadedModels = preparerStatistics.m_loadedModelCount;
+            m_statistics.m_gltfMaterialTime = NanosecondsToMilliseconds(preparerStatistics.m_loadStatistics.m_materialNanoseconds);
+            m_statistics.m_gltfAttributeTime = NanosecondsToMilliseconds(preparerStatistics.m_loadStatistics.m_attributeNanoseconds);
+            m_statistics.m_gltfTangentTime = NanosecondsToMilliseconds(preparerStatistics.m_loadStatistics.m_tangentNanoseconds);
+            m_statistics.m_gltfMeshAssetTime = NanosecondsToMilliseconds(preparerStatistics.m_loadStatistics.m_meshAssetNanoseconds);
+            m_statistics.m_tilesWaitingForMainThread = static_cast<std::uint32_t>(m_renderResourcesPreparer->GetPendingMainThreadWorkCount());
+
+            if (!m_httpAssetAccessor)
+            {
+                return;
+            }
+
+            // the completion rate is sampled about once a second, so it doesn't jump with every frame
+            HttpRequestScopeStatistics requestStatistics = m_httpAssetAccessor->GetRequestScopeStatistics(GetRequestScopeId());
+            m_statistics.m_requestsInFlight = static_cast<std::uint32_t>(requestStatistics.m_inFlightRequests);
+
+            auto now = AZStd::chrono::steady_clock::now();
+            auto elapsedTime = AZStd::chrono::duration<double>(now - m_requestRateSampleTime);
+            if (elapsedTime.count() >= 1.0)
+            {
+                // the count restarts when the requests of the tileset are cancelled
+                std::uint64_t completedRequests = requestStatistics.m_completedRequests >= m_requestRateSampleCount
+                    ? requestStatistics.m_completedRequests - m_requestRateSampleCount
+                    : requestStatistics.m_completedRequests;
+                m_statistics.m_requestsCompletedPerSecond = static_cast<double>(completedRequests) / elapsedTime.count();
+                m_requestRateSampleTime = now;
+                m_requestRateSampleCount = requestStatistics.m_completedRequests;
+            }
+        }
+
+        static double NanosecondsToMilliseconds(std::uint64_t nanoseconds)
+        {
+            return static_cast<double>(nanoseconds) / 1000000.0;
+        }
+
+        std::uint64_t GetRequestScopeId() const
+        {
+            return static_cast<AZ::u64>(m_selfEntity);
+        }
+
         void NotifyTilesetLoaded()
         {
             if (m_tilesetLoaded)
@@ -265,6 +516,7 @@ namespace Cesium
         AZ::EntityId m_selfEntity;
         TilesetCameraConfigurations m_cameraConfigurations;
         std::shared_ptr<RenderResourcesPreparer> m_renderResourcesPreparer;
+        std::shared_ptr<HttpAssetAccessor> m_httpAssetAccessor;
         AZStd::unique_ptr<Cesium3DTilesSelection::Tileset> m_tileset;
         TilesetLoadedEvent m_tilesetLoadedEvent;
         RasterOverlayContainerLoadedEvent m_rasterOverlayContainerLoadedEvent;
@@ -272,6 +524,16 @@ namespace Cesium
         glm::dmat4 m_absToRelWorld;
         int m_configFlags;
         bool m_tilesetLoaded;
+        TilesetStatistics m_statistics;
+        AZStd::vector<Cesium3DTilesSelection::Tile*> m_previousTilesToRender;
+        AZStd::vector<void*> m_renderResourcesToHide;
+        AZStd::vector<void*> m_renderResourcesToShow;
+        bool m_previousTilesToRenderDone;
+        bool m_previousTilesToRenderFiltered;
+        bool m_prefetchPriorityRequested;
+        AZStd::vector<TilesetPrefetchView> m_prefetchViews;
+        AZStd::chrono::steady_clock::time_point m_requestRateSampleTime;
+        std::uint64_t m_requestRateSampleCount;
     };
 
     void TilesetComponent::Reflect(AZ::ReflectContext* context)
@@ -455,6 +717,55 @@ namespace Cesium
         handler.Connect(m_impl->m_tilesetLoadedEvent);
     }
 
+    TilesetStatistics TilesetComponent::GetStatistics() const
+    {
+        TilesetStatistics statistics = m_impl->m_statistics;
+        if (!m_impl->m_tileset)
+        {
+            return statistics;
+        }
+
+        // load states are counted when asked for, so frames nobody inspects don't walk the loaded tiles
+        m_impl->m_tileset->forEachLoadedTile(
+            [&statistics](Cesium3DTilesSelection::Tile& tile)
+            {
+                switch (tile.getState())
+                {
+                case Cesium3DTilesSelection::Tile::LoadState::ContentLoading:
+                    ++statistics.m_tilesContentLoading;
+                    break;
+                case Cesium3DTilesSelection::Tile::LoadState::ContentLoaded:
+                    ++statistics.m_tilesContentLoaded;
+                    break;
+                case Cesium3DTilesSelection::Tile::LoadState::Done:
+                    ++statistics.m_tilesDone;
+                    break;
+                case Cesium3DTilesSelection::Tile::LoadState::Failed:
+                    ++statistics.m_tilesFailed;
+                    break;
+                case Cesium3DTilesSelection::Tile::LoadState::FailedTemporarily:
+                    ++statistics.m_tilesFailedTemporarily;
+                    break;
+                default:
+                    break;
+                }
+            });
+
+        statistics.m_cachedBytes = static_cast<std::uint64_t>(m_impl->m_tileset->getTotalDataBytes());
+        statistics.m_maximumCachedBytes = static_cast<std::uint64_t>(m_impl->m_tileset->getOptions().maximumCachedBytes);
+        return statistics;
+    }
+
+    void TilesetComponent::SetPrefetchViews(const AZStd::vector<TilesetPrefetchView>& views)
+    {
+        m_impl->m_prefetchViews = views;
+    }
+
+    void TilesetComponent::ClearPrefetchViews()
+    {
+        m_impl->m_prefetchViews.clear();
+    }
+
     void TilesetComponent::ApplyTransformToRoot(const glm::dmat4& transform)
     {
         m_transform = transform;
@@ -462,7 +773,7 @@ namespace Cesium
         m_impl->FlushTransformChange(m_transform);
     }
 
-    void TilesetComponent::OnTick([[maybe_unused]] float deltaTime, [[maybe_unused]] AZ::ScriptTimePoint time)
+    void TilesetComponent::OnTick([[maybe_unused]] float deltaTime, AZ::ScriptTimePoint time)
     {
         m_impl->FlushTilesetSourceChange(m_tilesetSource, m_renderConfiguration);
         m_impl->FlushTilesetConfigurationChange(m_tilesetConfiguration);
@@ -476,11 +787,14 @@ namespace Cesium
 
             if (!viewStates.empty())
             {
+                bool prefetch = m_impl->CanPrefetch(m_tilesetConfiguration);
+
                 // check if the root is visible. If it's not, then we should remove all the cache
+                bool isTilesetVisible = true;
                 const auto rootTile = m_impl->m_tileset->getRootTile();
                 if (rootTile)
                 {
-                    bool isTilesetVisible = false;
+                    isTilesetVisible = false;
                     for (const auto& viewState : viewStates)
                     {
                         if (viewState.isBoundingVolumeVisible(rootTile->getBoundingVolume()))
@@ -490,37 +804,46 @@ namespace Cesium
                         }
                     }
 
-                    if (!isTilesetVisible)
-                    {
-                        m_impl->m_tileset->getOptions().maximumCachedBytes = 0;
-                    }
-                    else
-                    {
-                        m_impl->m_tileset->getOptions().maximumCachedBytes = m_tilesetConfiguration.m_maximumCacheBytes;
-                    }
+                    // prefetched tiles get a share of the budget on top of it while prefetch views are set, so they don't
+                    // evict the tiles of the current view
+                    std::int64_t maximumCachedBytes =
+                        isTilesetVisible ? static_cast<std::int64_t>(m_tilesetConfiguration.m_maximumCacheBytes) : 0;
+                    m_impl->m_tileset->getOptions().maximumCachedBytes =
+                        maximumCachedBytes + m_impl->GetPrefetchCacheBytes(m_tilesetConfiguration);
                 }
 
-                // retrieve tiles are visible in the current frame
-                const Cesium3DTilesSelection::ViewUpdateResult& viewUpdate = m_impl->m_tileset->updateView(viewStates);
-
-                for (Cesium3DTilesSelection::Tile* tile : viewUpdate.tilesToNoLongerRenderThisFrame)
+                // tiles selected in the current frame are requested before the ones selected in earlier frames, which may be out of
+                // view by now. Requests of a tileset that is not visible anymore are only sent when nothing else is waiting, and
+                // prefetch requests go right before them
+                std::int64_t requestPriority = HttpAssetAccessor::LOWEST_REQUEST_PRIORITY;
+                if (isTilesetVisible)
                 {
-                    if (tile->getState() == Cesium3DTilesSelection::Tile::LoadState::Done)
-                    {
-                        void* renderResources = tile->getRendererResources();
-                        m_impl->m_renderResourcesPreparer->SetVisible(renderResources, false);
-                    }
+                    requestPriority =
+                        prefetch ? HttpAssetAccessor::LOWEST_REQUEST_PRIORITY + 1 : static_cast<std::int64_t>(time.GetMilliseconds());
                 }
 
-                for (Cesium3DTilesSelection::Tile* tile : viewUpdate.tilesToRenderThisFrame)
+                // tiles of the current view that are requested in a prefetch frame get the prefetch priority as well, so they
+                // are raised back together with the prefetched ones once the current view needs tiles again
+                if (!isTilesetVisible || (!prefetch && m_impl->m_prefetchPriorityRequested))
                 {
-                    if (tile->getState() == Cesium3DTilesSelection::Tile::LoadState::Done)
-                    {
-                        void* renderResources = tile->getRendererResources();
-                        m_impl->m_renderResourcesPreparer->SetVisible(renderResources, true);
-                    }
+                    m_impl->SetTileRequestsPriority(requestPriority);
                 }
+
+                m_impl->m_prefetchPriorityRequested = isTilesetVisible && prefetch;
+
+                // retrieve tiles are visible in the current frame, and the ones of the prefetch views when there is room for them
+                m_impl->BeginTileRequests(requestPriority);
+                const Cesium3DTilesSelection::ViewUpdateResult& viewUpdate = prefetch
+                    ? m_impl->UpdateView(m_impl->m_cameraConfigurations.GetViewStatesWithPrefetch(m_impl->m_prefetchViews))
+                    : m_impl->UpdateView(viewStates);
+                m_impl->EndTileRequests();
+
+                m_impl->UpdateTilesVisibility(viewUpdate, prefetch ? &viewStates : nullptr);
             }
+
+            // tiles loaded by updateView are turned into render resources within the frame's time limit
+            m_impl->m_renderResourcesPreparer->ProcessMainThreadWork(m_tilesetConfiguration.m_mainThreadLoadingTimeLimit);
+            m_impl->UpdateFrameStatistics();
         }
     }
 
@@ -65,6 +65,8 @@ namespace Cesium
                 ->Event("GetPanningSpeed", &GeoReferenceCameraFlyControllerRequestBus::Events::GetPanningSpeed)
                 ->Event("SetMovementSpeed", &GeoReferenceCameraFlyControllerRequestBus::Events::SetMovementSpeed)
                 ->Event("GetMovementSpeed", &GeoReferenceCameraFlyControllerRequestBus::Events::GetMovementSpeed)
+                ->Event("SetPrefetchViewCount", &GeoReferenceCameraFlyControllerRequestBus::Events::SetPrefetchViewCount)
+                ->Event("GetPrefetchViewCount", &GeoReferenceCameraFlyControllerRequestBus::Events::GetPrefetchViewCount)
                 ->Event(
                     "FlyToECEFLocation", &GeoReferenceCameraFlyControllerRequestBus::Events::FlyToECEFLocation,
                     { AZ::BehaviorParameterOverrides("ECEFLocation"), AZ::BehaviorParameterOverrides("ECEFDirection") })
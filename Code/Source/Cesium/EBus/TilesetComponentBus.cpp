@@ -10,14 +10,17 @@ namespace Cesium
         if (auto serializeContext = azrtti_cast<AZ::SerializeContext*>(context))
         {
             serializeContext->Class<TilesetConfiguration>()
-                ->Version(0)
+                ->Version(2)
                 ->Field("MaximumScreenSpaceError", &TilesetConfiguration::m_maximumScreenSpaceError)
                 ->Field("MaximumCacheBytes", &TilesetConfiguration::m_maximumCacheBytes)
                 ->Field("MaximumSimultaneousTileLoads", &TilesetConfiguration::m_maximumSimultaneousTileLoads)
                 ->Field("LoadingDescendantLimit", &TilesetConfiguration::m_loadingDescendantLimit)
                 ->Field("PreloadAncestors", &TilesetConfiguration::m_preloadAncestors)
                 ->Field("PreloadSiblings", &TilesetConfiguration::m_preloadSiblings)
-                ->Field("ForbidHole", &TilesetConfiguration::m_forbidHole);
+                ->Field("ForbidHole", &TilesetConfiguration::m_forbidHole)
+                ->Field("MainThreadLoadingTimeLimit", &TilesetConfiguration::m_mainThreadLoadingTimeLimit)
+                ->Field("PrefetchMaximumRequests", &TilesetConfiguration::m_prefetchMaximumRequests)
+                ->Field("PrefetchCacheShare", &TilesetConfiguration::m_prefetchCacheShare);
         }
 
         if (auto behaviorContext = azrtti_cast<AZ::BehaviorContext*>(context))
@@ -30,7 +33,54 @@ namespace Cesium
                 ->Property("LoadingDescendantLimit", BehaviorValueProperty(&TilesetConfiguration::m_loadingDescendantLimit))
                 ->Property("PreloadAncestors", BehaviorValueProperty(&TilesetConfiguration::m_preloadAncestors))
                 ->Property("PreloadSiblings", BehaviorValueProperty(&TilesetConfiguration::m_preloadSiblings))
-                ->Property("ForbidHole", BehaviorValueProperty(&TilesetConfiguration::m_forbidHole));
+                ->Property("ForbidHole", BehaviorValueProperty(&TilesetConfiguration::m_forbidHole))
+                ->Property("MainThreadLoadingTimeLimit", BehaviorValueProperty(&TilesetConfiguration::m_mainThreadLoadingTimeLimit))
+                ->Property("PrefetchMaximumRequests", BehaviorValueProperty(&TilesetConfiguration::m_prefetchMaximumRequests))
+                ->Property("PrefetchCacheShare", BehaviorValueProperty(&TilesetConfiguration::m_prefetchCacheShare));
+        }
+    }
+
+    void TilesetPrefetchView::Reflect(AZ::ReflectContext* context)
+    {
+        if (auto behaviorContext = azrtti_cast<AZ::BehaviorContext*>(context))
+        {
+            behaviorContext->Class<TilesetPrefetchView>("TilesetPrefetchView")
+                ->Attribute(AZ::Script::Attributes::Category, "Cesium/3DTiles")
+                ->Constructor<const glm::dvec3&, const glm::dvec3&, const glm::dvec3&>()
+                ->Property("Position", BehaviorValueProperty(&TilesetPrefetchView::m_position))
+                ->Property("Direction", BehaviorValueProperty(&TilesetPrefetchView::m_direction))
+                ->Property("Up", BehaviorValueProperty(&TilesetPrefetchView::m_up));
+        }
+    }
+
+    void TilesetStatistics::Reflect(AZ::ReflectContext* context)
+    {
+        if (auto behaviorContext = azrtti_cast<AZ::BehaviorContext*>(context))
+        {
+            behaviorContext->Class<TilesetStatistics>("TilesetStatistics")
+                ->Attribute(AZ::Script::Attributes::Category, "Cesium/3DTiles")
+                ->Property("TilesVisited", BehaviorValueProperty(&TilesetStatistics::m_tilesVisited))
+                ->Property("TilesRendered", BehaviorValueProperty(&TilesetStatistics::m_tilesRendered))
+                ->Property("TilesCulled", BehaviorValueProperty(&TilesetStatistics::m_tilesCulled))
+                ->Property("TilesContentLoading", BehaviorValueProperty(&TilesetStatistics::m_tilesContentLoading))
+                ->Property("TilesContentLoaded", BehaviorValueProperty(&TilesetStatistics::m_tilesContentLoaded))
+                ->Property("TilesDone", BehaviorValueProperty(&TilesetStatistics::m_tilesDone))
+                ->Property("TilesFailed", BehaviorValueProperty(&TilesetStatistics::m_tilesFailed))
+                ->Property("TilesFailedTemporarily", BehaviorValueProperty(&TilesetStatistics::m_tilesFailedTemporarily))
+                ->Property("TilesWaitingForMainThread", BehaviorValueProperty(&TilesetStatistics::m_tilesWaitingForMainThread))
+                ->Property("CachedBytes", BehaviorValueProperty(&TilesetStatistics::m_cachedBytes))
+                ->Property("MaximumCachedBytes", BehaviorValueProperty(&TilesetStatistics::m_maximumCachedBytes))
+                ->Property("RequestsInFlight", BehaviorValueProperty(&TilesetStatistics::m_requestsInFlight))
+                ->Property("RequestsCompletedPerSecond", BehaviorValueProperty(&TilesetStatistics::m_requestsCompletedPerSecond))
+                ->Property("UpdateViewTime", BehaviorValueProperty(&TilesetStatistics::m_updateViewTime))
+                ->Property("PrepareInMainThreadTime", BehaviorValueProperty(&TilesetStatistics::m_prepareInMainThreadTime))
+                ->Property("SetVisibleTime", BehaviorValueProperty(&TilesetStatistics::m_setVisibleTime))
+                ->Property("AttachRasterTime", BehaviorValueProperty(&TilesetStatistics::m_attachRasterTime))
+                ->Property("LoadedModels", BehaviorValueProperty(&TilesetStatistics::m_loadedModels))
+                ->Property("GltfMaterialTime", BehaviorValueProperty(&TilesetStatistics::m_gltfMaterialTime))
+                ->Property("GltfAttributeTime", BehaviorValueProperty(&TilesetStatistics::m_gltfAttributeTime))
+                ->Property("GltfTangentTime", BehaviorValueProperty(&TilesetStatistics::m_gltfTangentTime))
+                ->Property("GltfMeshAssetTime", BehaviorValueProperty(&TilesetStatistics::m_gltfMeshAssetTime));
         }
     }
 
@@ -38,16 +88,35 @@ namespace Cesium
     {
         if (auto serializeContext = azrtti_cast<AZ::SerializeContext*>(context))
         {
-            serializeContext->Class<TilesetRenderConfiguration>()->Version(0)->Field(
-                "GenerateMissingNormalAsSmooth", &TilesetRenderConfiguration::m_generateMissingNormalAsSmooth);
+            serializeContext->Class<TilesetRenderConfiguration>()
+                ->Version(1)
+                ->Field("GenerateMissingNormalAsSmooth", &TilesetRenderConfiguration::m_generateMissingNormalAsSmooth)
+                ->Field("CompactVertexLayout", &TilesetRenderConfiguration::m_compactVertexLayout)
+                ->Field("TextureCompression", &TilesetRenderConfiguration::m_textureCompression);
         }
 
         if (auto behaviorContext = azrtti_cast<AZ::BehaviorContext*>(context))
         {
+            behaviorContext->Enum<static_cast<int>(TilesetTextureCompression::None)>("TilesetTextureCompression_None")
+                ->Enum<static_cast<int>(TilesetTextureCompression::Fast)>("TilesetTextureCompression_Fast")
+                ->Enum<static_cast<int>(TilesetTextureCompression::Quality)>("TilesetTextureCompression_Quality");
+
+            auto getTextureCompression = [](TilesetRenderConfiguration* configuration) -> int
+            {
+                return static_cast<int>(configuration->m_textureCompression);
+            };
+
+            auto setTextureCompression = [](TilesetRenderConfiguration* configuration, int textureCompression)
+            {
+                configuration->m_textureCompression = static_cast<TilesetTextureCompression>(textureCompression);
+            };
+
             behaviorContext->Class<TilesetRenderConfiguration>("TilesetRenderConfiguration")
                 ->Attribute(AZ::Script::Attributes::Category, "Cesium/3DTiles")
                 ->Property(
-                    "GenerateMissingNormalAsSmooth", BehaviorValueProperty(&TilesetRenderConfiguration::m_generateMissingNormalAsSmooth));
+                    "GenerateMissingNormalAsSmooth", BehaviorValueProperty(&TilesetRenderConfiguration::m_generateMissingNormalAsSmooth))
+                ->Property("CompactVertexLayout", BehaviorValueProperty(&TilesetRenderConfiguration::m_compactVertexLayout))
+                ->Property("TextureCompression", getTextureCompression, setTextureCompression);
         }
     }
 
@@ -224,7 +293,10 @@ namespace Cesium
                 ->Event("LoadTileset", &TilesetRequestBus::Events::LoadTileset)
                 ->Event("GetRootTransform", &TilesetRequestBus::Events::GetRootTransform)
                 ->Event("GetTransform", &TilesetRequestBus::Events::GetTransform)
-                ->Event("ApplyTransformToRoot", &TilesetRequestBus::Events::ApplyTransformToRoot);
+                ->Event("ApplyTransformToRoot", &TilesetRequestBus::Events::ApplyTransformToRoot)
+                ->Event("GetStatistics", &TilesetRequestBus::Events::GetStatistics)
+                ->Event("SetPrefetchViews", &TilesetRequestBus::Events::SetPrefetchViews)
+                ->Event("ClearPrefetchViews", &TilesetRequestBus::Events::ClearPrefetchViews);
         }
     }
 } // namespace Cesium
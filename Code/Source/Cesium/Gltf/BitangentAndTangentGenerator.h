@@ -3,30 +3,20 @@
 #include <AzCore/std/containers/span.h>
 #include <AzCore/std/containers/vector.h>
 #include <glm/glm.hpp>
+#include <cstdint>
 
 namespace Cesium
 {
     struct BitangentAndTangentGenerator
     {
     public:
+        // positions, normals and uvs are indexed by the triangle list. Tangents and bitangents are written per triangle corner,
+        // so corners of the same vertex can end up with different tangents at UV seams
         static bool Generate(
-            const AZStd::span<glm::vec3>& positions,
-            const AZStd::span<glm::vec3>& normals,
-            const AZStd::span<glm::vec2>& uvs,
-            AZStd::vector<glm::vec4>& tangents,
-            AZStd::vector<glm::vec3>& bitangents);
-
-        static bool Generate(
-            const AZStd::span<glm::vec3>& positions,
-            const AZStd::span<glm::vec3>& normals,
-            const AZStd::span<glm::u8vec2>& unorm_uvs,
-            AZStd::vector<glm::vec4>& tangents,
-            AZStd::vector<glm::vec3>& bitangents);
-
-        static bool Generate(
-            const AZStd::span<glm::vec3>& positions,
-            const AZStd::span<glm::vec3>& normals,
-            const AZStd::span<glm::u16vec2>& unorm_uvs,
+            const AZStd::span<const std::uint32_t>& indices,
+            const AZStd::span<const glm::vec3>& positions,
+            const AZStd::span<const glm::vec3>& normals,
+            const AZStd::span<const glm::vec2>& uvs,
             AZStd::vector<glm::vec4>& tangents,
             AZStd::vector<glm::vec3>& bitangents);
 
@@ -28,12 +28,14 @@ namespace Cesium
     GltfLoadMaterial::GltfLoadMaterial()
         : m_materialAsset{}
         , m_needTangents{ false }
+        , m_compactVertexLayout{ false }
     {
     }
 
     GltfLoadMaterial::GltfLoadMaterial(AZ::Data::Asset<AZ::RPI::MaterialAsset>&& materialAsset, bool needTangents)
         : m_materialAsset{ std::move(materialAsset) }
         , m_needTangents{ needTangents }
+        , m_compactVertexLayout{ false }
     {
     }
 
@@ -45,12 +47,14 @@ namespace Cesium
     GltfLoadPrimitive::GltfLoadPrimitive()
         : m_modelAsset{}
         , m_materialId{ -1 }
+        , m_vertexTransform{ glm::dmat4(1.0) }
     {
     }
 
     GltfLoadPrimitive::GltfLoadPrimitive(AZ::Data::Asset<AZ::RPI::ModelAsset>&& modelAsset, MaterialId materialId)
         : m_modelAsset{ std::move(modelAsset) }
         , m_materialId{ materialId }
+        , m_vertexTransform{ glm::dmat4(1.0) }
     {
     }
 
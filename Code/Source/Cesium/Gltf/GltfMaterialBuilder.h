@@ -3,6 +3,7 @@
 #include "Cesium/Gltf/GltfLoadContext.h"
 #include <AzCore/Asset/AssetCommon.h>
 #include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/containers/vector.h>
 
 namespace CesiumGltf
 {
@@ -30,6 +31,15 @@ namespace Cesium
 
         virtual void OverrideMaterialType(const AZ::Data::Asset<AZ::RPI::MaterialTypeAsset>& materialType) = 0;
 
+        // Creates the textures of all materials up front, so that Create only finds them in the cache. Builders may create
+        // them concurrently, which is why this runs before any material is created
+        virtual void CreateTextures(
+            [[maybe_unused]] const CesiumGltf::Model& model,
+            [[maybe_unused]] const AZStd::vector<const CesiumGltf::Material*>& materials,
+            [[maybe_unused]] AZStd::unordered_map<TextureId, GltfLoadTexture>& textureCache)
+        {
+        }
+
         virtual void Create(
             const CesiumGltf::Model& model,
             const CesiumGltf::Material& material,
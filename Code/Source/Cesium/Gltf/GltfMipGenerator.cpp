@@ -0,0 +1,308 @@
+#include "Cesium/Gltf/GltfMipGenerator.h"
+#include <AzCore/base.h>
+#include <AzCore/std/algorithm.h>
+#include <AzCore/Debug/Trace.h>
+
+#if AZ_TRAIT_USE_PLATFORM_SIMD_SSE
+#include <emmintrin.h>
+#endif
+
+#include <cmath>
+
+namespace Cesium
+{
+    namespace
+    {
+        // lookup tables between sRGB encoded bytes and linear values, so filtering in linear space costs no pow per texel
+        struct SrgbTables final
+        {
+            static constexpr std::uint32_t LINEAR_STEPS = 4096;
+
+            SrgbTables()
+            {
+                for (std::uint32_t i = 0; i < 256; ++i)
+                {
+                    double encoded = i / 255.0;
+                    double linear = encoded <= 0.04045 ? encoded / 12.92 : std::pow((encoded + 0.055) / 1.055, 2.4);
+                    m_toLinear[i] = static_cast<float>(linear);
+                }
+
+                for (std::uint32_t i = 0; i < LINEAR_STEPS; ++i)
+                {
+                    double linear = i / static_cast<double>(LINEAR_STEPS - 1);
+                    double encoded = linear <= 0.0031308 ? linear * 12.92 : 1.055 * std::pow(linear, 1.0 / 2.4) - 0.055;
+                    m_fromLinear[i] = static_cast<std::uint8_t>(std::lround(encoded * 255.0));
+                }
+            }
+
+            float m_toLinear[256];
+            std::uint8_t m_fromLinear[LINEAR_STEPS];
+        };
+
+        const SrgbTables& GetSrgbTables()
+        {
+            static const SrgbTables tables;
+            return tables;
+        }
+
+#if AZ_TRAIT_USE_PLATFORM_SIMD_SSE
+        // 2x2 box filters of linear 8 bit texels, rounded like the scalar loop: (sum + 2) / 4. They filter as many destination
+        // texels as fill whole registers from source texel pairs that lie inside the row, and return how many they filtered.
+        // The scalar loop finishes the rest
+        std::uint32_t DownsampleRgbaRowSimd(
+            const std::uint8_t* row0, const std::uint8_t* row1, std::uint8_t* destination, std::uint32_t count)
+        {
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i rounding = _mm_set1_epi16(2);
+            std::uint32_t x = 0;
+            for (; x + 4 <= count; x += 4)
+            {
+                // each register holds 4 source texels, which make 2 destination texels
+                __m128i halves[2];
+                for (std::uint32_t i = 0; i < 2; ++i)
+                {
+                    __m128i top = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + x * 8 + i * 16));
+                    __m128i bottom = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + x * 8 + i * 16));
+                    __m128i low = _mm_add_epi16(_mm_unpacklo_epi8(top, zero), _mm_unpacklo_epi8(bottom, zero));
+                    __m128i high = _mm_add_epi16(_mm_unpackhi_epi8(top, zero), _mm_unpackhi_epi8(bottom, zero));
+
+                    // the lower 4 lanes of each register end up holding the sum of its two horizontally adjacent texels
+                    low = _mm_add_epi16(low, _mm_srli_si128(low, 8));
+                    high = _mm_add_epi16(high, _mm_srli_si128(high, 8));
+                    halves[i] = _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(low, high), rounding), 2);
+                }
+
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + x * 4), _mm_packus_epi16(halves[0], halves[1]));
+            }
+
+            return x;
+        }
+
+        std::uint32_t DownsampleRedRowSimd(
+            const std::uint8_t* row0, const std::uint8_t* row1, std::uint8_t* destination, std::uint32_t count)
+        {
+            const __m128i evenMask = _mm_set1_epi16(0x00FF);
+            const __m128i rounding = _mm_set1_epi16(2);
+            std::uint32_t x = 0;
+            for (; x + 16 <= count; x += 16)
+            {
+                // each register holds 16 source texels, which make 8 destination texels from their even and odd bytes
+                __m128i halves[2];
+                for (std::uint32_t i = 0; i < 2; ++i)
+                {
+                    __m128i top = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + x * 2 + i * 16));
+                    __m128i bottom = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + x * 2 + i * 16));
+                    __m128i sum = _mm_add_epi16(_mm_and_si128(top, evenMask), _mm_srli_epi16(top, 8));
+                    sum = _mm_add_epi16(sum, _mm_add_epi16(_mm_and_si128(bottom, evenMask), _mm_srli_epi16(bottom, 8)));
+                    halves[i] = _mm_srli_epi16(_mm_add_epi16(sum, rounding), 2);
+                }
+
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + x), _mm_packus_epi16(halves[0], halves[1]));
+            }
+
+            return x;
+        }
+#endif
+
+        // the channel count is a template argument, so the inner loop has a fixed stride the compiler can vectorize
+        template<std::uint32_t Channels>
+        void DownsampleLevel(
+            const std::uint8_t* source,
+            std::uint32_t sourceWidth,
+            std::uint32_t sourceHeight,
+            std::uint8_t* destination,
+            std::uint32_t width,
+            std::uint32_t height,
+            bool srgb)
+        {
+            const SrgbTables& srgbTables = GetSrgbTables();
+            std::uint32_t colorChannels = srgb ? AZStd::min(Channels, 3u) : 0u;
+            for (std::uint32_t y = 0; y < height; ++y)
+            {
+                std::size_t rowBytes = static_cast<std::size_t>(sourceWidth) * Channels;
+                const std::uint8_t* row0 = source + AZStd::min(2 * y, sourceHeight - 1) * rowBytes;
+                const std::uint8_t* row1 = source + AZStd::min(2 * y + 1, sourceHeight - 1) * rowBytes;
+                std::uint8_t* destinationRow = destination + static_cast<std::size_t>(y) * width * Channels;
+                std::uint32_t x = 0;
+#if AZ_TRAIT_USE_PLATFORM_SIMD_SSE
+                // sRGB channels go through the lookup tables, so only linear RGBA and single channel levels are filtered in SSE
+                if constexpr (Channels == 4)
+                {
+                    if (colorChannels == 0)
+                    {
+                        x = DownsampleRgbaRowSimd(row0, row1, destinationRow, AZStd::min(width, sourceWidth / 2));
+                    }
+                }
+                else if constexpr (Channels == 1)
+                {
+                    if (colorChannels == 0)
+                    {
+                        x = DownsampleRedRowSimd(row0, row1, destinationRow, AZStd::min(width, sourceWidth / 2));
+                    }
+                }
+#endif
+
+                for (; x < width; ++x)
+                {
+                    std::size_t x0 = static_cast<std::size_t>(AZStd::min(2 * x, sourceWidth - 1)) * Channels;
+                    std::size_t x1 = static_cast<std::size_t>(AZStd::min(2 * x + 1, sourceWidth - 1)) * Channels;
+                    for (std::uint32_t c = 0; c < Channels; ++c)
+                    {
+                        if (c < colorChannels)
+                        {
+                            float linear = (srgbTables.m_toLinear[row0[x0 + c]] + srgbTables.m_toLinear[row0[x1 + c]] +
+                                            srgbTables.m_toLinear[row1[x0 + c]] + srgbTables.m_toLinear[row1[x1 + c]]) *
+                                0.25f;
+                            destinationRow[x * Channels + c] =
+                                srgbTables.m_fromLinear[static_cast<std::size_t>(linear * (SrgbTables::LINEAR_STEPS - 1) + 0.5f)];
+                        }
+                        else
+                        {
+                            std::uint32_t sum = row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c];
+                            destinationRow[x * Channels + c] = static_cast<std::uint8_t>((sum + 2) >> 2);
+                        }
+                    }
+                }
+            }
+        }
+    } // namespace
+
+    float GltfMipGenerator::SrgbToLinear(std::uint8_t encoded)
+    {
+        return GetSrgbTables().m_toLinear[encoded];
+    }
+
+    std::uint8_t GltfMipGenerator::LinearToSrgb(float linear)
+    {
+        linear = AZStd::clamp(linear, 0.0f, 1.0f);
+        return GetSrgbTables().m_fromLinear[static_cast<std::size_t>(linear * (SrgbTables::LINEAR_STEPS - 1) + 0.5f)];
+    }
+
+    std::uint32_t GltfMipGenerator::GetMipCount(std::uint32_t width, std::uint32_t height)
+    {
+        std::uint32_t mipCount = 1;
+        std::uint32_t size = AZStd::max(width, height);
+        while (size > 1)
+        {
+            size >>= 1;
+            ++mipCount;
+        }
+
+        return mipCount;
+    }
+
+    AZStd::vector<GltfImageMip> GltfMipGenerator::GenerateMips(
+        AZStd::vector<std::byte>& pixels, std::uint32_t width, std::uint32_t height, std::uint32_t channels, bool srgb)
+    {
+        AZ_Assert(channels >= 1 && channels <= 4, "Mips can only be generated for 1 to 4 channels");
+        AZ_Assert(pixels.size() == static_cast<std::size_t>(width) * height * channels, "The pixels must hold exactly the top level");
+
+        // size the buffer once, so the levels can be written without moving the ones above
+        AZStd::vector<GltfImageMip> mips;
+        std::uint32_t mipCount = GetMipCount(width, height);
+        mips.reserve(mipCount);
+        std::size_t byteOffset = 0;
+        for (std::uint32_t mip = 0; mip < mipCount; ++mip)
+        {
+            std::uint32_t mipWidth = AZStd::max(width >> mip, 1u);
+            std::uint32_t mipHeight = AZStd::max(height >> mip, 1u);
+            std::size_t byteSize = static_cast<std::size_t>(mipWidth) * mipHeight * channels;
+            mips.push_back(GltfImageMip{ byteOffset, byteSize, mipWidth, mipHeight });
+            byteOffset += byteSize;
+        }
+
+        pixels.resize(byteOffset);
+        std::uint8_t* data = reinterpret_cast<std::uint8_t*>(pixels.data());
+        for (std::size_t mip = 1; mip < mips.size(); ++mip)
+        {
+            const GltfImageMip& source = mips[mip - 1];
+            const GltfImageMip& destination = mips[mip];
+            const std::uint8_t* sourceData = data + source.m_byteOffset;
+            std::uint8_t* destinationData = data + destination.m_byteOffset;
+            switch (channels)
+            {
+            case 1:
+                DownsampleLevel<1>(
+                    sourceData, source.m_width, source.m_height, destinationData, destination.m_width, destination.m_height, srgb);
+                break;
+            case 2:
+                DownsampleLevel<2>(
+                    sourceData, source.m_width, source.m_height, destinationData, destination.m_width, destination.m_height, srgb);
+                break;
+            case 3:
+                DownsampleLevel<3>(
+                    sourceData, source.m_width, source.m_height, destinationData, destination.m_width, destination.m_height, srgb);
+                break;
+            default:
+                DownsampleLevel<4>(
+                    sourceData, source.m_width, source.m_height, destinationData, destination.m_width, destination.m_height, srgb);
+                break;
+            }
+        }
+
+        return mips;
+    }
+
+    AZStd::vector<std::byte> GltfMipGenerator::Resize(
+        const std::byte* pixels,
+        std::uint32_t width,
+        std::uint32_t height,
+        std::uint32_t channels,
+        bool srgb,
+        std::uint32_t newWidth,
+        std::uint32_t newHeight)
+    {
+        AZ_Assert(channels >= 1 && channels <= 4, "Only images of 1 to 4 channels can be resized");
+        AZ_Assert(width > 0 && height > 0 && newWidth > 0 && newHeight > 0, "Images to resize must not be empty");
+
+        const SrgbTables& srgbTables = GetSrgbTables();
+        std::uint32_t colorChannels = srgb ? AZStd::min(channels, 3u) : 0u;
+        const std::uint8_t* source = reinterpret_cast<const std::uint8_t*>(pixels);
+        AZStd::vector<std::byte> result(static_cast<std::size_t>(newWidth) * newHeight * channels);
+        std::uint8_t* destination = reinterpret_cast<std::uint8_t*>(result.data());
+        float scaleX = static_cast<float>(width) / static_cast<float>(newWidth);
+        float scaleY = static_cast<float>(height) / static_cast<float>(newHeight);
+        for (std::uint32_t y = 0; y < newHeight; ++y)
+        {
+            float sourceY = AZStd::clamp((static_cast<float>(y) + 0.5f) * scaleY - 0.5f, 0.0f, static_cast<float>(height - 1));
+            std::uint32_t y0 = static_cast<std::uint32_t>(sourceY);
+            std::uint32_t y1 = AZStd::min(y0 + 1, height - 1);
+            float weightY = sourceY - static_cast<float>(y0);
+            const std::uint8_t* row0 = source + static_cast<std::size_t>(y0) * width * channels;
+            const std::uint8_t* row1 = source + static_cast<std::size_t>(y1) * width * channels;
+            for (std::uint32_t x = 0; x < newWidth; ++x)
+            {
+                float sourceX = AZStd::clamp((static_cast<float>(x) + 0.5f) * scaleX - 0.5f, 0.0f, static_cast<float>(width - 1));
+                std::uint32_t x0 = static_cast<std::uint32_t>(sourceX);
+                std::uint32_t x1 = AZStd::min(x0 + 1, width - 1);
+                float weightX = sourceX - static_cast<float>(x0);
+                std::uint8_t* texel = destination + (static_cast<std::size_t>(y) * newWidth + x) * channels;
+                for (std::uint32_t c = 0; c < channels; ++c)
+                {
+                    auto load = [&srgbTables, isColor = c < colorChannels](std::uint8_t value)
+                    {
+                        return isColor ? srgbTables.m_toLinear[value] : static_cast<float>(value);
+                    };
+
+                    float t00 = load(row0[x0 * channels + c]);
+                    float t01 = load(row0[x1 * channels + c]);
+                    float t10 = load(row1[x0 * channels + c]);
+                    float t11 = load(row1[x1 * channels + c]);
+                    float top = t00 + (t01 - t00) * weightX;
+                    float bottom = t10 + (t11 - t10) * weightX;
+                    float value = top + (bottom - top) * weightY;
+                    if (c < colorChannels)
+                    {
+                        texel[c] = srgbTables.m_fromLinear[static_cast<std::size_t>(value * (SrgbTables::LINEAR_STEPS - 1) + 0.5f)];
+                    }
+                    else
+                    {
+                        texel[c] = static_cast<std::uint8_t>(AZStd::min(value + 0.5f, 255.0f));
+                    }
+                }
+            }
+        }
+
+        return result;
+    }
+} // namespace Cesium
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <AzCore/std/containers/vector.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace Cesium
+{
+    // A level of an image whose levels are stored one after another in the same buffer
+    struct GltfImageMip final
+    {
+        std::size_t m_byteOffset;
+        std::size_t m_byteSize;
+        std::uint32_t m_width;
+        std::uint32_t m_height;
+    };
+
+    class GltfMipGenerator final
+    {
+    public:
+        // levels from width x height down to 1x1
+        static std::uint32_t GetMipCount(std::uint32_t width, std::uint32_t height);
+
+        // Appends the levels below the top one to pixels, which holds the top level of 8 bit texels on entry, and returns
+        // every level starting from the top. Each level averages 2x2 texels of the one above, repeating the texel of sides
+        // that are already 1 texel long. The color channels of sRGB images are averaged in linear space, alpha never is
+        static AZStd::vector<GltfImageMip> GenerateMips(
+            AZStd::vector<std::byte>& pixels, std::uint32_t width, std::uint32_t height, std::uint32_t channels, bool srgb);
+
+        // Resamples an image of 8 bit texels to newWidth x newHeight with bilinear filtering, using the same color space rules
+        // as GenerateMips. Texel centers are aligned, so the edges of the result repeat the edges of the source
+        static AZStd::vector<std::byte> Resize(
+            const std::byte* pixels,
+            std::uint32_t width,
+            std::uint32_t height,
+            std::uint32_t channels,
+            bool srgb,
+            std::uint32_t newWidth,
+            std::uint32_t newHeight);
+
+        // sRGB decoding and encoding of 8 bit color values with the lookup tables GenerateMips and Resize filter with
+        static float SrgbToLinear(std::uint8_t encoded);
+
+        // linear is clamped to [0, 1]
+        static std::uint8_t LinearToSrgb(float linear);
+    };
+} // namespace Cesium
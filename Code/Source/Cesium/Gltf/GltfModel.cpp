@@ -10,6 +10,7 @@ namespace Cesium
 {
     GltfPrimitive::GltfPrimitive()
         : m_materialIndex{ -1 }
+        , m_vertexTransform{ glm::dmat4(1.0) }
     {
     }
 
@@ -29,10 +30,6 @@ namespace Cesium
         m_meshes.reserve(loadModel.m_meshes.size());
         for (const auto& loadMesh : loadModel.m_meshes)
         {
-            AZ::Transform o3deTransform;
-            AZ::Vector3 o3deScale;
-            ConvertMat4ToTransformAndScale(loadMesh.m_transform, o3deTransform, o3deScale);
-
             GltfMesh& gltfMesh = m_meshes.emplace_back();
             gltfMesh.m_transform = loadMesh.m_transform;
             gltfMesh.m_primitives.reserve(loadMesh.m_primitives.size());
@@ -53,6 +50,9 @@ namespace Cesium
                     AZ::Render::MeshHandleDescriptor descriptor;
                     descriptor.m_modelAsset = loadPrimitive.m_modelAsset;
                     auto meshHandle = m_meshFeatureProcessor->AcquireMesh(descriptor);
+                    AZ::Transform o3deTransform;
+                    AZ::Vector3 o3deScale;
+                    ConvertMat4ToTransformAndScale(loadMesh.m_transform * loadPrimitive.m_vertexTransform, o3deTransform, o3deScale);
                     m_meshFeatureProcessor->SetTransform(meshHandle, o3deTransform, o3deScale);
 
                     // Set material assignment map after acquiring the mesh
@@ -68,6 +68,7 @@ namespace Cesium
                     GltfPrimitive primitive;
                     primitive.m_meshHandle = std::move(meshHandle);
                     primitive.m_materialIndex = loadPrimitive.m_materialId;
+                    primitive.m_vertexTransform = loadPrimitive.m_vertexTransform;
 
                     gltfMesh.m_primitives.emplace_back(std::move(primitive));
                 }
@@ -159,11 +160,11 @@ namespace Cesium
         for (GltfMesh& mesh : m_meshes)
         {
             glm::dmat4 newTransform = transform * mesh.m_transform;
-            AZ::Transform o3deTransform;
-            AZ::Vector3 o3deScale;
-            ConvertMat4ToTransformAndScale(newTransform, o3deTransform, o3deScale);
             for (auto& primitive : mesh.m_primitives)
             {
+                AZ::Transform o3deTransform;
+                AZ::Vector3 o3deScale;
+                ConvertMat4ToTransformAndScale(newTransform * primitive.m_vertexTransform, o3deTransform, o3deScale);
                 m_meshFeatureProcessor->SetTransform(primitive.m_meshHandle, o3deTransform, o3deScale);
             }
         }
@@ -14,6 +14,10 @@ namespace Cesium
         GltfMaterial() = default;
 
         AZ::Data::Instance<AZ::RPI::Material> m_material;
+
+        // the instance is found by the id of a material asset that is shared with every tile of the same material content, so
+        // it must be replaced by an instance of the model's own before its properties change
+        bool m_sharedInstance{ true };
     };
 
     struct GltfPrimitive
@@ -22,6 +26,7 @@ namespace Cesium
 
         AZ::Render::MeshFeatureProcessorInterface::MeshHandle m_meshHandle;
         std::int32_t m_materialIndex;
+        glm::dmat4 m_vertexTransform;
     };
 
     struct GltfMesh
@@ -2,6 +2,9 @@
 #include "Cesium/Gltf/GltfPrimitiveBuilder.h"
 #include "Cesium/Gltf/GltfLoadContext.h"
 #include "Cesium/Systems/GenericIOManager.h"
+#include "Cesium/Systems/CesiumProfiler.h"
+#include "Cesium/Systems/CesiumSystem.h"
+#include <AzCore/std/algorithm.h>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/quaternion.hpp>
 
@@ -29,6 +32,7 @@ namespace Cesium
 {
     GltfModelBuilderOption::GltfModelBuilderOption(const glm::dmat4& transform)
         : m_transform{ transform }
+        , m_smoothMissingNormals{ false }
     {
     }
 
@@ -40,14 +44,18 @@ namespace Cesium
     void GltfModelBuilder::Create(
         GenericIOManager& io, const AZStd::string& filePath, const GltfModelBuilderOption& option, GltfLoadModel& result)
     {
-        auto fileContent = io.GetFileContent({ "", filePath });
+        auto fileContent = io.GetMappedFileContent({ "", filePath });
         CesiumGltfReader::GltfReader reader;
-        auto load = reader.readModel(gsl::span<const std::byte>(fileContent.data(), fileContent.size()));
+
+        // embedded images are decoded together with the external ones below, instead of one after another by the reader
+        CesiumGltfReader::ReadModelOptions readOptions;
+        readOptions.decodeEmbeddedImages = false;
+        auto load = reader.readModel(fileContent.GetData(), readOptions);
         if (load.model)
         {
             AZStd::string parentPath = io.GetParentPath(filePath);
-            ResolveExternalImages(parentPath, reader, *load.model, io);
             ResolveExternalBuffers(parentPath, *load.model, io);
+            DecodeImages(parentPath, reader, *load.model, io);
 
             return Create(*load.model, option, result);
         }
@@ -55,6 +63,8 @@ namespace Cesium
 
     void GltfModelBuilder::Create(const CesiumGltf::Model& model, const GltfModelBuilderOption& option, GltfLoadModel& result)
     {
+        CESIUM_PROFILE_SCOPE("GltfModelBuilder::Create");
+
         // Resize materials to be the same with gltf materials, so that we can use it as a cache.
         // It maybe wasteful when some gltfs has more materials than what are used in the its primitives.
         result.m_materials.resize(model.materials.size());
@@ -62,21 +72,23 @@ namespace Cesium
         // Resize meshes the same with gltf meshes for caching
         result.m_meshes.resize(model.meshes.size());
 
+        // find the meshes to display and their transforms first, so that their materials and primitives can be built in bulk
+        AZStd::vector<std::size_t> meshIndices;
         if (model.scene >= 0 && model.scene < model.scenes.size())
         {
             // display default scene
-            LoadScene(model, model.scenes[model.scene], option, result);
+            LoadScene(model, model.scenes[model.scene], option, result, meshIndices);
         }
         else if (model.scenes.size() > 0)
         {
             // no default scene, display the first one
-            LoadScene(model, model.scenes.front(), option, result);
+            LoadScene(model, model.scenes.front(), option, result, meshIndices);
         }
         else if (model.nodes.size() > 0)
         {
             // no default scene, display the first node
             glm::dmat4 worldTransform = option.m_transform * GLTF_TO_O3DE;
-            LoadNode(model, model.nodes.front(), worldTransform, result);
+            LoadNode(model, model.nodes.front(), worldTransform, result, meshIndices);
         }
         else
         {
@@ -84,26 +96,37 @@ namespace Cesium
             glm::dmat4 worldTransform = option.m_transform * GLTF_TO_O3DE;
             for (std::size_t i = 0; i < model.meshes.size(); ++i)
             {
-                LoadMesh(model, i, worldTransform, result);
+                LoadMesh(i, worldTransform, result, meshIndices);
             }
         }
+
+        CreateMaterials(model, meshIndices, result);
+        CreatePrimitives(model, meshIndices, option.m_smoothMissingNormals, result);
     }
 
     void GltfModelBuilder::LoadScene(
-        const CesiumGltf::Model& model, const CesiumGltf::Scene& scene, const GltfModelBuilderOption& option, GltfLoadModel& result)
+        const CesiumGltf::Model& model,
+        const CesiumGltf::Scene& scene,
+        const GltfModelBuilderOption& option,
+        GltfLoadModel& result,
+        AZStd::vector<std::size_t>& meshIndices)
     {
         glm::dmat4 worldTransform = option.m_transform * GLTF_TO_O3DE;
         for (std::int32_t rootIndex : scene.nodes)
         {
             if (rootIndex >= 0 && rootIndex <= model.nodes.size())
             {
-                LoadNode(model, model.nodes[static_cast<std::size_t>(rootIndex)], worldTransform, result);
+                LoadNode(model, model.nodes[static_cast<std::size_t>(rootIndex)], worldTransform, result, meshIndices);
             }
         }
     }
 
     void GltfModelBuilder::LoadNode(
-        const CesiumGltf::Model& model, const CesiumGltf::Node& node, const glm::dmat4& parentTransform, GltfLoadModel& result)
+        const CesiumGltf::Model& model,
+        const CesiumGltf::Node& node,
+        const glm::dmat4& parentTransform,
+        GltfLoadModel& result,
+        AZStd::vector<std::size_t>& meshIndices)
     {
         glm::dmat4 currentTransform = parentTransform;
         if (node.matrix.size() == 16 && !IsIdentityMatrix(node.matrix))
@@ -135,80 +158,170 @@ namespace Cesium
 
         if (node.mesh >= 0 && node.mesh <= model.meshes.size())
         {
-            LoadMesh(model, static_cast<std::size_t>(node.mesh), currentTransform, result);
+            LoadMesh(static_cast<std::size_t>(node.mesh), currentTransform, result, meshIndices);
         }
 
         for (std::int32_t child : node.children)
         {
             if (child >= 0 && child < model.nodes.size())
             {
-                LoadNode(model, model.nodes[static_cast<std::size_t>(child)], currentTransform, result);
+                LoadNode(model, model.nodes[static_cast<std::size_t>(child)], currentTransform, result, meshIndices);
             }
         }
     }
 
     void GltfModelBuilder::LoadMesh(
-        const CesiumGltf::Model& model, std::size_t meshIndex, const glm::dmat4& transform, GltfLoadModel& result)
+        std::size_t meshIndex, const glm::dmat4& transform, GltfLoadModel& result, AZStd::vector<std::size_t>& meshIndices)
+    {
+        // a mesh referenced by several nodes is built once, with the transform of the last node
+        result.m_meshes[meshIndex].m_transform = transform;
+        if (AZStd::find(meshIndices.begin(), meshIndices.end(), meshIndex) == meshIndices.end())
+        {
+            meshIndices.emplace_back(meshIndex);
+        }
+    }
+
+    void GltfModelBuilder::CreateMaterials(
+        const CesiumGltf::Model& model, const AZStd::vector<std::size_t>& meshIndices, GltfLoadModel& result)
     {
-        const CesiumGltf::Mesh& mesh = model.meshes[meshIndex];
-        GltfLoadMesh& gltfLoadMesh = result.m_meshes[meshIndex];
-        gltfLoadMesh.m_transform = transform;
-        gltfLoadMesh.m_primitives.reserve(mesh.primitives.size());
-        for (const CesiumGltf::MeshPrimitive& primitive : mesh.primitives)
-        {
-            // create material asset
-            const CesiumGltf::Material* material = model.getSafe<CesiumGltf::Material>(&model.materials, primitive.material);
-            if (!material)
+        AZStd::vector<std::size_t> materialIndices;
+        AZStd::vector<const CesiumGltf::Material*> materials;
+        AZStd::vector<bool> usedMaterials(model.materials.size(), false);
+        for (std::size_t meshIndex : meshIndices)
+        {
+            for (const CesiumGltf::MeshPrimitive& primitive : model.meshes[meshIndex].primitives)
             {
-                continue;
+                const CesiumGltf::Material* material = model.getSafe<CesiumGltf::Material>(&model.materials, primitive.material);
+                if (material && !usedMaterials[static_cast<std::size_t>(primitive.material)])
+                {
+                    usedMaterials[static_cast<std::size_t>(primitive.material)] = true;
+                    materialIndices.emplace_back(static_cast<std::size_t>(primitive.material));
+                    materials.emplace_back(material);
+                }
             }
+        }
+
+        if (materials.empty())
+        {
+            return;
+        }
 
-            GltfLoadMaterial& loadMaterial = result.m_materials[primitive.material];
-            if (loadMaterial.IsEmpty())
+        // textures are decoded concurrently by the material builder. Materials themselves only look the textures up, so
+        // they are created in order
+        CESIUM_PROFILE_SCOPE("GltfModelBuilder::CreateMaterial");
+        StageTimer materialTimer(result.m_statistics.m_materialNanoseconds);
+        m_materialBuilder->CreateTextures(model, materials, result.m_textures);
+        for (std::size_t i = 0; i < materials.size(); ++i)
+        {
+            m_materialBuilder->Create(model, *materials[i], result.m_textures, result.m_materials[materialIndices[i]]);
+        }
+    }
+
+    void GltfModelBuilder::CreatePrimitives(
+        const CesiumGltf::Model& model, const AZStd::vector<std::size_t>& meshIndices, bool smoothMissingNormals, GltfLoadModel& result)
+    {
+        struct PrimitiveTask
+        {
+            const CesiumGltf::MeshPrimitive* m_primitive;
+            const GltfLoadMaterial* m_material;
+            GltfLoadPrimitive* m_result;
+        };
+
+        // size every mesh up front, so that the tasks write into stable primitives
+        AZStd::vector<PrimitiveTask> tasks;
+        for (std::size_t meshIndex : meshIndices)
+        {
+            const CesiumGltf::Mesh& mesh = model.meshes[meshIndex];
+            GltfLoadMesh& gltfLoadMesh = result.m_meshes[meshIndex];
+            std::size_t primitiveCount = AZStd::count_if(
+                mesh.primitives.begin(), mesh.primitives.end(),
+                [&model](const CesiumGltf::MeshPrimitive& primitive)
+                {
+                    return model.getSafe<CesiumGltf::Material>(&model.materials, primitive.material) != nullptr;
+                });
+            gltfLoadMesh.m_primitives.resize(primitiveCount);
+
+            std::size_t primitiveIndex = 0;
+            for (const CesiumGltf::MeshPrimitive& primitive : mesh.primitives)
             {
-                m_materialBuilder->Create(model, *material, result.m_textures, loadMaterial);
+                if (model.getSafe<CesiumGltf::Material>(&model.materials, primitive.material))
+                {
+                    tasks.push_back(PrimitiveTask{ &primitive, &result.m_materials[primitive.material],
+                                                   &gltfLoadMesh.m_primitives[primitiveIndex] });
+                    ++primitiveIndex;
+                }
             }
+        }
 
-            // load primitive
-            GltfLoadPrimitive& loadPrimitive = gltfLoadMesh.m_primitives.emplace_back();
-            GltfTrianglePrimitiveBuilder primitiveBuilder;
-            primitiveBuilder.Create(model, primitive, loadMaterial, loadPrimitive);
+        // each primitive has its own statistics, so the stage times are summed over the threads that built them
+        AZStd::vector<GltfLoadStatistics> primitiveStatistics(tasks.size());
+        CesiumInterface::Get()->GetScheduler().ParallelFor(
+            CesiumSchedulerLane::Compute,
+            tasks.size(),
+            [&model, &tasks, &primitiveStatistics, smoothMissingNormals](std::size_t i)
+            {
+                const PrimitiveTask& task = tasks[i];
+                GltfTrianglePrimitiveBuilder primitiveBuilder;
+                primitiveBuilder.Create(
+                    model, *task.m_primitive, *task.m_material, smoothMissingNormals, *task.m_result, primitiveStatistics[i]);
+            });
+
+        for (const GltfLoadStatistics& statistics : primitiveStatistics)
+        {
+            result.m_statistics.m_materialNanoseconds += statistics.m_materialNanoseconds;
+            result.m_statistics.m_attributeNanoseconds += statistics.m_attributeNanoseconds;
+            result.m_statistics.m_tangentNanoseconds += statistics.m_tangentNanoseconds;
+            result.m_statistics.m_meshAssetNanoseconds += statistics.m_meshAssetNanoseconds;
         }
     }
 
-    void GltfModelBuilder::ResolveExternalImages(
+    void GltfModelBuilder::DecodeImages(
         const AZStd::string& parentPath, const CesiumGltfReader::GltfReader& gltfReader, CesiumGltf::Model& model, GenericIOManager& io)
     {
+        AZStd::vector<CesiumGltf::Image*> images;
         for (CesiumGltf::Image& image : model.images)
         {
-            if (!image.cesium.pixelData.empty())
+            if (image.cesium.pixelData.empty() && (image.bufferView >= 0 || image.uri.has_value()))
             {
-                continue;
+                images.emplace_back(&image);
             }
+        }
 
-            if (!image.uri.has_value())
+        // every task decodes into its own image
+        CesiumInterface::Get()->GetScheduler().ParallelFor(
+            CesiumSchedulerLane::Compute,
+            images.size(),
+            [&parentPath, &gltfReader, &model, &io, &images](std::size_t i)
             {
-                continue;
-            }
+                CesiumGltf::Image& image = *images[i];
+                MappedIOContent fileContent;
+                gsl::span<const std::byte> content;
+                if (image.bufferView >= 0)
+                {
+                    content = GetBufferViewData(model, image.bufferView);
+                }
+                else
+                {
+                    IORequestParameter param;
+                    param.m_parentPath = parentPath;
+                    param.m_path = image.uri.value().c_str();
+                    fileContent = io.GetMappedFileContent(param);
+                    content = fileContent.GetData();
+                }
 
-            AZStd::string path = image.uri.value().c_str();
-            IORequestParameter param;
-            param.m_parentPath = parentPath;
-            param.m_path = std::move(path);
-            auto content = io.GetFileContent(param);
-            if (content.empty())
-            {
-                continue;
-            }
+                if (content.empty())
+                {
+                    return;
+                }
 
-            auto readResult = gltfReader.readImage(gsl::span<const std::byte>(content.data(), content.size()));
-            if (!readResult.image)
-            {
-                continue;
-            }
+                auto readResult = gltfReader.readImage(content);
+                if (!readResult.image)
+                {
+                    return;
+                }
 
-            image.cesium = std::move(*readResult.image);
-        }
+                image.cesium = std::move(*readResult.image);
+            });
     }
 
     void GltfModelBuilder::ResolveExternalBuffers(const AZStd::string& parentPath, CesiumGltf::Model& model, GenericIOManager& io)
@@ -229,17 +342,42 @@ namespace Cesium
             IORequestParameter param;
             param.m_parentPath = parentPath;
             param.m_path = std::move(path);
-            auto content = io.GetFileContent(param);
-            if (content.empty())
+            auto content = io.GetMappedFileContent(param);
+            if (content.IsEmpty())
             {
                 continue;
             }
 
-            buffer.cesium.data.resize(content.size());
-            std::memcpy(buffer.cesium.data.data(), content.data(), content.size());
+            gsl::span<const std::byte> data = content.GetData();
+            buffer.cesium.data.resize(data.size());
+            std::memcpy(buffer.cesium.data.data(), data.data(), data.size());
         }
     }
 
+    gsl::span<const std::byte> GltfModelBuilder::GetBufferViewData(const CesiumGltf::Model& model, std::int32_t bufferViewIndex)
+    {
+        const CesiumGltf::BufferView* bufferView = model.getSafe<CesiumGltf::BufferView>(&model.bufferViews, bufferViewIndex);
+        if (!bufferView || bufferView->byteOffset < 0 || bufferView->byteLength <= 0)
+        {
+            return {};
+        }
+
+        const CesiumGltf::Buffer* buffer = model.getSafe<CesiumGltf::Buffer>(&model.buffers, bufferView->buffer);
+        if (!buffer)
+        {
+            return {};
+        }
+
+        std::size_t byteOffset = static_cast<std::size_t>(bufferView->byteOffset);
+        std::size_t byteLength = static_cast<std::size_t>(bufferView->byteLength);
+        if (byteOffset + byteLength > buffer->cesium.data.size())
+        {
+            return {};
+        }
+
+        return gsl::span<const std::byte>(buffer->cesium.data.data() + byteOffset, byteLength);
+    }
+
     bool GltfModelBuilder::IsIdentityMatrix(const std::vector<double>& matrix)
     {
         static constexpr double identity[] = { 1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0 };
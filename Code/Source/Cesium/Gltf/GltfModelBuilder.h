@@ -3,6 +3,8 @@
 #include "Cesium/Gltf/GltfMaterialBuilder.h"
 #include <AzCore/std/string/string.h>
 #include <AzCore/std/smart_ptr/unique_ptr.h>
+#include <AzCore/std/containers/vector.h>
+#include <gsl/span>
 #include <glm/glm.hpp>
 #include <vector>
 #include <cstdint>
@@ -29,6 +31,10 @@ namespace Cesium
         GltfModelBuilderOption(const glm::dmat4& transform);
 
         glm::dmat4 m_transform;
+
+        // missing normals are generated smooth instead of flat. Tilesets opt into this, standalone glTFs keep the flat
+        // normals the glTF spec asks for
+        bool m_smoothMissingNormals;
     };
 
     class GltfModelBuilder
@@ -42,14 +48,31 @@ namespace Cesium
 
     private:
         void LoadScene(
-            const CesiumGltf::Model& model, const CesiumGltf::Scene& scene, const GltfModelBuilderOption& option, GltfLoadModel& result);
+            const CesiumGltf::Model& model,
+            const CesiumGltf::Scene& scene,
+            const GltfModelBuilderOption& option,
+            GltfLoadModel& result,
+            AZStd::vector<std::size_t>& meshIndices);
 
         void LoadNode(
-            const CesiumGltf::Model& model, const CesiumGltf::Node& node, const glm::dmat4& parentTransform, GltfLoadModel& loadModel);
+            const CesiumGltf::Model& model,
+            const CesiumGltf::Node& node,
+            const glm::dmat4& parentTransform,
+            GltfLoadModel& loadModel,
+            AZStd::vector<std::size_t>& meshIndices);
+
+        void LoadMesh(
+            std::size_t meshIndex, const glm::dmat4& transform, GltfLoadModel& loadModel, AZStd::vector<std::size_t>& meshIndices);
 
-        void LoadMesh(const CesiumGltf::Model& model, std::size_t meshIndex, const glm::dmat4& transform, GltfLoadModel& loadModel);
+        void CreateMaterials(const CesiumGltf::Model& model, const AZStd::vector<std::size_t>& meshIndices, GltfLoadModel& loadModel);
 
-        void ResolveExternalImages(
+        void CreatePrimitives(
+            const CesiumGltf::Model& model,
+            const AZStd::vector<std::size_t>& meshIndices,
+            bool smoothMissingNormals,
+            GltfLoadModel& loadModel);
+
+        void DecodeImages(
             const AZStd::string& parentPath,
             const CesiumGltfReader::GltfReader& gltfReader,
             CesiumGltf::Model& model,
@@ -57,6 +80,8 @@ namespace Cesium
 
         void ResolveExternalBuffers(const AZStd::string& parentPath, CesiumGltf::Model& model, GenericIOManager& io);
 
+        static gsl::span<const std::byte> GetBufferViewData(const CesiumGltf::Model& model, std::int32_t bufferViewIndex);
+
         static bool IsIdentityMatrix(const std::vector<double>& matrix);
 
         static constexpr glm::dmat4 GLTF_TO_O3DE =
@@ -1,11 +1,15 @@
 #include "Cesium/Gltf/GltfPBRMaterialBuilder.h"
 #include "Cesium/Systems/CesiumSystem.h"
 #include "Cesium/Systems/CriticalAssetManager.h"
+#include "Cesium/Systems/ContentAssetCache.h"
 #include <Atom/RPI.Reflect/Material/MaterialAssetCreator.h>
 #include <Atom/RPI.Reflect/Material/MaterialAsset.h>
+#include <Atom/RPI.Reflect/Material/MaterialPropertiesLayout.h>
+#include <Atom/RPI.Reflect/Material/MaterialPropertyValue.h>
 #include <Atom/RPI.Reflect/Image/StreamingImageAsset.h>
 #include <Atom/RPI.Reflect/Image/StreamingImageAssetCreator.h>
 #include <Atom/RPI.Reflect/Image/ImageMipChainAssetCreator.h>
+#include <AzCore/std/algorithm.h>
 
 // Window 10 wingdi.h header defines OPAQUE macro which mess up with CesiumGltf::Material::AlphaMode::OPAQUE.
 // This only happens with unity build
@@ -18,9 +22,132 @@
 
 #include <CesiumGltf/Model.h>
 #include <CesiumGltf/Material.h>
+#include <CesiumGltf/ImageCesium.h>
 
 namespace Cesium
 {
+    namespace
+    {
+        AZ::RHI::Format GetCompressedFormat(CesiumGltf::GpuCompressedPixelFormat format, bool srgb)
+        {
+            switch (format)
+            {
+            case CesiumGltf::GpuCompressedPixelFormat::BC1_RGB:
+                return srgb ? AZ::RHI::Format::BC1_UNORM_SRGB : AZ::RHI::Format::BC1_UNORM;
+            case CesiumGltf::GpuCompressedPixelFormat::BC3_RGBA:
+                return srgb ? AZ::RHI::Format::BC3_UNORM_SRGB : AZ::RHI::Format::BC3_UNORM;
+            case CesiumGltf::GpuCompressedPixelFormat::BC7_RGBA:
+                return srgb ? AZ::RHI::Format::BC7_UNORM_SRGB : AZ::RHI::Format::BC7_UNORM;
+            case CesiumGltf::GpuCompressedPixelFormat::BC4_R:
+                return srgb ? AZ::RHI::Format::Unknown : AZ::RHI::Format::BC4_UNORM;
+            case CesiumGltf::GpuCompressedPixelFormat::BC5_RG:
+                return srgb ? AZ::RHI::Format::Unknown : AZ::RHI::Format::BC5_UNORM;
+            default:
+                return AZ::RHI::Format::Unknown;
+            }
+        }
+
+        // images built from the same content are shared by the tiles of every tileset, and so is their GPU image
+        template<typename CreateFunction>
+        AZ::Data::Asset<AZ::RPI::StreamingImageAsset> FindOrCreateImage(ContentHasher& hasher, CreateFunction&& createImage)
+        {
+            ContentAssetCache<AZ::RPI::StreamingImageAsset>& imageAssetCache = CesiumInterface::Get()->GetImageAssetCache();
+            ContentKey key = hasher.Finish();
+            AZ::Data::Asset<AZ::RPI::StreamingImageAsset> imageAsset = imageAssetCache.Find(key);
+            if (!imageAsset)
+            {
+                imageAsset = createImage();
+                if (imageAsset)
+                {
+                    imageAsset = imageAssetCache.Store(key, imageAsset);
+                }
+            }
+
+            return imageAsset;
+        }
+
+        // returns false for values that have no stable content, like image instances
+        bool AddMaterialPropertyValue(ContentHasher& hasher, const AZ::RPI::MaterialPropertyValue& value)
+        {
+            if (!value.IsValid())
+            {
+                hasher.AddValue(0);
+            }
+            else if (value.Is<bool>())
+            {
+                hasher.AddValue(1);
+                hasher.AddValue(value.GetValue<bool>());
+            }
+            else if (value.Is<std::int32_t>())
+            {
+                hasher.AddValue(2);
+                hasher.AddValue(value.GetValue<std::int32_t>());
+            }
+            else if (value.Is<std::uint32_t>())
+            {
+                hasher.AddValue(3);
+                hasher.AddValue(value.GetValue<std::uint32_t>());
+            }
+            else if (value.Is<float>())
+            {
+                hasher.AddValue(4);
+                hasher.AddValue(value.GetValue<float>());
+            }
+            else if (value.Is<AZ::Vector2>())
+            {
+                const AZ::Vector2& vector = value.GetValue<AZ::Vector2>();
+                hasher.AddValue(5);
+                hasher.AddValue(vector.GetX());
+                hasher.AddValue(vector.GetY());
+            }
+            else if (value.Is<AZ::Vector3>())
+            {
+                const AZ::Vector3& vector = value.GetValue<AZ::Vector3>();
+                hasher.AddValue(6);
+                hasher.AddValue(vector.GetX());
+                hasher.AddValue(vector.GetY());
+                hasher.AddValue(vector.GetZ());
+            }
+            else if (value.Is<AZ::Vector4>())
+            {
+                const AZ::Vector4& vector = value.GetValue<AZ::Vector4>();
+                hasher.AddValue(7);
+                hasher.AddValue(vector.GetX());
+                hasher.AddValue(vector.GetY());
+                hasher.AddValue(vector.GetZ());
+                hasher.AddValue(vector.GetW());
+            }
+            else if (value.Is<AZ::Color>())
+            {
+                const AZ::Color& color = value.GetValue<AZ::Color>();
+                hasher.AddValue(8);
+                hasher.AddValue(color.GetR());
+                hasher.AddValue(color.GetG());
+                hasher.AddValue(color.GetB());
+                hasher.AddValue(color.GetA());
+            }
+            else if (value.Is<AZ::Data::Asset<AZ::RPI::ImageAsset>>())
+            {
+                // the images are deduplicated first, so the same content has the same asset id
+                hasher.AddValue(9);
+                hasher.AddAssetId(value.GetValue<AZ::Data::Asset<AZ::RPI::ImageAsset>>().GetId());
+            }
+            else if (value.Is<AZStd::string>())
+            {
+                const AZStd::string& string = value.GetValue<AZStd::string>();
+                hasher.AddValue(10);
+                hasher.AddValue(string.size());
+                hasher.Add(string.data(), string.size());
+            }
+            else
+            {
+                return false;
+            }
+
+            return true;
+        }
+    } // namespace
+
     const AZ::Data::Asset<AZ::RPI::MaterialTypeAsset>& GltfPBRMaterialBuilder::GetDefaultMaterialType() const
     {
         return CesiumInterface::Get()->GetCriticalAssetManager().m_standardPbrMaterialType;
@@ -31,6 +158,97 @@ namespace Cesium
         m_overrideMaterialTypeAsset = materialType;
     }
 
+    void GltfPBRMaterialBuilder::CreateTextures(
+        const CesiumGltf::Model& model,
+        const AZStd::vector<const CesiumGltf::Material*>& materials,
+        AZStd::unordered_map<TextureId, GltfLoadTexture>& textureCache)
+    {
+        // collect each image and usage once, keyed the same way as the texture cache
+        bool textureChannels = SamplesTextureChannels(GetMaterialType());
+        AZStd::unordered_map<TextureId, TextureRequest> uniqueRequests;
+        for (const CesiumGltf::Material* material : materials)
+        {
+            const std::optional<CesiumGltf::MaterialPBRMetallicRoughness>& pbrMetallicRoughness = material->pbrMetallicRoughness;
+            if (pbrMetallicRoughness)
+            {
+                if (pbrMetallicRoughness->baseColorTexture)
+                {
+                    AddTextureRequest(model, *pbrMetallicRoughness->baseColorTexture, TextureUsage::RGBA, textureCache, uniqueRequests);
+                }
+
+                // unlit materials ignore the metallic roughness texture
+                if (pbrMetallicRoughness->metallicRoughnessTexture && !material->getGenericExtension(MATERIALS_UNLIT_EXTENSION))
+                {
+                    AddTextureRequest(
+                        model, *pbrMetallicRoughness->metallicRoughnessTexture,
+                        textureChannels ? TextureUsage::PackedChannels : TextureUsage::MetallicRoughness, textureCache, uniqueRequests);
+                }
+            }
+
+            if (material->emissiveTexture)
+            {
+                AddTextureRequest(model, *material->emissiveTexture, TextureUsage::RGBA, textureCache, uniqueRequests);
+            }
+
+            if (material->occlusionTexture)
+            {
+                TextureUsage occlusionUsage =
+                    textureChannels ? GetOcclusionUsage(model, *material->occlusionTexture) : TextureUsage::Occlusion;
+                AddTextureRequest(model, *material->occlusionTexture, occlusionUsage, textureCache, uniqueRequests);
+            }
+        }
+
+        if (uniqueRequests.empty())
+        {
+            return;
+        }
+
+        // every task fills its own cache, so the tasks never touch a shared container
+        AZStd::vector<TextureRequest> requests;
+        requests.reserve(uniqueRequests.size());
+        for (const auto& uniqueRequest : uniqueRequests)
+        {
+            requests.emplace_back(uniqueRequest.second);
+        }
+
+        AZStd::vector<TextureCache> createdTextures(requests.size());
+        CesiumInterface::Get()->GetScheduler().ParallelFor(
+            CesiumSchedulerLane::Compute,
+            requests.size(),
+            [this, &model, &requests, &createdTextures](std::size_t i)
+            {
+                const TextureRequest& request = requests[i];
+                TextureCache& created = createdTextures[i];
+                switch (request.m_usage)
+                {
+                case TextureUsage::RGBA:
+                    GetOrCreateRGBAImage(model, *request.m_textureInfo, true, created);
+                    break;
+                case TextureUsage::PackedChannels:
+                    GetOrCreateRGBAImage(model, *request.m_textureInfo, false, created);
+                    break;
+                case TextureUsage::Occlusion:
+                    GetOrCreateOcclusionImage(model, *request.m_textureInfo, created);
+                    break;
+                case TextureUsage::MetallicRoughness:
+                    {
+                        AZ::Data::Asset<AZ::RPI::StreamingImageAsset> metallic;
+                        AZ::Data::Asset<AZ::RPI::StreamingImageAsset> roughness;
+                        GetOrCreateMetallicRoughnessImage(model, *request.m_textureInfo, metallic, roughness, created);
+                        break;
+                    }
+                }
+            });
+
+        for (TextureCache& created : createdTextures)
+        {
+            for (auto& texture : created)
+            {
+                textureCache.insert({ texture.first, std::move(texture.second) });
+            }
+        }
+    }
+
     void GltfPBRMaterialBuilder::Create(
         const CesiumGltf::Model& model,
         const CesiumGltf::Material& material,
@@ -38,15 +256,7 @@ namespace Cesium
         GltfLoadMaterial& result)
     {
         // Create material asset
-        AZ::Data::Asset<AZ::RPI::MaterialTypeAsset> materialTypeAsset;
-        if (m_overrideMaterialTypeAsset)
-        {
-            materialTypeAsset = m_overrideMaterialTypeAsset;
-        }
-        else
-        {
-            materialTypeAsset = GetDefaultMaterialType();
-        }
+        const AZ::Data::Asset<AZ::RPI::MaterialTypeAsset>& materialTypeAsset = GetMaterialType();
 
         // Validate material type asset
         if (!materialTypeAsset || !materialTypeAsset.IsReady())
@@ -59,22 +269,126 @@ namespace Cesium
         AZ::RPI::MaterialAssetCreator materialCreator;
         materialCreator.Begin(materialAssetId, materialTypeAsset);
 
-        ConfigurePbrMetallicRoughness(model, material, textureCache, materialCreator);
-        ConfigureOcclusion(model, material, textureCache, materialCreator);
+        bool textureChannels = SamplesTextureChannels(materialTypeAsset);
+        ConfigurePbrMetallicRoughness(model, material, textureChannels, textureCache, materialCreator);
+        ConfigureOcclusion(model, material, textureChannels, textureCache, materialCreator);
         ConfigureEmissive(model, material, textureCache, materialCreator);
         ConfigureOpacity(material, materialCreator);
 
+        bool compactVertexLayout = m_compactVertexLayout &&
+            materialTypeAsset->GetMaterialPropertiesLayout()->FindPropertyIndex(AZ::Name(COMPACT_VERTEX_LAYOUT_PROPERTY)).IsValid();
+        if (compactVertexLayout)
+        {
+            materialCreator.SetPropertyValue(AZ::Name(COMPACT_VERTEX_LAYOUT_PROPERTY), true);
+        }
+
         AZ::Data::Asset<AZ::RPI::MaterialAsset> standardPBRMaterialAsset;
         materialCreator.End(standardPBRMaterialAsset);
 
+        // tiles with the same material properties share the asset, so Material::FindOrCreate gives them one instance too
+        if (standardPBRMaterialAsset)
+        {
+            ContentHasher hasher;
+            hasher.AddAssetId(materialTypeAsset.GetId());
+            bool hashable = true;
+            for (const AZ::RPI::MaterialPropertyValue& value : standardPBRMaterialAsset->GetPropertyValues())
+            {
+                hashable = hashable && AddMaterialPropertyValue(hasher, value);
+            }
+
+            if (hashable)
+            {
+                standardPBRMaterialAsset =
+                    CesiumInterface::Get()->GetMaterialAssetCache().Store(hasher.Finish(), standardPBRMaterialAsset);
+            }
+        }
+
         // populate result
         result.m_materialAsset = std::move(standardPBRMaterialAsset);
         result.m_needTangents = false; // We don't load normal texture, so no need for tangents vertices for now
+        result.m_compactVertexLayout = compactVertexLayout;
+    }
+
+    void GltfPBRMaterialBuilder::SetCompactVertexLayout(bool compactVertexLayout)
+    {
+        m_compactVertexLayout = compactVertexLayout;
+    }
+
+    void GltfPBRMaterialBuilder::SetTextureCompression(GltfTextureCompression textureCompression)
+    {
+        m_textureCompression = textureCompression;
+    }
+
+    const AZ::Data::Asset<AZ::RPI::MaterialTypeAsset>& GltfPBRMaterialBuilder::GetMaterialType() const
+    {
+        if (m_overrideMaterialTypeAsset)
+        {
+            return m_overrideMaterialTypeAsset;
+        }
+
+        return GetDefaultMaterialType();
+    }
+
+    bool GltfPBRMaterialBuilder::SamplesTextureChannels(const AZ::Data::Asset<AZ::RPI::MaterialTypeAsset>& materialType)
+    {
+        return materialType && materialType.IsReady() &&
+            materialType->GetMaterialPropertiesLayout()->FindPropertyIndex(AZ::Name(METALLIC_TEXTURE_CHANNEL_PROPERTY)).IsValid();
+    }
+
+    GltfPBRMaterialBuilder::TextureUsage GltfPBRMaterialBuilder::GetOcclusionUsage(
+        const CesiumGltf::Model& model, const CesiumGltf::TextureInfo& textureInfo)
+    {
+        // images with fewer than 3 channels keep their single channel upload, compressed ones can only be sampled packed
+        const CesiumGltf::Texture* texture = model.getSafe<CesiumGltf::Texture>(&model.textures, textureInfo.index);
+        const CesiumGltf::Image* image = texture ? model.getSafe<CesiumGltf::Image>(&model.images, texture->source) : nullptr;
+        if (image && image->cesium.compressedPixelFormat == CesiumGltf::GpuCompressedPixelFormat::NONE && image->cesium.channels < 3)
+        {
+            return TextureUsage::Occlusion;
+        }
+
+        return TextureUsage::PackedChannels;
+    }
+
+    void GltfPBRMaterialBuilder::AddTextureRequest(
+        const CesiumGltf::Model& model,
+        const CesiumGltf::TextureInfo& textureInfo,
+        TextureUsage usage,
+        const TextureCache& textureCache,
+        AZStd::unordered_map<TextureId, TextureRequest>& requests)
+    {
+        const CesiumGltf::Texture* texture = model.getSafe<CesiumGltf::Texture>(&model.textures, textureInfo.index);
+        if (!texture)
+        {
+            return;
+        }
+
+        TextureId textureId;
+        switch (usage)
+        {
+        case TextureUsage::RGBA:
+            textureId = AZStd::string::format("RGBA_%d", texture->source);
+            break;
+        case TextureUsage::Occlusion:
+            textureId = AZStd::string::format("Occlusion_%d", texture->source);
+            break;
+        case TextureUsage::MetallicRoughness:
+            textureId = AZStd::string::format("Metallic_%d", texture->source);
+            break;
+        case TextureUsage::PackedChannels:
+            textureId = AZStd::string::format("Packed_%d", texture->source);
+            break;
+        }
+
+        if (textureCache.find(textureId) == textureCache.end())
+        {
+            requests.insert({ std::move(textureId), TextureRequest{ usage, &textureInfo } });
+        }
     }
 
     void GltfPBRMaterialBuilder::ConfigurePbrMetallicRoughness(
         const CesiumGltf::Model& model,
         const CesiumGltf::Material& material,
+        bool textureChannels,
         TextureCache& textureCache,
         AZ::RPI::MaterialAssetCreator& materialCreator)
     {
@@ -106,7 +420,7 @@ namespace Cesium
         std::int64_t baseColorTexCoord = -1;
         if (baseColorTexture)
         {
-            baseColorImage = GetOrCreateRGBAImage(model, *baseColorTexture, textureCache);
+            baseColorImage = GetOrCreateRGBAImage(model, *baseColorTexture, true, textureCache);
             baseColorTexCoord = baseColorTexture->texCoord;
         }
 
@@ -132,7 +446,14 @@ namespace Cesium
         AZ::Data::Asset<AZ::RPI::StreamingImageAsset> metallicImage;
         AZ::Data::Asset<AZ::RPI::StreamingImageAsset> roughnessImage;
         std::int64_t metallicRoughnessTexCoord = -1;
-        if (metallicRoughnessTexture)
+        if (metallicRoughnessTexture && textureChannels)
+        {
+            // glTF stores roughness in green and metallic in blue, so both sample the same image
+            metallicImage = GetOrCreateRGBAImage(model, *metallicRoughnessTexture, false, textureCache);
+            roughnessImage = metallicImage;
+            metallicRoughnessTexCoord = metallicRoughnessTexture->texCoord;
+        }
+        else if (metallicRoughnessTexture)
         {
             GetOrCreateMetallicRoughnessImage(model, *metallicRoughnessTexture, metallicImage, roughnessImage, textureCache);
             metallicRoughnessTexCoord = metallicRoughnessTexture->texCoord;
@@ -143,6 +464,10 @@ namespace Cesium
             materialCreator.SetPropertyValue(AZ::Name("metallic.useTexture"), true);
             materialCreator.SetPropertyValue(AZ::Name("metallic.textureMapUv"), static_cast<std::uint32_t>(metallicRoughnessTexCoord));
             materialCreator.SetPropertyValue(AZ::Name("metallic.textureMap"), metallicImage);
+            if (textureChannels)
+            {
+                materialCreator.SetPropertyValue(AZ::Name(METALLIC_TEXTURE_CHANNEL_PROPERTY), BLUE_CHANNEL);
+            }
         }
         else
         {
@@ -154,6 +479,10 @@ namespace Cesium
             materialCreator.SetPropertyValue(AZ::Name("roughness.useTexture"), true);
             materialCreator.SetPropertyValue(AZ::Name("roughness.textureMapUv"), static_cast<std::uint32_t>(metallicRoughnessTexCoord));
             materialCreator.SetPropertyValue(AZ::Name("roughness.textureMap"), roughnessImage);
+            if (textureChannels)
+            {
+                materialCreator.SetPropertyValue(AZ::Name("roughness.textureChannel"), GREEN_CHANNEL);
+            }
         }
         else
         {
@@ -190,7 +519,7 @@ namespace Cesium
         const std::optional<CesiumGltf::TextureInfo>& emissiveTexture = material.emissiveTexture;
         if (emissiveTexture)
         {
-            auto emissiveImage = GetOrCreateRGBAImage(model, *emissiveTexture, textureCache);
+            auto emissiveImage = GetOrCreateRGBAImage(model, *emissiveTexture, true, textureCache);
             std::int64_t emissiveTexCoord = emissiveTexture->texCoord;
             if (emissiveImage && emissiveTexCoord >= 0 && emissiveTexCoord < 2)
             {
@@ -214,13 +543,24 @@ namespace Cesium
     void GltfPBRMaterialBuilder::ConfigureOcclusion(
         const CesiumGltf::Model& model,
         const CesiumGltf::Material& material,
+        bool textureChannels,
         TextureCache& textureCache,
         AZ::RPI::MaterialAssetCreator& materialCreator)
     {
         const std::optional<CesiumGltf::MaterialOcclusionTextureInfo> occlusionTexture = material.occlusionTexture;
         if (occlusionTexture)
         {
-            auto occlusionImage = GetOrCreateOcclusionImage(model, *occlusionTexture, textureCache);
+            // occlusion is read from red. Packed images are the same asset as a metallic roughness image stored in it
+            AZ::Data::Asset<AZ::RPI::StreamingImageAsset> occlusionImage;
+            if (textureChannels && GetOcclusionUsage(model, *occlusionTexture) == TextureUsage::PackedChannels)
+            {
+                occlusionImage = GetOrCreateRGBAImage(model, *occlusionTexture, false, textureCache);
+            }
+            else
+            {
+                occlusionImage = GetOrCreateOcclusionImage(model, *occlusionTexture, textureCache);
+            }
+
             std::int64_t occlusionTexCoord = occlusionTexture->texCoord;
             if (occlusionImage && occlusionTexCoord >= 0 && occlusionTexCoord < 2)
             {
@@ -228,6 +568,10 @@ namespace Cesium
                 materialCreator.SetPropertyValue(AZ::Name("occlusion.diffuseTextureMapUv"), static_cast<std::uint32_t>(occlusionTexCoord));
                 materialCreator.SetPropertyValue(AZ::Name("occlusion.diffuseFactor"), static_cast<float>(occlusionTexture->strength));
                 materialCreator.SetPropertyValue(AZ::Name("occlusion.diffuseTextureMap"), occlusionImage);
+                if (textureChannels)
+                {
+                    materialCreator.SetPropertyValue(AZ::Name("occlusion.diffuseTextureChannel"), RED_CHANNEL);
+                }
             }
         }
     }
@@ -287,6 +631,20 @@ namespace Cesium
         const CesiumGltf::ImageCesium& imageData = image->cesium;
         std::uint32_t width = static_cast<std::uint32_t>(imageData.width);
         std::uint32_t height = static_cast<std::uint32_t>(imageData.height);
+
+        // occlusion is read from the red channel, which every block compressed format has, so compressed images are kept as they are
+        if (imageData.compressedPixelFormat != CesiumGltf::GpuCompressedPixelFormat::NONE)
+        {
+            newImage = CreateCompressedImage(imageData, false);
+            if (!newImage)
+            {
+                return {};
+            }
+
+            auto cache = textureCache.insert({ imageSourceIdx, std::move(newImage) });
+            return cache.first->second.m_imageAsset;
+        }
+
         if (imageData.bytesPerChannel != 1 || imageData.channels < 1)
         {
             return {};
@@ -300,7 +658,7 @@ namespace Cesium
         // Do the fast path. Copy the whole data over
         if (imageData.channels == 1)
         {
-            newImage = Create2DImage(imageData.pixelData.data(), imageData.pixelData.size(), width, height, AZ::RHI::Format::R8_UNORM);
+            newImage = CreateSingleChannelImage(imageData.pixelData.data(), width, height);
         }
         else
         {
@@ -313,7 +671,7 @@ namespace Cesium
                 ++j;
             }
 
-            newImage = Create2DImage(pixels.data(), pixels.size(), width, height, AZ::RHI::Format::R8_UNORM);
+            newImage = CreateSingleChannelImage(pixels.data(), width, height);
         }
 
         auto cache = textureCache.insert({ imageSourceIdx, std::move(newImage) });
@@ -321,7 +679,7 @@ namespace Cesium
     }
 
     AZ::Data::Asset<AZ::RPI::StreamingImageAsset> GltfPBRMaterialBuilder::GetOrCreateRGBAImage(
-        const CesiumGltf::Model& model, const CesiumGltf::TextureInfo& textureInfo, TextureCache& textureCache)
+        const CesiumGltf::Model& model, const CesiumGltf::TextureInfo& textureInfo, bool srgb, TextureCache& textureCache)
     {
         const CesiumGltf::Texture* texture = model.getSafe<CesiumGltf::Texture>(&model.textures, textureInfo.index);
         if (!texture)
@@ -341,7 +699,7 @@ namespace Cesium
         }
 
         // Lookup cache
-        TextureId imageSourceIdx = AZStd::string::format("RGBA_%d", texture->source);
+        TextureId imageSourceIdx = AZStd::string::format(srgb ? "RGBA_%d" : "Packed_%d", texture->source);
         auto cachedAsset = textureCache.find(imageSourceIdx);
         if (cachedAsset != textureCache.end())
         {
@@ -353,6 +711,18 @@ namespace Cesium
         const CesiumGltf::ImageCesium& imageData = image->cesium;
         std::uint32_t width = static_cast<std::uint32_t>(imageData.width);
         std::uint32_t height = static_cast<std::uint32_t>(imageData.height);
+        if (imageData.compressedPixelFormat != CesiumGltf::GpuCompressedPixelFormat::NONE)
+        {
+            newImage = CreateCompressedImage(imageData, srgb);
+            if (!newImage)
+            {
+                return {};
+            }
+
+            auto cache = textureCache.insert({ imageSourceIdx, std::move(newImage) });
+            return cache.first->second.m_imageAsset;
+        }
+
         if (imageData.bytesPerChannel != 1 || imageData.channels < 3 || imageData.channels > 4)
         {
             return {};
@@ -365,21 +735,22 @@ namespace Cesium
 
         if (imageData.channels == 3)
         {
+            std::size_t j = 0;
             AZStd::vector<std::byte> pixels(width * height * 4);
             for (std::size_t i = 0; i < imageData.pixelData.size(); i += 3)
             {
-                pixels[i] = imageData.pixelData[i];
-                pixels[i + 1] = imageData.pixelData[i + 1];
-                pixels[i + 2] = imageData.pixelData[i + 2];
-                pixels[i + 3] = static_cast<std::byte>(255);
+                pixels[j] = imageData.pixelData[i];
+                pixels[j + 1] = imageData.pixelData[i + 1];
+                pixels[j + 2] = imageData.pixelData[i + 2];
+                pixels[j + 3] = static_cast<std::byte>(255);
+                j += 4;
             }
 
-            newImage = Create2DImage(pixels.data(), pixels.size(), width, height, AZ::RHI::Format::R8G8B8A8_UNORM_SRGB);
+            newImage = CreateRGBAImage(pixels.data(), width, height, srgb);
         }
         else
         {
-            newImage =
-                Create2DImage(imageData.pixelData.data(), imageData.pixelData.size(), width, height, AZ::RHI::Format::R8G8B8A8_UNORM_SRGB);
+            newImage = CreateRGBAImage(imageData.pixelData.data(), width, height, srgb);
         }
 
         auto cache = textureCache.insert({ imageSourceIdx, std::move(newImage) });
@@ -425,10 +796,16 @@ namespace Cesium
             return;
         }
 
-        // Create new assets if caches are not found
+        // Create new assets if caches are not found. The channels of block compressed images cannot be split without
+        // decoding them, so those are skipped
         const CesiumGltf::ImageCesium& imageData = image->cesium;
         std::uint32_t width = static_cast<std::uint32_t>(imageData.width);
         std::uint32_t height = static_cast<std::uint32_t>(imageData.height);
+        if (imageData.compressedPixelFormat != CesiumGltf::GpuCompressedPixelFormat::NONE)
+        {
+            return;
+        }
+
         if (imageData.bytesPerChannel != 1 || imageData.channels < 3 || imageData.channels > 4)
         {
             return;
@@ -449,47 +826,174 @@ namespace Cesium
             ++j;
         }
 
-        auto metallicCache = textureCache.insert(
-            { metallicImageIdx, Create2DImage(metallicPixels.data(), metallicPixels.size(), width, height, AZ::RHI::Format::R8_UNORM) });
-        auto roughnessCache = textureCache.insert(
-            { roughnessImageIdx, Create2DImage(roughnessPixels.data(), roughnessPixels.size(), width, height, AZ::RHI::Format::R8_UNORM) });
+        auto metallicCache = textureCache.insert({ metallicImageIdx, CreateSingleChannelImage(metallicPixels.data(), width, height) });
+        auto roughnessCache = textureCache.insert({ roughnessImageIdx, CreateSingleChannelImage(roughnessPixels.data(), width, height) });
         metallic = metallicCache.first->second.m_imageAsset;
         roughness = roughnessCache.first->second.m_imageAsset;
     }
 
     AZ::Data::Asset<AZ::RPI::StreamingImageAsset> GltfPBRMaterialBuilder::Create2DImage(
-        const std::byte* pixelData, std::size_t bytesPerImage, std::uint32_t width, std::uint32_t height, AZ::RHI::Format format)
+        const std::byte* pixelData, const AZStd::vector<GltfImageMip>& mips, AZ::RHI::Format format)
     {
-        // image has 4 channels, so we just copy the data over
         AZ::RHI::ImageDescriptor imageDesc;
         imageDesc.m_bindFlags = AZ::RHI::ImageBindFlags::ShaderRead;
         imageDesc.m_dimension = AZ::RHI::ImageDimension::Image2D;
-        imageDesc.m_size = AZ::RHI::Size(width, height, 1);
+        imageDesc.m_size = AZ::RHI::Size(mips.front().m_width, mips.front().m_height, 1);
+        imageDesc.m_mipLevels = static_cast<std::uint16_t>(mips.size());
         imageDesc.m_format = format;
 
-        AZ::RHI::DeviceImageSubresourceLayout deviceImageSubresourceLayout = AZ::RHI::GetImageSubresourceLayout(imageDesc, AZ::RHI::ImageSubresource{});
-
-        // Create mip chain
-        AZ::Data::AssetId imageMipChainAssetId = CesiumInterface::Get()->GetCriticalAssetManager().GenerateRandomAssetId();
-        AZ::RPI::ImageMipChainAssetCreator mipChainCreator;
-        mipChainCreator.Begin(imageMipChainAssetId, 1, 1);
-        mipChainCreator.BeginMip(deviceImageSubresourceLayout);
-        mipChainCreator.AddSubImage(pixelData, bytesPerImage);
-        mipChainCreator.EndMip();
-        AZ::Data::Asset<AZ::RPI::ImageMipChainAsset> mipChainAsset;
-        mipChainCreator.End(mipChainAsset);
-
-        // Create streaming image
         AZ::Data::AssetId imageAssetId = CesiumInterface::Get()->GetCriticalAssetManager().GenerateRandomAssetId();
         AZ::RPI::StreamingImageAssetCreator imageCreator;
         imageCreator.Begin(imageAssetId);
         imageCreator.SetImageDescriptor(imageDesc);
-        imageCreator.AddMipChainAsset(*mipChainAsset);
+
+        // Create mip chains from the top mip down
+        std::size_t firstMip = 0;
+        while (firstMip < mips.size())
+        {
+            std::size_t endMip = firstMip + 1;
+            if (AZStd::max(mips[firstMip].m_width, mips[firstMip].m_height) <= MIP_CHAIN_TAIL_DIMENSION)
+            {
+                endMip = mips.size();
+            }
+
+            AZ::Data::AssetId imageMipChainAssetId = CesiumInterface::Get()->GetCriticalAssetManager().GenerateRandomAssetId();
+            AZ::RPI::ImageMipChainAssetCreator mipChainCreator;
+            mipChainCreator.Begin(imageMipChainAssetId, static_cast<std::uint16_t>(endMip - firstMip), 1);
+            for (std::size_t mip = firstMip; mip < endMip; ++mip)
+            {
+                AZ::RHI::DeviceImageSubresourceLayout deviceImageSubresourceLayout =
+                    AZ::RHI::GetImageSubresourceLayout(imageDesc, AZ::RHI::ImageSubresource{ static_cast<std::uint16_t>(mip), 0 });
+                mipChainCreator.BeginMip(deviceImageSubresourceLayout);
+                mipChainCreator.AddSubImage(pixelData + mips[mip].m_byteOffset, mips[mip].m_byteSize);
+                mipChainCreator.EndMip();
+            }
+
+            AZ::Data::Asset<AZ::RPI::ImageMipChainAsset> mipChainAsset;
+            mipChainCreator.End(mipChainAsset);
+            imageCreator.AddMipChainAsset(*mipChainAsset);
+            firstMip = endMip;
+        }
+
+        // Create streaming image
         AZ::Data::Asset<AZ::RPI::StreamingImageAsset> imageAsset;
         imageCreator.End(imageAsset);
 
         return imageAsset;
     }
+
+    AZ::Data::Asset<AZ::RPI::StreamingImageAsset> GltfPBRMaterialBuilder::CreateRGBAImage(
+        const std::byte* pixelData, std::uint32_t width, std::uint32_t height, bool srgb)
+    {
+        std::size_t byteSize = static_cast<std::size_t>(width) * height * 4;
+        ContentHasher hasher;
+        hasher.AddValue(srgb ? TextureUsage::RGBA : TextureUsage::PackedChannels);
+        hasher.AddValue(width);
+        hasher.AddValue(height);
+        hasher.AddValue(m_textureCompression);
+        hasher.Add(pixelData, byteSize);
+        return FindOrCreateImage(
+            hasher,
+            [&]()
+            {
+                AZStd::vector<std::byte> pixels(pixelData, pixelData + byteSize);
+                AZStd::vector<GltfImageMip> mips = GltfMipGenerator::GenerateMips(pixels, width, height, 4, srgb);
+
+                AZStd::vector<std::byte> compressed;
+                AZStd::vector<GltfImageMip> compressedMips;
+                AZ::RHI::Format compressedFormat = AZ::RHI::Format::Unknown;
+                if (GltfTextureCompressor::CompressRGBA(
+                        pixels.data(), mips, m_textureCompression, srgb, compressed, compressedMips, compressedFormat))
+                {
+                    return Create2DImage(compressed.data(), compressedMips, compressedFormat);
+                }
+
+                return Create2DImage(
+                    pixels.data(), mips, srgb ? AZ::RHI::Format::R8G8B8A8_UNORM_SRGB : AZ::RHI::Format::R8G8B8A8_UNORM);
+            });
+    }
+
+    AZ::Data::Asset<AZ::RPI::StreamingImageAsset> GltfPBRMaterialBuilder::CreateSingleChannelImage(
+        const std::byte* pixelData, std::uint32_t width, std::uint32_t height)
+    {
+        std::size_t byteSize = static_cast<std::size_t>(width) * height;
+        ContentHasher hasher;
+        hasher.AddValue(TextureUsage::Occlusion);
+        hasher.AddValue(width);
+        hasher.AddValue(height);
+        hasher.AddValue(m_textureCompression);
+        hasher.Add(pixelData, byteSize);
+        return FindOrCreateImage(
+            hasher,
+            [&]()
+            {
+                AZStd::vector<std::byte> pixels(pixelData, pixelData + byteSize);
+                AZStd::vector<GltfImageMip> mips = GltfMipGenerator::GenerateMips(pixels, width, height, 1, false);
+
+                AZStd::vector<std::byte> compressed;
+                AZStd::vector<GltfImageMip> compressedMips;
+                AZ::RHI::Format compressedFormat = AZ::RHI::Format::Unknown;
+                if (GltfTextureCompressor::CompressR(
+                        pixels.data(), mips, m_textureCompression, compressed, compressedMips, compressedFormat))
+                {
+                    return Create2DImage(compressed.data(), compressedMips, compressedFormat);
+                }
+
+                return Create2DImage(pixels.data(), mips, AZ::RHI::Format::R8_UNORM);
+            });
+    }
+
+    AZ::Data::Asset<AZ::RPI::StreamingImageAsset> GltfPBRMaterialBuilder::CreateCompressedImage(
+        const CesiumGltf::ImageCesium& imageData, bool srgb)
+    {
+        AZ::RHI::Format format = GetCompressedFormat(imageData.compressedPixelFormat, srgb);
+        if (format == AZ::RHI::Format::Unknown)
+        {
+            return {};
+        }
+
+        // images without mip positions only hold the top mip
+        std::uint32_t width = static_cast<std::uint32_t>(imageData.width);
+        std::uint32_t height = static_cast<std::uint32_t>(imageData.height);
+        AZStd::vector<GltfImageMip> mips;
+        if (imageData.mipPositions.empty())
+        {
+            mips.push_back(GltfImageMip{ 0, imageData.pixelData.size(), width, height });
+        }
+        else
+        {
+            mips.reserve(imageData.mipPositions.size());
+            for (std::size_t mip = 0; mip < imageData.mipPositions.size(); ++mip)
+            {
+                const CesiumGltf::ImageCesiumMipPosition& position = imageData.mipPositions[mip];
+                mips.push_back(GltfImageMip{ position.byteOffset, position.byteSize, AZStd::max(width >> mip, 1u),
+                                             AZStd::max(height >> mip, 1u) });
+            }
+        }
+
+        for (const GltfImageMip& mip : mips)
+        {
+            if (mip.m_byteOffset + mip.m_byteSize > imageData.pixelData.size())
+            {
+                return {};
+            }
+        }
+
+        ContentHasher hasher;
+        hasher.AddValue(format);
+        for (const GltfImageMip& mip : mips)
+        {
+            hasher.AddValue(mip);
+        }
+
+        hasher.Add(imageData.pixelData.data(), imageData.pixelData.size());
+        return FindOrCreateImage(
+            hasher,
+            [&]()
+            {
+                return Create2DImage(imageData.pixelData.data(), mips, format);
+            });
+    }
 } // namespace Cesium
 
 // Window 10 wingdi.h header defines OPAQUE macro which mess up with CesiumGltf::Material::AlphaMode::OPAQUE.
@@ -2,6 +2,7 @@
 
 #include "Cesium/Gltf/GltfMaterialBuilder.h"
 #include "Cesium/Gltf/GltfLoadContext.h"
+#include "Cesium/Gltf/GltfTextureCompressor.h"
 #include <Atom/RPI.Reflect/Material/MaterialTypeAsset.h>
 #include <AzCore/Asset/AssetCommon.h>
 #include <AzCore/std/containers/unordered_map.h>
@@ -11,6 +12,7 @@ namespace CesiumGltf
     struct Model;
     struct Material;
     struct TextureInfo;
+    struct ImageCesium;
 } // namespace CesiumGltf
 
 namespace AZ
@@ -34,16 +36,68 @@ namespace Cesium
 
         void OverrideMaterialType(const AZ::Data::Asset<AZ::RPI::MaterialTypeAsset>& materialType) override;
 
+        // decodes the textures of the materials on the compute lane, one task per image and usage. Material types that
+        // select the channel of their metallic, roughness and occlusion textures sample the glTF images as they are,
+        // otherwise the channels are split into an image each
+        void CreateTextures(
+            const CesiumGltf::Model& model,
+            const AZStd::vector<const CesiumGltf::Material*>& materials,
+            AZStd::unordered_map<TextureId, GltfLoadTexture>& textureCache) override;
+
         void Create(
             const CesiumGltf::Model& model,
             const CesiumGltf::Material& material,
             AZStd::unordered_map<TextureId, GltfLoadTexture>& textureCache,
             GltfLoadMaterial& result) override;
 
+        // builds materials that decode the compact vertex layout, when their material type has the compactVertexLayout property
+        void SetCompactVertexLayout(bool compactVertexLayout);
+
+        // block compresses decoded textures. Textures that arrive GPU compressed, like transcoded KTX2, are always kept
+        // compressed
+        void SetTextureCompression(GltfTextureCompression textureCompression);
+
+        // creates a streaming image from mips laid out in pixelData. Mips larger than MIP_CHAIN_TAIL_DIMENSION get a mip
+        // chain each, so the streaming image pool can evict them under memory pressure, the rest share the tail chain
+        static AZ::Data::Asset<AZ::RPI::StreamingImageAsset> Create2DImage(
+            const std::byte* pixelData, const AZStd::vector<GltfImageMip>& mips, AZ::RHI::Format format);
+
+        static constexpr std::uint32_t MIP_CHAIN_TAIL_DIMENSION = 64;
+
     private:
+        enum class TextureUsage
+        {
+            RGBA,
+            Occlusion,
+            MetallicRoughness,
+
+            // linear RGBA sampled one channel at a time, like the glTF metallic roughness and occlusion images
+            PackedChannels
+        };
+
+        struct TextureRequest
+        {
+            TextureUsage m_usage;
+            const CesiumGltf::TextureInfo* m_textureInfo;
+        };
+
+        const AZ::Data::Asset<AZ::RPI::MaterialTypeAsset>& GetMaterialType() const;
+
+        static bool SamplesTextureChannels(const AZ::Data::Asset<AZ::RPI::MaterialTypeAsset>& materialType);
+
+        static TextureUsage GetOcclusionUsage(const CesiumGltf::Model& model, const CesiumGltf::TextureInfo& textureInfo);
+
+        void AddTextureRequest(
+            const CesiumGltf::Model& model,
+            const CesiumGltf::TextureInfo& textureInfo,
+            TextureUsage usage,
+            const TextureCache& textureCache,
+            AZStd::unordered_map<TextureId, TextureRequest>& requests);
+
         void ConfigurePbrMetallicRoughness(
             const CesiumGltf::Model& model,
             const CesiumGltf::Material& material,
+            bool textureChannels,
             TextureCache& textureCache,
             AZ::RPI::MaterialAssetCreator& materialCreator);
 
@@ -56,6 +110,7 @@ namespace Cesium
         void ConfigureOcclusion(
             const CesiumGltf::Model& model,
             const CesiumGltf::Material& material,
+            bool textureChannels,
             TextureCache& textureCache,
             AZ::RPI::MaterialAssetCreator& materialCreator);
 
@@ -64,8 +119,9 @@ namespace Cesium
         AZ::Data::Asset<AZ::RPI::StreamingImageAsset> GetOrCreateOcclusionImage(
             const CesiumGltf::Model& model, const CesiumGltf::TextureInfo& textureInfo, TextureCache& textureCache);
 
+        // sRGB images hold colors, the others hold packed channels that are sampled as they are stored
         AZ::Data::Asset<AZ::RPI::StreamingImageAsset> GetOrCreateRGBAImage(
-            const CesiumGltf::Model& model, const CesiumGltf::TextureInfo& textureInfo, TextureCache& textureCache);
+            const CesiumGltf::Model& model, const CesiumGltf::TextureInfo& textureInfo, bool srgb, TextureCache& textureCache);
 
         void GetOrCreateMetallicRoughnessImage(
             const CesiumGltf::Model& model,
@@ -74,10 +130,27 @@ namespace Cesium
             AZ::Data::Asset<AZ::RPI::StreamingImageAsset>& roughness,
             TextureCache& textureCache);
 
-        AZ::Data::Asset<AZ::RPI::StreamingImageAsset> Create2DImage(
-            const std::byte* pixelData, std::size_t bytesPerImage, std::uint32_t width, std::uint32_t height, AZ::RHI::Format format);
+        // the RGBA and single channel images get a full mip chain, generated before they are compressed
+        AZ::Data::Asset<AZ::RPI::StreamingImageAsset> CreateRGBAImage(
+            const std::byte* pixelData, std::uint32_t width, std::uint32_t height, bool srgb);
+
+        AZ::Data::Asset<AZ::RPI::StreamingImageAsset> CreateSingleChannelImage(
+            const std::byte* pixelData, std::uint32_t width, std::uint32_t height);
+
+        AZ::Data::Asset<AZ::RPI::StreamingImageAsset> CreateCompressedImage(const CesiumGltf::ImageCesium& imageData, bool srgb);
 
         AZ::Data::Asset<AZ::RPI::MaterialTypeAsset> m_overrideMaterialTypeAsset;
+        bool m_compactVertexLayout{ false };
+        GltfTextureCompression m_textureCompression{ GltfTextureCompression::None };
+
+        static constexpr const char* const COMPACT_VERTEX_LAYOUT_PROPERTY = "general.compactVertexLayout";
+
+        static constexpr const char* const METALLIC_TEXTURE_CHANNEL_PROPERTY = "metallic.textureChannel";
+
+        // values of the textureChannel enums of the material type
+        static constexpr std::uint32_t RED_CHANNEL = 0;
+        static constexpr std::uint32_t GREEN_CHANNEL = 1;
+        static constexpr std::uint32_t BLUE_CHANNEL = 2;
 
         static constexpr const char* const MATERIALS_UNLIT_EXTENSION = "KHR_materials_unlit";
     };
@@ -1,7 +1,10 @@
 #include "Cesium/Gltf/GltfPrimitiveBuilder.h"
 #include "Cesium/Gltf/BitangentAndTangentGenerator.h"
+#include "Cesium/Gltf/NormalGenerator.h"
+#include "Cesium/Gltf/GltfVertexQuantizer.h"
 #include "Cesium/Systems/CesiumSystem.h"
 #include "Cesium/Systems/CriticalAssetManager.h"
+#include "Cesium/Systems/CesiumProfiler.h"
 #include "Cesium/Math/MathHelper.h"
 #include <Atom/RPI.Reflect/Model/ModelAsset.h>
 #include <Atom/RPI.Reflect/Buffer/BufferAsset.h>
@@ -10,7 +13,9 @@
 #include <Atom/RPI.Reflect/Model/ModelLodAssetCreator.h>
 #include <Atom/RPI.Reflect/Model/ModelAssetCreator.h>
 #include <AzCore/Asset/AssetCommon.h>
+#include <AzCore/std/algorithm.h>
 #include <AzCore/std/limits.h>
+#include <glm/gtc/matrix_transform.hpp>
 
 // Window 10 wingdi.h header defines OPAQUE macro which mess up with CesiumGltf::Material::AlphaMode::OPAQUE.
 // This only happens with unity build
@@ -22,7 +27,6 @@
 
 #include <CesiumGltf/Model.h>
 #include <CesiumGltf/MeshPrimitive.h>
-#include <CesiumGltf/AccessorView.h>
 #include <CesiumUtility/Math.h>
 
 #ifdef AZ_COMPILER_MSVC
@@ -35,6 +39,112 @@
 
 namespace Cesium
 {
+    namespace
+    {
+        // attributes that are converted to float. The stream is invalid when the attribute is missing, is not of the given
+        // type, or has components that cannot be converted
+        GltfAccessorStream GetFloatAttributeStream(
+            const CesiumGltf::Model& model, const CesiumGltf::MeshPrimitive& primitive, const char* attributeName, const char* type)
+        {
+            auto attribute = primitive.attributes.find(attributeName);
+            if (attribute == primitive.attributes.end())
+            {
+                return GltfAccessorStream{};
+            }
+
+            const CesiumGltf::Accessor* accessor = model.getSafe<CesiumGltf::Accessor>(&model.accessors, attribute->second);
+            if (!accessor || accessor->type != type)
+            {
+                return GltfAccessorStream{};
+            }
+
+            GltfAccessorStream stream = GltfVertexStreamPacker::GetAccessorStream(model, *accessor);
+            return GltfVertexStreamPacker::CanPackFloat(stream) ? stream : GltfAccessorStream{};
+        }
+
+        // UV set of the primitive, and the format its elements keep in the mesh buffer
+        GltfAccessorStream GetUVStream(
+            const CesiumGltf::Model& model, const CesiumGltf::MeshPrimitive& primitive, std::size_t uvSet, AZ::RHI::Format& format)
+        {
+            auto uvAttribute = primitive.attributes.find("TEXCOORD_" + std::to_string(uvSet));
+            if (uvAttribute == primitive.attributes.end())
+            {
+                return GltfAccessorStream{};
+            }
+
+            const CesiumGltf::Accessor* uvAccessor = model.getSafe<CesiumGltf::Accessor>(&model.accessors, uvAttribute->second);
+            if (!uvAccessor || uvAccessor->type != CesiumGltf::AccessorSpec::Type::VEC2)
+            {
+                return GltfAccessorStream{};
+            }
+
+            switch (uvAccessor->componentType)
+            {
+            case CesiumGltf::AccessorSpec::ComponentType::FLOAT:
+                format = AZ::RHI::Format::R32G32_FLOAT;
+                break;
+            case CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_BYTE:
+                format = AZ::RHI::Format::R8G8_UNORM;
+                break;
+            case CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_SHORT:
+                format = AZ::RHI::Format::R16G16_UNORM;
+                break;
+            default:
+                return GltfAccessorStream{};
+            }
+
+            return GltfVertexStreamPacker::GetAccessorStream(model, *uvAccessor);
+        }
+
+        template<glm::length_t Length>
+        bool AreNearlyEqual(const glm::vec<Length, float>& lhs, const glm::vec<Length, float>& rhs)
+        {
+            glm::vec<Length, float> difference = lhs - rhs;
+            return glm::dot(difference, difference) <= 1e-8f;
+        }
+
+        // Merges the triangle corners of each vertex whose generated attributes are equal back into one vertex, so generated
+        // attributes only split vertices where they are discontinuous. The indices are rewritten to the merged vertices.
+        // vertexSources maps each merged vertex to the vertex it came from, and vertexCorners to the first corner that used it
+        template<typename AreCornersEqual>
+        void WeldCorners(
+            AZStd::vector<std::uint32_t>& indices,
+            std::size_t vertexCount,
+            AreCornersEqual areCornersEqual,
+            AZStd::vector<std::uint32_t>& vertexSources,
+            AZStd::vector<std::uint32_t>& vertexCorners)
+        {
+            static constexpr std::uint32_t NO_VERTEX = ~0u;
+            AZStd::vector<std::uint32_t> firstSplits(vertexCount, NO_VERTEX);
+            AZStd::vector<std::uint32_t> nextSplits;
+            nextSplits.reserve(vertexCount);
+            vertexSources.clear();
+            vertexSources.reserve(vertexCount);
+            vertexCorners.clear();
+            vertexCorners.reserve(vertexCount);
+            for (std::size_t corner = 0; corner < indices.size(); ++corner)
+            {
+                std::uint32_t source = indices[corner];
+                std::uint32_t split = firstSplits[source];
+                while (split != NO_VERTEX && !areCornersEqual(vertexCorners[split], static_cast<std::uint32_t>(corner)))
+                {
+                    split = nextSplits[split];
+                }
+
+                if (split == NO_VERTEX)
+                {
+                    split = static_cast<std::uint32_t>(vertexSources.size());
+                    vertexSources.push_back(source);
+                    vertexCorners.push_back(static_cast<std::uint32_t>(corner));
+                    nextSplits.push_back(firstSplits[source]);
+                    firstSplits[source] = split;
+                }
+
+                indices[corner] = split;
+            }
+        }
+    } // namespace
+
     struct GltfTrianglePrimitiveBuilder::CommonAccessorViews final
     {
         CommonAccessorViews(const CesiumGltf::Model& model, const CesiumGltf::MeshPrimitive& primitive)
@@ -53,42 +163,37 @@ namespace Cesium
                 return;
             }
 
-            m_positions = CesiumGltf::AccessorView<glm::vec3>(model, *m_positionAccessor);
-            if (m_positions.status() != CesiumGltf::AccessorViewStatus::Valid)
+            m_positions = GetFloatAttributeStream(model, primitive, "POSITION", CesiumGltf::AccessorSpec::Type::VEC3);
+            if (!m_positions.IsValid())
             {
                 return;
             }
 
             // get normal view
-            auto normalAttribute = primitive.attributes.find("NORMAL");
-            if (normalAttribute != primitive.attributes.end())
-            {
-                m_normals = CesiumGltf::AccessorView<glm::vec3>(model, normalAttribute->second);
-            }
+            m_normals = GetFloatAttributeStream(model, primitive, "NORMAL", CesiumGltf::AccessorSpec::Type::VEC3);
 
             // get tangent
-            auto tangentAttribute = primitive.attributes.find("TANGENT");
-            if (tangentAttribute != primitive.attributes.end())
-            {
-                m_tangents = CesiumGltf::AccessorView<glm::vec4>(model, tangentAttribute->second);
-            }
+            m_tangents = GetFloatAttributeStream(model, primitive, "TANGENT", CesiumGltf::AccessorSpec::Type::VEC4);
         }
 
         const CesiumGltf::Accessor* m_positionAccessor;
-        CesiumGltf::AccessorView<glm::vec3> m_positions;
-        CesiumGltf::AccessorView<glm::vec3> m_normals;
-        CesiumGltf::AccessorView<glm::vec4> m_tangents;
+        GltfAccessorStream m_positions;
+        GltfAccessorStream m_normals;
+        GltfAccessorStream m_tangents;
     };
 
     GltfTrianglePrimitiveBuilder::LoadContext::LoadContext()
-        : m_generateFlatNormal{ false }
+        : m_generateNormal{ false }
+        , m_smoothNormals{ false }
         , m_generateTangent{ false }
-        , m_generateUnIndexedMesh{ false }
+        , m_remapVertices{ false }
+        , m_compactVertexLayout{ false }
     {
     }
 
     GltfTrianglePrimitiveBuilder::VertexRawBuffer::VertexRawBuffer()
         : m_buffer{}
+        , m_source{}
         , m_format{ AZ::RHI::Format::Unknown }
         , m_elementCount{ 0 }
     {
@@ -101,40 +206,51 @@ namespace Cesium
     {
     }
 
+    GltfTrianglePrimitiveBuilder::VertexStream::VertexStream()
+        : VertexStream(AZ::RHI::Format::Unknown, 0, nullptr, nullptr)
+    {
+    }
+
+    GltfTrianglePrimitiveBuilder::VertexStream::VertexStream(
+        AZ::RHI::Format format, std::size_t elementCount, const void* data, const GltfAccessorStream* source)
+        : m_format{ format }
+        , m_elementCount{ elementCount }
+        , m_data{ data }
+        , m_source{ source }
+        , m_descriptor{}
+    {
+    }
+
     void GltfTrianglePrimitiveBuilder::Create(
         const CesiumGltf::Model& model,
         const CesiumGltf::MeshPrimitive& primitive,
         const GltfLoadMaterial& material,
-        GltfLoadPrimitive& result)
+        bool smoothNormals,
+        GltfLoadPrimitive& result,
+        GltfLoadStatistics& statistics)
     {
+        CESIUM_PROFILE_SCOPE("GltfTrianglePrimitiveBuilder::Create");
+        StageTimer stageTimer(statistics.m_attributeNanoseconds);
         Reset();
 
         // Construct common accessor views. This is needed to begin determine loading context
         CommonAccessorViews commonAccessorViews{ model, primitive };
-        if (commonAccessorViews.m_positions.status() != CesiumGltf::AccessorViewStatus::Valid)
+        if (!commonAccessorViews.m_positions.IsValid())
         {
             return;
         }
 
-        if (commonAccessorViews.m_positions.size() == 0)
-        {
-            return;
-        }
-
-        // construct bounding volume
+        // construct bounding volume. Without min and max, it is computed from the packed positions
         auto positionAccessor = commonAccessorViews.m_positionAccessor;
+        bool hasPositionBounds = positionAccessor->min.size() == 3 && positionAccessor->max.size() == 3;
         AZ::Aabb aabb = AZ::Aabb::CreateNull();
-        if (positionAccessor->min.size() == 3 && positionAccessor->max.size() == 3)
+        if (hasPositionBounds)
         {
             aabb = AZ::Aabb::CreateFromMinMaxValues(
                 static_cast<float>(positionAccessor->min[0]), static_cast<float>(positionAccessor->min[1]),
                 static_cast<float>(positionAccessor->min[2]), static_cast<float>(positionAccessor->max[0]),
                 static_cast<float>(positionAccessor->max[1]), static_cast<float>(positionAccessor->max[2]));
         }
-        else
-        {
-            aabb = CreateAabbFromPositions(commonAccessorViews.m_positions);
-        }
 
         // set indices
         if (!CreateIndices(commonAccessorViews, model, primitive))
@@ -143,121 +259,154 @@ namespace Cesium
         }
 
         // We should expect indices size is a multiple of 3
-        if (m_indices.size() % 3 != 0)
+        if (GetIndexCount() % 3 != 0)
         {
             return;
         }
 
         // determine loading context
-        DetermineLoadContext(commonAccessorViews, material);
+        DetermineLoadContext(commonAccessorViews, material, smoothNormals);
+
+        // generated normals and tangents are created per triangle corner and welded back into indexed vertices. Vertices
+        // are only split where the generated attributes differ, and every other attribute is gathered for the split vertices
+        if (m_context.m_remapVertices)
+        {
+            ExpandIndices();
+            if (!AreIndicesInRange(m_indices.data(), m_indices.size(), commonAccessorViews.m_positions.m_count))
+            {
+                return;
+            }
+
+            GenerateNormals(commonAccessorViews);
+            if (m_context.m_generateTangent)
+            {
+                stageTimer.SwitchTo(statistics.m_tangentNanoseconds);
+                GenerateTangents(commonAccessorViews, model, primitive);
+                stageTimer.SwitchTo(statistics.m_attributeNanoseconds);
+            }
+        }
 
         // Create attributes. The order call of the functions is important
         CreatePositionsAttribute(commonAccessorViews);
         CreateNormalsAttribute(commonAccessorViews);
         CreateUVsAttributes(commonAccessorViews, model, primitive);
         CreateTangentsAndBitangentsAttributes(commonAccessorViews);
-        CreateCustomAttributes(model, primitive, material);
+        CreateCustomAttributes(commonAccessorViews, model, primitive, material);
 
-        // after retrieving all the attributes, we reindex the indices if it's un-indexed mesh
-        if (m_context.m_generateUnIndexedMesh)
+        // calculate buffer view descriptor for each attribute and total buffer size to store all of them
+        // in a single buffer. Attributes that did not have to be generated are still in the glTF buffer
+        stageTimer.SwitchTo(statistics.m_meshAssetNanoseconds);
+        std::size_t vertexCount = GetVertexCount(commonAccessorViews);
+        glm::dmat4 vertexTransform{ 1.0 };
+        VertexStream positionStream;
+        VertexStream normalStream;
+        VertexStream bitangentStream;
+        VertexStream tangentStream;
+        std::size_t totalBufferSize = 0;
+        if (m_context.m_compactVertexLayout)
         {
-            std::iota(m_indices.begin(), m_indices.end(), 0);
+            CreateCompactAttributes(commonAccessorViews, vertexCount, aabb, vertexTransform);
+            positionStream = VertexStream(AZ::RHI::Format::R16G16B16A16_UNORM, vertexCount, m_compactPositions.data(), nullptr);
+            normalStream = VertexStream(AZ::RHI::Format::R16G16B16A16_SNORM, vertexCount, m_compactNormals.data(), nullptr);
+            PlaceVertexStream(positionStream, totalBufferSize);
+            PlaceVertexStream(normalStream, totalBufferSize);
+
+            // the shader decodes tangents and bitangents from the normal stream, so their streams only alias its region
+            tangentStream = VertexStream(normalStream.m_format, vertexCount, nullptr, nullptr);
+            tangentStream.m_descriptor = normalStream.m_descriptor;
+            bitangentStream = tangentStream;
+        }
+        else
+        {
+            positionStream =
+                CreateVertexStream(AZ::RHI::Format::R32G32B32_FLOAT, m_positions, &commonAccessorViews.m_positions, vertexCount);
+            normalStream = CreateVertexStream(AZ::RHI::Format::R32G32B32_FLOAT, m_normals, &commonAccessorViews.m_normals, vertexCount);
+            bitangentStream = CreateVertexStream(AZ::RHI::Format::R32G32B32_FLOAT, m_bitangents, nullptr, vertexCount);
+            tangentStream =
+                CreateVertexStream(AZ::RHI::Format::R32G32B32A32_FLOAT, m_tangents, &commonAccessorViews.m_tangents, vertexCount);
+            PlaceVertexStream(positionStream, totalBufferSize);
+            PlaceVertexStream(normalStream, totalBufferSize);
+            PlaceVertexStream(bitangentStream, totalBufferSize);
+            PlaceVertexStream(tangentStream, totalBufferSize);
         }
 
-        // calculate buffer view descriptor for each attribute and total buffer size to store all of them
-        // in a single buffer
-        auto positionBufferViewDescriptor =
-            AZ::RHI::BufferViewDescriptor::CreateTyped(0, static_cast<std::uint32_t>(m_positions.size()), AZ::RHI::Format::R32G32B32_FLOAT);
-        std::size_t totalBufferSize = m_positions.size() * sizeof(glm::vec3);
-
-        std::size_t normalByteOffset = MathHelper::Align(totalBufferSize, sizeof(glm::vec3));
-        auto normalBufferViewDescriptor = AZ::RHI::BufferViewDescriptor::CreateTyped(
-            static_cast<std::uint32_t>(normalByteOffset / sizeof(glm::vec3)), static_cast<std::uint32_t>(m_normals.size()),
-            AZ::RHI::Format::R32G32B32_FLOAT);
-        totalBufferSize = normalByteOffset + m_normals.size() * sizeof(glm::vec3);
-
-        std::size_t bitangentByteOffset = MathHelper::Align(totalBufferSize, sizeof(glm::vec3));
-        auto bitangentBufferViewDescriptor = AZ::RHI::BufferViewDescriptor::CreateTyped(
-            static_cast<std::uint32_t>(bitangentByteOffset / sizeof(glm::vec3)), static_cast<std::uint32_t>(m_bitangents.size()),
-            AZ::RHI::Format::R32G32B32_FLOAT);
-        totalBufferSize = bitangentByteOffset + m_bitangents.size() * sizeof(glm::vec3);
-
-        std::size_t tangentByteOffset = MathHelper::Align(totalBufferSize, sizeof(glm::vec4));
-        auto tangentBufferViewDescriptor = AZ::RHI::BufferViewDescriptor::CreateTyped(
-            static_cast<std::uint32_t>(tangentByteOffset / sizeof(glm::vec4)), static_cast<std::uint32_t>(m_tangents.size()),
-            AZ::RHI::Format::R32G32B32A32_FLOAT);
-        totalBufferSize = tangentByteOffset + m_tangents.size() * sizeof(glm::vec4);
-
-        AZStd::array<AZ::RHI::BufferViewDescriptor, 2> uvBufferViewDescriptors;
-        for (std::size_t i = 0; i < uvBufferViewDescriptors.size(); ++i)
-        {
-            if (!m_uvs[i].m_buffer.empty())
+        AZStd::array<VertexStream, 2> uvStreams;
+        for (std::size_t i = 0; i < uvStreams.size(); ++i)
+        {
+            if (m_uvs[i].m_elementCount > 0)
             {
-                std::size_t formatSize = AZ::RHI::GetFormatSize(m_uvs[i].m_format);
-                std::size_t offset = MathHelper::Align(totalBufferSize, formatSize);
-                uvBufferViewDescriptors[i] = AZ::RHI::BufferViewDescriptor::CreateTyped(
-                    static_cast<std::uint32_t>(offset / formatSize), static_cast<std::uint32_t>(m_uvs[i].m_elementCount),
-                    m_uvs[i].m_format);
-                totalBufferSize = offset + m_uvs[i].m_buffer.size();
+                uvStreams[i] = CreateVertexStream(m_uvs[i]);
+                PlaceVertexStream(uvStreams[i], totalBufferSize);
             }
             else
             {
                 // since this UVs buffer is empty, we just assign its region to tangent buffer as dummy buffer since we don't
-                // care about its value anyway and tangent offset is also a multiple of R32G32_FLOAT size
+                // care about its value anyway and tangent offset is also a multiple of R32G32_FLOAT size. Compact tangents
+                // are 8 bytes, so this holds for them as well
                 std::size_t formatSize = AZ::RHI::GetFormatSize(AZ::RHI::Format::R32G32_FLOAT);
-                std::size_t offset = tangentByteOffset;
-                uvBufferViewDescriptors[i] = AZ::RHI::BufferViewDescriptor::CreateTyped(
-                    static_cast<std::uint32_t>(offset / formatSize), static_cast<std::uint32_t>(m_tangents.size()),
+                std::size_t offset = tangentStream.m_descriptor.m_elementOffset * tangentStream.m_descriptor.m_elementSize;
+                uvStreams[i].m_descriptor = AZ::RHI::BufferViewDescriptor::CreateTyped(
+                    static_cast<std::uint32_t>(offset / formatSize), static_cast<std::uint32_t>(tangentStream.m_elementCount),
                     AZ::RHI::Format::R32G32_FLOAT);
             }
         }
 
-        AZStd::vector<AZ::RHI::BufferViewDescriptor> customAttribBufferViewDescriptors;
-        if (!m_customAttributes.empty())
+        AZStd::vector<VertexStream> customAttributeStreams;
+        customAttributeStreams.reserve(m_customAttributes.size());
+        for (const auto& customAttribute : m_customAttributes)
         {
-            customAttribBufferViewDescriptors.reserve(m_customAttributes.size());
-            for (const auto& customAttribute : m_customAttributes)
-            {
-                std::size_t formatSize = AZ::RHI::GetFormatSize(customAttribute.m_buffer.m_format);
-                std::size_t offset = MathHelper::Align(totalBufferSize, formatSize);
-                customAttribBufferViewDescriptors.emplace_back(AZ::RHI::BufferViewDescriptor::CreateTyped(
-                    static_cast<std::uint32_t>(offset / formatSize), static_cast<std::uint32_t>(customAttribute.m_buffer.m_elementCount),
-                    customAttribute.m_buffer.m_format));
-                totalBufferSize = offset + customAttribute.m_buffer.m_buffer.size();
-            }
+            customAttributeStreams.push_back(CreateVertexStream(customAttribute.m_buffer));
+            PlaceVertexStream(customAttributeStreams.back(), totalBufferSize);
         }
 
-        std::size_t offset = MathHelper::Align(totalBufferSize, sizeof(std::uint32_t));
-        auto indicesBufferViewDescriptor = AZ::RHI::BufferViewDescriptor::CreateTyped(
-            static_cast<std::uint32_t>(offset / sizeof(std::uint32_t)), static_cast<std::uint32_t>(m_indices.size()),
-            AZ::RHI::Format::R32_UINT);
-        totalBufferSize = offset + m_indices.size() * sizeof(std::uint32_t);
+        // 16 bit indices are lossless whenever every vertex can be addressed by them
+        AZ::RHI::Format indexFormat =
+            vertexCount <= MAX_16_BIT_INDEX_VERTEX_COUNT ? AZ::RHI::Format::R16_UINT : AZ::RHI::Format::R32_UINT;
+        VertexStream indexStream = m_indices.empty()
+            ? VertexStream(indexFormat, m_indexSource.m_count, nullptr, &m_indexSource)
+            : VertexStream(indexFormat, m_indices.size(), m_indices.data(), nullptr);
+        PlaceVertexStream(indexStream, totalBufferSize);
 
-        // populate the raw buffer with attributes data
+        // pack every attribute into its region of the buffer
         AZStd::vector<std::byte> buffer;
         buffer.resize_no_construct(totalBufferSize);
-        CopySubregionBuffer(buffer, m_indices.data(), indicesBufferViewDescriptor);
-        CopySubregionBuffer(buffer, m_positions.data(), positionBufferViewDescriptor);
-        CopySubregionBuffer(buffer, m_normals.data(), normalBufferViewDescriptor);
-        CopySubregionBuffer(buffer, m_bitangents.data(), bitangentBufferViewDescriptor);
-        CopySubregionBuffer(buffer, m_tangents.data(), tangentBufferViewDescriptor);
+        PackVertexStream(buffer, positionStream);
+        PackVertexStream(buffer, normalStream);
+        PackVertexStream(buffer, bitangentStream);
+        PackVertexStream(buffer, tangentStream);
+        for (std::size_t i = 0; i < uvStreams.size(); ++i)
+        {
+            PackVertexStream(buffer, uvStreams[i]);
+        }
 
-        for (std::size_t i = 0; i < m_uvs.size(); ++i)
+        for (const VertexStream& customAttributeStream : customAttributeStreams)
         {
-            if (!m_uvs[i].m_buffer.empty())
-            {
-                CopySubregionBuffer(buffer, m_uvs[i].m_buffer.data(), uvBufferViewDescriptors[i]);
-            }
+            PackVertexStream(buffer, customAttributeStream);
         }
 
-        for (std::size_t i = 0; i < m_customAttributes.size(); ++i)
+        if (!PackIndexStream(buffer, indexStream, vertexCount))
+        {
+            return;
+        }
+
+        // bitangents of the tangents that are packed from the glTF buffer are created from the packed normals and tangents
+        if (!m_context.m_compactVertexLayout && !bitangentStream.m_data)
         {
-            if (!m_customAttributes[i].m_buffer.m_buffer.empty())
+            const glm::vec3* normals = reinterpret_cast<const glm::vec3*>(GetVertexStreamData(buffer, normalStream.m_descriptor));
+            const glm::vec4* tangents = reinterpret_cast<const glm::vec4*>(GetVertexStreamData(buffer, tangentStream.m_descriptor));
+            glm::vec3* bitangents = reinterpret_cast<glm::vec3*>(GetVertexStreamData(buffer, bitangentStream.m_descriptor));
+            for (std::size_t i = 0; i < vertexCount; ++i)
             {
-                CopySubregionBuffer(buffer, m_customAttributes[i].m_buffer.m_buffer.data(), customAttribBufferViewDescriptors[i]);
+                bitangents[i] = glm::cross(normals[i], glm::vec3(tangents[i])) * tangents[i].w;
             }
         }
 
+        if (!m_context.m_compactVertexLayout && !hasPositionBounds)
+        {
+            aabb = CreateAabbFromPositions(
+                reinterpret_cast<const glm::vec3*>(GetVertexStreamData(buffer, positionStream.m_descriptor)), vertexCount);
+        }
+
         AZ::Data::Asset<AZ::RPI::BufferAsset> bufferAsset = CreateBufferAsset(buffer);
 
         // create LOD asset
@@ -268,27 +417,27 @@ namespace Cesium
 
         // create mesh
         lodCreator.BeginMesh();
-        lodCreator.SetMeshIndexBuffer(AZ::RPI::BufferAssetView(bufferAsset, indicesBufferViewDescriptor));
+        lodCreator.SetMeshIndexBuffer(AZ::RPI::BufferAssetView(bufferAsset, indexStream.m_descriptor));
         lodCreator.AddMeshStreamBuffer(
-            AZ::RHI::ShaderSemantic("POSITION"), AZ::Name(), AZ::RPI::BufferAssetView(bufferAsset, positionBufferViewDescriptor));
+            AZ::RHI::ShaderSemantic("POSITION"), AZ::Name(), AZ::RPI::BufferAssetView(bufferAsset, positionStream.m_descriptor));
         lodCreator.AddMeshStreamBuffer(
-            AZ::RHI::ShaderSemantic("NORMAL"), AZ::Name(), AZ::RPI::BufferAssetView(bufferAsset, normalBufferViewDescriptor));
+            AZ::RHI::ShaderSemantic("NORMAL"), AZ::Name(), AZ::RPI::BufferAssetView(bufferAsset, normalStream.m_descriptor));
         lodCreator.AddMeshStreamBuffer(
-            AZ::RHI::ShaderSemantic("BITANGENT"), AZ::Name(), AZ::RPI::BufferAssetView(bufferAsset, bitangentBufferViewDescriptor));
+            AZ::RHI::ShaderSemantic("BITANGENT"), AZ::Name(), AZ::RPI::BufferAssetView(bufferAsset, bitangentStream.m_descriptor));
         lodCreator.AddMeshStreamBuffer(
-            AZ::RHI::ShaderSemantic("TANGENT"), AZ::Name(), AZ::RPI::BufferAssetView(bufferAsset, tangentBufferViewDescriptor));
+            AZ::RHI::ShaderSemantic("TANGENT"), AZ::Name(), AZ::RPI::BufferAssetView(bufferAsset, tangentStream.m_descriptor));
 
-        for (std::size_t i = 0; i < uvBufferViewDescriptors.size(); ++i)
+        for (std::size_t i = 0; i < uvStreams.size(); ++i)
         {
             lodCreator.AddMeshStreamBuffer(
-                AZ::RHI::ShaderSemantic("UV", i), AZ::Name(), AZ::RPI::BufferAssetView(bufferAsset, uvBufferViewDescriptors[i]));
+                AZ::RHI::ShaderSemantic("UV", i), AZ::Name(), AZ::RPI::BufferAssetView(bufferAsset, uvStreams[i].m_descriptor));
         }
 
         for (std::size_t i = 0; i < m_customAttributes.size(); ++i)
         {
             lodCreator.AddMeshStreamBuffer(
                 m_customAttributes[i].m_shaderAttribute.m_shaderSemantic, m_customAttributes[i].m_shaderAttribute.m_shaderAttributeName,
-                AZ::RPI::BufferAssetView(bufferAsset, customAttribBufferViewDescriptors[i]));
+                AZ::RPI::BufferAssetView(bufferAsset, customAttributeStreams[i].m_descriptor));
         }
 
         lodCreator.SetMeshAabb(std::move(aabb));
@@ -309,20 +458,23 @@ namespace Cesium
 
         result.m_modelAsset = std::move(modelAsset);
         result.m_materialId = primitive.material;
+        result.m_vertexTransform = vertexTransform;
     }
 
-    void GltfTrianglePrimitiveBuilder::DetermineLoadContext(const CommonAccessorViews& accessorViews, const GltfLoadMaterial& material)
+    void GltfTrianglePrimitiveBuilder::DetermineLoadContext(
+        const CommonAccessorViews& accessorViews, const GltfLoadMaterial& material, bool smoothNormals)
     {
         // check if we should generate normal
-        bool isNormalAccessorValid = accessorViews.m_normals.status() == CesiumGltf::AccessorViewStatus::Valid;
-        bool hasEnoughNormalVertices = accessorViews.m_normals.size() == accessorViews.m_positions.size();
-        m_context.m_generateFlatNormal = !isNormalAccessorValid || !hasEnoughNormalVertices;
+        bool isNormalAccessorValid = accessorViews.m_normals.IsValid();
+        bool hasEnoughNormalVertices = accessorViews.m_normals.m_count == accessorViews.m_positions.m_count;
+        m_context.m_generateNormal = !isNormalAccessorValid || !hasEnoughNormalVertices;
+        m_context.m_smoothNormals = smoothNormals;
 
         // check if we should generate tangent
         if (material.m_needTangents)
         {
-            bool isTangentAccessorValid = accessorViews.m_tangents.status() == CesiumGltf::AccessorViewStatus::Valid;
-            bool hasEnoughTangentVertices = accessorViews.m_tangents.size() == accessorViews.m_positions.size();
+            bool isTangentAccessorValid = accessorViews.m_tangents.IsValid();
+            bool hasEnoughTangentVertices = accessorViews.m_tangents.m_count == accessorViews.m_positions.m_count;
             m_context.m_generateTangent = !isTangentAccessorValid || !hasEnoughTangentVertices;
         }
         else
@@ -330,56 +482,41 @@ namespace Cesium
             m_context.m_generateTangent = false;
         }
 
-        // check if we should generate unindexed mesh
-        m_context.m_generateUnIndexedMesh = m_context.m_generateFlatNormal || m_context.m_generateTangent;
+        // check if generated attributes will split vertices
+        m_context.m_remapVertices = m_context.m_generateNormal || m_context.m_generateTangent;
+
+        m_context.m_compactVertexLayout = material.m_compactVertexLayout;
     }
 
-    template<typename AccessorType>
-    void GltfTrianglePrimitiveBuilder::CopyAccessorToBuffer(
-        const CesiumGltf::AccessorView<AccessorType>& attributeAccessorView, AZStd::vector<AccessorType>& attributes)
+    void GltfTrianglePrimitiveBuilder::CopyAccessorToBuffer(const GltfAccessorStream& stream, AZStd::vector<glm::vec3>& attributes)
     {
-        if (m_context.m_generateUnIndexedMesh)
-        {
-            // mesh has indices
-            attributes.resize(m_indices.size());
-            for (std::size_t i = 0; i < m_indices.size(); ++i)
-            {
-                std::int64_t index = static_cast<std::int64_t>(m_indices[i]);
-                attributes[static_cast<std::size_t>(i)] = attributeAccessorView[index];
-            }
-        }
-        else
-        {
-            attributes.resize(static_cast<std::size_t>(attributeAccessorView.size()));
-            for (std::int64_t i = 0; i < attributeAccessorView.size(); ++i)
-            {
-                attributes[static_cast<std::size_t>(i)] = attributeAccessorView[i];
-            }
-        }
+        // only remapped attributes are copied, the others are packed into the mesh buffer directly
+        assert(m_context.m_remapVertices);
+        attributes.resize_no_construct(m_vertexSources.size());
+        GltfVertexStreamPacker::PackFloat(
+            stream, 3, reinterpret_cast<float*>(attributes.data()), m_vertexSources.data(), m_vertexSources.size());
+    }
+
+    void GltfTrianglePrimitiveBuilder::CopyAccessorToBuffer(const GltfAccessorStream& stream, AZStd::vector<glm::vec4>& attributes)
+    {
+        assert(m_context.m_remapVertices);
+        attributes.resize_no_construct(m_vertexSources.size());
+        GltfVertexStreamPacker::PackFloat(
+            stream, 4, reinterpret_cast<float*>(attributes.data()), m_vertexSources.data(), m_vertexSources.size());
     }
 
-    template<typename AccessorType>
-    void GltfTrianglePrimitiveBuilder::CopyAccessorToBuffer(
-        const CesiumGltf::AccessorView<AccessorType>& accessorView, AZStd::vector<std::byte>& buffer)
+    void GltfTrianglePrimitiveBuilder::AssignAccessorToBuffer(const GltfAccessorStream& stream, VertexRawBuffer& buffer)
     {
-        if (m_context.m_generateUnIndexedMesh)
+        if (m_context.m_remapVertices)
         {
-            buffer.resize(m_indices.size() * sizeof(AccessorType));
-            AccessorType* value = reinterpret_cast<AccessorType*>(buffer.data());
-            for (std::size_t i = 0; i < m_indices.size(); ++i)
-            {
-                std::int64_t index = static_cast<std::int64_t>(m_indices[i]);
-                value[i] = accessorView[index];
-            }
+            buffer.m_buffer.resize_no_construct(m_vertexSources.size() * AZ::RHI::GetFormatSize(buffer.m_format));
+            GltfVertexStreamPacker::Pack(stream, buffer.m_format, buffer.m_buffer.data(), m_vertexSources.data(), m_vertexSources.size());
+            buffer.m_elementCount = m_vertexSources.size();
         }
         else
         {
-            buffer.resize(static_cast<std::size_t>(accessorView.size()) * sizeof(AccessorType));
-            AccessorType* value = reinterpret_cast<AccessorType*>(buffer.data());
-            for (std::int64_t i = 0; i < accessorView.size(); ++i)
-            {
-                value[i] = accessorView[i];
-            }
+            buffer.m_source = stream;
+            buffer.m_elementCount = stream.m_count;
         }
     }
 
@@ -415,7 +552,7 @@ namespace Cesium
         const CesiumGltf::Accessor* indicesAccessor = model.getSafe<CesiumGltf::Accessor>(&model.accessors, primitive.indices);
         if (!indicesAccessor)
         {
-            m_indices.resize(static_cast<std::size_t>(accessorViews.m_positions.size()));
+            m_indices.resize(accessorViews.m_positions.m_count);
             std::iota(m_indices.begin(), m_indices.end(), 0);
             return true;
         }
@@ -426,71 +563,53 @@ namespace Cesium
             return false;
         }
 
-        if (indicesAccessor->componentType == CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_BYTE)
-        {
-            CesiumGltf::AccessorView<std::uint8_t> view{ model, *indicesAccessor };
-            return CreateIndices(primitive, view);
-        }
-        else if (indicesAccessor->componentType == CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_SHORT)
-        {
-            CesiumGltf::AccessorView<std::uint16_t> view{ model, *indicesAccessor };
-            return CreateIndices(primitive, view);
-        }
-        else if (indicesAccessor->componentType == CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_INT)
-        {
-            CesiumGltf::AccessorView<std::uint32_t> view{ model, *indicesAccessor };
-            return CreateIndices(primitive, view);
-        }
-
-        return false;
-    }
-
-    template<typename IndexType>
-    bool GltfTrianglePrimitiveBuilder::CreateIndices(
-        const CesiumGltf::MeshPrimitive& primitive, const CesiumGltf::AccessorView<IndexType>& indicesAccessorView)
-    {
-        if (indicesAccessorView.status() != CesiumGltf::AccessorViewStatus::Valid)
+        GltfAccessorStream indices = GltfVertexStreamPacker::GetAccessorStream(model, *indicesAccessor);
+        if (!GltfVertexStreamPacker::CanPackIndices(indices))
         {
             return false;
         }
 
+        // triangle lists are packed from the glTF buffer straight into the mesh buffer
         if (primitive.mode == CesiumGltf::MeshPrimitive::Mode::TRIANGLES)
         {
-            if (indicesAccessorView.size() % 3 != 0)
+            if (indices.m_count % 3 != 0)
             {
                 return false;
             }
 
-            m_indices.resize(static_cast<std::size_t>(indicesAccessorView.size()));
-            for (std::int64_t i = 0; i < indicesAccessorView.size(); ++i)
-            {
-                m_indices[static_cast<std::size_t>(i)] = static_cast<std::uint32_t>(indicesAccessorView[i]);
-            }
-
+            m_indexSource = indices;
             return true;
         }
 
+        AZStd::vector<std::uint32_t> primitiveIndices;
+        primitiveIndices.resize_no_construct(indices.m_count);
+        GltfVertexStreamPacker::PackIndices(indices, primitiveIndices.data());
+        return CreateIndices(primitive, primitiveIndices);
+    }
+
+    bool GltfTrianglePrimitiveBuilder::CreateIndices(const CesiumGltf::MeshPrimitive& primitive, const AZStd::vector<std::uint32_t>& indices)
+    {
         if (primitive.mode == CesiumGltf::MeshPrimitive::Mode::TRIANGLE_STRIP)
         {
-            if (indicesAccessorView.size() <= 2)
+            if (indices.size() <= 2)
             {
                 return false;
             }
 
-            m_indices.reserve(static_cast<std::size_t>(indicesAccessorView.size() - 2) * 3);
-            for (std::int64_t i = 0; i < indicesAccessorView.size() - 2; ++i)
+            m_indices.reserve((indices.size() - 2) * 3);
+            for (std::size_t i = 0; i < indices.size() - 2; ++i)
             {
                 if (i % 2)
                 {
-                    m_indices.emplace_back(static_cast<std::uint32_t>(indicesAccessorView[i]));
-                    m_indices.emplace_back(static_cast<std::uint32_t>(indicesAccessorView[i + 2]));
-                    m_indices.emplace_back(static_cast<std::uint32_t>(indicesAccessorView[i + 1]));
+                    m_indices.emplace_back(indices[i]);
+                    m_indices.emplace_back(indices[i + 2]);
+                    m_indices.emplace_back(indices[i + 1]);
                 }
                 else
                 {
-                    m_indices.emplace_back(static_cast<std::uint32_t>(indicesAccessorView[i]));
-                    m_indices.emplace_back(static_cast<std::uint32_t>(indicesAccessorView[i + 1]));
-                    m_indices.emplace_back(static_cast<std::uint32_t>(indicesAccessorView[i + 2]));
+                    m_indices.emplace_back(indices[i]);
+                    m_indices.emplace_back(indices[i + 1]);
+                    m_indices.emplace_back(indices[i + 2]);
                 }
             }
 
@@ -499,17 +618,17 @@ namespace Cesium
 
         if (primitive.mode == CesiumGltf::MeshPrimitive::Mode::TRIANGLE_FAN)
         {
-            if (indicesAccessorView.size() <= 2)
+            if (indices.size() <= 2)
             {
                 return false;
             }
 
-            m_indices.reserve(static_cast<std::size_t>(indicesAccessorView.size() - 2) * 3);
-            for (std::int64_t i = 0; i < indicesAccessorView.size() - 2; ++i)
+            m_indices.reserve((indices.size() - 2) * 3);
+            for (std::size_t i = 0; i < indices.size() - 2; ++i)
             {
-                m_indices.emplace_back(static_cast<std::uint32_t>(indicesAccessorView[0]));
-                m_indices.emplace_back(static_cast<std::uint32_t>(indicesAccessorView[i + 1]));
-                m_indices.emplace_back(static_cast<std::uint32_t>(indicesAccessorView[i + 2]));
+                m_indices.emplace_back(indices[0]);
+                m_indices.emplace_back(indices[i + 1]);
+                m_indices.emplace_back(indices[i + 2]);
             }
 
             return true;
@@ -518,166 +637,227 @@ namespace Cesium
         return false;
     }
 
-    void GltfTrianglePrimitiveBuilder::CreatePositionsAttribute(const CommonAccessorViews& commonAccessorViews)
+    void GltfTrianglePrimitiveBuilder::ExpandIndices()
     {
-        assert(commonAccessorViews.m_positions.status() == CesiumGltf::AccessorViewStatus::Valid);
-        assert(commonAccessorViews.m_positions.size() > 0);
-        CopyAccessorToBuffer(commonAccessorViews.m_positions, m_positions);
+        if (m_indices.empty() && m_indexSource.IsValid())
+        {
+            m_indices.resize_no_construct(m_indexSource.m_count);
+            GltfVertexStreamPacker::PackIndices(m_indexSource, m_indices.data());
+            m_indexSource = GltfAccessorStream{};
+        }
     }
 
-    void GltfTrianglePrimitiveBuilder::CreateNormalsAttribute(const CommonAccessorViews& commonAccessorViews)
+    std::size_t GltfTrianglePrimitiveBuilder::GetIndexCount() const
     {
-        if (m_context.m_generateFlatNormal)
+        return m_indices.empty() ? m_indexSource.m_count : m_indices.size();
+    }
+
+    std::size_t GltfTrianglePrimitiveBuilder::GetVertexCount(const CommonAccessorViews& commonAccessorViews) const
+    {
+        return m_context.m_remapVertices ? m_vertexSources.size() : commonAccessorViews.m_positions.m_count;
+    }
+
+    void GltfTrianglePrimitiveBuilder::GenerateNormals(const CommonAccessorViews& commonAccessorViews)
+    {
+        assert(m_context.m_remapVertices);
+        std::size_t vertexCount = commonAccessorViews.m_positions.m_count;
+        if (!m_context.m_generateNormal)
+        {
+            // tangents are generated from the glTF normals, which keep every vertex as it is
+            assert(commonAccessorViews.m_normals.IsValid());
+            m_vertexSources.resize_no_construct(vertexCount);
+            std::iota(m_vertexSources.begin(), m_vertexSources.end(), 0);
+            m_normals.resize_no_construct(vertexCount);
+            GltfVertexStreamPacker::PackFloat(commonAccessorViews.m_normals, 3, reinterpret_cast<float*>(m_normals.data()));
+            return;
+        }
+
+        AZStd::vector<glm::vec3> positions;
+        positions.resize_no_construct(vertexCount);
+        GltfVertexStreamPacker::PackFloat(commonAccessorViews.m_positions, 3, reinterpret_cast<float*>(positions.data()));
+
+        // corners of a vertex only split where they fall into different smoothing groups, or onto faces facing another way
+        AZStd::vector<glm::vec3> cornerNormals;
+        AZStd::vector<std::uint32_t> vertexCorners;
+        if (m_context.m_smoothNormals)
         {
-            // if we are at this point, positions is already un-indexed
-            assert(m_context.m_generateUnIndexedMesh);
-            assert(m_positions.size() > 0);
-            assert(m_positions.size() % 3 == 0);
-            CreateFlatNormal();
+            NormalGenerator::Generate(m_indices, positions, NORMAL_CREASE_ANGLE, cornerNormals);
+            WeldCorners(
+                m_indices,
+                vertexCount,
+                [&cornerNormals](std::uint32_t vertexCorner, std::uint32_t corner)
+                {
+                    return AreNearlyEqual(cornerNormals[vertexCorner], cornerNormals[corner]);
+                },
+                m_vertexSources,
+                vertexCorners);
         }
         else
         {
-            assert(commonAccessorViews.m_normals.status() == CesiumGltf::AccessorViewStatus::Valid);
-            assert(commonAccessorViews.m_normals.size() > 0);
-            assert(commonAccessorViews.m_normals.size() == commonAccessorViews.m_positions.size());
-            CopyAccessorToBuffer(commonAccessorViews.m_normals, m_normals);
+            NormalGenerator::GenerateFlat(m_indices, positions, cornerNormals);
+            WeldCorners(
+                m_indices,
+                vertexCount,
+                [&cornerNormals](std::uint32_t vertexCorner, std::uint32_t corner)
+                {
+                    return cornerNormals[vertexCorner] == cornerNormals[corner];
+                },
+                m_vertexSources,
+                vertexCorners);
+        }
+
+        m_normals.resize_no_construct(vertexCorners.size());
+        for (std::size_t i = 0; i < vertexCorners.size(); ++i)
+        {
+            m_normals[i] = cornerNormals[vertexCorners[i]];
         }
     }
 
-    void GltfTrianglePrimitiveBuilder::CreateUVsAttributes(
+    void GltfTrianglePrimitiveBuilder::GenerateTangents(
         const CommonAccessorViews& commonAccessorViews, const CesiumGltf::Model& model, const CesiumGltf::MeshPrimitive& primitive)
     {
-        for (std::size_t i = 0; i < m_uvs.size(); ++i)
+        assert(m_context.m_remapVertices);
+        assert(m_normals.size() == m_vertexSources.size());
+
+        std::size_t vertexCount = m_vertexSources.size();
+        AZStd::vector<glm::vec3> positions;
+        positions.resize_no_construct(vertexCount);
+        GltfVertexStreamPacker::PackFloat(
+            commonAccessorViews.m_positions, 3, reinterpret_cast<float*>(positions.data()), m_vertexSources.data(), vertexCount);
+
+        // Try to generate tangents and bitangents
+        AZStd::vector<glm::vec4> cornerTangents;
+        AZStd::vector<glm::vec3> cornerBitangents;
+        bool success = false;
+        for (std::size_t i = 0; i < m_uvs.size() && !success; ++i)
         {
-            auto uvAttribute = primitive.attributes.find("TEXCOORD_" + std::to_string(i));
-            if (uvAttribute == primitive.attributes.end())
-            {
-                continue;
-            }
-
-            const CesiumGltf::Accessor* uvAccessor = model.getSafe<CesiumGltf::Accessor>(&model.accessors, uvAttribute->second);
-            if (uvAccessor->type != CesiumGltf::AccessorSpec::Type::VEC2)
+            AZ::RHI::Format format = AZ::RHI::Format::Unknown;
+            GltfAccessorStream uvStream = GetUVStream(model, primitive, i, format);
+            if (!uvStream.IsValid() || uvStream.m_count != commonAccessorViews.m_positions.m_count)
             {
                 continue;
             }
 
-            if (uvAccessor->componentType == CesiumGltf::AccessorSpec::ComponentType::FLOAT)
-            {
-                CesiumGltf::AccessorView<glm::vec2> view{ model, *uvAccessor };
-                if (view.status() != CesiumGltf::AccessorViewStatus::Valid)
-                {
-                    continue;
-                }
+            // byte and short UVs are always normalized
+            uvStream.m_normalized = true;
+            AZStd::vector<glm::vec2> uvs;
+            uvs.resize_no_construct(vertexCount);
+            GltfVertexStreamPacker::PackFloat(uvStream, 2, reinterpret_cast<float*>(uvs.data()), m_vertexSources.data(), vertexCount);
+            success = BitangentAndTangentGenerator::Generate(m_indices, positions, m_normals, uvs, cornerTangents, cornerBitangents);
+        }
 
-                if (view.size() != commonAccessorViews.m_positions.size())
-                {
-                    continue;
-                }
+        // if we still cannot generate MikkTSpace, then we generate dummy
+        if (!success)
+        {
+            m_tangents.resize(vertexCount, glm::vec4(1.0f, 0.0f, 0.0f, 1.0f));
+            m_bitangents.resize(vertexCount, glm::vec3(0.0f, 1.0f, 0.0f));
+            return;
+        }
 
-                CopyAccessorToBuffer(view, m_uvs[i].m_buffer);
-                m_uvs[i].m_elementCount = m_uvs[i].m_buffer.size() / (sizeof(float) * 2);
-                m_uvs[i].m_format = AZ::RHI::Format::R32G32_FLOAT;
-            }
-            else if (uvAccessor->componentType == CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_BYTE)
+        // corners of a vertex with different tangents, e.g. along UV seams and mirrored UVs, are split once more
+        AZStd::vector<std::uint32_t> tangentSources;
+        AZStd::vector<std::uint32_t> vertexCorners;
+        WeldCorners(
+            m_indices,
+            vertexCount,
+            [&cornerTangents, &cornerBitangents](std::uint32_t vertexCorner, std::uint32_t corner)
             {
-                CesiumGltf::AccessorView<glm::u8vec2> view{ model, *uvAccessor };
-                if (view.status() != CesiumGltf::AccessorViewStatus::Valid)
-                {
-                    continue;
-                }
+                return AreNearlyEqual(cornerTangents[vertexCorner], cornerTangents[corner]) &&
+                    AreNearlyEqual(cornerBitangents[vertexCorner], cornerBitangents[corner]);
+            },
+            tangentSources,
+            vertexCorners);
+
+        AZStd::vector<std::uint32_t> vertexSources;
+        AZStd::vector<glm::vec3> normals;
+        vertexSources.resize_no_construct(tangentSources.size());
+        normals.resize_no_construct(tangentSources.size());
+        m_tangents.resize_no_construct(tangentSources.size());
+        m_bitangents.resize_no_construct(tangentSources.size());
+        for (std::size_t i = 0; i < tangentSources.size(); ++i)
+        {
+            vertexSources[i] = m_vertexSources[tangentSources[i]];
+            normals[i] = m_normals[tangentSources[i]];
+            m_tangents[i] = cornerTangents[vertexCorners[i]];
+            m_bitangents[i] = cornerBitangents[vertexCorners[i]];
+        }
 
-                if (view.size() != commonAccessorViews.m_positions.size())
-                {
-                    continue;
-                }
+        m_vertexSources = std::move(vertexSources);
+        m_normals = std::move(normals);
+    }
 
-                CopyAccessorToBuffer(view, m_uvs[i].m_buffer);
-                m_uvs[i].m_elementCount = m_uvs[i].m_buffer.size() / (sizeof(std::uint8_t) * 2);
-                m_uvs[i].m_format = AZ::RHI::Format::R8G8_UNORM;
-            }
-            else if (uvAccessor->componentType == CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_SHORT)
-            {
-                CesiumGltf::AccessorView<glm::u16vec2> view{ model, *uvAccessor };
-                if (view.status() != CesiumGltf::AccessorViewStatus::Valid)
-                {
-                    continue;
-                }
+    void GltfTrianglePrimitiveBuilder::CreatePositionsAttribute(const CommonAccessorViews& commonAccessorViews)
+    {
+        assert(commonAccessorViews.m_positions.IsValid());
+        assert(commonAccessorViews.m_positions.m_count > 0);
 
-                if (view.size() != commonAccessorViews.m_positions.size())
-                {
-                    continue;
-                }
+        // positions that are not remapped are packed straight into the mesh buffer
+        if (m_context.m_remapVertices)
+        {
+            CopyAccessorToBuffer(commonAccessorViews.m_positions, m_positions);
+        }
+    }
 
-                CopyAccessorToBuffer(view, m_uvs[i].m_buffer);
-                m_uvs[i].m_elementCount = m_uvs[i].m_buffer.size() / (sizeof(std::uint16_t) * 2);
-                m_uvs[i].m_format = AZ::RHI::Format::R16G16_UNORM;
-            }
+    void GltfTrianglePrimitiveBuilder::CreateNormalsAttribute(const CommonAccessorViews& commonAccessorViews)
+    {
+        if (m_context.m_remapVertices)
+        {
+            // generated normals, and the glTF normals tangents are generated from, are remapped along with the vertices
+            assert(m_normals.size() == m_vertexSources.size());
+            return;
         }
+
+        // normals that are not remapped are packed straight into the mesh buffer
+        assert(commonAccessorViews.m_normals.IsValid());
+        assert(commonAccessorViews.m_normals.m_count == commonAccessorViews.m_positions.m_count);
     }
 
-    void GltfTrianglePrimitiveBuilder::CreateTangentsAndBitangentsAttributes(const CommonAccessorViews& commonAccessorViews)
+    void GltfTrianglePrimitiveBuilder::CreateUVsAttributes(
+        const CommonAccessorViews& commonAccessorViews, const CesiumGltf::Model& model, const CesiumGltf::MeshPrimitive& primitive)
     {
-        if (m_context.m_generateTangent)
+        for (std::size_t i = 0; i < m_uvs.size(); ++i)
         {
-            // positions, normals, and uvs should be unindexed at this point
-            assert(m_context.m_generateUnIndexedMesh);
-            assert(m_positions.size() == m_normals.size());
-            assert(m_positions.size() > 0);
-            assert(m_positions.size() % 3 == 0);
-            assert(m_normals.size() > 0);
-            assert(m_normals.size() % 3 == 0);
-
-            // Try to generate tangents and bitangents
-            bool success = false;
-            for (std::size_t i = 0; i < m_uvs.size(); ++i)
+            AZ::RHI::Format format = AZ::RHI::Format::Unknown;
+            GltfAccessorStream stream = GetUVStream(model, primitive, i, format);
+            if (!stream.IsValid())
             {
-                if (!m_uvs[i].m_buffer.empty())
-                {
-                    if (m_uvs[i].m_format == AZ::RHI::Format::R32G32_FLOAT)
-                    {
-                        AZStd::span<glm::vec2> uvs(reinterpret_cast<glm::vec2*>(m_uvs[i].m_buffer.data()), m_uvs[i].m_elementCount);
-                        success = BitangentAndTangentGenerator::Generate(m_positions, m_normals, uvs, m_tangents, m_bitangents);
-                    }
-                    else if (m_uvs[i].m_format == AZ::RHI::Format::R8G8_UNORM)
-                    {
-                        AZStd::span<glm::u8vec2> uvs(reinterpret_cast<glm::u8vec2*>(m_uvs[i].m_buffer.data()), m_uvs[i].m_elementCount);
-                        success = BitangentAndTangentGenerator::Generate(m_positions, m_normals, uvs, m_tangents, m_bitangents);
-                    }
-                    else if (m_uvs[i].m_format == AZ::RHI::Format::R16G16_UNORM)
-                    {
-                        AZStd::span<glm::u16vec2> uvs(reinterpret_cast<glm::u16vec2*>(m_uvs[i].m_buffer.data()), m_uvs[i].m_elementCount);
-                        success = BitangentAndTangentGenerator::Generate(m_positions, m_normals, uvs, m_tangents, m_bitangents);
-                    }
-                    else
-                    {
-                        // This code path should not happen since we check uv accessors before this function
-                        assert(false);
-                    }
-                }
-
-                if (success)
-                {
-                    break;
-                }
+                continue;
             }
 
-            // if we still cannot generate MikkTSpace, then we generate dummy
-            if (!success)
+            if (stream.m_count != commonAccessorViews.m_positions.m_count)
             {
-                m_tangents.resize(m_positions.size(), glm::vec4(1.0f, 0.0f, 0.0f, 1.0f));
-                m_bitangents.resize(m_positions.size(), glm::vec3(0.0f, 1.0f, 0.0f));
+                continue;
             }
 
+            m_uvs[i].m_format = format;
+            AssignAccessorToBuffer(stream, m_uvs[i]);
+        }
+    }
+
+    void GltfTrianglePrimitiveBuilder::CreateTangentsAndBitangentsAttributes(const CommonAccessorViews& commonAccessorViews)
+    {
+        if (m_context.m_generateTangent)
+        {
+            // generated tangents are remapped along with the vertices
+            assert(m_context.m_remapVertices);
+            assert(m_tangents.size() == m_vertexSources.size());
+            assert(m_bitangents.size() == m_vertexSources.size());
             return;
         }
 
         // check if tangents accessor is valid. If it is, we just copy to the buffer
-        const CesiumGltf::AccessorView<glm::vec4>& tangents = commonAccessorViews.m_tangents;
-        if ((tangents.status() == CesiumGltf::AccessorViewStatus::Valid) && (tangents.size() > 0) &&
-            (tangents.size() == commonAccessorViews.m_positions.size()))
+        const GltfAccessorStream& tangents = commonAccessorViews.m_tangents;
+        if (tangents.IsValid() && tangents.m_count == commonAccessorViews.m_positions.m_count)
         {
+            // tangents that are not remapped are packed straight into the mesh buffer, and their bitangents are created
+            // from the packed normals
+            if (!m_context.m_remapVertices)
+            {
+                return;
+            }
+
             // copy tangents to vector
-            CopyAccessorToBuffer(commonAccessorViews.m_tangents, m_tangents);
+            CopyAccessorToBuffer(tangents, m_tangents);
 
             // create bitangents
             m_bitangents.resize(m_tangents.size(), glm::vec3(0.0f));
@@ -690,12 +870,16 @@ namespace Cesium
         }
 
         // generate dummy if accessor is not valid
-        m_tangents.resize(m_positions.size(), glm::vec4(1.0f, 0.0f, 0.0f, 1.0f));
-        m_bitangents.resize(m_positions.size(), glm::vec3(0.0f, 1.0f, 0.0f));
+        std::size_t vertexCount = GetVertexCount(commonAccessorViews);
+        m_tangents.resize(vertexCount, glm::vec4(1.0f, 0.0f, 0.0f, 1.0f));
+        m_bitangents.resize(vertexCount, glm::vec3(0.0f, 1.0f, 0.0f));
     }
 
     void GltfTrianglePrimitiveBuilder::CreateCustomAttributes(
-        const CesiumGltf::Model& model, const CesiumGltf::MeshPrimitive& primitive, const GltfLoadMaterial& material)
+        const CommonAccessorViews& commonAccessorViews,
+        const CesiumGltf::Model& model,
+        const CesiumGltf::MeshPrimitive& primitive,
+        const GltfLoadMaterial& material)
     {
         m_customAttributes.reserve(material.m_customVertexAttributes.size());
         for (const auto& customAttribute : material.m_customVertexAttributes)
@@ -717,121 +901,126 @@ namespace Cesium
                 continue;
             }
 
-            switch (accessor->componentType)
+            // the format matches the accessor's components, so the elements are copied without conversion
+            GltfAccessorStream stream = GltfVertexStreamPacker::GetAccessorStream(model, *accessor);
+            if (!stream.IsValid() || stream.m_count != commonAccessorViews.m_positions.m_count)
             {
-            case CesiumGltf::AccessorSpec::ComponentType::BYTE:
-                CreateCustomAttribute<std::int8_t>(model, *accessor, customAttribute.second);
-                break;
-            case CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_BYTE:
-                CreateCustomAttribute<std::uint8_t>(model, *accessor, customAttribute.second);
-                break;
-            case CesiumGltf::AccessorSpec::ComponentType::SHORT:
-                CreateCustomAttribute<std::int16_t>(model, *accessor, customAttribute.second);
-                break;
-            case CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_SHORT:
-                CreateCustomAttribute<std::uint16_t>(model, *accessor, customAttribute.second);
-                break;
-            case CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_INT:
-                CreateCustomAttribute<std::uint32_t>(model, *accessor, customAttribute.second);
-                break;
-            case CesiumGltf::AccessorSpec::ComponentType::FLOAT:
-                CreateCustomAttribute<float>(model, *accessor, customAttribute.second);
-                break;
-            default:
-                break;
+                continue;
             }
+
+            VertexRawBuffer vertexBuffer;
+            vertexBuffer.m_format = customAttribute.second.m_format;
+            AssignAccessorToBuffer(stream, vertexBuffer);
+            m_customAttributes.emplace_back(customAttribute.second, std::move(vertexBuffer));
         }
     }
 
-    template<typename ComponentType>
-    void GltfTrianglePrimitiveBuilder::CreateCustomAttribute(
-        const CesiumGltf::Model& model, const CesiumGltf::Accessor& accessor, const GltfShaderVertexAttribute& customShaderAttribute)
+    void GltfTrianglePrimitiveBuilder::CreateCompactAttributes(
+        const CommonAccessorViews& commonAccessorViews, std::size_t vertexCount, AZ::Aabb& aabb, glm::dmat4& vertexTransform)
     {
-        if (accessor.type == CesiumGltf::AccessorSpec::Type::SCALAR)
-        {
-            CesiumGltf::AccessorView<ComponentType> accessorView{ model, accessor };
-            VertexRawBuffer vertexBuffer;
-            vertexBuffer.m_elementCount = static_cast<std::size_t>(accessorView.size());
-            vertexBuffer.m_format = customShaderAttribute.m_format;
-            CopyAccessorToBuffer(accessorView, vertexBuffer.m_buffer);
+        assert(m_context.m_compactVertexLayout);
 
-            m_customAttributes.emplace_back(customShaderAttribute, std::move(vertexBuffer));
+        // attributes that would be packed straight from the glTF buffer are unpacked, since they are encoded first
+        if (m_positions.empty())
+        {
+            m_positions.resize_no_construct(vertexCount);
+            GltfVertexStreamPacker::PackFloat(commonAccessorViews.m_positions, 3, reinterpret_cast<float*>(m_positions.data()));
         }
-        else if (accessor.type == CesiumGltf::AccessorSpec::Type::VEC2)
+
+        if (m_normals.empty())
         {
-            CesiumGltf::AccessorView<glm::vec<2, ComponentType, glm::defaultp>> accessorView{ model, accessor };
-            VertexRawBuffer vertexBuffer;
-            vertexBuffer.m_elementCount = static_cast<std::size_t>(accessorView.size());
-            vertexBuffer.m_format = customShaderAttribute.m_format;
-            CopyAccessorToBuffer(accessorView, vertexBuffer.m_buffer);
+            m_normals.resize_no_construct(vertexCount);
+            GltfVertexStreamPacker::PackFloat(commonAccessorViews.m_normals, 3, reinterpret_cast<float*>(m_normals.data()));
+        }
 
-            m_customAttributes.emplace_back(customShaderAttribute, std::move(vertexBuffer));
+        if (m_tangents.empty())
+        {
+            assert(commonAccessorViews.m_tangents.IsValid());
+            m_tangents.resize_no_construct(vertexCount);
+            GltfVertexStreamPacker::PackFloat(commonAccessorViews.m_tangents, 4, reinterpret_cast<float*>(m_tangents.data()));
         }
-        else if (accessor.type == CesiumGltf::AccessorSpec::Type::VEC3)
+
+        // positions are normalized to the mesh bounds with the same scale on every axis, so the vertex transform that
+        // restores them keeps normals and tangents valid without any decoding in the shader
+        glm::vec3 minimum{ AZStd::numeric_limits<float>::max() };
+        glm::vec3 maximum{ AZStd::numeric_limits<float>::lowest() };
+        for (const glm::vec3& position : m_positions)
         {
-            CesiumGltf::AccessorView<glm::vec<3, ComponentType, glm::defaultp>> accessorView{ model, accessor };
-            VertexRawBuffer vertexBuffer;
-            vertexBuffer.m_elementCount = static_cast<std::size_t>(accessorView.size());
-            vertexBuffer.m_format = customShaderAttribute.m_format;
-            CopyAccessorToBuffer(accessorView, vertexBuffer.m_buffer);
+            minimum = glm::min(minimum, position);
+            maximum = glm::max(maximum, position);
+        }
 
-            m_customAttributes.emplace_back(customShaderAttribute, std::move(vertexBuffer));
+        glm::vec3 extent = maximum - minimum;
+        float scale = AZStd::max(extent.x, AZStd::max(extent.y, extent.z));
+        if (!(scale > 0.0f))
+        {
+            scale = 1.0f;
         }
-        else if (accessor.type == CesiumGltf::AccessorSpec::Type::VEC4)
+
+        m_compactPositions.resize_no_construct(vertexCount * 4);
+        GltfVertexQuantizer::QuantizePositions(m_positions.data(), vertexCount, minimum, scale, m_compactPositions.data());
+        vertexTransform = glm::scale(glm::translate(glm::dmat4(1.0), glm::dvec3(minimum)), glm::dvec3(static_cast<double>(scale)));
+        aabb = AZ::Aabb::CreateFromMinMaxValues(0.0f, 0.0f, 0.0f, extent.x / scale, extent.y / scale, extent.z / scale);
+
+        m_compactNormals.resize_no_construct(vertexCount * 4);
+        GltfVertexQuantizer::EncodeNormalsAndTangents(m_normals.data(), m_tangents.data(), vertexCount, m_compactNormals.data());
+
+        for (VertexRawBuffer& uvs : m_uvs)
         {
-            CesiumGltf::AccessorView<glm::vec<4, ComponentType, glm::defaultp>> accessorView{ model, accessor };
-            VertexRawBuffer vertexBuffer;
-            vertexBuffer.m_elementCount = static_cast<std::size_t>(accessorView.size());
-            vertexBuffer.m_format = customShaderAttribute.m_format;
-            CopyAccessorToBuffer(accessorView, vertexBuffer.m_buffer);
+            CompactUVs(uvs);
+        }
 
-            m_customAttributes.emplace_back(customShaderAttribute, std::move(vertexBuffer));
+        for (VertexCustomAttribute& customAttribute : m_customAttributes)
+        {
+            CompactUVs(customAttribute.m_buffer);
         }
     }
 
-    void GltfTrianglePrimitiveBuilder::CreateFlatNormal()
+    void GltfTrianglePrimitiveBuilder::CompactUVs(VertexRawBuffer& buffer)
     {
-        m_normals.resize(m_positions.size());
-        for (std::size_t i = 0; i < m_positions.size(); i += 3)
+        // float UVs inside [0, 1] are stored as 16 bit normalized values, which are more precise than half floats near 1
+        if (buffer.m_format != AZ::RHI::Format::R32G32_FLOAT || buffer.m_elementCount == 0)
         {
-            const glm::vec3& p0 = m_positions[i];
-            const glm::vec3& p1 = m_positions[i + 1];
-            const glm::vec3& p2 = m_positions[i + 2];
-            glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
-            if (CesiumUtility::Math::equalsEpsilon(glm::dot(normal, normal), 0.0, CesiumUtility::Math::EPSILON5))
-            {
-                normal = glm::vec3(0.0f, 1.0f, 0.0f);
-            }
-            else
-            {
-                normal = glm::normalize(normal);
-            }
+            return;
+        }
 
-            m_normals[i] = normal;
-            m_normals[i + 1] = normal;
-            m_normals[i + 2] = normal;
+        AZStd::vector<glm::vec2> unpackedUVs;
+        const glm::vec2* uvs = reinterpret_cast<const glm::vec2*>(buffer.m_buffer.data());
+        if (buffer.m_buffer.empty())
+        {
+            unpackedUVs.resize_no_construct(buffer.m_elementCount);
+            GltfVertexStreamPacker::PackFloat(buffer.m_source, 2, reinterpret_cast<float*>(unpackedUVs.data()));
+            uvs = unpackedUVs.data();
         }
-    }
 
-    void GltfTrianglePrimitiveBuilder::CopySubregionBuffer(
-        AZStd::vector<std::byte>& buffer, const void* src, const AZ::RHI::BufferViewDescriptor& descriptor)
-    {
-        std::size_t offset = descriptor.m_elementOffset * descriptor.m_elementSize;
-        std::size_t totalBytes = descriptor.m_elementCount * descriptor.m_elementSize;
-        memcpy(buffer.data() + offset, src, totalBytes);
+        AZStd::vector<std::byte> compactUVs;
+        compactUVs.resize_no_construct(buffer.m_elementCount * AZ::RHI::GetFormatSize(AZ::RHI::Format::R16G16_UNORM));
+        if (!GltfVertexQuantizer::QuantizeUVs(uvs, buffer.m_elementCount, reinterpret_cast<std::uint16_t*>(compactUVs.data())))
+        {
+            return;
+        }
+
+        buffer.m_buffer = std::move(compactUVs);
+        buffer.m_source = GltfAccessorStream{};
+        buffer.m_format = AZ::RHI::Format::R16G16_UNORM;
     }
 
     void GltfTrianglePrimitiveBuilder::Reset()
     {
         m_context = LoadContext{};
+        m_indexSource = GltfAccessorStream{};
         m_indices.clear();
+        m_vertexSources.clear();
         m_positions.clear();
         m_normals.clear();
         m_tangents.clear();
         m_bitangents.clear();
+        m_compactPositions.clear();
+        m_compactNormals.clear();
         for (std::size_t i = 0; i < m_uvs.size(); ++i)
         {
             m_uvs[i].m_buffer.clear();
+            m_uvs[i].m_source = GltfAccessorStream{};
             m_uvs[i].m_elementCount = 0;
             m_uvs[i].m_format = AZ::RHI::Format::Unknown;
         }
@@ -839,12 +1028,111 @@ namespace Cesium
         m_customAttributes.clear();
     }
 
-    AZ::Aabb GltfTrianglePrimitiveBuilder::CreateAabbFromPositions(const CesiumGltf::AccessorView<glm::vec3>& positionAccessorView)
+    template<typename T>
+    GltfTrianglePrimitiveBuilder::VertexStream GltfTrianglePrimitiveBuilder::CreateVertexStream(
+        AZ::RHI::Format format, const AZStd::vector<T>& elements, const GltfAccessorStream* source, std::size_t vertexCount)
+    {
+        if (!elements.empty())
+        {
+            return VertexStream(format, elements.size(), elements.data(), nullptr);
+        }
+
+        return VertexStream(format, vertexCount, nullptr, source);
+    }
+
+    GltfTrianglePrimitiveBuilder::VertexStream GltfTrianglePrimitiveBuilder::CreateVertexStream(const VertexRawBuffer& buffer)
+    {
+        if (!buffer.m_buffer.empty())
+        {
+            return VertexStream(buffer.m_format, buffer.m_elementCount, buffer.m_buffer.data(), nullptr);
+        }
+
+        return VertexStream(buffer.m_format, buffer.m_elementCount, nullptr, &buffer.m_source);
+    }
+
+    void GltfTrianglePrimitiveBuilder::PlaceVertexStream(VertexStream& stream, std::size_t& totalBufferSize)
+    {
+        std::size_t formatSize = AZ::RHI::GetFormatSize(stream.m_format);
+        std::size_t offset = MathHelper::Align(totalBufferSize, formatSize);
+        stream.m_descriptor = AZ::RHI::BufferViewDescriptor::CreateTyped(
+            static_cast<std::uint32_t>(offset / formatSize), static_cast<std::uint32_t>(stream.m_elementCount), stream.m_format);
+        totalBufferSize = offset + stream.m_elementCount * formatSize;
+    }
+
+    void GltfTrianglePrimitiveBuilder::PackVertexStream(AZStd::vector<std::byte>& buffer, const VertexStream& stream)
+    {
+        std::byte* destination = GetVertexStreamData(buffer, stream.m_descriptor);
+        if (stream.m_data)
+        {
+            memcpy(destination, stream.m_data, stream.m_elementCount * stream.m_descriptor.m_elementSize);
+        }
+        else if (stream.m_source)
+        {
+            GltfVertexStreamPacker::Pack(*stream.m_source, stream.m_format, destination);
+        }
+    }
+
+    std::byte* GltfTrianglePrimitiveBuilder::GetVertexStreamData(
+        AZStd::vector<std::byte>& buffer, const AZ::RHI::BufferViewDescriptor& descriptor)
+    {
+        return buffer.data() + static_cast<std::size_t>(descriptor.m_elementOffset) * descriptor.m_elementSize;
+    }
+
+    bool GltfTrianglePrimitiveBuilder::PackIndexStream(
+        AZStd::vector<std::byte>& buffer, const VertexStream& stream, std::size_t vertexCount)
+    {
+        std::byte* destination = GetVertexStreamData(buffer, stream.m_descriptor);
+        if (stream.m_format == AZ::RHI::Format::R16_UINT)
+        {
+            // indices above 16 bits saturate, so they still fail the range check
+            std::uint16_t* indices = reinterpret_cast<std::uint16_t*>(destination);
+            if (stream.m_source)
+            {
+                GltfVertexStreamPacker::PackIndices(*stream.m_source, indices);
+            }
+            else
+            {
+                const std::uint32_t* sourceIndices = static_cast<const std::uint32_t*>(stream.m_data);
+                for (std::size_t i = 0; i < stream.m_elementCount; ++i)
+                {
+                    indices[i] = static_cast<std::uint16_t>(AZStd::min(sourceIndices[i], 0xFFFFu));
+                }
+            }
+
+            return AreIndicesInRange(indices, stream.m_elementCount, vertexCount);
+        }
+
+        std::uint32_t* indices = reinterpret_cast<std::uint32_t*>(destination);
+        if (stream.m_source)
+        {
+            GltfVertexStreamPacker::PackIndices(*stream.m_source, indices);
+        }
+        else
+        {
+            PackVertexStream(buffer, stream);
+        }
+
+        return AreIndicesInRange(indices, stream.m_elementCount, vertexCount);
+    }
+
+    template<typename IndexType>
+    bool GltfTrianglePrimitiveBuilder::AreIndicesInRange(const IndexType* indices, std::size_t indexCount, std::size_t vertexCount)
+    {
+        IndexType maximumIndex = 0;
+        for (std::size_t i = 0; i < indexCount; ++i)
+        {
+            maximumIndex = AZStd::max(maximumIndex, indices[i]);
+        }
+
+        return indexCount == 0 || static_cast<std::size_t>(maximumIndex) < vertexCount;
+    }
+
+    AZ::Aabb GltfTrianglePrimitiveBuilder::CreateAabbFromPositions(const glm::vec3* positions, std::size_t positionCount)
     {
         AZ::Aabb aabb = AZ::Aabb::CreateNull();
-        for (std::int64_t i = 0; i < positionAccessorView.size(); ++i)
+        for (std::size_t i = 0; i < positionCount; ++i)
         {
-            const glm::vec3& position = positionAccessorView[i];
+            const glm::vec3& position = positions[i];
             aabb.AddPoint(AZ::Vector3(position.x, position.y, position.z));
         }
 
@@ -1,7 +1,9 @@
 #pragma once
 
 #include "Cesium/Gltf/GltfLoadContext.h"
+#include "Cesium/Gltf/GltfVertexStreamPacker.h"
 #include <Atom/RHI.Reflect/Format.h>
+#include <Atom/RHI.Reflect/BufferViewDescriptor.h>
 #include <AzCore/std/containers/vector.h>
 #include <AzCore/std/containers/array.h>
 #include <glm/glm.hpp>
@@ -11,9 +13,6 @@ namespace CesiumGltf
     struct Model;
     struct Accessor;
     struct MeshPrimitive;
-
-    template<typename AccessorType>
-    class AccessorView;
 } // namespace CesiumGltf
 
 namespace AZ
@@ -43,9 +42,18 @@ namespace Cesium
         {
             LoadContext();
 
-            bool m_generateFlatNormal;
+            bool m_generateNormal;
+
+            // generated normals are smoothed across faces less than NORMAL_CREASE_ANGLE apart. Otherwise they are flat, as glTF
+            // requires for primitives without normals
+            bool m_smoothNormals;
             bool m_generateTangent;
-            bool m_generateUnIndexedMesh;
+
+            // generated attributes split some vertices, so every other attribute is gathered through m_vertexSources
+            bool m_remapVertices;
+
+            // quantized positions, octahedral normals and tangents, and normalized UVs. See GltfVertexQuantizer
+            bool m_compactVertexLayout;
         };
 
         struct VertexRawBuffer final
@@ -53,6 +61,9 @@ namespace Cesium
             VertexRawBuffer();
 
             AZStd::vector<std::byte> m_buffer;
+
+            // elements that are still in the glTF buffer when m_buffer is empty. They are packed straight into the mesh buffer
+            GltfAccessorStream m_source;
             AZ::RHI::Format m_format;
             std::size_t m_elementCount;
         };
@@ -65,28 +76,54 @@ namespace Cesium
             VertexRawBuffer m_buffer;
         };
 
+        // region of the mesh buffer and where its elements come from: either memory the builder filled, or an accessor that
+        // is packed into the region directly. A stream with neither is filled after the others are packed
+        struct VertexStream final
+        {
+            VertexStream();
+
+            VertexStream(AZ::RHI::Format format, std::size_t elementCount, const void* data, const GltfAccessorStream* source);
+
+            AZ::RHI::Format m_format;
+            std::size_t m_elementCount;
+            const void* m_data;
+            const GltfAccessorStream* m_source;
+            AZ::RHI::BufferViewDescriptor m_descriptor;
+        };
+
     public:
         void Create(
             const CesiumGltf::Model& model,
             const CesiumGltf::MeshPrimitive& primitive,
             const GltfLoadMaterial& material,
-            GltfLoadPrimitive& result);
+            bool smoothNormals,
+            GltfLoadPrimitive& result,
+            GltfLoadStatistics& statistics);
 
     private:
-        void DetermineLoadContext(const CommonAccessorViews& accessorViews, const GltfLoadMaterial& material);
+        void DetermineLoadContext(const CommonAccessorViews& accessorViews, const GltfLoadMaterial& material, bool smoothNormals);
 
-        template<typename AccessorType>
-        void CopyAccessorToBuffer(
-            const CesiumGltf::AccessorView<AccessorType>& attributeAccessorView, AZStd::vector<AccessorType>& attributes);
+        void CopyAccessorToBuffer(const GltfAccessorStream& stream, AZStd::vector<glm::vec3>& attributes);
 
-        template<typename AccessorType>
-        void CopyAccessorToBuffer(const CesiumGltf::AccessorView<AccessorType>& accessorView, AZStd::vector<std::byte>& buffer);
+        void CopyAccessorToBuffer(const GltfAccessorStream& stream, AZStd::vector<glm::vec4>& attributes);
+
+        void AssignAccessorToBuffer(const GltfAccessorStream& stream, VertexRawBuffer& buffer);
 
         bool CreateIndices(
             const CommonAccessorViews& accessorViews, const CesiumGltf::Model& model, const CesiumGltf::MeshPrimitive& primitive);
 
-        template<typename IndexType>
-        bool CreateIndices(const CesiumGltf::MeshPrimitive& primitive, const CesiumGltf::AccessorView<IndexType>& indicesAccessorView);
+        bool CreateIndices(const CesiumGltf::MeshPrimitive& primitive, const AZStd::vector<std::uint32_t>& indices);
+
+        void ExpandIndices();
+
+        void GenerateNormals(const CommonAccessorViews& commonAccessorViews);
+
+        void GenerateTangents(
+            const CommonAccessorViews& commonAccessorViews, const CesiumGltf::Model& model, const CesiumGltf::MeshPrimitive& primitive);
+
+        std::size_t GetIndexCount() const;
+
+        std::size_t GetVertexCount(const CommonAccessorViews& commonAccessorViews) const;
 
         void CreatePositionsAttribute(const CommonAccessorViews& commonAccessorViews);
 
@@ -98,30 +135,60 @@ namespace Cesium
         void CreateTangentsAndBitangentsAttributes(const CommonAccessorViews& commonAccessorViews);
 
         void CreateCustomAttributes(
-            const CesiumGltf::Model& model, const CesiumGltf::MeshPrimitive& primitive, const GltfLoadMaterial& material);
-
-        template<typename ComponentType>
-        void CreateCustomAttribute(
-            const CesiumGltf::Model& model, const CesiumGltf::Accessor& accessor, const GltfShaderVertexAttribute& customShaderAttribute);
+            const CommonAccessorViews& commonAccessorViews,
+            const CesiumGltf::Model& model,
+            const CesiumGltf::MeshPrimitive& primitive,
+            const GltfLoadMaterial& material);
 
-        void CreateFlatNormal();
+        void CreateCompactAttributes(
+            const CommonAccessorViews& commonAccessorViews, std::size_t vertexCount, AZ::Aabb& aabb, glm::dmat4& vertexTransform);
 
-        void CopySubregionBuffer(AZStd::vector<std::byte>& buffer, const void* src, const AZ::RHI::BufferViewDescriptor& descriptor);
+        static void CompactUVs(VertexRawBuffer& buffer);
 
         void Reset();
 
+        template<typename T>
+        static VertexStream CreateVertexStream(
+            AZ::RHI::Format format, const AZStd::vector<T>& elements, const GltfAccessorStream* source, std::size_t vertexCount);
+
+        static VertexStream CreateVertexStream(const VertexRawBuffer& buffer);
+
+        static void PlaceVertexStream(VertexStream& stream, std::size_t& totalBufferSize);
+
+        static void PackVertexStream(AZStd::vector<std::byte>& buffer, const VertexStream& stream);
+
+        static std::byte* GetVertexStreamData(AZStd::vector<std::byte>& buffer, const AZ::RHI::BufferViewDescriptor& descriptor);
+
+        static bool PackIndexStream(AZStd::vector<std::byte>& buffer, const VertexStream& stream, std::size_t vertexCount);
+
+        template<typename IndexType>
+        static bool AreIndicesInRange(const IndexType* indices, std::size_t indexCount, std::size_t vertexCount);
+
         static AZ::Data::Asset<AZ::RPI::BufferAsset> CreateBufferAsset(const AZStd::vector<std::byte>& buffer);
 
-        static AZ::Aabb CreateAabbFromPositions(const CesiumGltf::AccessorView<glm::vec3>& positionAccessorView);
+        static AZ::Aabb CreateAabbFromPositions(const glm::vec3* positions, std::size_t positionCount);
 
         static bool DoesRHIVertexFormatSupported(const CesiumGltf::Accessor& accessor, AZ::RHI::Format format);
 
+        // faces around a vertex that are further apart than 60 degrees keep separate generated normals
+        static constexpr float NORMAL_CREASE_ANGLE = 1.04719755f;
+
+        // meshes with at most this many vertices use 16 bit indices. 0xFFFF itself is left out since some APIs reserve it
+        // for primitive restart
+        static constexpr std::size_t MAX_16_BIT_INDEX_VERTEX_COUNT = 0xFFFF;
+
         LoadContext m_context;
+
+        // triangle list indices that are still in the glTF buffer when m_indices is empty
+        GltfAccessorStream m_indexSource;
         AZStd::vector<std::uint32_t> m_indices;
+        AZStd::vector<std::uint32_t> m_vertexSources;
         AZStd::vector<glm::vec3> m_positions;
         AZStd::vector<glm::vec3> m_normals;
         AZStd::vector<glm::vec4> m_tangents;
         AZStd::vector<glm::vec3> m_bitangents;
+        AZStd::vector<std::uint16_t> m_compactPositions;
+        AZStd::vector<std::int16_t> m_compactNormals;
         AZStd::array<VertexRawBuffer, 2> m_uvs;
         AZStd::vector<VertexCustomAttribute> m_customAttributes;
     };
@@ -0,0 +1,505 @@
+#include "Cesium/Gltf/GltfTextureCompressor.h"
+#include <AzCore/std/algorithm.h>
+#include <glm/glm.hpp>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+namespace Cesium
+{
+    namespace
+    {
+        std::uint16_t ToRGB565(const glm::vec3& color)
+        {
+            glm::vec3 clamped = glm::clamp(color, glm::vec3(0.0f), glm::vec3(255.0f));
+            std::uint32_t r = static_cast<std::uint32_t>(std::lround(clamped.r * 31.0f / 255.0f));
+            std::uint32_t g = static_cast<std::uint32_t>(std::lround(clamped.g * 63.0f / 255.0f));
+            std::uint32_t b = static_cast<std::uint32_t>(std::lround(clamped.b * 31.0f / 255.0f));
+            return static_cast<std::uint16_t>((r << 11) | (g << 5) | b);
+        }
+
+        glm::vec3 FromRGB565(std::uint16_t color)
+        {
+            std::uint32_t r = (color >> 11) & 0x1F;
+            std::uint32_t g = (color >> 5) & 0x3F;
+            std::uint32_t b = color & 0x1F;
+            return glm::vec3(
+                static_cast<float>((r << 3) | (r >> 2)), static_cast<float>((g << 2) | (g >> 4)), static_cast<float>((b << 3) | (b >> 2)));
+        }
+
+        // picks the closest palette color for every pixel and returns the squared error of the block
+        float SelectBC1Indices(const glm::vec3* colors, std::uint16_t color0, std::uint16_t color1, std::uint32_t& indices)
+        {
+            glm::vec3 palette[4];
+            palette[0] = FromRGB565(color0);
+            palette[1] = FromRGB565(color1);
+            palette[2] = (palette[0] * 2.0f + palette[1]) / 3.0f;
+            palette[3] = (palette[0] + palette[1] * 2.0f) / 3.0f;
+
+            float error = 0.0f;
+            indices = 0;
+            for (std::uint32_t i = 0; i < GltfTextureCompressor::PIXELS_PER_BLOCK; ++i)
+            {
+                std::uint32_t bestIndex = 0;
+                float bestDistance = std::numeric_limits<float>::max();
+                for (std::uint32_t p = 0; p < 4; ++p)
+                {
+                    glm::vec3 difference = colors[i] - palette[p];
+                    float distance = glm::dot(difference, difference);
+                    if (distance < bestDistance)
+                    {
+                        bestDistance = distance;
+                        bestIndex = p;
+                    }
+                }
+
+                indices |= bestIndex << (i * 2);
+                error += bestDistance;
+            }
+
+            return error;
+        }
+
+        // quantizes the endpoints in the order of the four color mode, and returns the squared error of the block
+        float QuantizeBC1Endpoints(
+            const glm::vec3* colors,
+            const glm::vec3& endpoint0,
+            const glm::vec3& endpoint1,
+            std::uint16_t& color0,
+            std::uint16_t& color1,
+            std::uint32_t& indices)
+        {
+            color0 = ToRGB565(endpoint0);
+            color1 = ToRGB565(endpoint1);
+            if (color0 < color1)
+            {
+                std::swap(color0, color1);
+            }
+
+            return SelectBC1Indices(colors, color0, color1, indices);
+        }
+
+        // solves for the endpoints with the least squared error for the selected indices
+        bool RefineBC1Endpoints(const glm::vec3* colors, std::uint32_t indices, glm::vec3& endpoint0, glm::vec3& endpoint1)
+        {
+            // weight of the first endpoint for each index
+            static constexpr float WEIGHTS[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+
+            float aa = 0.0f;
+            float ab = 0.0f;
+            float bb = 0.0f;
+            glm::vec3 ax{ 0.0f };
+            glm::vec3 bx{ 0.0f };
+            for (std::uint32_t i = 0; i < GltfTextureCompressor::PIXELS_PER_BLOCK; ++i)
+            {
+                float a = WEIGHTS[(indices >> (i * 2)) & 0x3];
+                float b = 1.0f - a;
+                aa += a * a;
+                ab += a * b;
+                bb += b * b;
+                ax += a * colors[i];
+                bx += b * colors[i];
+            }
+
+            float determinant = aa * bb - ab * ab;
+            if (std::abs(determinant) < 1e-6f)
+            {
+                return false;
+            }
+
+            endpoint0 = (ax * bb - bx * ab) / determinant;
+            endpoint1 = (bx * aa - ax * ab) / determinant;
+            return true;
+        }
+
+        void BuildBC4Palette(std::uint8_t value0, std::uint8_t value1, std::uint8_t* palette)
+        {
+            palette[0] = value0;
+            palette[1] = value1;
+            if (value0 > value1)
+            {
+                // six interpolated values
+                for (std::uint32_t i = 1; i < 7; ++i)
+                {
+                    palette[i + 1] = static_cast<std::uint8_t>(((7 - i) * value0 + i * value1 + 3) / 7);
+                }
+            }
+            else
+            {
+                // four interpolated values, then exact 0 and 255
+                for (std::uint32_t i = 1; i < 5; ++i)
+                {
+                    palette[i + 1] = static_cast<std::uint8_t>(((5 - i) * value0 + i * value1 + 2) / 5);
+                }
+
+                palette[6] = 0;
+                palette[7] = 255;
+            }
+        }
+
+        // picks the closest palette value for every pixel and returns the squared error of the block
+        std::uint32_t SelectBC4Indices(const std::uint8_t* values, const std::uint8_t* palette, std::uint64_t& indices)
+        {
+            std::uint32_t error = 0;
+            indices = 0;
+            for (std::uint32_t i = 0; i < GltfTextureCompressor::PIXELS_PER_BLOCK; ++i)
+            {
+                std::uint64_t bestIndex = 0;
+                std::uint32_t bestDistance = std::numeric_limits<std::uint32_t>::max();
+                for (std::uint32_t p = 0; p < 8; ++p)
+                {
+                    std::int32_t difference = static_cast<std::int32_t>(values[i]) - static_cast<std::int32_t>(palette[p]);
+                    std::uint32_t distance = static_cast<std::uint32_t>(difference * difference);
+                    if (distance < bestDistance)
+                    {
+                        bestDistance = distance;
+                        bestIndex = p;
+                    }
+                }
+
+                indices |= bestIndex << (i * 3);
+                error += bestDistance;
+            }
+
+            return error;
+        }
+
+        // copies a 4x4 block, repeating the last row and column for the partial blocks of mips smaller than a block
+        void GatherBlock(
+            const std::uint8_t* pixels,
+            std::uint32_t width,
+            std::uint32_t height,
+            std::uint32_t blockX,
+            std::uint32_t blockY,
+            std::uint32_t bytesPerPixel,
+            std::uint8_t* block)
+        {
+            for (std::uint32_t row = 0; row < GltfTextureCompressor::BLOCK_DIMENSION; ++row)
+            {
+                std::size_t y = AZStd::min(blockY * GltfTextureCompressor::BLOCK_DIMENSION + row, height - 1);
+                for (std::uint32_t column = 0; column < GltfTextureCompressor::BLOCK_DIMENSION; ++column)
+                {
+                    std::size_t x = AZStd::min(blockX * GltfTextureCompressor::BLOCK_DIMENSION + column, width - 1);
+                    std::memcpy(
+                        block + (row * GltfTextureCompressor::BLOCK_DIMENSION + column) * bytesPerPixel,
+                        pixels + (y * width + x) * bytesPerPixel,
+                        bytesPerPixel);
+                }
+            }
+        }
+
+        std::size_t GetCompressedSize(std::uint32_t width, std::uint32_t height, std::size_t blockBytes)
+        {
+            std::size_t blocksX = (width + GltfTextureCompressor::BLOCK_DIMENSION - 1) / GltfTextureCompressor::BLOCK_DIMENSION;
+            std::size_t blocksY = (height + GltfTextureCompressor::BLOCK_DIMENSION - 1) / GltfTextureCompressor::BLOCK_DIMENSION;
+            return blocksX * blocksY * blockBytes;
+        }
+
+        // lays out the compressed mips one after another, and sizes result to hold them all
+        AZStd::vector<GltfImageMip> AllocateCompressedMips(
+            const AZStd::vector<GltfImageMip>& mips, std::size_t blockBytes, AZStd::vector<std::byte>& result)
+        {
+            AZStd::vector<GltfImageMip> compressedMips;
+            compressedMips.reserve(mips.size());
+            std::size_t byteOffset = 0;
+            for (const GltfImageMip& mip : mips)
+            {
+                std::size_t byteSize = GetCompressedSize(mip.m_width, mip.m_height, blockBytes);
+                compressedMips.push_back(GltfImageMip{ byteOffset, byteSize, mip.m_width, mip.m_height });
+                byteOffset += byteSize;
+            }
+
+            result.resize(byteOffset);
+            return compressedMips;
+        }
+
+        void CompressRGBALevel(
+            const std::uint8_t* source, std::uint32_t width, std::uint32_t height, bool opaque, bool refine, std::uint8_t* destination)
+        {
+            std::uint32_t blocksX = (width + GltfTextureCompressor::BLOCK_DIMENSION - 1) / GltfTextureCompressor::BLOCK_DIMENSION;
+            std::uint32_t blocksY = (height + GltfTextureCompressor::BLOCK_DIMENSION - 1) / GltfTextureCompressor::BLOCK_DIMENSION;
+            std::uint8_t blockPixels[GltfTextureCompressor::PIXELS_PER_BLOCK * 4];
+            std::uint8_t blockAlpha[GltfTextureCompressor::PIXELS_PER_BLOCK];
+            for (std::uint32_t blockY = 0; blockY < blocksY; ++blockY)
+            {
+                for (std::uint32_t blockX = 0; blockX < blocksX; ++blockX)
+                {
+                    GatherBlock(source, width, height, blockX, blockY, 4, blockPixels);
+                    if (!opaque)
+                    {
+                        for (std::uint32_t i = 0; i < GltfTextureCompressor::PIXELS_PER_BLOCK; ++i)
+                        {
+                            blockAlpha[i] = blockPixels[i * 4 + 3];
+                        }
+
+                        GltfTextureCompressor::EncodeBC4Block(blockAlpha, refine, destination);
+                        destination += GltfTextureCompressor::BC4_BLOCK_BYTES;
+                    }
+
+                    GltfTextureCompressor::EncodeBC1Block(blockPixels, refine, destination);
+                    destination += GltfTextureCompressor::BC1_BLOCK_BYTES;
+                }
+            }
+        }
+
+        void CompressRLevel(const std::uint8_t* source, std::uint32_t width, std::uint32_t height, bool refine, std::uint8_t* destination)
+        {
+            std::uint32_t blocksX = (width + GltfTextureCompressor::BLOCK_DIMENSION - 1) / GltfTextureCompressor::BLOCK_DIMENSION;
+            std::uint32_t blocksY = (height + GltfTextureCompressor::BLOCK_DIMENSION - 1) / GltfTextureCompressor::BLOCK_DIMENSION;
+            std::uint8_t blockValues[GltfTextureCompressor::PIXELS_PER_BLOCK];
+            for (std::uint32_t blockY = 0; blockY < blocksY; ++blockY)
+            {
+                for (std::uint32_t blockX = 0; blockX < blocksX; ++blockX)
+                {
+                    GatherBlock(source, width, height, blockX, blockY, 1, blockValues);
+                    GltfTextureCompressor::EncodeBC4Block(blockValues, refine, destination);
+                    destination += GltfTextureCompressor::BC4_BLOCK_BYTES;
+                }
+            }
+        }
+    } // namespace
+
+    bool GltfTextureCompressor::CanCompress(std::uint32_t width, std::uint32_t height)
+    {
+        return width > 0 && height > 0 && width % BLOCK_DIMENSION == 0 && height % BLOCK_DIMENSION == 0;
+    }
+
+    bool GltfTextureCompressor::CompressRGBA(
+        const std::byte* pixels,
+        std::uint32_t width,
+        std::uint32_t height,
+        GltfTextureCompression compression,
+        AZStd::vector<std::byte>& result,
+        AZ::RHI::Format& format)
+    {
+        AZStd::vector<GltfImageMip> mips{ GltfImageMip{ 0, static_cast<std::size_t>(width) * height * 4, width, height } };
+        AZStd::vector<GltfImageMip> compressedMips;
+        return CompressRGBA(pixels, mips, compression, true, result, compressedMips, format);
+    }
+
+    bool GltfTextureCompressor::CompressRGBA(
+        const std::byte* pixels,
+        const AZStd::vector<GltfImageMip>& mips,
+        GltfTextureCompression compression,
+        bool srgb,
+        AZStd::vector<std::byte>& result,
+        AZStd::vector<GltfImageMip>& resultMips,
+        AZ::RHI::Format& format)
+    {
+        if (compression == GltfTextureCompression::None || mips.empty() || !CanCompress(mips[0].m_width, mips[0].m_height))
+        {
+            return false;
+        }
+
+        // the mips below are averages of the top one, so they are opaque whenever it is
+        const std::uint8_t* source = reinterpret_cast<const std::uint8_t*>(pixels);
+        std::size_t pixelCount = static_cast<std::size_t>(mips[0].m_width) * mips[0].m_height;
+        bool opaque = true;
+        for (std::size_t i = 0; i < pixelCount; ++i)
+        {
+            if (source[mips[0].m_byteOffset + i * 4 + 3] != 255)
+            {
+                opaque = false;
+                break;
+            }
+        }
+
+        bool refine = compression == GltfTextureCompression::Quality;
+        resultMips = AllocateCompressedMips(mips, opaque ? BC1_BLOCK_BYTES : BC3_BLOCK_BYTES, result);
+        std::uint8_t* destination = reinterpret_cast<std::uint8_t*>(result.data());
+        for (std::size_t mip = 0; mip < mips.size(); ++mip)
+        {
+            CompressRGBALevel(
+                source + mips[mip].m_byteOffset, mips[mip].m_width, mips[mip].m_height, opaque, refine,
+                destination + resultMips[mip].m_byteOffset);
+        }
+
+        if (srgb)
+        {
+            format = opaque ? AZ::RHI::Format::BC1_UNORM_SRGB : AZ::RHI::Format::BC3_UNORM_SRGB;
+        }
+        else
+        {
+            format = opaque ? AZ::RHI::Format::BC1_UNORM : AZ::RHI::Format::BC3_UNORM;
+        }
+
+        return true;
+    }
+
+    bool GltfTextureCompressor::CompressR(
+        const std::byte* pixels,
+        std::uint32_t width,
+        std::uint32_t height,
+        GltfTextureCompression compression,
+        AZStd::vector<std::byte>& result,
+        AZ::RHI::Format& format)
+    {
+        AZStd::vector<GltfImageMip> mips{ GltfImageMip{ 0, static_cast<std::size_t>(width) * height, width, height } };
+        AZStd::vector<GltfImageMip> compressedMips;
+        return CompressR(pixels, mips, compression, result, compressedMips, format);
+    }
+
+    bool GltfTextureCompressor::CompressR(
+        const std::byte* pixels,
+        const AZStd::vector<GltfImageMip>& mips,
+        GltfTextureCompression compression,
+        AZStd::vector<std::byte>& result,
+        AZStd::vector<GltfImageMip>& resultMips,
+        AZ::RHI::Format& format)
+    {
+        if (compression == GltfTextureCompression::None || mips.empty() || !CanCompress(mips[0].m_width, mips[0].m_height))
+        {
+            return false;
+        }
+
+        const std::uint8_t* source = reinterpret_cast<const std::uint8_t*>(pixels);
+        bool refine = compression == GltfTextureCompression::Quality;
+        resultMips = AllocateCompressedMips(mips, BC4_BLOCK_BYTES, result);
+        std::uint8_t* destination = reinterpret_cast<std::uint8_t*>(result.data());
+        for (std::size_t mip = 0; mip < mips.size(); ++mip)
+        {
+            CompressRLevel(
+                source + mips[mip].m_byteOffset, mips[mip].m_width, mips[mip].m_height, refine, destination + resultMips[mip].m_byteOffset);
+        }
+
+        format = AZ::RHI::Format::BC4_UNORM;
+        return true;
+    }
+
+    void GltfTextureCompressor::EncodeBC1Block(const std::uint8_t* rgba, bool refine, std::uint8_t* block)
+    {
+        glm::vec3 colors[PIXELS_PER_BLOCK];
+        glm::vec3 minimum{ 255.0f };
+        glm::vec3 maximum{ 0.0f };
+        glm::vec3 mean{ 0.0f };
+        for (std::uint32_t i = 0; i < PIXELS_PER_BLOCK; ++i)
+        {
+            colors[i] = glm::vec3(rgba[i * 4], rgba[i * 4 + 1], rgba[i * 4 + 2]);
+            minimum = glm::min(minimum, colors[i]);
+            maximum = glm::max(maximum, colors[i]);
+            mean += colors[i];
+        }
+
+        mean /= static_cast<float>(PIXELS_PER_BLOCK);
+
+        glm::vec3 endpoint0;
+        glm::vec3 endpoint1;
+        if (!refine)
+        {
+            endpoint0 = maximum;
+            endpoint1 = minimum;
+        }
+        else
+        {
+            // principal axis of the colors by power iteration over their covariance
+            glm::mat3 covariance{ 0.0f };
+            for (std::uint32_t i = 0; i < PIXELS_PER_BLOCK; ++i)
+            {
+                glm::vec3 difference = colors[i] - mean;
+                covariance += glm::outerProduct(difference, difference);
+            }
+
+            glm::vec3 axis = maximum - minimum;
+            for (std::uint32_t iteration = 0; iteration < 8; ++iteration)
+            {
+                axis = covariance * axis;
+                float length = glm::length(axis);
+                if (length < 1e-6f)
+                {
+                    axis = glm::vec3{ 0.0f };
+                    break;
+                }
+
+                axis /= length;
+            }
+
+            float minimumProjection = 0.0f;
+            float maximumProjection = 0.0f;
+            for (std::uint32_t i = 0; i < PIXELS_PER_BLOCK; ++i)
+            {
+                float projection = glm::dot(colors[i] - mean, axis);
+                minimumProjection = glm::min(minimumProjection, projection);
+                maximumProjection = glm::max(maximumProjection, projection);
+            }
+
+            endpoint0 = mean + axis * maximumProjection;
+            endpoint1 = mean + axis * minimumProjection;
+        }
+
+        std::uint16_t color0 = 0;
+        std::uint16_t color1 = 0;
+        std::uint32_t indices = 0;
+        float error = QuantizeBC1Endpoints(colors, endpoint0, endpoint1, color0, color1, indices);
+        if (refine && RefineBC1Endpoints(colors, indices, endpoint0, endpoint1))
+        {
+            std::uint16_t refinedColor0 = 0;
+            std::uint16_t refinedColor1 = 0;
+            std::uint32_t refinedIndices = 0;
+            float refinedError = QuantizeBC1Endpoints(colors, endpoint0, endpoint1, refinedColor0, refinedColor1, refinedIndices);
+            if (refinedError < error)
+            {
+                color0 = refinedColor0;
+                color1 = refinedColor1;
+                indices = refinedIndices;
+            }
+        }
+
+        block[0] = static_cast<std::uint8_t>(color0 & 0xFF);
+        block[1] = static_cast<std::uint8_t>(color0 >> 8);
+        block[2] = static_cast<std::uint8_t>(color1 & 0xFF);
+        block[3] = static_cast<std::uint8_t>(color1 >> 8);
+        for (std::uint32_t i = 0; i < 4; ++i)
+        {
+            block[4 + i] = static_cast<std::uint8_t>((indices >> (i * 8)) & 0xFF);
+        }
+    }
+
+    void GltfTextureCompressor::EncodeBC4Block(const std::uint8_t* values, bool refine, std::uint8_t* block)
+    {
+        std::uint8_t minimum = 255;
+        std::uint8_t maximum = 0;
+        std::uint8_t interiorMinimum = 255;
+        std::uint8_t interiorMaximum = 0;
+        for (std::uint32_t i = 0; i < PIXELS_PER_BLOCK; ++i)
+        {
+            minimum = AZStd::min(minimum, values[i]);
+            maximum = AZStd::max(maximum, values[i]);
+            if (values[i] != 0 && values[i] != 255)
+            {
+                interiorMinimum = AZStd::min(interiorMinimum, values[i]);
+                interiorMaximum = AZStd::max(interiorMaximum, values[i]);
+            }
+        }
+
+        // the six interpolated values mode spans the whole range
+        std::uint8_t value0 = maximum;
+        std::uint8_t value1 = minimum;
+        std::uint8_t palette[8];
+        std::uint64_t indices = 0;
+        BuildBC4Palette(value0, value1, palette);
+        std::uint32_t error = SelectBC4Indices(values, palette, indices);
+
+        // the other mode has exact 0 and 255, so its four interpolated values only have to span the rest
+        bool hasExtremes = minimum == 0 || maximum == 255;
+        if (refine && hasExtremes && interiorMinimum <= interiorMaximum)
+        {
+            std::uint64_t extremeIndices = 0;
+            BuildBC4Palette(interiorMinimum, interiorMaximum, palette);
+            std::uint32_t extremeError = SelectBC4Indices(values, palette, extremeIndices);
+            if (extremeError < error)
+            {
+                value0 = interiorMinimum;
+                value1 = interiorMaximum;
+                indices = extremeIndices;
+            }
+        }
+
+        block[0] = value0;
+        block[1] = value1;
+        for (std::uint32_t i = 0; i < 6; ++i)
+        {
+            block[2 + i] = static_cast<std::uint8_t>((indices >> (i * 8)) & 0xFF);
+        }
+    }
+} // namespace Cesium
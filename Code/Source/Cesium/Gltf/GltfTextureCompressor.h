@@ -0,0 +1,83 @@
+#pragma once
+
+#include "Cesium/Gltf/GltfMipGenerator.h"
+#include <Atom/RHI.Reflect/Format.h>
+#include <AzCore/std/containers/vector.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace Cesium
+{
+    enum class GltfTextureCompression
+    {
+        // upload textures uncompressed
+        None,
+
+        // endpoints from the bounding box of each block
+        Fast,
+
+        // endpoints along the principal axis of each block, refined by least squares
+        Quality
+    };
+
+    // Block compression of 8 bit textures into BCn formats on the CPU. Every 4x4 block is encoded on its own, and since the
+    // top mip of a block compressed image must be made of whole blocks, only images whose dimensions are multiples of 4
+    // are compressed. The mips below may end in partial blocks, which repeat their last row and column
+    class GltfTextureCompressor final
+    {
+    public:
+        static constexpr std::uint32_t BLOCK_DIMENSION = 4;
+        static constexpr std::uint32_t PIXELS_PER_BLOCK = BLOCK_DIMENSION * BLOCK_DIMENSION;
+        static constexpr std::size_t BC1_BLOCK_BYTES = 8;
+        static constexpr std::size_t BC3_BLOCK_BYTES = 16;
+        static constexpr std::size_t BC4_BLOCK_BYTES = 8;
+
+        static bool CanCompress(std::uint32_t width, std::uint32_t height);
+
+        // compresses sRGB encoded RGBA pixels into BC1 when every pixel is opaque and into BC3 otherwise. Returns false
+        // and leaves result untouched when the image cannot be compressed
+        static bool CompressRGBA(
+            const std::byte* pixels,
+            std::uint32_t width,
+            std::uint32_t height,
+            GltfTextureCompression compression,
+            AZStd::vector<std::byte>& result,
+            AZ::RHI::Format& format);
+
+        // compresses every mip of pixels, and lays them out in result as described by resultMips. Pixels that are not
+        // sRGB encoded, like packed material channels, get the UNORM variant of the format
+        static bool CompressRGBA(
+            const std::byte* pixels,
+            const AZStd::vector<GltfImageMip>& mips,
+            GltfTextureCompression compression,
+            bool srgb,
+            AZStd::vector<std::byte>& result,
+            AZStd::vector<GltfImageMip>& resultMips,
+            AZ::RHI::Format& format);
+
+        // compresses a single 8 bit channel into BC4. Returns false and leaves result untouched when the image cannot be
+        // compressed
+        static bool CompressR(
+            const std::byte* pixels,
+            std::uint32_t width,
+            std::uint32_t height,
+            GltfTextureCompression compression,
+            AZStd::vector<std::byte>& result,
+            AZ::RHI::Format& format);
+
+        static bool CompressR(
+            const std::byte* pixels,
+            const AZStd::vector<GltfImageMip>& mips,
+            GltfTextureCompression compression,
+            AZStd::vector<std::byte>& result,
+            AZStd::vector<GltfImageMip>& resultMips,
+            AZ::RHI::Format& format);
+
+        // encodes the RGB of 16 RGBA pixels in row order into a BC1 block. The block always uses the four color mode, so
+        // it is also valid as the color half of a BC3 block
+        static void EncodeBC1Block(const std::uint8_t* rgba, bool refine, std::uint8_t* block);
+
+        // encodes 16 values in row order into a BC4 block. BC3 stores its alpha the same way
+        static void EncodeBC4Block(const std::uint8_t* values, bool refine, std::uint8_t* block);
+    };
+} // namespace Cesium
@@ -0,0 +1,91 @@
+#include "Cesium/Gltf/GltfVertexQuantizer.h"
+#include <AzCore/std/algorithm.h>
+#include <cmath>
+
+namespace Cesium
+{
+    void GltfVertexQuantizer::QuantizePositions(
+        const glm::vec3* positions, std::size_t count, const glm::vec3& minimum, float scale, std::uint16_t* destination)
+    {
+        float inverseScale = scale > 0.0f ? 1.0f / scale : 0.0f;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            glm::vec3 normalized = (positions[i] - minimum) * inverseScale;
+            destination[i * 4] = ToUnorm16(normalized.x);
+            destination[i * 4 + 1] = ToUnorm16(normalized.y);
+            destination[i * 4 + 2] = ToUnorm16(normalized.z);
+            destination[i * 4 + 3] = 0;
+        }
+    }
+
+    void GltfVertexQuantizer::EncodeNormalsAndTangents(
+        const glm::vec3* normals, const glm::vec4* tangents, std::size_t count, std::int16_t* destination)
+    {
+        // the remapped tangent y never reaches 0, so the bitangent sign survives even when y is -1
+        static constexpr float MINIMUM_MAGNITUDE = 1.0f / 32767.0f;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            glm::vec2 normal = EncodeOctahedron(normals[i]);
+            glm::vec2 tangent = EncodeOctahedron(glm::vec3(tangents[i]));
+            float bitangentSign = tangents[i].w < 0.0f ? -1.0f : 1.0f;
+            destination[i * 4] = ToSnorm16(normal.x);
+            destination[i * 4 + 1] = ToSnorm16(normal.y);
+            destination[i * 4 + 2] = ToSnorm16(tangent.x);
+            destination[i * 4 + 3] = ToSnorm16(bitangentSign * AZStd::max((tangent.y + 1.0f) * 0.5f, MINIMUM_MAGNITUDE));
+        }
+    }
+
+    bool GltfVertexQuantizer::QuantizeUVs(const glm::vec2* uvs, std::size_t count, std::uint16_t* destination)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const glm::vec2& uv = uvs[i];
+            if (!(uv.x >= 0.0f && uv.x <= 1.0f && uv.y >= 0.0f && uv.y <= 1.0f))
+            {
+                return false;
+            }
+
+            destination[i * 2] = ToUnorm16(uv.x);
+            destination[i * 2 + 1] = ToUnorm16(uv.y);
+        }
+
+        return true;
+    }
+
+    glm::vec2 GltfVertexQuantizer::EncodeOctahedron(const glm::vec3& direction)
+    {
+        float length = std::abs(direction.x) + std::abs(direction.y) + std::abs(direction.z);
+        if (length == 0.0f)
+        {
+            return glm::vec2(0.0f);
+        }
+
+        glm::vec2 projected = glm::vec2(direction) / length;
+        if (direction.z < 0.0f)
+        {
+            glm::vec2 signs(projected.x >= 0.0f ? 1.0f : -1.0f, projected.y >= 0.0f ? 1.0f : -1.0f);
+            projected = (glm::vec2(1.0f) - glm::abs(glm::vec2(projected.y, projected.x))) * signs;
+        }
+
+        return projected;
+    }
+
+    glm::vec3 GltfVertexQuantizer::DecodeOctahedron(const glm::vec2& encoded)
+    {
+        glm::vec3 direction(encoded.x, encoded.y, 1.0f - std::abs(encoded.x) - std::abs(encoded.y));
+        float fold = AZStd::max(-direction.z, 0.0f);
+        direction.x += direction.x >= 0.0f ? -fold : fold;
+        direction.y += direction.y >= 0.0f ? -fold : fold;
+        return glm::normalize(direction);
+    }
+
+    std::uint16_t GltfVertexQuantizer::ToUnorm16(float value)
+    {
+        return static_cast<std::uint16_t>(std::lround(AZStd::clamp(value, 0.0f, 1.0f) * 65535.0f));
+    }
+
+    std::int16_t GltfVertexQuantizer::ToSnorm16(float value)
+    {
+        return static_cast<std::int16_t>(std::lround(AZStd::clamp(value, -1.0f, 1.0f) * 32767.0f));
+    }
+} // namespace Cesium
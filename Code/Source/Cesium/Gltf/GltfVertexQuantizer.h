@@ -0,0 +1,38 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace Cesium
+{
+    // Encodes vertex attributes into the compact vertex layout of the GltfStandardPBR material type. The shader decodes
+    // normals and tangents in CompactVertexLayout.azsli, so the encodings here and there must stay in sync
+    class GltfVertexQuantizer final
+    {
+    public:
+        // writes each position as four 16 bit unsigned normalized components: (position - minimum) / scale, and 0 in the
+        // fourth component. Positions are expected to be inside [minimum, minimum + scale] on every axis
+        static void QuantizePositions(
+            const glm::vec3* positions, std::size_t count, const glm::vec3& minimum, float scale, std::uint16_t* destination);
+
+        // writes each vertex as four 16 bit signed normalized components: the octahedral normal, the x of the octahedral
+        // tangent, and the y of the octahedral tangent remapped to [0, 1] with the sign of the bitangent
+        static void EncodeNormalsAndTangents(
+            const glm::vec3* normals, const glm::vec4* tangents, std::size_t count, std::int16_t* destination);
+
+        // writes each UV as two 16 bit unsigned normalized components. Returns false without finishing when a UV is
+        // outside [0, 1], since those cannot be normalized
+        static bool QuantizeUVs(const glm::vec2* uvs, std::size_t count, std::uint16_t* destination);
+
+        // maps a unit vector onto the [-1, 1] square of an octahedron unfolded along its lower half
+        static glm::vec2 EncodeOctahedron(const glm::vec3& direction);
+
+        static glm::vec3 DecodeOctahedron(const glm::vec2& encoded);
+
+    private:
+        static std::uint16_t ToUnorm16(float value);
+
+        static std::int16_t ToSnorm16(float value);
+    };
+} // namespace Cesium
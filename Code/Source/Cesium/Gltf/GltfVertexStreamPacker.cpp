@@ -0,0 +1,503 @@
+#include "Cesium/Gltf/GltfVertexStreamPacker.h"
+#include <AzCore/base.h>
+#include <AzCore/Debug/Trace.h>
+#include <AzCore/std/algorithm.h>
+
+// Window 10 wingdi.h header defines OPAQUE macro which mess up with CesiumGltf::Material::AlphaMode::OPAQUE.
+// This only happens with unity build
+#include <AzCore/PlatformDef.h>
+#ifdef AZ_COMPILER_MSVC
+#pragma push_macro("OPAQUE")
+#undef OPAQUE
+#endif
+
+#include <CesiumGltf/Model.h>
+#include <CesiumGltf/Accessor.h>
+
+#ifdef AZ_COMPILER_MSVC
+#pragma pop_macro("OPAQUE")
+#endif
+
+#if AZ_TRAIT_USE_PLATFORM_SIMD_SSE
+#include <emmintrin.h>
+#endif
+
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace Cesium
+{
+    namespace
+    {
+        template<typename ComponentType>
+        float ConvertComponent(ComponentType value, bool normalized)
+        {
+            if constexpr (std::is_floating_point_v<ComponentType>)
+            {
+                AZ_UNUSED(normalized);
+                return static_cast<float>(value);
+            }
+            else
+            {
+                if (!normalized)
+                {
+                    return static_cast<float>(value);
+                }
+
+                // glTF maps the smallest signed value to -1 as well, so both -127 and -128 are -1
+                constexpr float scale = 1.0f / static_cast<float>(std::numeric_limits<ComponentType>::max());
+                return AZStd::max(static_cast<float>(value) * scale, -1.0f);
+            }
+        }
+
+#if AZ_TRAIT_USE_PLATFORM_SIMD_SSE
+        void StoreConverted(__m128i low, __m128i high, float* destination, __m128 scale, bool normalized)
+        {
+            __m128 lowFloats = _mm_cvtepi32_ps(low);
+            __m128 highFloats = _mm_cvtepi32_ps(high);
+            if (normalized)
+            {
+                const __m128 minimum = _mm_set1_ps(-1.0f);
+                lowFloats = _mm_max_ps(_mm_mul_ps(lowFloats, scale), minimum);
+                highFloats = _mm_max_ps(_mm_mul_ps(highFloats, scale), minimum);
+            }
+
+            _mm_storeu_ps(destination, lowFloats);
+            _mm_storeu_ps(destination + 4, highFloats);
+        }
+
+        // the SIMD kernels convert as many components as fill whole registers and return how many they converted.
+        // The scalar loop finishes the rest
+        std::size_t ConvertComponentsSimd(const std::uint8_t* source, std::size_t count, float* destination, bool normalized)
+        {
+            const __m128i zero = _mm_setzero_si128();
+            const __m128 scale = _mm_set1_ps(1.0f / 255.0f);
+            std::size_t i = 0;
+            for (; i + 16 <= count; i += 16)
+            {
+                __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+                __m128i low = _mm_unpacklo_epi8(bytes, zero);
+                __m128i high = _mm_unpackhi_epi8(bytes, zero);
+                StoreConverted(_mm_unpacklo_epi16(low, zero), _mm_unpackhi_epi16(low, zero), destination + i, scale, normalized);
+                StoreConverted(_mm_unpacklo_epi16(high, zero), _mm_unpackhi_epi16(high, zero), destination + i + 8, scale, normalized);
+            }
+
+            return i;
+        }
+
+        std::size_t ConvertComponentsSimd(const std::int8_t* source, std::size_t count, float* destination, bool normalized)
+        {
+            const __m128 scale = _mm_set1_ps(1.0f / 127.0f);
+            std::size_t i = 0;
+            for (; i + 16 <= count; i += 16)
+            {
+                // sign extend by placing each byte in the upper half of a wider lane and shifting it back down
+                __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+                __m128i low = _mm_srai_epi16(_mm_unpacklo_epi8(bytes, bytes), 8);
+                __m128i high = _mm_srai_epi16(_mm_unpackhi_epi8(bytes, bytes), 8);
+                StoreConverted(
+                    _mm_srai_epi32(_mm_unpacklo_epi16(low, low), 16), _mm_srai_epi32(_mm_unpackhi_epi16(low, low), 16), destination + i,
+                    scale, normalized);
+                StoreConverted(
+                    _mm_srai_epi32(_mm_unpacklo_epi16(high, high), 16), _mm_srai_epi32(_mm_unpackhi_epi16(high, high), 16),
+                    destination + i + 8, scale, normalized);
+            }
+
+            return i;
+        }
+
+        std::size_t ConvertComponentsSimd(const std::uint16_t* source, std::size_t count, float* destination, bool normalized)
+        {
+            const __m128i zero = _mm_setzero_si128();
+            const __m128 scale = _mm_set1_ps(1.0f / 65535.0f);
+            std::size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                __m128i shorts = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+                StoreConverted(_mm_unpacklo_epi16(shorts, zero), _mm_unpackhi_epi16(shorts, zero), destination + i, scale, normalized);
+            }
+
+            return i;
+        }
+
+        std::size_t ConvertComponentsSimd(const std::int16_t* source, std::size_t count, float* destination, bool normalized)
+        {
+            const __m128 scale = _mm_set1_ps(1.0f / 32767.0f);
+            std::size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                __m128i shorts = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+                StoreConverted(
+                    _mm_srai_epi32(_mm_unpacklo_epi16(shorts, shorts), 16), _mm_srai_epi32(_mm_unpackhi_epi16(shorts, shorts), 16),
+                    destination + i, scale, normalized);
+            }
+
+            return i;
+        }
+
+        std::size_t WidenIndicesSimd(const std::uint8_t* source, std::size_t count, std::uint32_t* destination)
+        {
+            const __m128i zero = _mm_setzero_si128();
+            std::size_t i = 0;
+            for (; i + 16 <= count; i += 16)
+            {
+                __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+                __m128i low = _mm_unpacklo_epi8(bytes, zero);
+                __m128i high = _mm_unpackhi_epi8(bytes, zero);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_unpacklo_epi16(low, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i + 4), _mm_unpackhi_epi16(low, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i + 8), _mm_unpacklo_epi16(high, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i + 12), _mm_unpackhi_epi16(high, zero));
+            }
+
+            return i;
+        }
+
+        std::size_t WidenIndicesSimd(const std::uint16_t* source, std::size_t count, std::uint32_t* destination)
+        {
+            const __m128i zero = _mm_setzero_si128();
+            std::size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                __m128i shorts = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_unpacklo_epi16(shorts, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i + 4), _mm_unpackhi_epi16(shorts, zero));
+            }
+
+            return i;
+        }
+#endif
+
+        // converts tightly packed components, so a stream of count elements is count * componentCount components
+        template<typename ComponentType>
+        void ConvertComponents(const std::byte* source, std::size_t count, float* destination, bool normalized)
+        {
+            std::size_t i = 0;
+#if AZ_TRAIT_USE_PLATFORM_SIMD_SSE
+            i = ConvertComponentsSimd(reinterpret_cast<const ComponentType*>(source), count, destination, normalized);
+#endif
+            for (; i < count; ++i)
+            {
+                ComponentType value;
+                memcpy(&value, source + i * sizeof(ComponentType), sizeof(ComponentType));
+                destination[i] = ConvertComponent(value, normalized);
+            }
+        }
+
+        template<typename ComponentType>
+        void ConvertElements(
+            const GltfAccessorStream& stream,
+            std::uint32_t componentCount,
+            float* destination,
+            const std::uint32_t* indices,
+            std::size_t elementCount)
+        {
+            std::uint32_t sourceComponentCount = AZStd::min(stream.m_componentCount, componentCount);
+            for (std::size_t i = 0; i < elementCount; ++i)
+            {
+                std::size_t elementIndex = indices ? indices[i] : i;
+                const std::byte* element = stream.m_data + elementIndex * stream.m_stride;
+                float* output = destination + i * componentCount;
+                for (std::uint32_t component = 0; component < sourceComponentCount; ++component)
+                {
+                    ComponentType value;
+                    memcpy(&value, element + component * sizeof(ComponentType), sizeof(ComponentType));
+                    output[component] = ConvertComponent(value, stream.m_normalized);
+                }
+
+                for (std::uint32_t component = sourceComponentCount; component < componentCount; ++component)
+                {
+                    output[component] = component == 3 ? 1.0f : 0.0f;
+                }
+            }
+        }
+
+        template<typename ComponentType>
+        void PackFloatElements(
+            const GltfAccessorStream& stream,
+            std::uint32_t componentCount,
+            float* destination,
+            const std::uint32_t* indices,
+            std::size_t elementCount)
+        {
+            bool isTightlyPacked = stream.m_stride == stream.GetElementSize();
+            if (!indices && isTightlyPacked && stream.m_componentCount == componentCount)
+            {
+                ConvertComponents<ComponentType>(stream.m_data, elementCount * componentCount, destination, stream.m_normalized);
+            }
+            else
+            {
+                ConvertElements<ComponentType>(stream, componentCount, destination, indices, elementCount);
+            }
+        }
+
+        // a copy with a size known at compile time is a couple of moves instead of a call to memcpy
+        template<std::size_t ElementSize>
+        void CopyElements(
+            const std::byte* source, std::size_t stride, std::byte* destination, const std::uint32_t* indices, std::size_t elementCount)
+        {
+            for (std::size_t i = 0; i < elementCount; ++i)
+            {
+                std::size_t elementIndex = indices ? indices[i] : i;
+                memcpy(destination + i * ElementSize, source + elementIndex * stride, ElementSize);
+            }
+        }
+
+        void CopyElements(
+            const std::byte* source,
+            std::size_t stride,
+            std::size_t elementSize,
+            std::byte* destination,
+            const std::uint32_t* indices,
+            std::size_t elementCount)
+        {
+            switch (elementSize)
+            {
+            case 2:
+                CopyElements<2>(source, stride, destination, indices, elementCount);
+                break;
+            case 4:
+                CopyElements<4>(source, stride, destination, indices, elementCount);
+                break;
+            case 8:
+                CopyElements<8>(source, stride, destination, indices, elementCount);
+                break;
+            case 12:
+                CopyElements<12>(source, stride, destination, indices, elementCount);
+                break;
+            case 16:
+                CopyElements<16>(source, stride, destination, indices, elementCount);
+                break;
+            default:
+                for (std::size_t i = 0; i < elementCount; ++i)
+                {
+                    std::size_t elementIndex = indices ? indices[i] : i;
+                    memcpy(destination + i * elementSize, source + elementIndex * stride, elementSize);
+                }
+                break;
+            }
+        }
+
+        template<typename IndexType>
+        void WidenIndices(const std::byte* source, std::size_t count, std::uint32_t* destination)
+        {
+            std::size_t i = 0;
+#if AZ_TRAIT_USE_PLATFORM_SIMD_SSE
+            i = WidenIndicesSimd(reinterpret_cast<const IndexType*>(source), count, destination);
+#endif
+            for (; i < count; ++i)
+            {
+                IndexType index;
+                memcpy(&index, source + i * sizeof(IndexType), sizeof(IndexType));
+                destination[i] = static_cast<std::uint32_t>(index);
+            }
+        }
+
+        template<typename IndexType>
+        void ConvertIndices(const std::byte* source, std::size_t count, std::uint16_t* destination)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                IndexType index;
+                memcpy(&index, source + i * sizeof(IndexType), sizeof(IndexType));
+                destination[i] = static_cast<std::uint16_t>(AZStd::min(index, static_cast<IndexType>(0xFFFF)));
+            }
+        }
+    } // namespace
+
+    bool GltfAccessorStream::IsValid() const
+    {
+        return m_data != nullptr;
+    }
+
+    std::size_t GltfAccessorStream::GetElementSize() const
+    {
+        return static_cast<std::size_t>(m_componentCount) * static_cast<std::size_t>(m_componentSize);
+    }
+
+    GltfAccessorStream GltfVertexStreamPacker::GetAccessorStream(const CesiumGltf::Model& model, const CesiumGltf::Accessor& accessor)
+    {
+        const CesiumGltf::BufferView* bufferView = model.getSafe<CesiumGltf::BufferView>(&model.bufferViews, accessor.bufferView);
+        if (!bufferView)
+        {
+            return GltfAccessorStream{};
+        }
+
+        const CesiumGltf::Buffer* buffer = model.getSafe<CesiumGltf::Buffer>(&model.buffers, bufferView->buffer);
+        if (!buffer)
+        {
+            return GltfAccessorStream{};
+        }
+
+        std::int64_t componentSize = accessor.computeByteSizeOfComponent();
+        std::int64_t componentCount = accessor.computeNumberOfComponents();
+        if (componentSize <= 0 || componentCount <= 0 || accessor.count <= 0 || accessor.byteOffset < 0 || bufferView->byteOffset < 0)
+        {
+            return GltfAccessorStream{};
+        }
+
+        std::int64_t elementSize = componentSize * componentCount;
+        std::int64_t stride = bufferView->byteStride && *bufferView->byteStride > 0 ? *bufferView->byteStride : elementSize;
+        if (stride < elementSize)
+        {
+            return GltfAccessorStream{};
+        }
+
+        // the last element has to end inside the bufferView, and the bufferView inside the buffer
+        std::int64_t accessorByteLength = accessor.byteOffset + stride * (accessor.count - 1) + elementSize;
+        std::int64_t bufferSize = static_cast<std::int64_t>(buffer->cesium.data.size());
+        if (accessorByteLength > bufferView->byteLength || bufferView->byteOffset + bufferView->byteLength > bufferSize)
+        {
+            return GltfAccessorStream{};
+        }
+
+        GltfAccessorStream stream;
+        stream.m_data = buffer->cesium.data.data() + bufferView->byteOffset + accessor.byteOffset;
+        stream.m_stride = static_cast<std::size_t>(stride);
+        stream.m_count = static_cast<std::size_t>(accessor.count);
+        stream.m_componentType = accessor.componentType;
+        stream.m_componentCount = static_cast<std::uint32_t>(componentCount);
+        stream.m_componentSize = static_cast<std::uint32_t>(componentSize);
+        stream.m_normalized = accessor.normalized;
+        return stream;
+    }
+
+    bool GltfVertexStreamPacker::CanPackFloat(const GltfAccessorStream& stream)
+    {
+        switch (stream.m_componentType)
+        {
+        case CesiumGltf::AccessorSpec::ComponentType::FLOAT:
+        case CesiumGltf::AccessorSpec::ComponentType::BYTE:
+        case CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_BYTE:
+        case CesiumGltf::AccessorSpec::ComponentType::SHORT:
+        case CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_SHORT:
+            return stream.IsValid();
+        default:
+            return false;
+        }
+    }
+
+    bool GltfVertexStreamPacker::CanPackIndices(const GltfAccessorStream& stream)
+    {
+        switch (stream.m_componentType)
+        {
+        case CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_BYTE:
+        case CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_SHORT:
+        case CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_INT:
+            // glTF does not allow a byte stride on index bufferViews
+            return stream.IsValid() && stream.m_componentCount == 1 && stream.m_stride == stream.GetElementSize();
+        default:
+            return false;
+        }
+    }
+
+    void GltfVertexStreamPacker::PackFloat(
+        const GltfAccessorStream& stream, std::uint32_t componentCount, float* destination, const std::uint32_t* indices, std::size_t indexCount)
+    {
+        std::size_t elementCount = indices ? indexCount : stream.m_count;
+        switch (stream.m_componentType)
+        {
+        case CesiumGltf::AccessorSpec::ComponentType::FLOAT:
+            if (stream.m_componentCount == componentCount)
+            {
+                PackRaw(stream, reinterpret_cast<std::byte*>(destination), indices, indexCount);
+            }
+            else
+            {
+                ConvertElements<float>(stream, componentCount, destination, indices, elementCount);
+            }
+            break;
+        case CesiumGltf::AccessorSpec::ComponentType::BYTE:
+            PackFloatElements<std::int8_t>(stream, componentCount, destination, indices, elementCount);
+            break;
+        case CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_BYTE:
+            PackFloatElements<std::uint8_t>(stream, componentCount, destination, indices, elementCount);
+            break;
+        case CesiumGltf::AccessorSpec::ComponentType::SHORT:
+            PackFloatElements<std::int16_t>(stream, componentCount, destination, indices, elementCount);
+            break;
+        case CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_SHORT:
+            PackFloatElements<std::uint16_t>(stream, componentCount, destination, indices, elementCount);
+            break;
+        default:
+            AZ_Assert(false, "Accessor component type %d cannot be converted to float", stream.m_componentType);
+            break;
+        }
+    }
+
+    void GltfVertexStreamPacker::PackRaw(
+        const GltfAccessorStream& stream, std::byte* destination, const std::uint32_t* indices, std::size_t indexCount)
+    {
+        std::size_t elementSize = stream.GetElementSize();
+        if (!indices && stream.m_stride == elementSize)
+        {
+            memcpy(destination, stream.m_data, stream.m_count * elementSize);
+            return;
+        }
+
+        std::size_t elementCount = indices ? indexCount : stream.m_count;
+        CopyElements(stream.m_data, stream.m_stride, elementSize, destination, indices, elementCount);
+    }
+
+    void GltfVertexStreamPacker::Pack(
+        const GltfAccessorStream& stream, AZ::RHI::Format format, std::byte* destination, const std::uint32_t* indices, std::size_t indexCount)
+    {
+        switch (format)
+        {
+        case AZ::RHI::Format::R32_FLOAT:
+            PackFloat(stream, 1, reinterpret_cast<float*>(destination), indices, indexCount);
+            break;
+        case AZ::RHI::Format::R32G32_FLOAT:
+            PackFloat(stream, 2, reinterpret_cast<float*>(destination), indices, indexCount);
+            break;
+        case AZ::RHI::Format::R32G32B32_FLOAT:
+            PackFloat(stream, 3, reinterpret_cast<float*>(destination), indices, indexCount);
+            break;
+        case AZ::RHI::Format::R32G32B32A32_FLOAT:
+            PackFloat(stream, 4, reinterpret_cast<float*>(destination), indices, indexCount);
+            break;
+        default:
+            PackRaw(stream, destination, indices, indexCount);
+            break;
+        }
+    }
+
+    void GltfVertexStreamPacker::PackIndices(const GltfAccessorStream& stream, std::uint32_t* destination)
+    {
+        switch (stream.m_componentType)
+        {
+        case CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_BYTE:
+            WidenIndices<std::uint8_t>(stream.m_data, stream.m_count, destination);
+            break;
+        case CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_SHORT:
+            WidenIndices<std::uint16_t>(stream.m_data, stream.m_count, destination);
+            break;
+        case CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_INT:
+            PackRaw(stream, reinterpret_cast<std::byte*>(destination));
+            break;
+        default:
+            AZ_Assert(false, "Accessor component type %d cannot be used as indices", stream.m_componentType);
+            break;
+        }
+    }
+
+    void GltfVertexStreamPacker::PackIndices(const GltfAccessorStream& stream, std::uint16_t* destination)
+    {
+        switch (stream.m_componentType)
+        {
+        case CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_BYTE:
+            ConvertIndices<std::uint8_t>(stream.m_data, stream.m_count, destination);
+            break;
+        case CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_SHORT:
+            PackRaw(stream, reinterpret_cast<std::byte*>(destination));
+            break;
+        case CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_INT:
+            ConvertIndices<std::uint32_t>(stream.m_data, stream.m_count, destination);
+            break;
+        default:
+            AZ_Assert(false, "Accessor component type %d cannot be used as indices", stream.m_componentType);
+            break;
+        }
+    }
+} // namespace Cesium
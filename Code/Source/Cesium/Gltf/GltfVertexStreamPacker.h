@@ -0,0 +1,75 @@
+#pragma once
+
+#include <Atom/RHI.Reflect/Format.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace CesiumGltf
+{
+    struct Model;
+    struct Accessor;
+} // namespace CesiumGltf
+
+namespace Cesium
+{
+    // Elements of an accessor, resolved once to their bytes in the glTF buffer. Elements are m_stride bytes apart,
+    // which is larger than the element size for interleaved bufferViews
+    struct GltfAccessorStream final
+    {
+        bool IsValid() const;
+
+        std::size_t GetElementSize() const;
+
+        const std::byte* m_data{ nullptr };
+        std::size_t m_stride{ 0 };
+        std::size_t m_count{ 0 };
+        std::int32_t m_componentType{ 0 };
+        std::uint32_t m_componentCount{ 0 };
+        std::uint32_t m_componentSize{ 0 };
+        bool m_normalized{ false };
+    };
+
+    // Packs glTF accessors straight into a mesh buffer. Unlike AccessorView, elements are not copied one by one through a
+    // typed view: tightly packed streams are copied or converted in bulk with SIMD kernels, and interleaved streams are
+    // gathered with a fixed size copy per element. When indices are given, element i of the destination is element
+    // indices[i] of the source, which un-indexes the stream in the same pass.
+    class GltfVertexStreamPacker final
+    {
+    public:
+        // returns an invalid stream when the accessor, its bufferView or its buffer is missing, or when the elements
+        // do not fit in the bufferView
+        static GltfAccessorStream GetAccessorStream(const CesiumGltf::Model& model, const CesiumGltf::Accessor& accessor);
+
+        // float, and normalized or integer byte and short components can be converted to float
+        static bool CanPackFloat(const GltfAccessorStream& stream);
+
+        static bool CanPackIndices(const GltfAccessorStream& stream);
+
+        // writes each element to the destination as componentCount floats. Missing components are 0, except the fourth one which is 1
+        static void PackFloat(
+            const GltfAccessorStream& stream,
+            std::uint32_t componentCount,
+            float* destination,
+            const std::uint32_t* indices = nullptr,
+            std::size_t indexCount = 0);
+
+        // copies the elements as they are stored, e.g. normalized UVs that keep their format on the GPU
+        static void PackRaw(
+            const GltfAccessorStream& stream, std::byte* destination, const std::uint32_t* indices = nullptr, std::size_t indexCount = 0);
+
+        // packs the elements in the layout of a vertex format. Float formats are converted, every other format is copied as it is
+        static void Pack(
+            const GltfAccessorStream& stream,
+            AZ::RHI::Format format,
+            std::byte* destination,
+            const std::uint32_t* indices = nullptr,
+            std::size_t indexCount = 0);
+
+        // widens unsigned byte, short and int indices to 32 bits
+        static void PackIndices(const GltfAccessorStream& stream, std::uint32_t* destination);
+
+        // widens unsigned byte indices and narrows unsigned int indices to 16 bits. Int indices above 65535 saturate, so
+        // they still fail a range check against a vertex count that fits 16 bit indices
+        static void PackIndices(const GltfAccessorStream& stream, std::uint16_t* destination);
+    };
+} // namespace Cesium
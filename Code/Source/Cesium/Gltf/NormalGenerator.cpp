@@ -0,0 +1,157 @@
+#include "Cesium/Gltf/NormalGenerator.h"
+#include <AzCore/std/algorithm.h>
+#include <AzCore/std/sort.h>
+#include <cmath>
+#include <numeric>
+
+namespace Cesium
+{
+    void NormalGenerator::Generate(
+        const AZStd::span<const std::uint32_t>& indices,
+        const AZStd::span<const glm::vec3>& positions,
+        float creaseAngle,
+        AZStd::vector<glm::vec3>& normals)
+    {
+        static constexpr float EPSILON = 1e-12f;
+
+        std::size_t cornerCount = indices.size() - indices.size() % 3;
+        normals.resize(cornerCount);
+
+        // unit face normals, and the angle of each corner as the weight of its face
+        AZStd::vector<glm::vec3> faceNormals(cornerCount / 3, glm::vec3(0.0f));
+        AZStd::vector<float> cornerAngles(cornerCount, 0.0f);
+        for (std::size_t face = 0; face < faceNormals.size(); ++face)
+        {
+            const glm::vec3* corners[3] = { &positions[indices[face * 3]], &positions[indices[face * 3 + 1]],
+                                            &positions[indices[face * 3 + 2]] };
+            glm::vec3 normal = glm::cross(*corners[1] - *corners[0], *corners[2] - *corners[0]);
+            float normalLength = glm::length(normal);
+            if (normalLength * normalLength <= EPSILON)
+            {
+                continue;
+            }
+
+            faceNormals[face] = normal / normalLength;
+            for (std::size_t corner = 0; corner < 3; ++corner)
+            {
+                glm::vec3 next = *corners[(corner + 1) % 3] - *corners[corner];
+                glm::vec3 previous = *corners[(corner + 2) % 3] - *corners[corner];
+                float lengths = glm::length(next) * glm::length(previous);
+                if (lengths > EPSILON)
+                {
+                    cornerAngles[face * 3 + corner] = std::acos(AZStd::clamp(glm::dot(next, previous) / lengths, -1.0f, 1.0f));
+                }
+            }
+        }
+
+        // corners around each welded position, stored contiguously per position
+        std::uint32_t positionCount = 0;
+        AZStd::vector<std::uint32_t> positionIds = WeldPositions(positions, positionCount);
+        AZStd::vector<std::uint32_t> cornerOffsets(static_cast<std::size_t>(positionCount) + 1, 0);
+        for (std::size_t corner = 0; corner < cornerCount; ++corner)
+        {
+            ++cornerOffsets[positionIds[indices[corner]] + 1];
+        }
+
+        std::partial_sum(cornerOffsets.begin(), cornerOffsets.end(), cornerOffsets.begin());
+        AZStd::vector<std::uint32_t> positionCorners(cornerCount);
+        AZStd::vector<std::uint32_t> cursors(cornerOffsets.begin(), cornerOffsets.end() - 1);
+        for (std::size_t corner = 0; corner < cornerCount; ++corner)
+        {
+            positionCorners[cursors[positionIds[indices[corner]]]++] = static_cast<std::uint32_t>(corner);
+        }
+
+        float creaseCosine = std::cos(creaseAngle);
+        for (std::size_t corner = 0; corner < cornerCount; ++corner)
+        {
+            const glm::vec3& faceNormal = faceNormals[corner / 3];
+            if (glm::dot(faceNormal, faceNormal) == 0.0f)
+            {
+                normals[corner] = glm::vec3(0.0f, 1.0f, 0.0f);
+                continue;
+            }
+
+            std::uint32_t positionId = positionIds[indices[corner]];
+            glm::vec3 normal(0.0f);
+            for (std::uint32_t i = cornerOffsets[positionId]; i < cornerOffsets[positionId + 1]; ++i)
+            {
+                std::uint32_t neighbor = positionCorners[i];
+                const glm::vec3& neighborNormal = faceNormals[neighbor / 3];
+                if (glm::dot(faceNormal, neighborNormal) >= creaseCosine)
+                {
+                    normal += neighborNormal * cornerAngles[neighbor];
+                }
+            }
+
+            float normalLength = glm::length(normal);
+            normals[corner] = normalLength * normalLength > EPSILON ? normal / normalLength : faceNormal;
+        }
+    }
+
+    void NormalGenerator::GenerateFlat(
+        const AZStd::span<const std::uint32_t>& indices,
+        const AZStd::span<const glm::vec3>& positions,
+        AZStd::vector<glm::vec3>& normals)
+    {
+        static constexpr float EPSILON = 1e-12f;
+
+        std::size_t cornerCount = indices.size() - indices.size() % 3;
+        normals.resize(cornerCount);
+        for (std::size_t face = 0; face < cornerCount / 3; ++face)
+        {
+            const glm::vec3& p0 = positions[indices[face * 3]];
+            const glm::vec3& p1 = positions[indices[face * 3 + 1]];
+            const glm::vec3& p2 = positions[indices[face * 3 + 2]];
+            glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+            float normalLength = glm::length(normal);
+            normal = normalLength * normalLength > EPSILON ? normal / normalLength : glm::vec3(0.0f, 1.0f, 0.0f);
+            normals[face * 3] = normal;
+            normals[face * 3 + 1] = normal;
+            normals[face * 3 + 2] = normal;
+        }
+    }
+
+    AZStd::vector<std::uint32_t> NormalGenerator::WeldPositions(const AZStd::span<const glm::vec3>& positions, std::uint32_t& positionCount)
+    {
+        // sorting the vertices by position puts equal positions next to each other
+        AZStd::vector<std::uint32_t> order(positions.size());
+        std::iota(order.begin(), order.end(), 0u);
+        AZStd::sort(
+            order.begin(), order.end(),
+            [&positions](std::uint32_t lhs, std::uint32_t rhs)
+            {
+                const glm::vec3& a = positions[lhs];
+                const glm::vec3& b = positions[rhs];
+                if (a.x != b.x)
+                {
+                    return a.x < b.x;
+                }
+
+                if (a.y != b.y)
+                {
+                    return a.y < b.y;
+                }
+
+                return a.z < b.z;
+            });
+
+        AZStd::vector<std::uint32_t> positionIds(positions.size(), 0);
+        positionCount = 0;
+        for (std::size_t i = 0; i < order.size(); ++i)
+        {
+            if (i > 0 && positions[order[i]] != positions[order[i - 1]])
+            {
+                ++positionCount;
+            }
+
+            positionIds[order[i]] = positionCount;
+        }
+
+        if (!order.empty())
+        {
+            ++positionCount;
+        }
+
+        return positionIds;
+    }
+} // namespace Cesium
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <AzCore/std/containers/span.h>
+#include <AzCore/std/containers/vector.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+
+namespace Cesium
+{
+    struct NormalGenerator
+    {
+    public:
+        // Angle weighted normals of an indexed triangle list, written per triangle corner. Vertices at the same position are
+        // smoothed together even when they are different vertices, e.g. at UV seams. Faces around a position are only smoothed
+        // with each other when their normals are less than creaseAngle radians apart, so hard edges stay sharp.
+        static void Generate(
+            const AZStd::span<const std::uint32_t>& indices,
+            const AZStd::span<const glm::vec3>& positions,
+            float creaseAngle,
+            AZStd::vector<glm::vec3>& normals);
+
+        // Unit face normals of an indexed triangle list, written per triangle corner, as glTF requires for meshes without
+        // normals. Degenerate faces get +Y.
+        static void GenerateFlat(
+            const AZStd::span<const std::uint32_t>& indices,
+            const AZStd::span<const glm::vec3>& positions,
+            AZStd::vector<glm::vec3>& normals);
+
+    private:
+        static AZStd::vector<std::uint32_t> WeldPositions(const AZStd::span<const glm::vec3>& positions, std::uint32_t& positionCount);
+    };
+} // namespace Cesium
@@ -122,27 +122,36 @@ namespace Cesium
             m_isStop = true;
         }
 
-        double t = m_totalTimePassed / m_totalDuration;
-        double currentLongitude = CesiumUtility::Math::lerp(m_beginLongitude, m_destinationLongitude, t);
-        double currentLatitude = CesiumUtility::Math::lerp(m_beginLatitude, m_destinationLatitude, t);
-        double currentHeight{};
+        Sample(GetProgress(), m_current, m_currentOrientation);
+    }
+
+    double GeoReferenceInterpolator::GetProgress() const
+    {
+        return m_totalTimePassed / m_totalDuration;
+    }
+
+    void GeoReferenceInterpolator::Sample(double progress, glm::dvec3& position, glm::dquat& orientation) const
+    {
+        double longitude = CesiumUtility::Math::lerp(m_beginLongitude, m_destinationLongitude, progress);
+        double latitude = CesiumUtility::Math::lerp(m_beginLatitude, m_destinationLatitude, progress);
+        double height{};
         if (m_useHeightLerp)
         {
-            currentHeight = CesiumUtility::Math::lerp(m_beginHeight, m_destinationHeight, t);
+            height = CesiumUtility::Math::lerp(m_beginHeight, m_destinationHeight, progress);
         }
         else
         {
-            currentHeight = -glm::pow(t * (m_e - m_s) + m_s, m_flyPower) / m_flyFactor + m_flyHeight;
+            height = -glm::pow(progress * (m_e - m_s) + m_s, m_flyPower) / m_flyFactor + m_flyHeight;
         }
 
-        // interpolate current ecef position
-        m_current = CesiumGeospatial::Ellipsoid::WGS84.cartographicToCartesian(
-            CesiumGeospatial::Cartographic{ currentLongitude, currentLatitude, currentHeight });
+        // interpolate ecef position
+        position =
+            CesiumGeospatial::Ellipsoid::WGS84.cartographicToCartesian(CesiumGeospatial::Cartographic{ longitude, latitude, height });
 
-        // interpolate current orientation
-        glm::dmat4 enuToECEF = CesiumGeospatial::Transforms::eastNorthUpToFixedFrame(m_current);
-        glm::dvec3 currentPitchRollHead = glm::lerp(m_beginPitchRollHead, m_destinationPitchRollHead, t);
-        m_currentOrientation = glm::dquat(enuToECEF) * glm::dquat(currentPitchRollHead);
+        // interpolate orientation
+        glm::dmat4 enuToECEF = CesiumGeospatial::Transforms::eastNorthUpToFixedFrame(position);
+        glm::dvec3 pitchRollHead = glm::lerp(m_beginPitchRollHead, m_destinationPitchRollHead, progress);
+        orientation = glm::dquat(enuToECEF) * glm::dquat(pitchRollHead);
     }
 
     glm::dvec3 GeoReferenceInterpolator::CalculatePitchRollHead(const glm::dvec3& position, const glm::dvec3& direction)
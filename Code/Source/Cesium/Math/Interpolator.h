@@ -16,6 +16,12 @@ namespace Cesium
 
         virtual bool IsStop() const = 0;
 
+        // share of the flight that is done, between 0 and 1
+        virtual double GetProgress() const = 0;
+
+        // position and orientation at a share of the flight between 0 and 1, without moving along it
+        virtual void Sample(double progress, glm::dvec3& position, glm::dquat& orientation) const = 0;
+
         virtual void Update(float deltaTime) = 0;
     };
 } // namespace Cesium
@@ -50,14 +50,22 @@ namespace Cesium
             m_isStop = true;
         }
 
-        double t = m_totalTimePassed / m_totalDuration;
+        Sample(GetProgress(), m_current, m_currentOrientation);
+    }
 
-        // interpolate current ecef position
-        m_current = glm::lerp(m_begin, m_destination, t);
+    double LinearInterpolator::GetProgress() const
+    {
+        return m_totalTimePassed / m_totalDuration;
+    }
+
+    void LinearInterpolator::Sample(double progress, glm::dvec3& position, glm::dquat& orientation) const
+    {
+        // interpolate ecef position
+        position = glm::lerp(m_begin, m_destination, progress);
 
-        // interpolate current orientation
-        glm::dvec3 currentPitchRollHead = glm::lerp(m_beginPitchRollHead, m_destinationPitchRollHead, t);
-        m_currentOrientation = glm::dquat(currentPitchRollHead);
+        // interpolate orientation
+        glm::dvec3 pitchRollHead = glm::lerp(m_beginPitchRollHead, m_destinationPitchRollHead, progress);
+        orientation = glm::dquat(pitchRollHead);
     }
 
     glm::dvec3 LinearInterpolator::CalculatePitchRollHead(const glm::dvec3& direction)
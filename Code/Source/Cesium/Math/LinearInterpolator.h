@@ -19,6 +19,10 @@ namespace Cesium
 
         bool IsStop() const override;
 
+        double GetProgress() const override;
+
+        void Sample(double progress, glm::dvec3& position, glm::dquat& orientation) const override;
+
         void Update(float deltaTime) override;
 
     private:
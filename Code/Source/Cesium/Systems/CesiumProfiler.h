@@ -0,0 +1,58 @@
+#pragma once
+
+#include <AzCore/Debug/Budget.h>
+#include <AzCore/Debug/Profiler.h>
+#include <AzCore/std/chrono/chrono.h>
+#include <cstdint>
+
+AZ_DECLARE_BUDGET(Cesium);
+
+// Profiler markers for the tile streaming stages. They are only compiled in with the LY_CESIUM_PROFILER_MARKERS build
+// option, so regular builds do not pay for them
+#if defined(CESIUM_PROFILER_MARKERS)
+#define CESIUM_PROFILE_SCOPE(...) AZ_PROFILE_SCOPE(Cesium, __VA_ARGS__)
+#else
+#define CESIUM_PROFILE_SCOPE(...)
+#endif
+
+namespace Cesium
+{
+    // Adds the time spent in its scope to a nanosecond counter. SwitchTo charges the time from then on to another
+    // counter, so consecutive stages of a function can be timed with one timer
+    class StageTimer final
+    {
+    public:
+        explicit StageTimer(std::uint64_t& nanoseconds)
+            : m_nanoseconds{ &nanoseconds }
+            , m_start{ AZStd::chrono::steady_clock::now() }
+        {
+        }
+
+        StageTimer(const StageTimer&) = delete;
+
+        StageTimer& operator=(const StageTimer&) = delete;
+
+        ~StageTimer() noexcept
+        {
+            Record(AZStd::chrono::steady_clock::now());
+        }
+
+        void SwitchTo(std::uint64_t& nanoseconds)
+        {
+            auto now = AZStd::chrono::steady_clock::now();
+            Record(now);
+            m_nanoseconds = &nanoseconds;
+            m_start = now;
+        }
+
+    private:
+        void Record(AZStd::chrono::steady_clock::time_point now)
+        {
+            auto elapsedTime = AZStd::chrono::duration_cast<AZStd::chrono::nanoseconds>(now - m_start);
+            *m_nanoseconds += static_cast<std::uint64_t>(elapsedTime.count());
+        }
+
+        std::uint64_t* m_nanoseconds;
+        AZStd::chrono::steady_clock::time_point m_start;
+    };
+} // namespace Cesium
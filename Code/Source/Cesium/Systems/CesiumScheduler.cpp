@@ -0,0 +1,387 @@
+#include "Cesium/Systems/CesiumScheduler.h"
+#include <AzCore/Debug/Trace.h>
+#include <AzCore/Jobs/JobContext.h>
+#include <AzCore/Jobs/JobFunction.h>
+#include <AzCore/Jobs/JobManager.h>
+#include <AzCore/std/algorithm.h>
+#include <AzCore/std/parallel/thread.h>
+#include <memory>
+
+namespace Cesium
+{
+    namespace
+    {
+        // Items of a ParallelFor. Helper tasks share it, so a helper that only starts after the caller returned still
+        // finds no item left instead of a dangling state
+        struct ParallelForState final
+        {
+            ParallelForState(std::size_t count, const std::function<void(std::size_t)>& function)
+                : m_function{ function }
+                , m_count{ count }
+            {
+            }
+
+            void RunItems()
+            {
+                for (std::size_t i = m_nextItem.fetch_add(1); i < m_count; i = m_nextItem.fetch_add(1))
+                {
+                    m_function(i);
+                    if (m_completedItems.fetch_add(1) + 1 == m_count)
+                    {
+                        AZStd::scoped_lock<AZStd::mutex> lock(m_mutex);
+                        m_condition.notify_all();
+                    }
+                }
+            }
+
+            void Wait()
+            {
+                AZStd::unique_lock<AZStd::mutex> lock(m_mutex);
+                m_condition.wait(
+                    lock,
+                    [this]()
+                    {
+                        return m_completedItems.load() == m_count;
+                    });
+            }
+
+            std::function<void(std::size_t)> m_function;
+            std::size_t m_count;
+            std::atomic<std::size_t> m_nextItem{ 0 };
+            std::atomic<std::size_t> m_completedItems{ 0 };
+            AZStd::mutex m_mutex;
+            AZStd::condition_variable m_condition;
+        };
+    } // namespace
+
+    void CesiumSchedulerTaskGroup::Wait()
+    {
+        AZStd::unique_lock<AZStd::mutex> lock(m_mutex);
+        m_condition.wait(
+            lock,
+            [this]()
+            {
+                return m_pendingTasks == 0;
+            });
+    }
+
+    void CesiumSchedulerTaskGroup::AddTask()
+    {
+        AZStd::scoped_lock<AZStd::mutex> lock(m_mutex);
+        ++m_pendingTasks;
+    }
+
+    void CesiumSchedulerTaskGroup::CompleteTask()
+    {
+        AZStd::scoped_lock<AZStd::mutex> lock(m_mutex);
+        --m_pendingTasks;
+        if (m_pendingTasks == 0)
+        {
+            m_condition.notify_all();
+        }
+    }
+
+    CesiumScheduler::CesiumScheduler()
+        : CesiumScheduler(GetDefaultConfiguration())
+    {
+    }
+
+    CesiumScheduler::CesiumScheduler(const CesiumSchedulerConfiguration& configuration)
+        : m_configuration{ configuration }
+    {
+        CreateWorkers(m_ioLane, m_configuration.m_ioLane);
+        CreateWorkers(m_fileLane, m_configuration.m_fileLane);
+
+        AZ::JobContext* globalJobContext = m_configuration.m_useGlobalJobContext ? AZ::JobContext::GetGlobalContext() : nullptr;
+        if (globalJobContext)
+        {
+            m_computeLane.m_jobContext = globalJobContext;
+            m_computeLane.m_threadCount = globalJobContext->GetJobManager().GetNumWorkerThreads();
+        }
+        else
+        {
+            AZ_Warning(
+                "Cesium", !m_configuration.m_useGlobalJobContext, "There is no global job context. Cesium creates its own compute workers");
+            CreateWorkerPool(m_computeLane, m_configuration.m_computeLane);
+        }
+
+        m_ioLane.m_lastSampleTime = AZStd::chrono::steady_clock::now();
+        m_fileLane.m_lastSampleTime = m_ioLane.m_lastSampleTime;
+        m_computeLane.m_lastSampleTime = m_ioLane.m_lastSampleTime;
+    }
+
+    CesiumScheduler::~CesiumScheduler() noexcept
+    {
+        DrainLane(m_ioLane);
+        DrainLane(m_fileLane);
+        DrainLane(m_computeLane);
+    }
+
+    void CesiumScheduler::Submit(CesiumSchedulerLane lane, std::function<void()> task, CesiumSchedulerTaskGroup* taskGroup)
+    {
+        Lane& schedulerLane = GetLane(lane);
+        if (taskGroup)
+        {
+            taskGroup->AddTask();
+        }
+
+        if (schedulerLane.m_workerPool)
+        {
+            schedulerLane.m_workerPool->Submit(PooledTask::Create(std::move(task), taskGroup));
+        }
+        else
+        {
+            SubmitJob(schedulerLane, std::move(task), taskGroup);
+        }
+
+        m_submittedTasks.fetch_add(1);
+    }
+
+    void CesiumScheduler::SubmitBatch(
+        CesiumSchedulerLane lane, AZStd::vector<std::function<void()>>&& tasks, CesiumSchedulerTaskGroup* taskGroup)
+    {
+        Lane& schedulerLane = GetLane(lane);
+        if (taskGroup)
+        {
+            for (std::size_t i = 0; i < tasks.size(); ++i)
+            {
+                taskGroup->AddTask();
+            }
+        }
+
+        if (schedulerLane.m_workerPool)
+        {
+            AZStd::vector<PooledTask*> pooledTasks;
+            pooledTasks.reserve(tasks.size());
+            for (auto& task : tasks)
+            {
+                pooledTasks.push_back(PooledTask::Create(std::move(task), taskGroup));
+            }
+
+            schedulerLane.m_workerPool->SubmitBatch(pooledTasks.data(), pooledTasks.size());
+        }
+        else
+        {
+            for (auto& task : tasks)
+            {
+                SubmitJob(schedulerLane, std::move(task), taskGroup);
+            }
+        }
+
+        m_submittedTasks.fetch_add(tasks.size());
+        tasks.clear();
+    }
+
+    void CesiumScheduler::ParallelFor(CesiumSchedulerLane lane, std::size_t count, const std::function<void(std::size_t)>& function)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        if (count == 1)
+        {
+            function(0);
+            return;
+        }
+
+        // items that no helper has taken yet are run by the calling thread, so waiting only covers running items
+        auto state = std::make_shared<ParallelForState>(count, function);
+        std::size_t helperCount = AZStd::min(count - 1, static_cast<std::size_t>(GetThreadCount(lane)));
+        AZStd::vector<std::function<void()>> helpers;
+        helpers.reserve(helperCount);
+        for (std::size_t i = 0; i < helperCount; ++i)
+        {
+            helpers.emplace_back(
+                [state]()
+                {
+                    state->RunItems();
+                });
+        }
+
+        SubmitBatch(lane, std::move(helpers));
+        state->RunItems();
+        state->Wait();
+    }
+
+    void CesiumScheduler::SubmitJob(Lane& schedulerLane, std::function<void()>&& task, CesiumSchedulerTaskGroup* taskGroup)
+    {
+        schedulerLane.m_queuedTasks.fetch_add(1, std::memory_order_relaxed);
+        AZ::Job* job = AZ::CreateJobFunction(
+            [&schedulerLane, task = std::move(task), taskGroup]()
+            {
+                schedulerLane.m_runningTasks.fetch_add(1, std::memory_order_relaxed);
+                schedulerLane.m_queuedTasks.fetch_sub(1, std::memory_order_relaxed);
+                auto start = AZStd::chrono::steady_clock::now();
+
+                task();
+
+                auto busyTime = AZStd::chrono::duration_cast<AZStd::chrono::nanoseconds>(AZStd::chrono::steady_clock::now() - start);
+                schedulerLane.m_busyNanoseconds.fetch_add(static_cast<std::uint64_t>(busyTime.count()), std::memory_order_relaxed);
+                schedulerLane.m_completedTasks.fetch_add(1, std::memory_order_relaxed);
+                if (taskGroup)
+                {
+                    taskGroup->CompleteTask();
+                }
+
+                // the scheduler may be destroyed as soon as the last task stops running
+                schedulerLane.m_runningTasks.fetch_sub(1, std::memory_order_release);
+            },
+            true,
+            schedulerLane.m_jobContext);
+        job->Start();
+    }
+
+    void CesiumScheduler::Drain()
+    {
+        // a lane that was idle stays idle until something is submitted to it, so the lanes are idle at the same time
+        // once a pass over all of them sees no new submission
+        std::uint64_t submittedTasks = 0;
+        do
+        {
+            submittedTasks = m_submittedTasks.load();
+            for (const Lane* lane : { &m_ioLane, &m_fileLane, &m_computeLane })
+            {
+                while (!IsLaneIdle(*lane))
+                {
+                    AZStd::this_thread::yield();
+                }
+            }
+        } while (m_submittedTasks.load() != submittedTasks);
+    }
+
+    CesiumSchedulerLaneStatistics CesiumScheduler::GetStatistics(CesiumSchedulerLane lane)
+    {
+        Lane& schedulerLane = GetLane(lane);
+        CesiumSchedulerLaneStatistics statistics;
+        statistics.m_threadCount = schedulerLane.m_threadCount;
+        std::uint64_t busyNanoseconds = 0;
+        if (schedulerLane.m_workerPool)
+        {
+            WorkStealingThreadPoolStatistics poolStatistics = schedulerLane.m_workerPool->GetStatistics();
+            statistics.m_queuedTasks = poolStatistics.m_queuedTasks;
+            statistics.m_runningTasks = poolStatistics.m_runningTasks;
+            statistics.m_completedTasks = poolStatistics.m_completedTasks;
+            busyNanoseconds = poolStatistics.m_busyNanoseconds;
+        }
+        else
+        {
+            statistics.m_queuedTasks = schedulerLane.m_queuedTasks.load(std::memory_order_relaxed);
+            statistics.m_runningTasks = schedulerLane.m_runningTasks.load(std::memory_order_relaxed);
+            statistics.m_completedTasks = schedulerLane.m_completedTasks.load(std::memory_order_relaxed);
+            busyNanoseconds = schedulerLane.m_busyNanoseconds.load(std::memory_order_relaxed);
+        }
+
+        AZStd::scoped_lock<AZStd::mutex> lock(schedulerLane.m_sampleMutex);
+        auto now = AZStd::chrono::steady_clock::now();
+        auto elapsedTime = AZStd::chrono::duration_cast<AZStd::chrono::nanoseconds>(now - schedulerLane.m_lastSampleTime);
+        double availableNanoseconds = static_cast<double>(elapsedTime.count()) * static_cast<double>(schedulerLane.m_threadCount);
+        if (availableNanoseconds > 0.0)
+        {
+            double busyDelta = static_cast<double>(busyNanoseconds - schedulerLane.m_lastSampleBusyNanoseconds);
+            statistics.m_utilization = static_cast<float>(AZStd::min(busyDelta / availableNanoseconds, 1.0));
+        }
+
+        schedulerLane.m_lastSampleTime = now;
+        schedulerLane.m_lastSampleBusyNanoseconds = busyNanoseconds;
+        return statistics;
+    }
+
+    std::uint32_t CesiumScheduler::GetThreadCount(CesiumSchedulerLane lane) const
+    {
+        return GetLane(lane).m_threadCount;
+    }
+
+    const CesiumSchedulerConfiguration& CesiumScheduler::GetConfiguration() const
+    {
+        return m_configuration;
+    }
+
+    CesiumSchedulerConfiguration CesiumScheduler::GetDefaultConfiguration()
+    {
+        // The engine runs its own job system on every core, so Cesium only takes half of them for decoding.
+        // I/O workers spend most of their time blocked, so there are enough of them to keep the connection pool busy.
+        // Local disks serve few reads at once, so the file lane stays small.
+        CesiumSchedulerConfiguration configuration;
+        configuration.m_ioLane.m_threadCount = 32;
+        configuration.m_fileLane.m_threadCount = 2;
+        configuration.m_computeLane.m_threadCount = AZStd::max(AZStd::thread::hardware_concurrency() / 2u, 1u);
+        return configuration;
+    }
+
+    CesiumScheduler::Lane& CesiumScheduler::GetLane(CesiumSchedulerLane lane)
+    {
+        switch (lane)
+        {
+        case CesiumSchedulerLane::IO:
+            return m_ioLane;
+        case CesiumSchedulerLane::File:
+            return m_fileLane;
+        default:
+            return m_computeLane;
+        }
+    }
+
+    const CesiumScheduler::Lane& CesiumScheduler::GetLane(CesiumSchedulerLane lane) const
+    {
+        switch (lane)
+        {
+        case CesiumSchedulerLane::IO:
+            return m_ioLane;
+        case CesiumSchedulerLane::File:
+            return m_fileLane;
+        default:
+            return m_computeLane;
+        }
+    }
+
+    void CesiumScheduler::CreateWorkers(Lane& lane, const CesiumSchedulerLaneConfiguration& configuration)
+    {
+        std::uint32_t threadCount = AZStd::max(configuration.m_threadCount, 1u);
+        AZ::JobManagerDesc jobDesc;
+        for (std::uint32_t i = 0; i < threadCount; ++i)
+        {
+            int cpuId = configuration.m_firstCore < 0 ? -1 : configuration.m_firstCore + static_cast<int>(i);
+            jobDesc.m_workerThreads.push_back({ cpuId });
+        }
+
+        lane.m_jobManager = AZStd::make_unique<AZ::JobManager>(jobDesc);
+        lane.m_ownedJobContext = AZStd::make_unique<AZ::JobContext>(*lane.m_jobManager);
+        lane.m_jobContext = lane.m_ownedJobContext.get();
+        lane.m_threadCount = threadCount;
+    }
+
+    void CesiumScheduler::CreateWorkerPool(Lane& lane, const CesiumSchedulerLaneConfiguration& configuration)
+    {
+        lane.m_workerPool = AZStd::make_unique<WorkStealingThreadPool>(configuration.m_threadCount, configuration.m_firstCore);
+        lane.m_threadCount = lane.m_workerPool->GetThreadCount();
+    }
+
+    bool CesiumScheduler::IsLaneIdle(const Lane& lane)
+    {
+        if (lane.m_workerPool)
+        {
+            WorkStealingThreadPoolStatistics poolStatistics = lane.m_workerPool->GetStatistics();
+            return poolStatistics.m_queuedTasks == 0 && poolStatistics.m_runningTasks == 0;
+        }
+
+        return lane.m_queuedTasks.load() == 0 && lane.m_runningTasks.load() == 0;
+    }
+
+    void CesiumScheduler::DrainLane(Lane& lane)
+    {
+        // the pool runs the tasks it still has before its workers exit
+        lane.m_workerPool.reset();
+
+        // tasks keep a reference to the lane, so they all have to finish before it is destroyed. This matters when
+        // the lane runs on the global job context, which outlives the scheduler
+        while (lane.m_queuedTasks.load(std::memory_order_relaxed) != 0 || lane.m_runningTasks.load(std::memory_order_acquire) != 0)
+        {
+            AZStd::this_thread::yield();
+        }
+
+        lane.m_ownedJobContext.reset();
+        lane.m_jobManager.reset();
+        lane.m_jobContext = nullptr;
+    }
+} // namespace Cesium
@@ -0,0 +1,170 @@
+#pragma once
+
+#include "Cesium/Systems/WorkStealingThreadPool.h"
+#include <AzCore/std/chrono/chrono.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/parallel/condition_variable.h>
+#include <AzCore/std/parallel/mutex.h>
+#include <AzCore/std/smart_ptr/unique_ptr.h>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+namespace AZ
+{
+    class JobManager;
+    class JobContext;
+} // namespace AZ
+
+namespace Cesium
+{
+    enum class CesiumSchedulerLane
+    {
+        // blocking work that mostly waits on the network
+        IO,
+
+        // local file reads. They have workers of their own, so they never wait behind slow http responses
+        File,
+
+        // CPU bound work, e.g. decoding tiles
+        Compute
+    };
+
+    struct CesiumSchedulerLaneConfiguration final
+    {
+        std::uint32_t m_threadCount{ 1 };
+
+        // worker i is pinned to core m_firstCore + i. A negative value leaves the workers unpinned
+        std::int32_t m_firstCore{ -1 };
+    };
+
+    struct CesiumSchedulerConfiguration final
+    {
+        CesiumSchedulerLaneConfiguration m_ioLane;
+
+        CesiumSchedulerLaneConfiguration m_fileLane;
+
+        CesiumSchedulerLaneConfiguration m_computeLane;
+
+        // run compute work on O3DE's global job context instead of dedicated workers. I/O and file work always have
+        // dedicated workers, so blocking requests never stall the engine's jobs
+        bool m_useGlobalJobContext{ false };
+    };
+
+    struct CesiumSchedulerLaneStatistics final
+    {
+        std::uint32_t m_threadCount{ 0 };
+        std::uint64_t m_queuedTasks{ 0 };
+        std::uint64_t m_runningTasks{ 0 };
+        std::uint64_t m_completedTasks{ 0 };
+
+        // fraction of the lane's worker time spent running tasks since the previous sample
+        float m_utilization{ 0.0f };
+    };
+
+    // Tracks the tasks an owner submitted to the scheduler, so it can wait for them before it is destroyed.
+    class CesiumSchedulerTaskGroup final
+    {
+    public:
+        CesiumSchedulerTaskGroup() = default;
+
+        CesiumSchedulerTaskGroup(const CesiumSchedulerTaskGroup&) = delete;
+
+        CesiumSchedulerTaskGroup& operator=(const CesiumSchedulerTaskGroup&) = delete;
+
+        void Wait();
+
+    private:
+        friend class CesiumScheduler;
+        friend class WorkStealingThreadPool;
+
+        void AddTask();
+
+        void CompleteTask();
+
+        AZStd::mutex m_mutex;
+        AZStd::condition_variable m_condition;
+        std::uint32_t m_pendingTasks{ 0 };
+    };
+
+    // Single scheduler for all the work Cesium runs off the main thread. Work is split into I/O, file and compute
+    // lanes, so network and disk waits do not occupy the threads that decode tiles and disk reads don't queue behind
+    // slow http responses. Dedicated compute workers steal work from each other, the I/O and file lanes and the
+    // global job context run on AZ jobs.
+    class CesiumScheduler final
+    {
+        struct Lane
+        {
+            AZStd::unique_ptr<WorkStealingThreadPool> m_workerPool;
+            AZStd::unique_ptr<AZ::JobManager> m_jobManager;
+            AZStd::unique_ptr<AZ::JobContext> m_ownedJobContext;
+            AZ::JobContext* m_jobContext{ nullptr };
+            std::uint32_t m_threadCount{ 0 };
+            std::atomic<std::uint64_t> m_queuedTasks{ 0 };
+            std::atomic<std::uint64_t> m_runningTasks{ 0 };
+            std::atomic<std::uint64_t> m_completedTasks{ 0 };
+            std::atomic<std::uint64_t> m_busyNanoseconds{ 0 };
+            AZStd::mutex m_sampleMutex;
+            AZStd::chrono::steady_clock::time_point m_lastSampleTime;
+            std::uint64_t m_lastSampleBusyNanoseconds{ 0 };
+        };
+
+    public:
+        CesiumScheduler();
+
+        explicit CesiumScheduler(const CesiumSchedulerConfiguration& configuration);
+
+        CesiumScheduler(const CesiumScheduler&) = delete;
+
+        CesiumScheduler& operator=(const CesiumScheduler&) = delete;
+
+        ~CesiumScheduler() noexcept;
+
+        void Submit(CesiumSchedulerLane lane, std::function<void()> task, CesiumSchedulerTaskGroup* taskGroup = nullptr);
+
+        // submits all the tasks with a single wake up of the workers
+        void SubmitBatch(
+            CesiumSchedulerLane lane, AZStd::vector<std::function<void()>>&& tasks, CesiumSchedulerTaskGroup* taskGroup = nullptr);
+
+        // Runs function(i) for every i in [0, count) on the lane's workers and the calling thread, and returns once all
+        // of them have finished. The calling thread takes items as well instead of only waiting, so it is safe to call
+        // from a task of the same lane even when every worker does the same
+        void ParallelFor(CesiumSchedulerLane lane, std::size_t count, const std::function<void(std::size_t)>& function);
+
+        // Waits until every lane is idle, including the work that running tasks hand to other lanes. The workers keep
+        // running, so owners of the state that tasks capture can drain before they are destroyed. Threads outside of the
+        // scheduler must not submit work meanwhile
+        void Drain();
+
+        CesiumSchedulerLaneStatistics GetStatistics(CesiumSchedulerLane lane);
+
+        std::uint32_t GetThreadCount(CesiumSchedulerLane lane) const;
+
+        const CesiumSchedulerConfiguration& GetConfiguration() const;
+
+        static CesiumSchedulerConfiguration GetDefaultConfiguration();
+
+    private:
+        Lane& GetLane(CesiumSchedulerLane lane);
+
+        const Lane& GetLane(CesiumSchedulerLane lane) const;
+
+        static void CreateWorkers(Lane& lane, const CesiumSchedulerLaneConfiguration& configuration);
+
+        static void CreateWorkerPool(Lane& lane, const CesiumSchedulerLaneConfiguration& configuration);
+
+        static void SubmitJob(Lane& lane, std::function<void()>&& task, CesiumSchedulerTaskGroup* taskGroup);
+
+        static bool IsLaneIdle(const Lane& lane);
+
+        static void DrainLane(Lane& lane);
+
+        CesiumSchedulerConfiguration m_configuration;
+        Lane m_ioLane;
+        Lane m_fileLane;
+        Lane m_computeLane;
+
+        // counted after a task is queued in its lane, so Drain notices work submitted after it checked the lane
+        std::atomic<std::uint64_t> m_submittedTasks{ 0 };
+    };
+} // namespace Cesium
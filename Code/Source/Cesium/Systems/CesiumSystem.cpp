@@ -3,21 +3,54 @@
 #include "Cesium/Systems/HttpAssetAccessor.h"
 #include "Cesium/Systems/GenericAssetAccessor.h"
 #include "Cesium/Systems/TaskProcessor.h"
+#include "Cesium/Systems/CesiumProfiler.h"
+#include <AzCore/IO/FileIO.h>
+#include <AzCore/Settings/SettingsRegistry.h>
+
+AZ_DEFINE_BUDGET(Cesium);
 
 namespace Cesium
 {
     CesiumSystem::CesiumSystem()
     {
+        // read settings
+        HttpManagerConfiguration httpManagerConfiguration;
+        AZ::u64 httpMaxConnections = httpManagerConfiguration.m_maxConnections;
+        AZ::u64 httpMaxInFlightRequests = httpManagerConfiguration.m_maxInFlightRequests;
+        bool httpCacheEnabled = true;
+        AZ::u64 httpCacheMaximumBytes = DEFAULT_HTTP_CACHE_MAXIMUM_BYTES;
+        if (auto settingsRegistry = AZ::SettingsRegistry::Get())
+        {
+            settingsRegistry->Get(httpMaxConnections, HTTP_MAX_CONNECTIONS_SETTING_KEY);
+            settingsRegistry->Get(httpMaxInFlightRequests, HTTP_MAX_IN_FLIGHT_REQUESTS_SETTING_KEY);
+            settingsRegistry->Get(httpCacheEnabled, HTTP_CACHE_ENABLED_SETTING_KEY);
+            settingsRegistry->Get(httpCacheMaximumBytes, HTTP_CACHE_MAXIMUM_BYTES_SETTING_KEY);
+        }
+
+        httpManagerConfiguration.m_maxConnections = static_cast<std::uint32_t>(httpMaxConnections);
+        httpManagerConfiguration.m_maxInFlightRequests = static_cast<std::uint32_t>(httpMaxInFlightRequests);
+
+        // initialize the scheduler that all the IO managers and the task processor share
+        m_scheduler = AZStd::make_unique<CesiumScheduler>(ReadSchedulerConfiguration());
+
         // initialize IO managers
-        m_httpManager = AZStd::make_unique<HttpManager>();
-        m_localFileManager = AZStd::make_unique<LocalFileManager>();
+        m_httpManager = AZStd::make_unique<HttpManager>(httpManagerConfiguration, *m_scheduler);
+        m_localFileManager = AZStd::make_unique<LocalFileManager>(*m_scheduler);
+
+        // initialize http response cache
+        AZ::IO::FileIOBase* fileIO = AZ::IO::FileIOBase::GetInstance();
+        AZ::IO::FixedMaxPath httpCacheDirectory;
+        if (httpCacheEnabled && fileIO && fileIO->ResolvePath(httpCacheDirectory, HTTP_CACHE_DIRECTORY))
+        {
+            m_httpResponseCache = AZStd::make_unique<HttpResponseCache>(httpCacheDirectory.c_str(), httpCacheMaximumBytes);
+        }
 
         // initialize asset accessors
-        m_httpAssetAccessor = std::make_shared<HttpAssetAccessor>(m_httpManager.get());
+        m_httpAssetAccessor = std::make_shared<HttpAssetAccessor>(m_httpManager.get(), m_httpResponseCache.get());
         m_localFileAssetAccessor = std::make_shared<GenericAssetAccessor>(m_localFileManager.get(), "");
 
         // initialize task processor
-        m_taskProcessor = std::make_shared<TaskProcessor>();
+        m_taskProcessor = std::make_shared<TaskProcessor>(*m_scheduler);
 
         // initialize credit system
         m_creditSystem = std::make_shared<Cesium3DTilesSelection::CreditSystem>();
@@ -28,6 +61,17 @@ namespace Cesium
         m_logger->sinks().push_back(std::make_shared<LoggerSink>());
     }
 
+    CesiumSystem::~CesiumSystem() noexcept
+    {
+        // queued downloads are cancelled instead of being sent, so draining doesn't wait on the network
+        m_httpManager->Shutdown();
+
+        // e.g. cached responses are read on the compute lane and may send a request when the blob is missing. Tasks
+        // like that must not run after the members they capture are destroyed, which would otherwise happen while
+        // the scheduler is destroyed last
+        m_scheduler->Drain();
+    }
+
     GenericIOManager& CesiumSystem::GetIOManager(IOKind kind)
     {
         switch (kind)
@@ -73,4 +117,74 @@ namespace Cesium
     {
         return m_criticalAssetManager;
     }
+
+    ContentAssetCache<AZ::RPI::StreamingImageAsset>& CesiumSystem::GetImageAssetCache()
+    {
+        return m_imageAssetCache;
+    }
+
+    ContentAssetCache<AZ::RPI::MaterialAsset>& CesiumSystem::GetMaterialAssetCache()
+    {
+        return m_materialAssetCache;
+    }
+
+    void CesiumSystem::SetHttpCacheMaximumBytes(std::uint64_t maximumBytes)
+    {
+        if (m_httpResponseCache)
+        {
+            m_httpResponseCache->SetMaximumBytes(maximumBytes);
+        }
+    }
+
+    std::uint64_t CesiumSystem::GetHttpCacheMaximumBytes() const
+    {
+        return m_httpResponseCache ? m_httpResponseCache->GetMaximumBytes() : 0;
+    }
+
+    void CesiumSystem::ClearHttpCache()
+    {
+        if (m_httpResponseCache)
+        {
+            m_httpResponseCache->Clear();
+        }
+    }
+
+    CesiumSchedulerLaneStatistics CesiumSystem::GetSchedulerStatistics(CesiumSchedulerLane lane)
+    {
+        return m_scheduler->GetStatistics(lane);
+    }
+
+    CesiumScheduler& CesiumSystem::GetScheduler()
+    {
+        return *m_scheduler;
+    }
+
+    CesiumSchedulerConfiguration CesiumSystem::ReadSchedulerConfiguration()
+    {
+        CesiumSchedulerConfiguration configuration = CesiumScheduler::GetDefaultConfiguration();
+        AZ::u64 ioThreadCount = configuration.m_ioLane.m_threadCount;
+        AZ::s64 ioFirstCore = configuration.m_ioLane.m_firstCore;
+        AZ::u64 fileThreadCount = configuration.m_fileLane.m_threadCount;
+        AZ::s64 fileFirstCore = configuration.m_fileLane.m_firstCore;
+        AZ::u64 computeThreadCount = configuration.m_computeLane.m_threadCount;
+        AZ::s64 computeFirstCore = configuration.m_computeLane.m_firstCore;
+        if (auto settingsRegistry = AZ::SettingsRegistry::Get())
+        {
+            settingsRegistry->Get(ioThreadCount, SCHEDULER_IO_THREAD_COUNT_SETTING_KEY);
+            settingsRegistry->Get(ioFirstCore, SCHEDULER_IO_FIRST_CORE_SETTING_KEY);
+            settingsRegistry->Get(fileThreadCount, SCHEDULER_FILE_THREAD_COUNT_SETTING_KEY);
+            settingsRegistry->Get(fileFirstCore, SCHEDULER_FILE_FIRST_CORE_SETTING_KEY);
+            settingsRegistry->Get(computeThreadCount, SCHEDULER_COMPUTE_THREAD_COUNT_SETTING_KEY);
+            settingsRegistry->Get(computeFirstCore, SCHEDULER_COMPUTE_FIRST_CORE_SETTING_KEY);
+            settingsRegistry->Get(configuration.m_useGlobalJobContext, SCHEDULER_USE_GLOBAL_JOB_CONTEXT_SETTING_KEY);
+        }
+
+        configuration.m_ioLane.m_threadCount = static_cast<std::uint32_t>(ioThreadCount);
+        configuration.m_ioLane.m_firstCore = static_cast<std::int32_t>(ioFirstCore);
+        configuration.m_fileLane.m_threadCount = static_cast<std::uint32_t>(fileThreadCount);
+        configuration.m_fileLane.m_firstCore = static_cast<std::int32_t>(fileFirstCore);
+        configuration.m_computeLane.m_threadCount = static_cast<std::uint32_t>(computeThreadCount);
+        configuration.m_computeLane.m_firstCore = static_cast<std::int32_t>(computeFirstCore);
+        return configuration;
+    }
 } // namespace Cesium
\ No newline at end of file
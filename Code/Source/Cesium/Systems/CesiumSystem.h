@@ -1,9 +1,14 @@
 
 #pragma once
 
+#include "Cesium/Systems/CesiumScheduler.h"
 #include "Cesium/Systems/LocalFileManager.h"
 #include "Cesium/Systems/HttpManager.h"
+#include "Cesium/Systems/HttpResponseCache.h"
 #include "Cesium/Systems/CriticalAssetManager.h"
+#include "Cesium/Systems/ContentAssetCache.h"
+#include <Atom/RPI.Reflect/Image/StreamingImageAsset.h>
+#include <Atom/RPI.Reflect/Material/MaterialAsset.h>
 #include <AzCore/JSON/rapidjson.h>
 #include <AzCore/Interface/Interface.h>
 #include <AzCore/RTTI/TypeInfo.h>
@@ -12,6 +17,7 @@
 #include <CesiumAsync/IAssetAccessor.h>
 #include <CesiumAsync/ITaskProcessor.h>
 #include <spdlog/logger.h>
+#include <cstdint>
 #include <memory>
 
 namespace Cesium
@@ -30,7 +36,7 @@ namespace Cesium
     public:
         CesiumSystem();
 
-        ~CesiumSystem() noexcept = default;
+        ~CesiumSystem() noexcept;
 
         GenericIOManager& GetIOManager(IOKind kind);
 
@@ -44,7 +50,42 @@ namespace Cesium
 
         const CriticalAssetManager& GetCriticalAssetManager() const;
 
+        // images and materials of glTF content, shared by every tileset and model
+        ContentAssetCache<AZ::RPI::StreamingImageAsset>& GetImageAssetCache();
+
+        ContentAssetCache<AZ::RPI::MaterialAsset>& GetMaterialAssetCache();
+
+        void SetHttpCacheMaximumBytes(std::uint64_t maximumBytes);
+
+        std::uint64_t GetHttpCacheMaximumBytes() const;
+
+        void ClearHttpCache();
+
+        CesiumSchedulerLaneStatistics GetSchedulerStatistics(CesiumSchedulerLane lane);
+
+        CesiumScheduler& GetScheduler();
+
     private:
+        static CesiumSchedulerConfiguration ReadSchedulerConfiguration();
+
+        static constexpr const char* const HTTP_CACHE_DIRECTORY = "@user@/Cesium/HttpCache";
+        static constexpr const char* const HTTP_CACHE_ENABLED_SETTING_KEY = "/O3DE/Cesium/HttpCache/Enabled";
+        static constexpr const char* const HTTP_CACHE_MAXIMUM_BYTES_SETTING_KEY = "/O3DE/Cesium/HttpCache/MaximumBytes";
+        static constexpr const char* const HTTP_MAX_CONNECTIONS_SETTING_KEY = "/O3DE/Cesium/Http/MaxConnections";
+        static constexpr const char* const HTTP_MAX_IN_FLIGHT_REQUESTS_SETTING_KEY = "/O3DE/Cesium/Http/MaxInFlightRequests";
+        static constexpr const char* const SCHEDULER_IO_THREAD_COUNT_SETTING_KEY = "/O3DE/Cesium/Scheduler/IOThreadCount";
+        static constexpr const char* const SCHEDULER_IO_FIRST_CORE_SETTING_KEY = "/O3DE/Cesium/Scheduler/IOFirstCore";
+        static constexpr const char* const SCHEDULER_FILE_THREAD_COUNT_SETTING_KEY = "/O3DE/Cesium/Scheduler/FileThreadCount";
+        static constexpr const char* const SCHEDULER_FILE_FIRST_CORE_SETTING_KEY = "/O3DE/Cesium/Scheduler/FileFirstCore";
+        static constexpr const char* const SCHEDULER_COMPUTE_THREAD_COUNT_SETTING_KEY = "/O3DE/Cesium/Scheduler/ComputeThreadCount";
+        static constexpr const char* const SCHEDULER_COMPUTE_FIRST_CORE_SETTING_KEY = "/O3DE/Cesium/Scheduler/ComputeFirstCore";
+        static constexpr const char* const SCHEDULER_USE_GLOBAL_JOB_CONTEXT_SETTING_KEY = "/O3DE/Cesium/Scheduler/UseGlobalJobContext";
+        static constexpr std::uint64_t DEFAULT_HTTP_CACHE_MAXIMUM_BYTES = 512ull * 1024ull * 1024ull;
+
+        // declared first, so every manager that submits work is destroyed before it. The destructor drains it before
+        // any member is destroyed, since tasks capture the accessors, the managers and the http response cache
+        AZStd::unique_ptr<CesiumScheduler> m_scheduler;
+        AZStd::unique_ptr<HttpResponseCache> m_httpResponseCache;
         AZStd::unique_ptr<HttpManager> m_httpManager;
         AZStd::unique_ptr<LocalFileManager> m_localFileManager;
         std::shared_ptr<CesiumAsync::IAssetAccessor> m_httpAssetAccessor;
@@ -53,6 +94,8 @@ namespace Cesium
         std::shared_ptr<spdlog::logger> m_logger;
         std::shared_ptr<Cesium3DTilesSelection::CreditSystem> m_creditSystem;
         CriticalAssetManager m_criticalAssetManager;
+        ContentAssetCache<AZ::RPI::StreamingImageAsset> m_imageAssetCache;
+        ContentAssetCache<AZ::RPI::MaterialAsset> m_materialAssetCache;
     };
 } // namespace Cesium
 
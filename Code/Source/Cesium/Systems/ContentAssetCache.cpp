@@ -0,0 +1,22 @@
+#include "Cesium/Systems/ContentAssetCache.h"
+
+namespace Cesium
+{
+    void ContentHasher::Add(const void* data, std::size_t size)
+    {
+        m_sha.ProcessBytes(data, size);
+    }
+
+    void ContentHasher::AddAssetId(const AZ::Data::AssetId& assetId)
+    {
+        AZStd::string assetIdString = assetId.ToString<AZStd::string>();
+        Add(assetIdString.data(), assetIdString.size());
+    }
+
+    ContentKey ContentHasher::Finish()
+    {
+        AZ::u32 digest[5];
+        m_sha.GetDigest(digest);
+        return AZStd::string::format("%08x%08x%08x%08x%08x", digest[0], digest[1], digest[2], digest[3], digest[4]);
+    }
+} // namespace Cesium
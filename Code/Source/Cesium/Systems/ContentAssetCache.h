@@ -0,0 +1,115 @@
+#pragma once
+
+#include <AzCore/Asset/AssetCommon.h>
+#include <AzCore/Math/Sha1.h>
+#include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/parallel/mutex.h>
+#include <AzCore/std/parallel/scoped_lock.h>
+#include <AzCore/std/string/string.h>
+#include <AzCore/std/algorithm.h>
+#include <cstddef>
+#include <type_traits>
+
+namespace Cesium
+{
+    using ContentKey = AZStd::string;
+
+    // Sha1 of everything an asset is built from, so assets built from the same content get the same key
+    class ContentHasher final
+    {
+    public:
+        void Add(const void* data, std::size_t size);
+
+        template<typename T>
+        void AddValue(const T& value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "Only values that are plain bytes can be hashed directly");
+            Add(&value, sizeof(T));
+        }
+
+        void AddAssetId(const AZ::Data::AssetId& assetId);
+
+        ContentKey Finish();
+
+    private:
+        AZ::Sha1 m_sha;
+    };
+
+    // Process wide cache of assets keyed by the hash of their content, so that tiles of every tileset that hold the same
+    // content share one asset, and the GPU resources instantiated from its id. The asset handles are reference counted,
+    // so the cache only drops an entry once no handle outside of it is left. Those entries are released whenever the cache
+    // doubles in size, or on request.
+    template<typename AssetType>
+    class ContentAssetCache final
+    {
+    public:
+        AZ::Data::Asset<AssetType> Find(const ContentKey& key) const
+        {
+            AZStd::scoped_lock lock(m_mutex);
+            auto it = m_assets.find(key);
+            if (it == m_assets.end())
+            {
+                return {};
+            }
+
+            return it->second;
+        }
+
+        // returns the asset stored first when several threads build the same content at once
+        AZ::Data::Asset<AssetType> Store(const ContentKey& key, const AZ::Data::Asset<AssetType>& asset)
+        {
+            AZStd::scoped_lock lock(m_mutex);
+            auto inserted = m_assets.insert({ key, asset });
+            if (inserted.second && m_assets.size() >= m_releaseThreshold)
+            {
+                ReleaseUnreferencedLocked();
+                m_releaseThreshold = AZStd::max(m_assets.size() * 2, MINIMUM_RELEASE_THRESHOLD);
+            }
+
+            return inserted.first->second;
+        }
+
+        void ReleaseUnreferenced()
+        {
+            AZStd::scoped_lock lock(m_mutex);
+            ReleaseUnreferencedLocked();
+        }
+
+        void Clear()
+        {
+            AZStd::scoped_lock lock(m_mutex);
+            m_assets.clear();
+            m_releaseThreshold = MINIMUM_RELEASE_THRESHOLD;
+        }
+
+        std::size_t GetSize() const
+        {
+            AZStd::scoped_lock lock(m_mutex);
+            return m_assets.size();
+        }
+
+    private:
+        void ReleaseUnreferencedLocked()
+        {
+            for (auto it = m_assets.begin(); it != m_assets.end();)
+            {
+                // the handle of the cache is the only one left
+                const AZ::Data::AssetData* assetData = it->second.Get();
+                if (!assetData || assetData->GetUseCount() <= 1)
+                {
+                    it = m_assets.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+        }
+
+        static constexpr std::size_t MINIMUM_RELEASE_THRESHOLD = 64;
+
+        mutable AZStd::mutex m_mutex;
+        AZStd::unordered_map<ContentKey, AZ::Data::Asset<AssetType>> m_assets;
+        std::size_t m_releaseThreshold{ MINIMUM_RELEASE_THRESHOLD };
+    };
+} // namespace Cesium
@@ -27,6 +27,11 @@ namespace Cesium
         {
             AZ_Error("Cesium", false, "Failed to load critical material type asset: %s", RASTER_MAT_TYPE);
         }
+        else
+        {
+            m_rasterMaterialProperties.Build(*m_rasterMaterialType->GetMaterialPropertiesLayout());
+            AZ_Error("Cesium", m_rasterMaterialProperties.IsValid(), "Raster properties are missing from %s", RASTER_MAT_TYPE);
+        }
 
         AzFramework::AssetCatalogEventBus::Handler::BusDisconnect();
     }
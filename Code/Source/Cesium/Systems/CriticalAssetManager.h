@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Cesium/TilesetUtility/RasterMaterialProperties.h"
 #include <Atom/RPI.Reflect/Material/MaterialTypeAsset.h>
 #include <AzFramework/Asset/AssetCatalogBus.h>
 #include <AzCore/Asset/AssetCommon.h>
@@ -20,6 +21,7 @@ namespace Cesium
 
         AZ::Data::Asset<AZ::RPI::MaterialTypeAsset> m_standardPbrMaterialType;
         AZ::Data::Asset<AZ::RPI::MaterialTypeAsset> m_rasterMaterialType;
+        RasterMaterialProperties m_rasterMaterialProperties;
 
     private:
         static constexpr const char* const STANDARD_PBR_MAT_TYPE = "Materials/Types/StandardPBR.azmaterialtype";
@@ -10,12 +10,12 @@ namespace Cesium
 
     struct GenericAssetAccessor::RequestAssetHandler
     {
-        std::shared_ptr<CesiumAsync::IAssetRequest> operator()(IOContent&& result)
+        std::shared_ptr<CesiumAsync::IAssetRequest> operator()(MappedIOContent&& result)
         {
             // Hack: We need to add prefix here, so that Cesium Native can compose absolute url from base url and relative url correctly
             m_url = PREFIX + m_url;
             std::uint16_t responseStatus = 200;
-            if (result.empty())
+            if (result.IsEmpty())
             {
                 responseStatus = 404;
             }
@@ -43,11 +43,11 @@ namespace Cesium
         if (url.substr(0, PREFIX.size()) == PREFIX)
         {
             std::string noPrefixUrl = url.substr(PREFIX.size());
-            return m_ioManager->GetFileContentAsync(asyncSystem, IORequestParameter{ "", noPrefixUrl.c_str() })
+            return m_ioManager->GetMappedFileContentAsync(asyncSystem, IORequestParameter{ "", noPrefixUrl.c_str() })
                 .thenImmediately(RequestAssetHandler{ m_contentType, noPrefixUrl, ConvertToCesiumHeaders(headers) });
         }
 
-        return m_ioManager->GetFileContentAsync(asyncSystem, IORequestParameter{ "", url.c_str() })
+        return m_ioManager->GetMappedFileContentAsync(asyncSystem, IORequestParameter{ "", url.c_str() })
             .thenImmediately(RequestAssetHandler{ m_contentType, url, ConvertToCesiumHeaders(headers) });
     }
 
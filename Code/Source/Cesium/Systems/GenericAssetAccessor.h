@@ -11,7 +11,7 @@ namespace Cesium
     class GenericAssetResponse final : public CesiumAsync::IAssetResponse
     {
     public:
-        GenericAssetResponse(std::uint16_t statusCode, std::string&& contentType, IOContent&& ioContent)
+        GenericAssetResponse(std::uint16_t statusCode, std::string&& contentType, MappedIOContent&& ioContent)
             : m_statusCode{ statusCode }
             , m_contentType{ std::move(contentType) }
             , m_ioContent{ std::move(ioContent) }
@@ -35,7 +35,7 @@ namespace Cesium
 
         gsl::span<const std::byte> data() const override
         {
-            return gsl::span<const std::byte>(m_ioContent.data(), m_ioContent.size());
+            return m_ioContent.GetData();
         }
 
     private:
@@ -43,7 +43,7 @@ namespace Cesium
 
         std::uint16_t m_statusCode;
         std::string m_contentType;
-        IOContent m_ioContent;
+        MappedIOContent m_ioContent;
     };
 
     class GenericAssetRequest final : public CesiumAsync::IAssetRequest
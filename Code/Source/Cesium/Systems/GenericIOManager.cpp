@@ -1 +1,50 @@
 #include "Cesium/Systems/GenericIOManager.h"
+
+namespace Cesium
+{
+    MappedIOContent::MappedIOContent(IOContent&& content)
+        : m_content{ std::move(content) }
+    {
+    }
+
+    MappedIOContent::MappedIOContent(AZStd::unique_ptr<MappedFile> mappedFile)
+        : m_mappedFile{ std::move(mappedFile) }
+    {
+    }
+
+    gsl::span<const std::byte> MappedIOContent::GetData() const
+    {
+        if (m_mappedFile)
+        {
+            return m_mappedFile->GetData();
+        }
+
+        return gsl::span<const std::byte>(m_content.data(), m_content.size());
+    }
+
+    bool MappedIOContent::IsMapped() const
+    {
+        return m_mappedFile != nullptr;
+    }
+
+    bool MappedIOContent::IsEmpty() const
+    {
+        return GetData().empty();
+    }
+
+    MappedIOContent GenericIOManager::GetMappedFileContent(const IORequestParameter& request)
+    {
+        return MappedIOContent(GetFileContent(request));
+    }
+
+    CesiumAsync::Future<MappedIOContent> GenericIOManager::GetMappedFileContentAsync(
+        const CesiumAsync::AsyncSystem& asyncSystem, IORequestParameter&& request)
+    {
+        return GetFileContentAsync(asyncSystem, std::move(request))
+            .thenImmediately(
+                [](IOContent&& content)
+                {
+                    return MappedIOContent(std::move(content));
+                });
+    }
+} // namespace Cesium
@@ -1,9 +1,12 @@
 #pragma once
 
+#include "Cesium/Systems/MappedFile.h"
 #include <AzCore/std/containers/vector.h>
+#include <AzCore/std/smart_ptr/unique_ptr.h>
 #include <AzCore/std/string/string.h>
 #include <CesiumAsync/AsyncSystem.h>
 #include <CesiumAsync/Future.h>
+#include <gsl/span>
 #include <cstddef>
 #include <vector>
 
@@ -17,6 +20,28 @@ namespace Cesium
 
     using IOContent = std::vector<std::byte>;
 
+    // Read-only file content that is either owned in memory or mapped from disk. The mapping is released
+    // together with the content, e.g. when the asset response holding it is freed.
+    class MappedIOContent final
+    {
+    public:
+        MappedIOContent() = default;
+
+        explicit MappedIOContent(IOContent&& content);
+
+        explicit MappedIOContent(AZStd::unique_ptr<MappedFile> mappedFile);
+
+        gsl::span<const std::byte> GetData() const;
+
+        bool IsMapped() const;
+
+        bool IsEmpty() const;
+
+    private:
+        IOContent m_content;
+        AZStd::unique_ptr<MappedFile> m_mappedFile;
+    };
+
     class GenericIOManager
     {
     public:
@@ -33,5 +58,11 @@ namespace Cesium
 
         virtual CesiumAsync::Future<IOContent> GetFileContentAsync(
             const CesiumAsync::AsyncSystem& asyncSystem, IORequestParameter&& request) = 0;
+
+        // Managers that can map files override these. The default implementations read the file into memory.
+        virtual MappedIOContent GetMappedFileContent(const IORequestParameter& request);
+
+        virtual CesiumAsync::Future<MappedIOContent> GetMappedFileContentAsync(
+            const CesiumAsync::AsyncSystem& asyncSystem, IORequestParameter&& request);
     };
 } // namespace Cesium
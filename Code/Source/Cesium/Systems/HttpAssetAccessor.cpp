@@ -1,13 +1,16 @@
 #include "Cesium/Systems/HttpAssetAccessor.h"
 #include "Cesium/PlatformInfo/PlatformInfo.h"
+#include <AzCore/std/parallel/scoped_lock.h>
 #include <cassert>
 #include <string>
-#include <zlib.h>
 
 namespace Cesium
 {
-    HttpAssetAccessor::HttpAssetAccessor(HttpManager* httpManager)
+    thread_local HttpAssetAccessor::RequestScope HttpAssetAccessor::s_requestScope;
+
+    HttpAssetAccessor::HttpAssetAccessor(HttpManager* httpManager, HttpResponseCache* responseCache)
         : m_httpManager{ httpManager }
+        , m_responseCache{ responseCache }
     {
         std::string engineVersion = PlatformInfo::GetEngineVersion().c_str();
         m_userAgentHeaderValue = std::string("Mozilla/5.0 (") + PlatformInfo::GetPlatformName().c_str() + ") Cesium For O3DE/" +
@@ -19,13 +22,43 @@ namespace Cesium
     {
         CesiumAsync::HttpHeaders requestHeaders = ConvertToCesiumHeaders(headers);
         requestHeaders[USER_AGENT_HEADER_KEY] = m_userAgentHeaderValue;
-        HttpRequestParameter parameter(AZStd ::string(url.c_str()), Aws::Http::HttpMethod::HTTP_GET, std::move(requestHeaders));
-        return m_httpManager->AddRequest(asyncSystem, std::move(parameter))
-            .thenImmediately(
-                [](HttpResult&& result) -> std::shared_ptr<CesiumAsync::IAssetRequest>
+        if (!m_responseCache)
+        {
+            return RequestAndCacheAsset(asyncSystem, url, std::move(requestHeaders), AZStd::nullopt, s_requestScope);
+        }
+
+        // fresh responses are served from disk without touching the network
+        AZStd::string cacheKey = HttpResponseCache::CreateCacheKey(url, requestHeaders);
+        AZStd::optional<HttpCachedResponse> cachedResponse = m_responseCache->Find(cacheKey);
+        if (cachedResponse && cachedResponse->m_isFresh)
+        {
+            return asyncSystem.runInWorkerThread(
+                [this,
+                 asyncSystem,
+                 url,
+                 cacheKey = std::move(cacheKey),
+                 requestHeaders = std::move(requestHeaders),
+                 cachedResponse = std::move(*cachedResponse),
+                 requestScope = s_requestScope]() mutable
                 {
-                    return HttpAssetAccessor::CreateO3DEAssetRequest(*result.m_request, result.m_response.get());
+                    IOContent content = HttpResponseCache::ReadBlob(cachedResponse.m_blobPath);
+                    if (content.empty())
+                    {
+                        m_responseCache->Remove(cacheKey);
+                        return RequestAndCacheAsset(asyncSystem, url, std::move(requestHeaders), AZStd::nullopt, requestScope);
+                    }
+
+                    if (requestScope.m_scopeId != 0)
+                    {
+                        CountCompletedRequest(requestScope.m_scopeId);
+                    }
+
+                    return asyncSystem.createResolvedFuture<std::shared_ptr<CesiumAsync::IAssetRequest>>(
+                        CreateCachedAssetRequest(url, requestHeaders, cachedResponse, std::move(content)));
                 });
+        }
+
+        return RequestAndCacheAsset(asyncSystem, url, std::move(requestHeaders), std::move(cachedResponse), s_requestScope);
     }
 
     CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>> HttpAssetAccessor::post(
@@ -41,8 +74,13 @@ namespace Cesium
             AZStd ::string(url.c_str()), Aws::Http::HttpMethod::HTTP_POST, std::move(requestHeaders), std::move(requestBody));
         return m_httpManager->AddRequest(asyncSystem, std::move(parameter))
             .thenImmediately(
-                [](HttpResult&& result) -> std::shared_ptr<CesiumAsync::IAssetRequest>
+                [url, headers = ConvertToCesiumHeaders(headers)](HttpResult&& result) -> std::shared_ptr<CesiumAsync::IAssetRequest>
                 {
+                    if (result.m_cancelled)
+                    {
+                        return HttpAssetAccessor::CreateCancelledAssetRequest("POST", url, headers);
+                    }
+
                     return HttpAssetAccessor::CreateO3DEAssetRequest(*result.m_request, result.m_response.get());
                 });
     }
@@ -51,6 +89,265 @@ namespace Cesium
     {
     }
 
+    HttpAssetAccessor::RequestScopeGuard::RequestScopeGuard(const RequestScope& requestScope)
+        : m_previousScope{ s_requestScope }
+    {
+        s_requestScope = requestScope;
+    }
+
+    HttpAssetAccessor::RequestScopeGuard::~RequestScopeGuard() noexcept
+    {
+        s_requestScope = m_previousScope;
+    }
+
+    HttpAssetAccessor::RequestScope HttpAssetAccessor::GetCurrentRequestScope()
+    {
+        return s_requestScope;
+    }
+
+    void HttpAssetAccessor::BeginRequestScope(std::uint64_t scopeId, std::int64_t priority)
+    {
+        s_requestScope = RequestScope{ scopeId, priority };
+        if (scopeId != 0)
+        {
+            AZStd::scoped_lock<AZStd::mutex> lock(m_requestScopesMutex);
+            m_requestScopes[scopeId].m_released = false;
+        }
+    }
+
+    void HttpAssetAccessor::EndRequestScope()
+    {
+        s_requestScope = RequestScope{};
+    }
+
+    void HttpAssetAccessor::SetRequestScopePriority(std::uint64_t scopeId, std::int64_t priority)
+    {
+        for (HttpRequestId requestId : GetScopeRequests(scopeId))
+        {
+            m_httpManager->SetRequestPriority(requestId, priority);
+        }
+    }
+
+    void HttpAssetAccessor::CancelRequestScope(std::uint64_t scopeId)
+    {
+        // cancelled requests resolve immediately and untrack themselves, so they can't be cancelled while holding the lock
+        for (HttpRequestId requestId : GetScopeRequests(scopeId))
+        {
+            m_httpManager->CancelRequest(requestId);
+        }
+
+        AZStd::scoped_lock<AZStd::mutex> lock(m_requestScopesMutex);
+        auto scopeIt = m_requestScopes.find(scopeId);
+        if (scopeIt == m_requestScopes.end())
+        {
+            return;
+        }
+
+        // requests that were already resolving when they got cancelled untrack themselves later
+        if (scopeIt->second.m_inFlightRequests.empty())
+        {
+            m_requestScopes.erase(scopeIt);
+        }
+        else
+        {
+            scopeIt->second.m_released = true;
+        }
+    }
+
+    HttpRequestScopeStatistics HttpAssetAccessor::GetRequestScopeStatistics(std::uint64_t scopeId)
+    {
+        AZStd::scoped_lock<AZStd::mutex> lock(m_requestScopesMutex);
+        HttpRequestScopeStatistics statistics;
+        auto scopeIt = m_requestScopes.find(scopeId);
+        if (scopeIt != m_requestScopes.end())
+        {
+            statistics.m_inFlightRequests = scopeIt->second.m_inFlightRequests.size();
+            statistics.m_completedRequests = scopeIt->second.m_completedRequests;
+        }
+
+        return statistics;
+    }
+
+    bool HttpAssetAccessor::TrackRequest(std::uint64_t scopeId, HttpRequestId requestId)
+    {
+        // a scope is only missing or released once it is cancelled, until it begins again
+        AZStd::scoped_lock<AZStd::mutex> lock(m_requestScopesMutex);
+        auto scopeIt = m_requestScopes.find(scopeId);
+        if (scopeIt == m_requestScopes.end() || scopeIt->second.m_released)
+        {
+            return false;
+        }
+
+        scopeIt->second.m_inFlightRequests.insert(requestId);
+        return true;
+    }
+
+    void HttpAssetAccessor::UntrackRequest(std::uint64_t scopeId, HttpRequestId requestId, bool completed)
+    {
+        // the scope is kept after its last request finishes, so its completed count survives until the scope is cancelled
+        AZStd::scoped_lock<AZStd::mutex> lock(m_requestScopesMutex);
+        auto scopeIt = m_requestScopes.find(scopeId);
+        if (scopeIt == m_requestScopes.end())
+        {
+            return;
+        }
+
+        RequestScopeState& scope = scopeIt->second;
+        scope.m_inFlightRequests.erase(requestId);
+        if (scope.m_released && scope.m_inFlightRequests.empty())
+        {
+            m_requestScopes.erase(scopeIt);
+        }
+        else if (completed)
+        {
+            ++scope.m_completedRequests;
+        }
+    }
+
+    void HttpAssetAccessor::CountCompletedRequest(std::uint64_t scopeId)
+    {
+        // responses read from the cache after the scope is cancelled don't bring it back
+        AZStd::scoped_lock<AZStd::mutex> lock(m_requestScopesMutex);
+        auto scopeIt = m_requestScopes.find(scopeId);
+        if (scopeIt != m_requestScopes.end() && !scopeIt->second.m_released)
+        {
+            ++scopeIt->second.m_completedRequests;
+        }
+    }
+
+    AZStd::vector<HttpRequestId> HttpAssetAccessor::GetScopeRequests(std::uint64_t scopeId)
+    {
+        AZStd::scoped_lock<AZStd::mutex> lock(m_requestScopesMutex);
+        auto scopeIt = m_requestScopes.find(scopeId);
+        if (scopeIt == m_requestScopes.end())
+        {
+            return {};
+        }
+
+        return AZStd::vector<HttpRequestId>(scopeIt->second.m_inFlightRequests.begin(), scopeIt->second.m_inFlightRequests.end());
+    }
+
+    CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>> HttpAssetAccessor::RequestAndCacheAsset(
+        const CesiumAsync::AsyncSystem& asyncSystem,
+        const std::string& url,
+        CesiumAsync::HttpHeaders&& requestHeaders,
+        AZStd::optional<HttpCachedResponse>&& staleResponse,
+        const RequestScope& requestScope)
+    {
+        // ask the server to revalidate the stale response instead of sending the whole body again
+        if (staleResponse)
+        {
+            auto etag = staleResponse->m_headers.find(ETAG_HEADER_KEY);
+            if (etag != staleResponse->m_headers.end())
+            {
+                requestHeaders[IF_NONE_MATCH_HEADER_KEY] = etag->second;
+            }
+
+            auto lastModified = staleResponse->m_headers.find(LAST_MODIFIED_HEADER_KEY);
+            if (lastModified != staleResponse->m_headers.end())
+            {
+                requestHeaders[IF_MODIFIED_SINCE_HEADER_KEY] = lastModified->second;
+            }
+        }
+
+        CesiumAsync::HttpHeaders cachedRequestHeaders = requestHeaders;
+        AZStd::string cacheKey = m_responseCache ? HttpResponseCache::CreateCacheKey(url, requestHeaders) : AZStd::string{};
+        HttpRequestParameter parameter(AZStd ::string(url.c_str()), Aws::Http::HttpMethod::HTTP_GET, std::move(requestHeaders));
+        std::uint64_t scopeId = requestScope.m_scopeId;
+        HttpRequestId requestId = scopeId != 0 ? HttpManager::GenerateRequestId() : 0;
+        parameter.m_priority = requestScope.m_priority;
+        parameter.m_requestId = requestId;
+        if (scopeId != 0 && !TrackRequest(scopeId, requestId))
+        {
+            // follow-up requests of a cancelled scope are cancelled with it
+            return asyncSystem.createResolvedFuture<std::shared_ptr<CesiumAsync::IAssetRequest>>(
+                CreateCancelledAssetRequest("GET", url, cachedRequestHeaders));
+        }
+
+        // the result is handed to Cesium Native under the scope of the request, so the tasks its continuations start, and
+        // the requests those make, keep the scope even though the response arrives on an I/O worker
+        auto promise = asyncSystem.createPromise<std::shared_ptr<CesiumAsync::IAssetRequest>>();
+        auto future = promise.getFuture();
+        m_httpManager->AddRequest(asyncSystem, std::move(parameter))
+            .thenImmediately(
+                [this,
+                 scopeId,
+                 requestId,
+                 responseCache = m_responseCache,
+                 url,
+                 cacheKey = std::move(cacheKey),
+                 cachedRequestHeaders = std::move(cachedRequestHeaders),
+                 staleResponse = std::move(staleResponse)](HttpResult&& result) -> std::shared_ptr<CesiumAsync::IAssetRequest>
+                {
+                    if (scopeId != 0)
+                    {
+                        UntrackRequest(scopeId, requestId, !result.m_cancelled);
+                    }
+
+                    if (result.m_cancelled)
+                    {
+                        return HttpAssetAccessor::CreateCancelledAssetRequest("GET", url, cachedRequestHeaders);
+                    }
+
+                    std::shared_ptr<HttpAssetRequest> assetRequest =
+                        HttpAssetAccessor::CreateO3DEAssetRequest(*result.m_request, result.m_response.get());
+                    if (!responseCache)
+                    {
+                        return assetRequest;
+                    }
+
+                    const CesiumAsync::IAssetResponse* response = assetRequest->response();
+                    if (response->statusCode() == HTTP_NOT_MODIFIED && staleResponse &&
+                        responseCache->Revalidate(cacheKey, response->headers()))
+                    {
+                        IOContent content = HttpResponseCache::ReadBlob(staleResponse->m_blobPath);
+                        if (!content.empty())
+                        {
+                            return CreateCachedAssetRequest(url, cachedRequestHeaders, *staleResponse, std::move(content));
+                        }
+
+                        responseCache->Remove(cacheKey);
+                    }
+                    else if (response->statusCode() == HTTP_OK)
+                    {
+                        responseCache->Store(
+                            cacheKey, response->statusCode(), response->contentType(), response->headers(), response->data());
+                    }
+
+                    return assetRequest;
+                })
+            .thenImmediately(
+                [promise = std::move(promise), requestScope](std::shared_ptr<CesiumAsync::IAssetRequest>&& assetRequest)
+                {
+                    RequestScopeGuard scopeGuard(requestScope);
+                    promise.resolve(std::move(assetRequest));
+                });
+
+        return future;
+    }
+
+    std::shared_ptr<HttpAssetRequest> HttpAssetAccessor::CreateCachedAssetRequest(
+        const std::string& url,
+        const CesiumAsync::HttpHeaders& requestHeaders,
+        const HttpCachedResponse& cachedResponse,
+        IOContent&& content)
+    {
+        std::string contentType = cachedResponse.m_contentType;
+        CesiumAsync::HttpHeaders responseHeaders = cachedResponse.m_headers;
+        auto assetResponse = std::make_unique<HttpAssetResponse>(
+            cachedResponse.m_statusCode, std::move(contentType), std::move(responseHeaders), std::move(content));
+        CesiumAsync::HttpHeaders headers = requestHeaders;
+        return std::make_shared<HttpAssetRequest>("GET", std::string(url), std::move(headers), std::move(assetResponse));
+    }
+
+    std::shared_ptr<HttpAssetRequest> HttpAssetAccessor::CreateCancelledAssetRequest(
+        std::string&& method, const std::string& url, const CesiumAsync::HttpHeaders& requestHeaders)
+    {
+        // cancelled requests never received a response
+        CesiumAsync::HttpHeaders headers = requestHeaders;
+        return std::make_shared<HttpAssetRequest>(std::move(method), std::string(url), std::move(headers), nullptr);
+    }
+
     std::string HttpAssetAccessor::ConvertMethodToString(Aws::Http::HttpMethod method)
     {
         switch (method)
@@ -121,63 +418,10 @@ namespace Cesium
         std::string contentType = response.GetContentType().c_str();
         CesiumAsync::HttpHeaders headers = ConvertToCesiumHeaders(response.GetHeaders());
 
-        // try to decompress gzip if there are any
+        // the body is decoded while it is received, so the encoding doesn't describe the content anymore
         IOContent responseContent = HttpManager::GetResponseBodyContent(response);
-        auto contentEncoding = headers.find(CONTENT_ENCODING_HEADER_KEY);
-        if (contentEncoding != headers.end())
-        {
-            if (contentEncoding->second.find("gzip") != std::string::npos)
-            {
-                return std::make_unique<HttpAssetResponse>(
-                    statusCode, std::move(contentType), std::move(headers), DecodeGzip(responseContent));
-            }
-        }
+        headers.erase(CONTENT_ENCODING_HEADER_KEY);
 
         return std::make_unique<HttpAssetResponse>(statusCode, std::move(contentType), std::move(headers), std::move(responseContent));
     }
-
-    IOContent HttpAssetAccessor::DecodeGzip(IOContent& content)
-    {
-        z_stream zs; // z_stream is zlib's control structure
-        memset(&zs, 0, sizeof(zs));
-
-        if (inflateInit2(&zs, MAX_WBITS + 16) != Z_OK)
-        {
-            return std::move(content);
-        }
-
-        zs.next_in = reinterpret_cast<Bytef*>(content.data());
-        zs.avail_in = static_cast<uInt>(content.size());
-
-        int ret;
-        char outbuffer[32768];
-        IOContent output;
-
-        // get the decompressed bytes blockwise using repeated calls to inflate
-        do
-        {
-            zs.next_out = reinterpret_cast<Bytef*>(outbuffer);
-            zs.avail_out = sizeof(outbuffer);
-
-            ret = inflate(&zs, 0);
-
-            if (output.size() < zs.total_out)
-            {
-                std::size_t decompressSoFar = output.size();
-                std::size_t addSize = zs.total_out - output.size();
-                output.resize(output.size() + addSize);
-                std::memcpy(output.data() + decompressSoFar, outbuffer, addSize);
-            }
-
-        } while (ret == Z_OK);
-
-        inflateEnd(&zs);
-
-        if (ret != Z_STREAM_END)
-        {
-            return std::move(content);
-        }
-
-        return output;
-    }
 } // namespace Cesium
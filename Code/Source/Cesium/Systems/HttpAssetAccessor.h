@@ -1,6 +1,12 @@
 #pragma once
 
 #include "Cesium/Systems/HttpManager.h"
+#include "Cesium/Systems/HttpResponseCache.h"
+#include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/containers/unordered_set.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/optional.h>
+#include <AzCore/std/parallel/mutex.h>
 #include <AzCore/std/smart_ptr/shared_ptr.h>
 #include <CesiumAsync/AsyncSystem.h>
 #include <CesiumAsync/Future.h>
@@ -8,6 +14,7 @@
 #include <CesiumAsync/IAssetResponse.h>
 #include <aws/core/http/HttpTypes.h>
 #include <cstdint>
+#include <limits>
 #include <map>
 #include <memory>
 #include <string>
@@ -103,10 +110,18 @@ namespace Cesium
         std::unique_ptr<HttpAssetResponse> m_response;
     };
 
+    struct HttpRequestScopeStatistics final
+    {
+        std::uint64_t m_inFlightRequests{ 0 };
+
+        // requests that received a response, including the ones served from the response cache
+        std::uint64_t m_completedRequests{ 0 };
+    };
+
     class HttpAssetAccessor final : public CesiumAsync::IAssetAccessor
     {
     public:
-        HttpAssetAccessor(HttpManager* httpManager);
+        HttpAssetAccessor(HttpManager* httpManager, HttpResponseCache* responseCache = nullptr);
 
         CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>> requestAsset(
             const CesiumAsync::AsyncSystem& asyncSystem, const std::string& url, const std::vector<THeader>& headers = {}) override;
@@ -119,7 +134,86 @@ namespace Cesium
 
         void tick() noexcept override;
 
+        // Requests made on the calling thread between BeginRequestScope and EndRequestScope are tagged with the scope,
+        // so they can be reprioritized or cancelled together, e.g. all the tile requests of a tileset.
+        void BeginRequestScope(std::uint64_t scopeId, std::int64_t priority);
+
+        void EndRequestScope();
+
+        void SetRequestScopePriority(std::uint64_t scopeId, std::int64_t priority);
+
+        void CancelRequestScope(std::uint64_t scopeId);
+
+        HttpRequestScopeStatistics GetRequestScopeStatistics(std::uint64_t scopeId);
+
+        static constexpr std::int64_t LOWEST_REQUEST_PRIORITY = std::numeric_limits<std::int64_t>::min() + 1;
+        static constexpr std::int64_t HIGHEST_REQUEST_PRIORITY = std::numeric_limits<std::int64_t>::max();
+
+        // requests made outside of any scope neither jump ahead of scoped requests nor wait behind prefetches
+        static constexpr std::int64_t DEFAULT_REQUEST_PRIORITY = 0;
+
+        struct RequestScope
+        {
+            std::uint64_t m_scopeId{ 0 };
+            std::int64_t m_priority{ DEFAULT_REQUEST_PRIORITY };
+        };
+
+        // Makes a scope current on the calling thread while the guard lives. Continuations of a scoped request resolve under
+        // its scope and TaskProcessor hands the current scope on to the tasks it starts, so follow-up requests made from
+        // Cesium Native continuations, e.g. subtrees and external tilesets, are prioritized and cancelled with their tile
+        class RequestScopeGuard final
+        {
+        public:
+            explicit RequestScopeGuard(const RequestScope& requestScope);
+
+            RequestScopeGuard(const RequestScopeGuard&) = delete;
+
+            RequestScopeGuard& operator=(const RequestScopeGuard&) = delete;
+
+            ~RequestScopeGuard() noexcept;
+
+        private:
+            RequestScope m_previousScope;
+        };
+
+        static RequestScope GetCurrentRequestScope();
+
     private:
+
+        struct RequestScopeState
+        {
+            AZStd::unordered_set<HttpRequestId> m_inFlightRequests;
+            std::uint64_t m_completedRequests{ 0 };
+
+            // set once the scope is cancelled. Released scopes are erased as soon as their last request finishes
+            bool m_released{ false };
+        };
+
+        CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>> RequestAndCacheAsset(
+            const CesiumAsync::AsyncSystem& asyncSystem,
+            const std::string& url,
+            CesiumAsync::HttpHeaders&& requestHeaders,
+            AZStd::optional<HttpCachedResponse>&& staleResponse,
+            const RequestScope& requestScope);
+
+        // returns false when the scope is cancelled, in which case the request isn't tracked and must not be sent
+        bool TrackRequest(std::uint64_t scopeId, HttpRequestId requestId);
+
+        void UntrackRequest(std::uint64_t scopeId, HttpRequestId requestId, bool completed);
+
+        void CountCompletedRequest(std::uint64_t scopeId);
+
+        AZStd::vector<HttpRequestId> GetScopeRequests(std::uint64_t scopeId);
+
+        static std::shared_ptr<HttpAssetRequest> CreateCancelledAssetRequest(
+            std::string&& method, const std::string& url, const CesiumAsync::HttpHeaders& requestHeaders);
+
+        static std::shared_ptr<HttpAssetRequest> CreateCachedAssetRequest(
+            const std::string& url,
+            const CesiumAsync::HttpHeaders& requestHeaders,
+            const HttpCachedResponse& cachedResponse,
+            IOContent&& content);
+
         static std::string ConvertMethodToString(Aws::Http::HttpMethod method);
 
         static CesiumAsync::HttpHeaders ConvertToCesiumHeaders(const std::vector<THeader>& headers);
@@ -131,12 +225,21 @@ namespace Cesium
 
         static std::unique_ptr<HttpAssetResponse> CreateO3DEAssetResponse(Aws::Http::HttpResponse& response);
 
-        static IOContent DecodeGzip(IOContent& content);
-
         static constexpr const char* const USER_AGENT_HEADER_KEY = "User-Agent";
         static constexpr const char* const CONTENT_ENCODING_HEADER_KEY = "Content-Encoding";
+        static constexpr const char* const ETAG_HEADER_KEY = "ETag";
+        static constexpr const char* const LAST_MODIFIED_HEADER_KEY = "Last-Modified";
+        static constexpr const char* const IF_NONE_MATCH_HEADER_KEY = "If-None-Match";
+        static constexpr const char* const IF_MODIFIED_SINCE_HEADER_KEY = "If-Modified-Since";
+        static constexpr std::uint16_t HTTP_OK = 200;
+        static constexpr std::uint16_t HTTP_NOT_MODIFIED = 304;
 
         std::string m_userAgentHeaderValue;
         HttpManager* m_httpManager;
+        HttpResponseCache* m_responseCache;
+        AZStd::mutex m_requestScopesMutex;
+        AZStd::unordered_map<std::uint64_t, RequestScopeState> m_requestScopes;
+
+        static thread_local RequestScope s_requestScope;
     };
 } // namespace Cesium
@@ -0,0 +1,238 @@
+#include "Cesium/Systems/HttpContentDecoder.h"
+#include <AzCore/std/string/conversions.h>
+#include <AzCore/std/string/string.h>
+#include <algorithm>
+#include <cstring>
+
+namespace Cesium
+{
+    HttpContentDecoder::HttpContentDecoder(const std::string& contentEncoding)
+        : m_state{ State::Detecting }
+        , m_allowRawDeflate{ false }
+        , m_inflateInitialized{ false }
+        , m_multiMember{ false }
+    {
+        std::memset(&m_stream, 0, sizeof(m_stream));
+
+        // some servers send raw deflate data for "deflate" instead of the zlib format the spec asks for
+        AZStd::string encoding = contentEncoding.c_str();
+        AZStd::to_lower(encoding.begin(), encoding.end());
+        m_allowRawDeflate = encoding.find("deflate") != AZStd::string::npos && encoding.find("gzip") == AZStd::string::npos;
+    }
+
+    HttpContentDecoder::~HttpContentDecoder() noexcept
+    {
+        if (m_inflateInitialized)
+        {
+            inflateEnd(&m_stream);
+        }
+    }
+
+    bool HttpContentDecoder::Decode(const std::byte* data, std::size_t size, IOContent& output)
+    {
+        switch (m_state)
+        {
+        case State::Detecting:
+        {
+            m_pendingInput.insert(m_pendingInput.end(), data, data + size);
+            if (m_pendingInput.size() < 2)
+            {
+                return true;
+            }
+
+            if (!Detect())
+            {
+                m_state = State::Failed;
+                return false;
+            }
+
+            IOContent pendingInput = std::move(m_pendingInput);
+            m_pendingInput = IOContent{};
+            return Decode(pendingInput.data(), pendingInput.size(), output);
+        }
+        case State::Inflating:
+            return Inflate(data, size, output);
+        case State::MemberEnded:
+        {
+            // the magic bytes of the next gzip member may arrive in a later chunk than the end of the previous member
+            if (m_pendingInput.empty() && size >= 2)
+            {
+                return InflateNextMember(data, size, output);
+            }
+
+            m_pendingInput.insert(m_pendingInput.end(), data, data + size);
+            if (m_pendingInput.size() < 2)
+            {
+                return true;
+            }
+
+            IOContent pendingInput = std::move(m_pendingInput);
+            m_pendingInput = IOContent{};
+            return InflateNextMember(pendingInput.data(), pendingInput.size(), output);
+        }
+        case State::PassThrough:
+            output.insert(output.end(), data, data + size);
+            return true;
+        case State::Finished:
+            // ignore anything that comes after the end of the compressed stream
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    bool HttpContentDecoder::IsFinished() const
+    {
+        return m_state == State::Finished || m_state == State::MemberEnded || m_state == State::PassThrough ||
+            (m_state == State::Detecting && m_pendingInput.empty());
+    }
+
+    bool HttpContentDecoder::IsSupportedEncoding(const std::string& contentEncoding)
+    {
+        AZStd::string encoding = contentEncoding.c_str();
+        AZStd::to_lower(encoding.begin(), encoding.end());
+        return encoding.find("gzip") != AZStd::string::npos || encoding.find("deflate") != AZStd::string::npos;
+    }
+
+    std::size_t HttpContentDecoder::GetDecodedSizeHint(const IOContent& content)
+    {
+        // gzip stores the size of the uncompressed data modulo 2^32 in the last 4 bytes (ISIZE) of the stream.
+        // The decoded data can't be smaller than the compressed data, so use it as a lower bound otherwise
+        constexpr std::size_t minGzipSize = 18;
+        if (content.size() < minGzipSize || content[0] != std::byte{ 0x1f } || content[1] != std::byte{ 0x8b })
+        {
+            return content.size();
+        }
+
+        const std::byte* trailer = content.data() + content.size() - 4;
+        std::size_t decodedSize = std::to_integer<std::size_t>(trailer[0]) | (std::to_integer<std::size_t>(trailer[1]) << 8) |
+            (std::to_integer<std::size_t>(trailer[2]) << 16) | (std::to_integer<std::size_t>(trailer[3]) << 24);
+        return std::min(decodedSize, content.size() * MAX_COMPRESSION_RATIO);
+    }
+
+    IOContent HttpContentDecoder::DecodeContent(const std::string& contentEncoding, IOContent&& content)
+    {
+        if (!IsSupportedEncoding(contentEncoding))
+        {
+            return std::move(content);
+        }
+
+        HttpContentDecoder decoder(contentEncoding);
+        IOContent output;
+        output.reserve(GetDecodedSizeHint(content));
+        if (!decoder.Decode(content.data(), content.size(), output) || !decoder.IsFinished())
+        {
+            return std::move(content);
+        }
+
+        return output;
+    }
+
+    bool HttpContentDecoder::Detect()
+    {
+        std::uint8_t cmf = std::to_integer<std::uint8_t>(m_pendingInput[0]);
+        std::uint8_t flag = std::to_integer<std::uint8_t>(m_pendingInput[1]);
+        int windowBits = 0;
+        if (cmf == 0x1f && flag == 0x8b)
+        {
+            windowBits = MAX_WBITS + 16;
+        }
+        else if ((cmf & 0x0f) == Z_DEFLATED && ((cmf << 8) | flag) % 31 == 0)
+        {
+            windowBits = MAX_WBITS;
+        }
+        else if (m_allowRawDeflate)
+        {
+            windowBits = -MAX_WBITS;
+        }
+        else
+        {
+            // the body is not compressed even though the header says so, e.g. it is already decoded by the transport
+            m_state = State::PassThrough;
+            return true;
+        }
+
+        if (inflateInit2(&m_stream, windowBits) != Z_OK)
+        {
+            return false;
+        }
+
+        // inflated data goes through uninitialized scratch storage, so the output is never zero filled by a resize
+        m_inflateBuffer.reset(new std::byte[INFLATE_BUFFER_SIZE]);
+        m_inflateInitialized = true;
+        m_multiMember = windowBits == MAX_WBITS + 16;
+        m_state = State::Inflating;
+        return true;
+    }
+
+    bool HttpContentDecoder::Inflate(const std::byte* data, std::size_t size, IOContent& output)
+    {
+        m_stream.next_in = reinterpret_cast<Bytef*>(const_cast<std::byte*>(data));
+        m_stream.avail_in = static_cast<uInt>(size);
+        do
+        {
+            m_stream.next_out = reinterpret_cast<Bytef*>(m_inflateBuffer.get());
+            m_stream.avail_out = static_cast<uInt>(INFLATE_BUFFER_SIZE);
+
+            int ret = inflate(&m_stream, Z_NO_FLUSH);
+            output.insert(output.end(), m_inflateBuffer.get(), m_inflateBuffer.get() + (INFLATE_BUFFER_SIZE - m_stream.avail_out));
+            if (ret == Z_STREAM_END)
+            {
+                if (!m_multiMember)
+                {
+                    m_state = State::Finished;
+                    return true;
+                }
+
+                // gzip allows several members to be concatenated into a single body. When the input ends before the
+                // magic bytes of the next member, the following chunk decides whether there is one
+                if (m_stream.avail_in < 2)
+                {
+                    const std::byte* remainingInput = reinterpret_cast<const std::byte*>(m_stream.next_in);
+                    m_pendingInput.assign(remainingInput, remainingInput + m_stream.avail_in);
+                    m_stream.avail_in = 0;
+                    m_state = State::MemberEnded;
+                    return true;
+                }
+
+                bool hasNextMember = m_stream.next_in[0] == 0x1f && m_stream.next_in[1] == 0x8b;
+                if (!hasNextMember || inflateReset(&m_stream) != Z_OK)
+                {
+                    m_state = State::Finished;
+                    return true;
+                }
+            }
+            else if (ret == Z_BUF_ERROR)
+            {
+                // all the input is consumed, wait for the next chunk
+                return true;
+            }
+            else if (ret != Z_OK)
+            {
+                m_state = State::Failed;
+                return false;
+            }
+        } while (m_stream.avail_in > 0 || m_stream.avail_out == 0);
+
+        return true;
+    }
+
+    bool HttpContentDecoder::InflateNextMember(const std::byte* data, std::size_t size, IOContent& output)
+    {
+        // anything else than another member after the end of the stream is ignored
+        if (data[0] != std::byte{ 0x1f } || data[1] != std::byte{ 0x8b })
+        {
+            m_state = State::Finished;
+            return true;
+        }
+
+        if (inflateReset(&m_stream) != Z_OK)
+        {
+            m_state = State::Failed;
+            return false;
+        }
+
+        m_state = State::Inflating;
+        return Inflate(data, size, output);
+    }
+} // namespace Cesium
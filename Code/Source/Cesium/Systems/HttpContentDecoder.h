@@ -0,0 +1,65 @@
+#pragma once
+
+#include "Cesium/Systems/GenericIOManager.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <zlib.h>
+
+namespace Cesium
+{
+    // Incremental decoder for gzip and deflate encoded response bodies. Input can be fed in arbitrary chunks
+    // while it is received, and is inflated through a fixed scratch buffer that is appended to the output content.
+    class HttpContentDecoder final
+    {
+        enum class State
+        {
+            Detecting,
+            Inflating,
+            MemberEnded,
+            PassThrough,
+            Finished,
+            Failed
+        };
+
+    public:
+        explicit HttpContentDecoder(const std::string& contentEncoding);
+
+        HttpContentDecoder(const HttpContentDecoder&) = delete;
+
+        HttpContentDecoder& operator=(const HttpContentDecoder&) = delete;
+
+        ~HttpContentDecoder() noexcept;
+
+        bool Decode(const std::byte* data, std::size_t size, IOContent& output);
+
+        bool IsFinished() const;
+
+        static bool IsSupportedEncoding(const std::string& contentEncoding);
+
+        static std::size_t GetDecodedSizeHint(const IOContent& content);
+
+        static IOContent DecodeContent(const std::string& contentEncoding, IOContent&& content);
+
+        static constexpr const char* const ACCEPT_ENCODING = "gzip, deflate";
+
+    private:
+        bool Detect();
+
+        bool Inflate(const std::byte* data, std::size_t size, IOContent& output);
+
+        bool InflateNextMember(const std::byte* data, std::size_t size, IOContent& output);
+
+        static constexpr std::size_t INFLATE_BUFFER_SIZE = 65536;
+        static constexpr std::size_t MAX_COMPRESSION_RATIO = 1032;
+
+        State m_state;
+        bool m_allowRawDeflate;
+        bool m_inflateInitialized;
+        bool m_multiMember;
+        IOContent m_pendingInput;
+        std::unique_ptr<std::byte[]> m_inflateBuffer;
+        z_stream m_stream;
+    };
+} // namespace Cesium
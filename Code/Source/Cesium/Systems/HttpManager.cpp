@@ -1,11 +1,12 @@
 #include "Cesium/Systems/HttpManager.h"
+#include "Cesium/Systems/HttpContentDecoder.h"
+#include "Cesium/Systems/HttpResponseBodyStream.h"
 #include <AzFramework/AzFramework_Traits_Platform.h>
 #include <aws/core/Aws.h>
 #include <AzCore/PlatformDef.h>
 #include <AzCore/Utils/Utils.h>
-#include <AzCore/Jobs/JobManager.h>
-#include <AzCore/Jobs/JobContext.h>
-#include <AzCore/Jobs/JobFunction.h>
+#include <AzCore/std/algorithm.h>
+#include <AzCore/std/parallel/scoped_lock.h>
 #include <CesiumUtility/Uri.h>
 #include <CesiumAsync/Promise.h>
 
@@ -22,6 +23,7 @@ AZ_PUSH_DISABLE_WARNING(4251 4996, "-Wunknown-warning-option")
 #include <aws/core/http/HttpResponse.h>
 AZ_POP_DISABLE_WARNING
 
+#include <cstdlib>
 #include <stdexcept>
 
 namespace Cesium
@@ -34,15 +36,22 @@ namespace Cesium
             const CesiumAsync::Promise<HttpResult>& promise)
             : m_awsHttpClient{ awsHttpClient }
             , m_httpRequestParameter{ std::move(httpRequestParameter) }
+            , m_host{ HttpManager::GetHost(m_httpRequestParameter.m_url) }
             , m_promise{ promise }
+            , m_cancelled{ std::make_shared<std::atomic_bool>(false) }
         {
         }
 
         void operator()()
         {
-            Aws::Http::URI awsURI(m_httpRequestParameter.m_url.c_str());
-            auto awsHttpRequest = Aws::Http::CreateHttpRequest(
-                awsURI, m_httpRequestParameter.m_method, Aws::Utils::Stream::DefaultResponseStreamFactoryMethod);
+            auto awsHttpRequest = HttpManager::CreateHttpRequest(m_httpRequestParameter.m_url.c_str(), m_httpRequestParameter.m_method);
+
+            // the transfer is aborted as soon as the request is cancelled while it is in flight
+            awsHttpRequest->SetContinueRequestHandle(
+                [cancelled = m_cancelled]([[maybe_unused]] const Aws::Http::HttpRequest* request)
+                {
+                    return !cancelled->load(std::memory_order_relaxed);
+                });
 
             for (const auto& it : m_httpRequestParameter.m_headers)
             {
@@ -58,12 +67,25 @@ namespace Cesium
             }
 
             auto awsHttpResponse = m_awsHttpClient->MakeRequest(awsHttpRequest);
+            if (m_cancelled->load(std::memory_order_relaxed))
+            {
+                Cancel();
+                return;
+            }
+
             m_promise.resolve({ awsHttpRequest, awsHttpResponse });
         }
 
+        void Cancel()
+        {
+            m_promise.resolve(HttpResult{ nullptr, nullptr, true });
+        }
+
         std::shared_ptr<Aws::Http::HttpClient> m_awsHttpClient;
         HttpRequestParameter m_httpRequestParameter;
+        AZStd::string m_host;
         CesiumAsync::Promise<HttpResult> m_promise;
+        std::shared_ptr<std::atomic_bool> m_cancelled;
     };
 
     struct HttpManager::GenericIORequestHandler
@@ -92,9 +114,7 @@ namespace Cesium
         {
             std::string absoluteUrl = CesiumUtility::Uri::resolve(m_request.m_parentPath.c_str(), m_request.m_path.c_str());
 
-            Aws::Http::URI awsURI(absoluteUrl.c_str());
-            auto awsHttpRequest = Aws::Http::CreateHttpRequest(
-                awsURI, Aws::Http::HttpMethod::HTTP_GET, Aws::Utils::Stream::DefaultResponseStreamFactoryMethod);
+            auto awsHttpRequest = HttpManager::CreateHttpRequest(absoluteUrl.c_str(), Aws::Http::HttpMethod::HTTP_GET);
 
             auto awsHttpResponse = m_awsHttpClient->MakeRequest(awsHttpRequest);
             if (awsHttpResponse)
@@ -113,14 +133,34 @@ namespace Cesium
     };
 
     HttpManager::HttpManager()
+        : HttpManager(HttpManagerConfiguration{})
     {
-        AZ::JobManagerDesc jobDesc;
-        for (size_t i = 0; i < AZStd::thread::hardware_concurrency(); ++i)
-        {
-            jobDesc.m_workerThreads.push_back({ static_cast<int>(i) });
-        }
-        m_ioJobManager = AZStd::make_unique<AZ::JobManager>(jobDesc);
-        m_ioJobContext = AZStd::make_unique<AZ::JobContext>(*m_ioJobManager);
+    }
+
+    HttpManager::HttpManager(const HttpManagerConfiguration& configuration)
+        : HttpManager(configuration, nullptr)
+    {
+        // without a shared scheduler, the manager gets one I/O worker for every request that can be in flight
+        CesiumSchedulerConfiguration schedulerConfiguration;
+        schedulerConfiguration.m_ioLane.m_threadCount = m_configuration.m_maxInFlightRequests;
+        m_ownedScheduler = AZStd::make_unique<CesiumScheduler>(schedulerConfiguration);
+        m_scheduler = m_ownedScheduler.get();
+    }
+
+    HttpManager::HttpManager(const HttpManagerConfiguration& configuration, CesiumScheduler& scheduler)
+        : HttpManager(configuration, &scheduler)
+    {
+    }
+
+    HttpManager::HttpManager(const HttpManagerConfiguration& configuration, CesiumScheduler* scheduler)
+        : m_configuration{ configuration }
+        , m_scheduler{ scheduler }
+        , m_requestSequence{ 0 }
+        , m_activeDispatchers{ 0 }
+        , m_shutdown{ false }
+    {
+        m_configuration.m_maxConnections = AZStd::max(m_configuration.m_maxConnections, 1u);
+        m_configuration.m_maxInFlightRequests = AZStd::max(m_configuration.m_maxInFlightRequests, 1u);
 
         AZ::Utils::SetEnv("AWS_EC2_METADATA_DISABLED", "True", true);
         Aws::SDKOptions options;
@@ -128,13 +168,16 @@ namespace Cesium
 
         Aws::Client::ClientConfiguration config;
         config.enableTcpKeepAlive = AZ_TRAIT_AZFRAMEWORK_AWS_ENABLE_TCP_KEEP_ALIVE_SUPPORTED;
+        // the pool needs a connection for every request in flight, the per host limit is enforced by the dispatchers
+        config.maxConnections = AZStd::max(m_configuration.m_maxConnections, m_configuration.m_maxInFlightRequests);
         m_awsHttpClient = Aws::Http::CreateHttpClient(config);
     }
 
     HttpManager::~HttpManager() noexcept
     {
-        m_ioJobContext.reset();
-        m_ioJobManager.reset();
+        Shutdown();
+        m_scheduledTasks.Wait();
+        m_ownedScheduler.reset();
         m_awsHttpClient.reset();
         Aws::SDKOptions options;
         Aws::ShutdownAPI(options);
@@ -144,13 +187,202 @@ namespace Cesium
         const CesiumAsync::AsyncSystem& asyncSystem, HttpRequestParameter&& httpRequestParameter)
     {
         auto promise = asyncSystem.createPromise<HttpResult>();
-        AZ::Job* job = aznew AZ::JobFunction<std::function<void()>>(
-            RequestHandler{ m_awsHttpClient, std::move(httpRequestParameter), promise }, true, m_ioJobContext.get());
-        job->Start();
+        bool startDispatcher = false;
+        bool shutdown = false;
+        {
+            AZStd::scoped_lock<AZStd::mutex> lock(m_requestQueueMutex);
+            shutdown = m_shutdown;
+            if (!shutdown)
+            {
+                RequestQueueKey key{ -httpRequestParameter.m_priority, m_requestSequence++ };
+                if (httpRequestParameter.m_requestId != 0)
+                {
+                    m_queuedRequests.insert_or_assign(httpRequestParameter.m_requestId, key);
+                }
+
+                m_requestQueue.emplace(
+                    key, AZStd::make_unique<RequestHandler>(m_awsHttpClient, std::move(httpRequestParameter), promise));
+                if (m_activeDispatchers < m_configuration.m_maxInFlightRequests)
+                {
+                    ++m_activeDispatchers;
+                    startDispatcher = true;
+                }
+            }
+        }
+
+        // requests added after the shutdown are cancelled right away. Resolve outside of the lock, since continuations
+        // may add new requests
+        if (shutdown)
+        {
+            promise.resolve(HttpResult{ nullptr, nullptr, true });
+        }
+
+        // every dispatcher sends whichever request has the highest priority at the time, not necessarily the one added here
+        if (startDispatcher)
+        {
+            m_scheduler->Submit(
+                CesiumSchedulerLane::IO,
+                [this]()
+                {
+                    DispatchRequests();
+                },
+                &m_scheduledTasks);
+        }
 
         return promise.getFuture();
     }
 
+    bool HttpManager::CancelRequest(HttpRequestId requestId)
+    {
+        AZStd::unique_ptr<RequestHandler> requestHandler;
+        {
+            AZStd::scoped_lock<AZStd::mutex> lock(m_requestQueueMutex);
+            auto inFlightRequest = m_inFlightRequests.find(requestId);
+            if (inFlightRequest != m_inFlightRequests.end())
+            {
+                inFlightRequest->second->store(true, std::memory_order_relaxed);
+                return true;
+            }
+
+            auto queuedRequest = m_queuedRequests.find(requestId);
+            if (queuedRequest == m_queuedRequests.end())
+            {
+                return false;
+            }
+
+            auto requestIt = m_requestQueue.find(queuedRequest->second);
+            requestHandler = std::move(requestIt->second);
+            m_requestQueue.erase(requestIt);
+            m_queuedRequests.erase(queuedRequest);
+        }
+
+        // resolve outside of the lock, since continuations may add new requests
+        requestHandler->Cancel();
+        return true;
+    }
+
+    void HttpManager::Shutdown()
+    {
+        // resolve the requests that are never going to be sent, and abort the ones in flight
+        AZStd::map<RequestQueueKey, AZStd::unique_ptr<RequestHandler>> requestQueue;
+        {
+            AZStd::scoped_lock<AZStd::mutex> lock(m_requestQueueMutex);
+            m_shutdown = true;
+            for (auto& inFlightRequest : m_inFlightRequests)
+            {
+                inFlightRequest.second->store(true, std::memory_order_relaxed);
+            }
+
+            requestQueue = std::move(m_requestQueue);
+            m_requestQueue.clear();
+            m_queuedRequests.clear();
+        }
+
+        for (auto& queuedRequest : requestQueue)
+        {
+            queuedRequest.second->Cancel();
+        }
+    }
+
+    bool HttpManager::SetRequestPriority(HttpRequestId requestId, std::int64_t priority)
+    {
+        AZStd::scoped_lock<AZStd::mutex> lock(m_requestQueueMutex);
+        auto queuedRequest = m_queuedRequests.find(requestId);
+        if (queuedRequest == m_queuedRequests.end())
+        {
+            return false;
+        }
+
+        RequestQueueKey& key = queuedRequest->second;
+        if (key.first == -priority)
+        {
+            return true;
+        }
+
+        auto requestIt = m_requestQueue.find(key);
+        AZStd::unique_ptr<RequestHandler> requestHandler = std::move(requestIt->second);
+        m_requestQueue.erase(requestIt);
+        key = RequestQueueKey{ -priority, m_requestSequence++ };
+        requestHandler->m_httpRequestParameter.m_priority = priority;
+        m_requestQueue.emplace(key, std::move(requestHandler));
+        return true;
+    }
+
+    HttpRequestId HttpManager::GenerateRequestId()
+    {
+        static std::atomic<HttpRequestId> nextRequestId = 1;
+        return nextRequestId.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void HttpManager::DispatchRequests()
+    {
+        HttpRequestId completedRequestId = 0;
+        AZStd::string completedHost;
+        bool hasCompletedRequest = false;
+        while (true)
+        {
+            AZStd::unique_ptr<RequestHandler> requestHandler;
+            {
+                AZStd::scoped_lock<AZStd::mutex> lock(m_requestQueueMutex);
+                if (completedRequestId != 0)
+                {
+                    m_inFlightRequests.erase(completedRequestId);
+                }
+
+                if (hasCompletedRequest)
+                {
+                    auto hostConnections = m_hostConnections.find(completedHost);
+                    if (--hostConnections->second == 0)
+                    {
+                        m_hostConnections.erase(hostConnections);
+                    }
+                }
+
+                // send the request with the highest priority whose host is below its connection limit
+                auto requestIt = AZStd::find_if(
+                    m_requestQueue.begin(),
+                    m_requestQueue.end(),
+                    [this](const auto& queuedRequest)
+                    {
+                        auto hostConnections = m_hostConnections.find(queuedRequest.second->m_host);
+                        return hostConnections == m_hostConnections.end() || hostConnections->second < m_configuration.m_maxConnections;
+                    });
+
+                if (requestIt == m_requestQueue.end())
+                {
+                    // requests added after this point start a new dispatcher. Requests left in the queue wait for their host,
+                    // and a dispatcher sending to that host picks them up when its request completes
+                    --m_activeDispatchers;
+                    return;
+                }
+
+                requestHandler = std::move(requestIt->second);
+                m_requestQueue.erase(requestIt);
+
+                completedHost = requestHandler->m_host;
+                hasCompletedRequest = true;
+                ++m_hostConnections[completedHost];
+
+                completedRequestId = requestHandler->m_httpRequestParameter.m_requestId;
+                if (completedRequestId != 0)
+                {
+                    m_queuedRequests.erase(completedRequestId);
+                    m_inFlightRequests.insert_or_assign(completedRequestId, requestHandler->m_cancelled);
+                }
+            }
+
+            (*requestHandler)();
+        }
+    }
+
+    AZStd::string HttpManager::GetHost(const AZStd::string& url)
+    {
+        auto schemeEnd = url.find("://");
+        auto hostBegin = schemeEnd == AZStd::string::npos ? 0 : schemeEnd + 3;
+        auto hostEnd = url.find_first_of("/?#", hostBegin);
+        return url.substr(0, hostEnd);
+    }
+
     AZStd::string HttpManager::GetParentPath(const AZStd::string& path)
     {
         auto lastSlashPos = path.rfind('/');
@@ -165,16 +397,10 @@ namespace Cesium
     IOContent HttpManager::GetFileContent(const IORequestParameter& request)
     {
         std::string absoluteUrl = CesiumUtility::Uri::resolve(request.m_parentPath.c_str(), request.m_path.c_str());
+        auto awsHttpRequest = CreateHttpRequest(absoluteUrl.c_str(), Aws::Http::HttpMethod::HTTP_GET);
 
-        Aws::Client::ClientConfiguration config;
-        config.enableTcpKeepAlive = AZ_TRAIT_AZFRAMEWORK_AWS_ENABLE_TCP_KEEP_ALIVE_SUPPORTED;
-        std::shared_ptr<Aws::Http::HttpClient> awsHttpClient = Aws::Http::CreateHttpClient(config);
-
-        Aws::Http::URI awsURI(absoluteUrl.c_str());
-        auto awsHttpRequest =
-            Aws::Http::CreateHttpRequest(awsURI, Aws::Http::HttpMethod::HTTP_GET, Aws::Utils::Stream::DefaultResponseStreamFactoryMethod);
-
-        auto awsHttpResponse = awsHttpClient->MakeRequest(awsHttpRequest);
+        // reuse the pooled connections of the shared client instead of creating a new client for every call
+        auto awsHttpResponse = m_awsHttpClient->MakeRequest(awsHttpRequest);
         if (!awsHttpRequest || !awsHttpResponse)
         {
             return {};
@@ -192,9 +418,7 @@ namespace Cesium
         const CesiumAsync::AsyncSystem& asyncSystem, const IORequestParameter& request)
     {
         auto promise = asyncSystem.createPromise<IOContent>();
-        AZ::Job* job = aznew AZ::JobFunction<std::function<void()>>(
-            GenericIORequestHandler{ m_awsHttpClient, request, promise }, true, m_ioJobContext.get());
-        job->Start();
+        m_scheduler->Submit(CesiumSchedulerLane::IO, GenericIORequestHandler{ m_awsHttpClient, request, promise }, &m_scheduledTasks);
 
         return promise.getFuture();
     }
@@ -203,26 +427,75 @@ namespace Cesium
         const CesiumAsync::AsyncSystem& asyncSystem, IORequestParameter&& request)
     {
         auto promise = asyncSystem.createPromise<IOContent>();
-        AZ::Job* job = aznew AZ::JobFunction<std::function<void()>>(
-            GenericIORequestHandler{ m_awsHttpClient, std::move(request), promise }, true, m_ioJobContext.get());
-        job->Start();
+        m_scheduler->Submit(
+            CesiumSchedulerLane::IO, GenericIORequestHandler{ m_awsHttpClient, std::move(request), promise }, &m_scheduledTasks);
 
         return promise.getFuture();
     }
 
+    const HttpManagerConfiguration& HttpManager::GetConfiguration() const
+    {
+        return m_configuration;
+    }
+
     IOContent HttpManager::GetResponseBodyContent(Aws::Http::HttpResponse& response)
     {
+        // the body is already decoded and in place when the response is written by our own stream, so it only needs to be moved out
         auto& ioStream = response.GetResponseBody();
+        if (auto bodyStream = dynamic_cast<HttpResponseBodyStream*>(&ioStream))
+        {
+            return bodyStream->TakeContent();
+        }
+
         std::size_t readSoFar = 0;
-        const std::size_t maxRead = 256;
         IOContent content;
         while (ioStream)
         {
-            content.resize(readSoFar + maxRead);
-            ioStream.read(reinterpret_cast<char*>(content.data() + readSoFar), maxRead);
-            readSoFar += maxRead;
+            content.resize(readSoFar + RESPONSE_BODY_READ_SIZE);
+            ioStream.read(reinterpret_cast<char*>(content.data() + readSoFar), RESPONSE_BODY_READ_SIZE);
+            readSoFar += static_cast<std::size_t>(ioStream.gcount());
+        }
+
+        content.resize(readSoFar);
+        if (response.HasHeader(CONTENT_ENCODING_HEADER_KEY))
+        {
+            return HttpContentDecoder::DecodeContent(response.GetHeader(CONTENT_ENCODING_HEADER_KEY).c_str(), std::move(content));
         }
 
         return content;
     }
+
+    std::shared_ptr<Aws::Http::HttpRequest> HttpManager::CreateHttpRequest(const char* url, Aws::Http::HttpMethod method)
+    {
+        Aws::Http::URI awsURI(url);
+        auto awsHttpRequest = Aws::Http::CreateHttpRequest(awsURI, method, &HttpResponseBodyStream::Create);
+        awsHttpRequest->SetHeaderValue(ACCEPT_ENCODING_HEADER_KEY, HttpContentDecoder::ACCEPT_ENCODING);
+        awsHttpRequest->SetDataReceivedEventHandler(&HttpManager::PrepareResponseBody);
+        return awsHttpRequest;
+    }
+
+    void HttpManager::PrepareResponseBody(
+        [[maybe_unused]] const Aws::Http::HttpRequest* request, Aws::Http::HttpResponse* response, [[maybe_unused]] long long receivedBytes)
+    {
+        // headers are complete once the first chunk of the body arrives, so set up decoding and reserve the whole body
+        // up front instead of growing the buffer chunk by chunk. For compressed bodies the content length is only a lower bound
+        auto bodyStream = dynamic_cast<HttpResponseBodyStream*>(&response->GetResponseBody());
+        if (!bodyStream || bodyStream->IsReserved())
+        {
+            return;
+        }
+
+        if (response->HasHeader(CONTENT_ENCODING_HEADER_KEY))
+        {
+            bodyStream->SetContentEncoding(response->GetHeader(CONTENT_ENCODING_HEADER_KEY).c_str());
+        }
+
+        std::size_t contentLength = 0;
+        if (response->HasHeader(CONTENT_LENGTH_HEADER_KEY))
+        {
+            contentLength = static_cast<std::size_t>(std::strtoull(response->GetHeader(CONTENT_LENGTH_HEADER_KEY).c_str(), nullptr, 10));
+        }
+
+        bodyStream->Reserve(contentLength);
+    }
 } // namespace Cesium
@@ -1,19 +1,19 @@
 #pragma once
 
+#include "Cesium/Systems/CesiumScheduler.h"
 #include "Cesium/Systems/GenericIOManager.h"
+#include <AzCore/std/containers/map.h>
+#include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/parallel/mutex.h>
 #include <AzCore/std/string/string.h>
 #include <AzCore/std/smart_ptr/unique_ptr.h>
+#include <AzCore/std/utils.h>
 #include <CesiumAsync/AsyncSystem.h>
 #include <CesiumAsync/Future.h>
 #include <CesiumAsync/HttpHeaders.h>
 #include <aws/core/http/HttpResponse.h>
-
-namespace AZ
-{
-    class JobManager;
-    class JobContext;
-    class Job;
-} // namespace AZ
+#include <atomic>
+#include <cstdint>
 
 namespace Aws
 {
@@ -25,6 +25,8 @@ namespace Aws
 
 namespace Cesium
 {
+    using HttpRequestId = std::uint64_t;
+
     struct HttpRequestParameter final
     {
         HttpRequestParameter(AZStd::string&& url, Aws::Http::HttpMethod method)
@@ -55,12 +57,31 @@ namespace Cesium
         CesiumAsync::HttpHeaders m_headers;
 
         AZStd::string m_body;
+
+        // requests with higher priority are sent first. Requests with the same priority are sent in the order they are added
+        std::int64_t m_priority{ 0 };
+
+        // id used to cancel or reprioritize the request. Requests with the id 0 can't be addressed after they are added
+        HttpRequestId m_requestId{ 0 };
+    };
+
+    struct HttpManagerConfiguration final
+    {
+        // number of requests that can be in flight to the same host (scheme, host and port) at the same time.
+        // Requests to a host at its limit wait in the queue while requests to other hosts are sent
+        std::uint32_t m_maxConnections{ 16 };
+
+        // number of requests that can wait on the network at the same time. The AWS http client blocks a thread
+        // for every request and doesn't multiplex requests over a connection, so every request in flight
+        // occupies a worker of the scheduler's I/O lane. This is independent of the number of hardware threads
+        std::uint32_t m_maxInFlightRequests{ 32 };
     };
 
     struct HttpResult final
     {
         std::shared_ptr<Aws::Http::HttpRequest> m_request;
         std::shared_ptr<Aws::Http::HttpResponse> m_response;
+        bool m_cancelled{ false };
     };
 
     class HttpManager final : public GenericIOManager
@@ -71,11 +92,25 @@ namespace Cesium
     public:
         HttpManager();
 
+        explicit HttpManager(const HttpManagerConfiguration& configuration);
+
+        HttpManager(const HttpManagerConfiguration& configuration, CesiumScheduler& scheduler);
+
         ~HttpManager() noexcept;
 
         CesiumAsync::Future<HttpResult> AddRequest(
             const CesiumAsync::AsyncSystem& asyncSystem, HttpRequestParameter&& httpRequestParameter);
 
+        bool CancelRequest(HttpRequestId requestId);
+
+        // Cancels the queued requests, aborts the ones in flight and cancels every request added afterwards, so the
+        // owner of the scheduler doesn't wait on the network when it drains it before shutting down
+        void Shutdown();
+
+        bool SetRequestPriority(HttpRequestId requestId, std::int64_t priority);
+
+        static HttpRequestId GenerateRequestId();
+
         AZStd::string GetParentPath(const AZStd::string& path) override;
 
         IOContent GetFileContent(const IORequestParameter& request) override;
@@ -88,11 +123,42 @@ namespace Cesium
         CesiumAsync::Future<IOContent> GetFileContentAsync(
             const CesiumAsync::AsyncSystem& asyncSystem, IORequestParameter&& request) override;
 
+        const HttpManagerConfiguration& GetConfiguration() const;
+
         static IOContent GetResponseBodyContent(Aws::Http::HttpResponse& response);
 
     private:
-        AZStd::unique_ptr<AZ::JobManager> m_ioJobManager;
-        AZStd::unique_ptr<AZ::JobContext> m_ioJobContext;
+        // queued requests are ordered by descending priority first, then by the order they are added
+        using RequestQueueKey = AZStd::pair<std::int64_t, std::uint64_t>;
+
+        HttpManager(const HttpManagerConfiguration& configuration, CesiumScheduler* scheduler);
+
+        void DispatchRequests();
+
+        static AZStd::string GetHost(const AZStd::string& url);
+
+        static std::shared_ptr<Aws::Http::HttpRequest> CreateHttpRequest(const char* url, Aws::Http::HttpMethod method);
+
+        static void PrepareResponseBody(const Aws::Http::HttpRequest* request, Aws::Http::HttpResponse* response, long long receivedBytes);
+
+        static constexpr const char* const ACCEPT_ENCODING_HEADER_KEY = "Accept-Encoding";
+        static constexpr const char* const CONTENT_ENCODING_HEADER_KEY = "content-encoding";
+        static constexpr const char* const CONTENT_LENGTH_HEADER_KEY = "content-length";
+        static constexpr std::size_t RESPONSE_BODY_READ_SIZE = 16384;
+
+        HttpManagerConfiguration m_configuration;
+        AZStd::unique_ptr<CesiumScheduler> m_ownedScheduler;
+        CesiumScheduler* m_scheduler;
+        CesiumSchedulerTaskGroup m_scheduledTasks;
         std::shared_ptr<Aws::Http::HttpClient> m_awsHttpClient;
+
+        AZStd::mutex m_requestQueueMutex;
+        std::uint64_t m_requestSequence;
+        std::uint32_t m_activeDispatchers;
+        bool m_shutdown;
+        AZStd::map<RequestQueueKey, AZStd::unique_ptr<RequestHandler>> m_requestQueue;
+        AZStd::unordered_map<HttpRequestId, RequestQueueKey> m_queuedRequests;
+        AZStd::unordered_map<HttpRequestId, std::shared_ptr<std::atomic_bool>> m_inFlightRequests;
+        AZStd::unordered_map<AZStd::string, std::uint32_t> m_hostConnections;
     };
 } // namespace Cesium
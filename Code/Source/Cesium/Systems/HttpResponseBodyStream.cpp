@@ -0,0 +1,138 @@
+#include "Cesium/Systems/HttpResponseBodyStream.h"
+#include <AzCore/Debug/Trace.h>
+#include <aws/core/utils/memory/AWSMemory.h>
+#include <cstring>
+
+namespace Cesium
+{
+    void HttpResponseBodyBuffer::Reserve(std::size_t size)
+    {
+        if (size > m_content.capacity())
+        {
+            ResetGetArea();
+            m_content.reserve(size);
+        }
+    }
+
+    void HttpResponseBodyBuffer::SetContentEncoding(const std::string& contentEncoding)
+    {
+        if (m_decoder || !HttpContentDecoder::IsSupportedEncoding(contentEncoding))
+        {
+            return;
+        }
+
+        // decode what is already received. Everything after this is decoded as soon as it is written
+        ResetGetArea();
+        m_readPosition = 0;
+        m_decoder = AZStd::make_unique<HttpContentDecoder>(contentEncoding);
+        IOContent encodedContent = std::move(m_content);
+        m_content = IOContent{};
+        m_content.reserve(encodedContent.size());
+        m_decoder->Decode(encodedContent.data(), encodedContent.size(), m_content);
+    }
+
+    std::size_t HttpResponseBodyBuffer::GetSize() const
+    {
+        return m_content.size();
+    }
+
+    IOContent HttpResponseBodyBuffer::TakeContent()
+    {
+        setg(nullptr, nullptr, nullptr);
+        m_readPosition = 0;
+        if (m_decoder && !m_decoder->IsFinished())
+        {
+            AZ_Warning("Cesium", false, "Failed to decode the compressed http response body");
+            m_content = IOContent{};
+        }
+
+        return std::move(m_content);
+    }
+
+    std::streamsize HttpResponseBodyBuffer::xsputn(const char_type* data, std::streamsize count)
+    {
+        if (count <= 0)
+        {
+            return 0;
+        }
+
+        // the get area points into the content, so it has to be dropped before the content can be reallocated
+        ResetGetArea();
+        if (m_decoder)
+        {
+            m_decoder->Decode(reinterpret_cast<const std::byte*>(data), static_cast<std::size_t>(count), m_content);
+            return count;
+        }
+
+        std::size_t writePosition = m_content.size();
+        m_content.resize(writePosition + static_cast<std::size_t>(count));
+        std::memcpy(m_content.data() + writePosition, data, static_cast<std::size_t>(count));
+        return count;
+    }
+
+    HttpResponseBodyBuffer::int_type HttpResponseBodyBuffer::overflow(int_type ch)
+    {
+        if (traits_type::eq_int_type(ch, traits_type::eof()))
+        {
+            return traits_type::not_eof(ch);
+        }
+
+        char_type data = traits_type::to_char_type(ch);
+        xsputn(&data, 1);
+        return ch;
+    }
+
+    HttpResponseBodyBuffer::int_type HttpResponseBodyBuffer::underflow()
+    {
+        ResetGetArea();
+        if (m_readPosition >= m_content.size())
+        {
+            return traits_type::eof();
+        }
+
+        char* begin = reinterpret_cast<char*>(m_content.data());
+        setg(begin + m_readPosition, begin + m_readPosition, begin + m_content.size());
+        return traits_type::to_int_type(*gptr());
+    }
+
+    void HttpResponseBodyBuffer::ResetGetArea()
+    {
+        if (eback())
+        {
+            m_readPosition += static_cast<std::size_t>(gptr() - eback());
+            setg(nullptr, nullptr, nullptr);
+        }
+    }
+
+    HttpResponseBodyStream::HttpResponseBodyStream()
+        : Aws::IOStream(&m_buffer)
+        , m_reserved{ false }
+    {
+    }
+
+    void HttpResponseBodyStream::Reserve(std::size_t size)
+    {
+        m_buffer.Reserve(size);
+        m_reserved = true;
+    }
+
+    void HttpResponseBodyStream::SetContentEncoding(const std::string& contentEncoding)
+    {
+        m_buffer.SetContentEncoding(contentEncoding);
+    }
+
+    IOContent HttpResponseBodyStream::TakeContent()
+    {
+        return m_buffer.TakeContent();
+    }
+
+    bool HttpResponseBodyStream::IsReserved() const
+    {
+        return m_reserved;
+    }
+
+    Aws::IOStream* HttpResponseBodyStream::Create()
+    {
+        return Aws::New<HttpResponseBodyStream>(ALLOCATION_TAG);
+    }
+} // namespace Cesium
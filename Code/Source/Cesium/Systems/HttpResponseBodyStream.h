@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Cesium/Systems/GenericIOManager.h"
+#include "Cesium/Systems/HttpContentDecoder.h"
+#include <AzCore/std/smart_ptr/unique_ptr.h>
+#include <aws/core/utils/memory/stl/AWSStreamFwd.h>
+#include <cstddef>
+#include <streambuf>
+#include <string>
+
+namespace Cesium
+{
+    // Stream buffer that writes the response body directly into an IOContent, so the body can be moved to the
+    // asset response once the request is finished instead of being read back out of a string stream.
+    // Compressed bodies are inflated chunk by chunk while they are received.
+    class HttpResponseBodyBuffer final : public std::streambuf
+    {
+    public:
+        void Reserve(std::size_t size);
+
+        void SetContentEncoding(const std::string& contentEncoding);
+
+        std::size_t GetSize() const;
+
+        IOContent TakeContent();
+
+    protected:
+        std::streamsize xsputn(const char_type* data, std::streamsize count) override;
+
+        int_type overflow(int_type ch) override;
+
+        int_type underflow() override;
+
+    private:
+        void ResetGetArea();
+
+        IOContent m_content;
+        std::size_t m_readPosition{ 0 };
+        AZStd::unique_ptr<HttpContentDecoder> m_decoder;
+    };
+
+    class HttpResponseBodyStream final : public Aws::IOStream
+    {
+    public:
+        HttpResponseBodyStream();
+
+        void Reserve(std::size_t size);
+
+        void SetContentEncoding(const std::string& contentEncoding);
+
+        IOContent TakeContent();
+
+        bool IsReserved() const;
+
+        static Aws::IOStream* Create();
+
+    private:
+        static constexpr const char* const ALLOCATION_TAG = "CesiumHttpResponseBodyStream";
+
+        HttpResponseBodyBuffer m_buffer;
+        bool m_reserved;
+    };
+} // namespace Cesium
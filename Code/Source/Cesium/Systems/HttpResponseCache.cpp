@@ -0,0 +1,668 @@
+#include "Cesium/Systems/HttpResponseCache.h"
+#include <AzCore/IO/SystemFile.h>
+#include <AzCore/IO/Path/Path.h>
+#include <AzCore/JSON/document.h>
+#include <AzCore/JSON/stringbuffer.h>
+#include <AzCore/JSON/writer.h>
+#include <AzCore/Math/Sha1.h>
+#include <AzCore/std/parallel/scoped_lock.h>
+#include <AzCore/std/string/conversions.h>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <limits>
+
+namespace Cesium
+{
+    HttpResponseCache::HttpResponseCache(const AZStd::string& cacheDirectory, std::uint64_t maximumBytes)
+        : m_cacheDirectory{ cacheDirectory }
+        , m_maximumBytes{ maximumBytes }
+        , m_currentBytes{ 0 }
+        , m_indexDirty{ false }
+        , m_lruDirty{ false }
+        , m_lastIndexSaveTime{ GetUnixTime() }
+        , m_indexSnapshotCount{ 0 }
+        , m_savedIndexSequence{ 0 }
+    {
+        if (!AZ::IO::SystemFile::Exists(m_cacheDirectory.c_str()))
+        {
+            AZ::IO::SystemFile::CreateDir(m_cacheDirectory.c_str());
+        }
+
+        AZStd::scoped_lock<AZStd::mutex> lock(m_mutex);
+        LoadIndex();
+        EvictToBudget();
+    }
+
+    HttpResponseCache::~HttpResponseCache() noexcept
+    {
+        Flush();
+    }
+
+    AZStd::optional<HttpCachedResponse> HttpResponseCache::Find(const AZStd::string& url)
+    {
+        AZStd::scoped_lock<AZStd::mutex> lock(m_mutex);
+        auto entryIt = m_entries.find(url);
+        if (entryIt == m_entries.end())
+        {
+            return AZStd::nullopt;
+        }
+
+        // mark the entry as the most recently used
+        CacheEntry& entry = entryIt->second;
+        m_lru.splice(m_lru.begin(), m_lru, entry.m_lruPosition);
+        m_lruDirty = true;
+
+        HttpCachedResponse response;
+        response.m_statusCode = entry.m_statusCode;
+        response.m_contentType = entry.m_contentType;
+        response.m_headers = entry.m_headers;
+        response.m_blobPath = GetBlobPath(entry.m_blobName);
+        response.m_isFresh = GetUnixTime() < entry.m_expiryTime;
+        return response;
+    }
+
+    bool HttpResponseCache::Store(
+        const AZStd::string& url,
+        std::uint16_t statusCode,
+        const std::string& contentType,
+        const CesiumAsync::HttpHeaders& headers,
+        gsl::span<const std::byte> content)
+    {
+        if (!IsCacheable(headers) || content.size() > GetMaximumBytes())
+        {
+            Remove(url);
+            return false;
+        }
+
+        // write the blob to a temporary file outside of the lock. The blob is only moved into place
+        // if no other request has stored the same content in the mean time
+        static std::atomic_uint32_t tempFileCounter = 0;
+        AZStd::string blobName = CalculateBlobName(content);
+        AZStd::string blobPath = GetBlobPath(blobName);
+        AZStd::string tempBlobPath =
+            AZStd::string::format("%s.%u.tmp", blobPath.c_str(), tempFileCounter.fetch_add(1, std::memory_order_relaxed));
+        bool blobExists = false;
+        {
+            AZStd::scoped_lock<AZStd::mutex> lock(m_mutex);
+            blobExists = m_blobs.find(blobName) != m_blobs.end();
+        }
+
+        if (!blobExists)
+        {
+            AZ::IO::SystemFile file;
+            if (!file.Open(
+                    tempBlobPath.c_str(),
+                    AZ::IO::SystemFile::SF_OPEN_CREATE | AZ::IO::SystemFile::SF_OPEN_CREATE_PATH | AZ::IO::SystemFile::SF_OPEN_WRITE_ONLY))
+            {
+                return false;
+            }
+
+            AZ::IO::SizeType written = file.Write(content.data(), content.size());
+            file.Close();
+            if (written != content.size())
+            {
+                AZ::IO::SystemFile::Delete(tempBlobPath.c_str());
+                return false;
+            }
+        }
+
+        AZStd::optional<IndexSnapshot> indexSnapshot;
+        {
+            AZStd::scoped_lock<AZStd::mutex> lock(m_mutex);
+            auto blobIt = m_blobs.find(blobName);
+            if (blobIt == m_blobs.end())
+            {
+                if (blobExists || !AZ::IO::SystemFile::Rename(tempBlobPath.c_str(), blobPath.c_str(), true))
+                {
+                    // the blob was evicted while we were writing it, or it cannot be moved into place
+                    AZ::IO::SystemFile::Delete(tempBlobPath.c_str());
+                    return false;
+                }
+
+                blobIt = m_blobs.insert({ blobName, CacheBlob{ static_cast<std::uint64_t>(content.size()), 0 } }).first;
+                m_currentBytes += content.size();
+            }
+            else if (!blobExists)
+            {
+                AZ::IO::SystemFile::Delete(tempBlobPath.c_str());
+            }
+
+            // reference the blob before releasing the old entry, so the blob is kept if the content didn't change
+            ++blobIt->second.m_refCount;
+            RemoveEntry(url);
+
+            // the body is stored decoded, so transport specific headers are not valid anymore
+            CesiumAsync::HttpHeaders cachedHeaders = headers;
+            cachedHeaders.erase(CONTENT_ENCODING_HEADER_KEY);
+            cachedHeaders.erase(CONTENT_LENGTH_HEADER_KEY);
+
+            m_lru.push_front(url);
+            CacheEntry entry;
+            entry.m_blobName = std::move(blobName);
+            entry.m_statusCode = statusCode;
+            entry.m_contentType = contentType;
+            entry.m_headers = std::move(cachedHeaders);
+            entry.m_expiryTime = CalculateExpiryTime(entry.m_headers, GetUnixTime());
+            entry.m_lruPosition = m_lru.begin();
+            m_entries.insert_or_assign(url, std::move(entry));
+            m_indexDirty = true;
+
+            EvictToBudget();
+            indexSnapshot = TakeIndexSnapshotIfDue();
+        }
+
+        if (indexSnapshot)
+        {
+            SaveIndex(*indexSnapshot);
+        }
+
+        return true;
+    }
+
+    bool HttpResponseCache::Revalidate(const AZStd::string& url, const CesiumAsync::HttpHeaders& revalidatedHeaders)
+    {
+        AZStd::optional<IndexSnapshot> indexSnapshot;
+        {
+            AZStd::scoped_lock<AZStd::mutex> lock(m_mutex);
+            auto entryIt = m_entries.find(url);
+            if (entryIt == m_entries.end())
+            {
+                return false;
+            }
+
+            // 304 responses carry the updated validators and freshness information of the stored response
+            CacheEntry& entry = entryIt->second;
+            for (const char* key : { CACHE_CONTROL_HEADER_KEY, ETAG_HEADER_KEY, LAST_MODIFIED_HEADER_KEY })
+            {
+                auto headerIt = revalidatedHeaders.find(key);
+                if (headerIt != revalidatedHeaders.end())
+                {
+                    entry.m_headers.insert_or_assign(headerIt->first, headerIt->second);
+                }
+            }
+
+            entry.m_expiryTime = CalculateExpiryTime(entry.m_headers, GetUnixTime());
+            m_lru.splice(m_lru.begin(), m_lru, entry.m_lruPosition);
+            m_indexDirty = true;
+            indexSnapshot = TakeIndexSnapshotIfDue();
+        }
+
+        if (indexSnapshot)
+        {
+            SaveIndex(*indexSnapshot);
+        }
+
+        return true;
+    }
+
+    void HttpResponseCache::Remove(const AZStd::string& url)
+    {
+        AZStd::optional<IndexSnapshot> indexSnapshot;
+        {
+            AZStd::scoped_lock<AZStd::mutex> lock(m_mutex);
+            RemoveEntry(url);
+            indexSnapshot = TakeIndexSnapshotIfDue();
+        }
+
+        if (indexSnapshot)
+        {
+            SaveIndex(*indexSnapshot);
+        }
+    }
+
+    void HttpResponseCache::Clear()
+    {
+        IndexSnapshot indexSnapshot;
+        {
+            AZStd::scoped_lock<AZStd::mutex> lock(m_mutex);
+            for (const auto& blob : m_blobs)
+            {
+                AZ::IO::SystemFile::Delete(GetBlobPath(blob.first).c_str());
+            }
+
+            m_entries.clear();
+            m_blobs.clear();
+            m_lru.clear();
+            m_currentBytes = 0;
+            indexSnapshot = TakeIndexSnapshot();
+        }
+
+        SaveIndex(indexSnapshot);
+    }
+
+    void HttpResponseCache::Flush()
+    {
+        AZStd::optional<IndexSnapshot> indexSnapshot;
+        {
+            AZStd::scoped_lock<AZStd::mutex> lock(m_mutex);
+            if (m_indexDirty || m_lruDirty)
+            {
+                indexSnapshot = TakeIndexSnapshot();
+            }
+        }
+
+        if (indexSnapshot)
+        {
+            SaveIndex(*indexSnapshot);
+        }
+    }
+
+    void HttpResponseCache::SetMaximumBytes(std::uint64_t maximumBytes)
+    {
+        AZStd::scoped_lock<AZStd::mutex> lock(m_mutex);
+        m_maximumBytes = maximumBytes;
+        EvictToBudget();
+    }
+
+    std::uint64_t HttpResponseCache::GetMaximumBytes() const
+    {
+        AZStd::scoped_lock<AZStd::mutex> lock(m_mutex);
+        return m_maximumBytes;
+    }
+
+    std::uint64_t HttpResponseCache::GetCurrentBytes() const
+    {
+        AZStd::scoped_lock<AZStd::mutex> lock(m_mutex);
+        return m_currentBytes;
+    }
+
+    bool HttpResponseCache::IsCacheable(const CesiumAsync::HttpHeaders& headers)
+    {
+        bool hasMaxAge = false;
+        auto cacheControl = headers.find(CACHE_CONTROL_HEADER_KEY);
+        if (cacheControl != headers.end())
+        {
+            AZStd::string directives = cacheControl->second.c_str();
+            AZStd::to_lower(directives.begin(), directives.end());
+            if (directives.find("no-store") != AZStd::string::npos)
+            {
+                return false;
+            }
+
+            hasMaxAge = CalculateExpiryTime(headers, 0) > 0;
+        }
+
+        // bodies are stored decoded, so only varying on the encoding is independent of the request
+        auto vary = headers.find(VARY_HEADER_KEY);
+        if (vary != headers.end())
+        {
+            AZStd::string fields = vary->second.c_str();
+            AZStd::to_lower(fields.begin(), fields.end());
+            std::size_t begin = 0;
+            while (begin < fields.size())
+            {
+                std::size_t end = fields.find(',', begin);
+                if (end == AZStd::string::npos)
+                {
+                    end = fields.size();
+                }
+
+                AZStd::string_view field = AZStd::string_view(fields).substr(begin, end - begin);
+                while (!field.empty() && field.front() == ' ')
+                {
+                    field.remove_prefix(1);
+                }
+
+                while (!field.empty() && field.back() == ' ')
+                {
+                    field.remove_suffix(1);
+                }
+
+                if (!field.empty() && field != "accept-encoding")
+                {
+                    return false;
+                }
+
+                begin = end + 1;
+            }
+        }
+
+        // without freshness information the response is only useful if it can be revalidated
+        return hasMaxAge || headers.find(ETAG_HEADER_KEY) != headers.end() || headers.find(LAST_MODIFIED_HEADER_KEY) != headers.end();
+    }
+
+    AZStd::string HttpResponseCache::CreateCacheKey(const std::string& url, const CesiumAsync::HttpHeaders& requestHeaders)
+    {
+        AZStd::string cacheKey(url.c_str());
+        auto authorization = requestHeaders.find(AUTHORIZATION_HEADER_KEY);
+        if (authorization != requestHeaders.end())
+        {
+            const std::string& credentials = authorization->second;
+            cacheKey += " authorization=";
+            cacheKey += CalculateBlobName(
+                gsl::span<const std::byte>(reinterpret_cast<const std::byte*>(credentials.data()), credentials.size()));
+        }
+
+        return cacheKey;
+    }
+
+    std::int64_t HttpResponseCache::CalculateExpiryTime(const CesiumAsync::HttpHeaders& headers, std::int64_t now)
+    {
+        auto cacheControl = headers.find(CACHE_CONTROL_HEADER_KEY);
+        if (cacheControl == headers.end())
+        {
+            return now;
+        }
+
+        AZStd::string directives = cacheControl->second.c_str();
+        AZStd::to_lower(directives.begin(), directives.end());
+
+        std::int64_t maxAge = 0;
+        std::size_t begin = 0;
+        while (begin < directives.size())
+        {
+            std::size_t end = directives.find(',', begin);
+            if (end == AZStd::string::npos)
+            {
+                end = directives.size();
+            }
+
+            AZStd::string_view directive = AZStd::string_view(directives).substr(begin, end - begin);
+            while (!directive.empty() && directive.front() == ' ')
+            {
+                directive.remove_prefix(1);
+            }
+
+            if (directive.starts_with("no-cache"))
+            {
+                return now;
+            }
+
+            if (directive.starts_with("max-age="))
+            {
+                maxAge = std::strtoll(AZStd::string(directive.substr(8)).c_str(), nullptr, 10);
+            }
+
+            begin = end + 1;
+        }
+
+        return now + AZStd::max<std::int64_t>(maxAge, 0);
+    }
+
+    std::int64_t HttpResponseCache::GetUnixTime()
+    {
+        auto now = std::chrono::system_clock::now().time_since_epoch();
+        return std::chrono::duration_cast<std::chrono::seconds>(now).count();
+    }
+
+    IOContent HttpResponseCache::ReadBlob(const AZStd::string& blobPath)
+    {
+        AZ::IO::SystemFile file;
+        if (!file.Open(blobPath.c_str(), AZ::IO::SystemFile::SF_OPEN_READ_ONLY))
+        {
+            return {};
+        }
+
+        IOContent content(static_cast<std::size_t>(file.Length()));
+        AZ::IO::SizeType read = file.Read(content.size(), content.data());
+        if (read != content.size())
+        {
+            return {};
+        }
+
+        return content;
+    }
+
+    void HttpResponseCache::LoadIndex()
+    {
+        AZStd::string indexPath = (AZ::IO::Path(m_cacheDirectory) / INDEX_FILE_NAME).Native();
+        IOContent indexContent = ReadBlob(indexPath);
+        if (indexContent.empty())
+        {
+            return;
+        }
+
+        rapidjson::Document document;
+        document.Parse(reinterpret_cast<const char*>(indexContent.data()), indexContent.size());
+        if (document.HasParseError() || !document.IsObject())
+        {
+            return;
+        }
+
+        auto version = document.FindMember("version");
+        if (version == document.MemberEnd() || !version->value.IsUint() || version->value.GetUint() != INDEX_VERSION)
+        {
+            return;
+        }
+
+        auto entries = document.FindMember("entries");
+        if (entries == document.MemberEnd() || !entries->value.IsArray())
+        {
+            return;
+        }
+
+        // entries are saved from the most to the least recently used
+        for (const auto& jsonEntry : entries->value.GetArray())
+        {
+            // the index may be truncated or edited by hand, so entries of the wrong shape are skipped
+            if (!jsonEntry.IsObject())
+            {
+                continue;
+            }
+
+            auto jsonUrl = jsonEntry.FindMember("url");
+            auto jsonBlob = jsonEntry.FindMember("blob");
+            auto jsonStatus = jsonEntry.FindMember("status");
+            auto jsonContentType = jsonEntry.FindMember("contentType");
+            auto jsonExpiry = jsonEntry.FindMember("expiry");
+            auto jsonHeaders = jsonEntry.FindMember("headers");
+            if (jsonUrl == jsonEntry.MemberEnd() || !jsonUrl->value.IsString() || jsonBlob == jsonEntry.MemberEnd() ||
+                !jsonBlob->value.IsString() || jsonStatus == jsonEntry.MemberEnd() || !jsonStatus->value.IsUint() ||
+                jsonStatus->value.GetUint() > std::numeric_limits<std::uint16_t>::max() || jsonContentType == jsonEntry.MemberEnd() ||
+                !jsonContentType->value.IsString() || jsonExpiry == jsonEntry.MemberEnd() || !jsonExpiry->value.IsInt64() ||
+                jsonHeaders == jsonEntry.MemberEnd() || !jsonHeaders->value.IsObject())
+            {
+                continue;
+            }
+
+            CesiumAsync::HttpHeaders headers;
+            bool validHeaders = true;
+            for (const auto& header : jsonHeaders->value.GetObject())
+            {
+                if (!header.value.IsString())
+                {
+                    validHeaders = false;
+                    break;
+                }
+
+                headers.insert_or_assign(header.name.GetString(), header.value.GetString());
+            }
+
+            if (!validHeaders)
+            {
+                continue;
+            }
+
+            AZStd::string url = jsonUrl->value.GetString();
+            AZStd::string blobName = jsonBlob->value.GetString();
+            AZStd::string blobPath = GetBlobPath(blobName);
+
+            // blob names are sha1 digests. Anything else could point outside of the cache directory
+            if (blobName.empty() || blobName.find_first_not_of("0123456789abcdef") != AZStd::string::npos ||
+                m_entries.find(url) != m_entries.end() || !AZ::IO::SystemFile::Exists(blobPath.c_str()))
+            {
+                continue;
+            }
+
+            auto blobIt = m_blobs.find(blobName);
+            if (blobIt == m_blobs.end())
+            {
+                std::uint64_t blobSize = AZ::IO::SystemFile::Length(blobPath.c_str());
+                blobIt = m_blobs.insert({ blobName, CacheBlob{ blobSize, 0 } }).first;
+                m_currentBytes += blobSize;
+            }
+
+            ++blobIt->second.m_refCount;
+
+            m_lru.push_back(url);
+            CacheEntry entry;
+            entry.m_blobName = std::move(blobName);
+            entry.m_statusCode = static_cast<std::uint16_t>(jsonStatus->value.GetUint());
+            entry.m_contentType = jsonContentType->value.GetString();
+            entry.m_headers = std::move(headers);
+            entry.m_expiryTime = jsonExpiry->value.GetInt64();
+            entry.m_lruPosition = AZStd::prev(m_lru.end());
+            m_entries.insert_or_assign(url, std::move(entry));
+        }
+
+        // remove blobs that are not referenced by the index anymore, e.g. when the editor was terminated before the index is saved
+        AZStd::string blobFilter = (AZ::IO::Path(m_cacheDirectory) / "*.blob").Native();
+        AZ::IO::SystemFile::FindFiles(
+            blobFilter.c_str(),
+            [this](const char* fileName, bool isFile)
+            {
+                if (isFile)
+                {
+                    AZStd::string blobName = AZ::IO::PathView(fileName).Stem().Native();
+                    if (m_blobs.find(blobName) == m_blobs.end())
+                    {
+                        AZ::IO::SystemFile::Delete(GetBlobPath(blobName).c_str());
+                    }
+                }
+
+                return true;
+            });
+    }
+
+    HttpResponseCache::IndexSnapshot HttpResponseCache::TakeIndexSnapshot()
+    {
+        // a failing disk is retried on the next interval, not on every write
+        m_lastIndexSaveTime = GetUnixTime();
+        m_indexDirty = false;
+        m_lruDirty = false;
+
+        IndexSnapshot snapshot;
+        snapshot.m_sequence = ++m_indexSnapshotCount;
+        snapshot.m_entries.reserve(m_lru.size());
+        for (const AZStd::string& url : m_lru)
+        {
+            snapshot.m_entries.emplace_back(url, m_entries.find(url)->second);
+        }
+
+        return snapshot;
+    }
+
+    AZStd::optional<HttpResponseCache::IndexSnapshot> HttpResponseCache::TakeIndexSnapshotIfDue()
+    {
+        if (m_indexDirty && GetUnixTime() - m_lastIndexSaveTime >= INDEX_SAVE_INTERVAL)
+        {
+            return TakeIndexSnapshot();
+        }
+
+        return AZStd::nullopt;
+    }
+
+    void HttpResponseCache::SaveIndex(const IndexSnapshot& snapshot)
+    {
+        AZStd::scoped_lock<AZStd::mutex> fileLock(m_indexFileMutex);
+        if (snapshot.m_sequence < m_savedIndexSequence)
+        {
+            return;
+        }
+
+        rapidjson::StringBuffer buffer;
+        rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+        writer.StartObject();
+        writer.Key("version");
+        writer.Uint(INDEX_VERSION);
+        writer.Key("entries");
+        writer.StartArray();
+        for (const auto& snapshotEntry : snapshot.m_entries)
+        {
+            const AZStd::string& url = snapshotEntry.first;
+            const CacheEntry& entry = snapshotEntry.second;
+            writer.StartObject();
+            writer.Key("url");
+            writer.String(url.c_str(), static_cast<rapidjson::SizeType>(url.size()));
+            writer.Key("blob");
+            writer.String(entry.m_blobName.c_str(), static_cast<rapidjson::SizeType>(entry.m_blobName.size()));
+            writer.Key("status");
+            writer.Uint(entry.m_statusCode);
+            writer.Key("contentType");
+            writer.String(entry.m_contentType.c_str(), static_cast<rapidjson::SizeType>(entry.m_contentType.size()));
+            writer.Key("expiry");
+            writer.Int64(entry.m_expiryTime);
+            writer.Key("headers");
+            writer.StartObject();
+            for (const auto& header : entry.m_headers)
+            {
+                writer.Key(header.first.c_str(), static_cast<rapidjson::SizeType>(header.first.size()));
+                writer.String(header.second.c_str(), static_cast<rapidjson::SizeType>(header.second.size()));
+            }
+            writer.EndObject();
+            writer.EndObject();
+        }
+        writer.EndArray();
+        writer.EndObject();
+
+        // write the index to a temporary file first, so a crash never leaves a truncated index behind
+        AZStd::string indexPath = (AZ::IO::Path(m_cacheDirectory) / INDEX_FILE_NAME).Native();
+        AZStd::string tempIndexPath = indexPath + ".tmp";
+        AZ::IO::SystemFile file;
+        bool saved = false;
+        if (file.Open(
+                tempIndexPath.c_str(),
+                AZ::IO::SystemFile::SF_OPEN_CREATE | AZ::IO::SystemFile::SF_OPEN_CREATE_PATH | AZ::IO::SystemFile::SF_OPEN_WRITE_ONLY))
+        {
+            AZ::IO::SizeType written = file.Write(buffer.GetString(), buffer.GetSize());
+            file.Close();
+            saved = written == buffer.GetSize() && AZ::IO::SystemFile::Rename(tempIndexPath.c_str(), indexPath.c_str(), true);
+        }
+
+        if (saved)
+        {
+            m_savedIndexSequence = snapshot.m_sequence;
+            return;
+        }
+
+        // the snapshot marked the index as saved, so it is marked dirty again to be retried. The file lock is always taken
+        // before m_mutex, never the other way around
+        AZStd::scoped_lock<AZStd::mutex> lock(m_mutex);
+        m_indexDirty = true;
+    }
+
+    void HttpResponseCache::RemoveEntry(const AZStd::string& url)
+    {
+        auto entryIt = m_entries.find(url);
+        if (entryIt == m_entries.end())
+        {
+            return;
+        }
+
+        auto blobIt = m_blobs.find(entryIt->second.m_blobName);
+        if (blobIt != m_blobs.end() && --blobIt->second.m_refCount == 0)
+        {
+            AZ::IO::SystemFile::Delete(GetBlobPath(blobIt->first).c_str());
+            m_currentBytes -= blobIt->second.m_size;
+            m_blobs.erase(blobIt);
+        }
+
+        m_lru.erase(entryIt->second.m_lruPosition);
+        m_entries.erase(entryIt);
+        m_indexDirty = true;
+    }
+
+    void HttpResponseCache::EvictToBudget()
+    {
+        while (m_currentBytes > m_maximumBytes && !m_lru.empty())
+        {
+            AZStd::string leastRecentlyUsed = m_lru.back();
+            RemoveEntry(leastRecentlyUsed);
+        }
+    }
+
+    AZStd::string HttpResponseCache::GetBlobPath(const AZStd::string& blobName) const
+    {
+        return (AZ::IO::Path(m_cacheDirectory) / (blobName + ".blob")).Native();
+    }
+
+    AZStd::string HttpResponseCache::CalculateBlobName(gsl::span<const std::byte> content)
+    {
+        AZ::Sha1 sha;
+        sha.ProcessBytes(content.data(), content.size());
+        AZ::u32 digest[5];
+        sha.GetDigest(digest);
+        return AZStd::string::format("%08x%08x%08x%08x%08x", digest[0], digest[1], digest[2], digest[3], digest[4]);
+    }
+} // namespace Cesium
@@ -0,0 +1,152 @@
+#pragma once
+
+#include "Cesium/Systems/GenericIOManager.h"
+#include <AzCore/std/containers/list.h>
+#include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/optional.h>
+#include <AzCore/std/parallel/mutex.h>
+#include <AzCore/std/string/string.h>
+#include <AzCore/std/utils.h>
+#include <CesiumAsync/HttpHeaders.h>
+#include <gsl/span>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Cesium
+{
+    struct HttpCachedResponse final
+    {
+        std::uint16_t m_statusCode;
+        std::string m_contentType;
+        CesiumAsync::HttpHeaders m_headers;
+        AZStd::string m_blobPath;
+        bool m_isFresh;
+    };
+
+    // Disk-backed cache for http responses. Response bodies are stored as content-addressed blobs, so the same payload
+    // served from different urls is only stored once. The index maps the cache key of a url to its blob and the validators
+    // (ETag, Last-Modified) needed to revalidate the response with the server. Entries are evicted in LRU order
+    // when the total size of the blobs exceeds the byte budget.
+    class HttpResponseCache final
+    {
+        struct CacheBlob
+        {
+            std::uint64_t m_size;
+            std::uint32_t m_refCount;
+        };
+
+        struct CacheEntry
+        {
+            AZStd::string m_blobName;
+            std::uint16_t m_statusCode;
+            std::string m_contentType;
+            CesiumAsync::HttpHeaders m_headers;
+            std::int64_t m_expiryTime;
+            AZStd::list<AZStd::string>::iterator m_lruPosition;
+        };
+
+        // copy of the index taken under the lock, so it can be serialized and written without blocking requests
+        struct IndexSnapshot
+        {
+            std::uint64_t m_sequence;
+            AZStd::vector<AZStd::pair<AZStd::string, CacheEntry>> m_entries;
+        };
+
+    public:
+        HttpResponseCache(const AZStd::string& cacheDirectory, std::uint64_t maximumBytes);
+
+        HttpResponseCache(const HttpResponseCache&) = delete;
+
+        HttpResponseCache& operator=(const HttpResponseCache&) = delete;
+
+        ~HttpResponseCache() noexcept;
+
+        AZStd::optional<HttpCachedResponse> Find(const AZStd::string& url);
+
+        bool Store(
+            const AZStd::string& url,
+            std::uint16_t statusCode,
+            const std::string& contentType,
+            const CesiumAsync::HttpHeaders& headers,
+            gsl::span<const std::byte> content);
+
+        bool Revalidate(const AZStd::string& url, const CesiumAsync::HttpHeaders& revalidatedHeaders);
+
+        void Remove(const AZStd::string& url);
+
+        void Clear();
+
+        void Flush();
+
+        void SetMaximumBytes(std::uint64_t maximumBytes);
+
+        std::uint64_t GetMaximumBytes() const;
+
+        std::uint64_t GetCurrentBytes() const;
+
+        // responses that vary on request headers other than Accept-Encoding can't be told apart by their key
+        static bool IsCacheable(const CesiumAsync::HttpHeaders& headers);
+
+        // responses to authorized requests are keyed by the digest of their credentials as well, so they are never served
+        // to requests with other credentials, and the credentials themselves are not written to the index
+        static AZStd::string CreateCacheKey(const std::string& url, const CesiumAsync::HttpHeaders& requestHeaders);
+
+        static std::int64_t CalculateExpiryTime(const CesiumAsync::HttpHeaders& headers, std::int64_t now);
+
+        static std::int64_t GetUnixTime();
+
+        static IOContent ReadBlob(const AZStd::string& blobPath);
+
+    private:
+        void LoadIndex();
+
+        // takes a snapshot of the index in LRU order. Must be called with m_mutex held
+        IndexSnapshot TakeIndexSnapshot();
+
+        AZStd::optional<IndexSnapshot> TakeIndexSnapshotIfDue();
+
+        // writes a snapshot to disk. Must be called without m_mutex held
+        void SaveIndex(const IndexSnapshot& snapshot);
+
+        void RemoveEntry(const AZStd::string& url);
+
+        void EvictToBudget();
+
+        AZStd::string GetBlobPath(const AZStd::string& blobName) const;
+
+        static AZStd::string CalculateBlobName(gsl::span<const std::byte> content);
+
+        static constexpr const char* const INDEX_FILE_NAME = "index.json";
+        static constexpr const char* const CACHE_CONTROL_HEADER_KEY = "Cache-Control";
+        static constexpr const char* const ETAG_HEADER_KEY = "ETag";
+        static constexpr const char* const LAST_MODIFIED_HEADER_KEY = "Last-Modified";
+        static constexpr const char* const CONTENT_ENCODING_HEADER_KEY = "Content-Encoding";
+        static constexpr const char* const CONTENT_LENGTH_HEADER_KEY = "Content-Length";
+        static constexpr const char* const VARY_HEADER_KEY = "Vary";
+        static constexpr const char* const AUTHORIZATION_HEADER_KEY = "Authorization";
+        static constexpr std::uint32_t INDEX_VERSION = 1;
+
+        // seconds between index saves while the cache is modified, so a crash loses at most this much of the index
+        static constexpr std::int64_t INDEX_SAVE_INTERVAL = 30;
+
+        mutable AZStd::mutex m_mutex;
+        AZStd::string m_cacheDirectory;
+        std::uint64_t m_maximumBytes;
+        std::uint64_t m_currentBytes;
+        // the entries changed since the last snapshot. Only the LRU order changing is saved with them or on Flush, so cache
+        // hits alone don't rewrite the index
+        bool m_indexDirty;
+        bool m_lruDirty;
+        std::int64_t m_lastIndexSaveTime;
+        std::uint64_t m_indexSnapshotCount;
+
+        // serializes index writes, so an older snapshot never replaces a newer one on disk
+        AZStd::mutex m_indexFileMutex;
+        std::uint64_t m_savedIndexSequence;
+        AZStd::unordered_map<AZStd::string, CacheEntry> m_entries;
+        AZStd::unordered_map<AZStd::string, CacheBlob> m_blobs;
+        AZStd::list<AZStd::string> m_lru;
+    };
+} // namespace Cesium
@@ -1,9 +1,8 @@
 #include "Cesium/Systems/LocalFileManager.h"
 #include <AzCore/StringFunc/StringFunc.h>
 #include <AzCore/IO/FileIO.h>
-#include <AzCore/Jobs/JobManager.h>
-#include <AzCore/Jobs/JobContext.h>
-#include <AzCore/Jobs/JobFunction.h>
+#include <AzCore/IO/Path/Path.h>
+#include <AzCore/IO/SystemFile.h>
 #include <CesiumAsync/Promise.h>
 
 namespace Cesium
@@ -24,48 +23,46 @@ namespace Cesium
 
         void operator()()
         {
-            AZStd::string absolutePath;
-            if (m_request.m_parentPath.empty())
-            {
-                absolutePath = m_request.m_path;
-            }
-            else if (m_request.m_path.empty())
-            {
-                absolutePath = m_request.m_parentPath;
-            }
-            else
-            {
-                AZ::StringFunc::Path::Join(m_request.m_parentPath.c_str(), m_request.m_path.c_str(), absolutePath);
-            }
-
-            AZ::IO::FileIOStream stream(absolutePath.c_str(), AZ::IO::OpenMode::ModeRead | AZ::IO::OpenMode::ModeBinary);
-            if (!stream.IsOpen())
-            {
-                m_promise.resolve(IOContent{});
-            }
-            else
-            {
-                // Create a buffer.
-                std::size_t fileSize = stream.GetLength();
-                IOContent content(fileSize);
-                stream.Read(fileSize, content.data());
-                m_promise.resolve(std::move(content));
-            }
+            m_promise.resolve(ReadFileContent(GetAbsolutePath(m_request)));
         }
 
         IORequestParameter m_request;
         CesiumAsync::Promise<IOContent> m_promise;
     };
 
-    LocalFileManager::LocalFileManager()
+    struct LocalFileManager::MappedRequestHandler
     {
-        AZ::JobManagerDesc jobDesc;
-        for (size_t i = 0; i < 2; ++i)
+        MappedRequestHandler(IORequestParameter&& request, const CesiumAsync::Promise<MappedIOContent>& promise)
+            : m_request{ std::move(request) }
+            , m_promise{ promise }
+        {
+        }
+
+        void operator()()
         {
-            jobDesc.m_workerThreads.push_back({ static_cast<int>(i) });
+            m_promise.resolve(MapFileContent(GetAbsolutePath(m_request)));
         }
-        m_ioJobManager = AZStd::make_unique<AZ::JobManager>(jobDesc);
-        m_ioJobContext = AZStd::make_unique<AZ::JobContext>(*m_ioJobManager);
+
+        IORequestParameter m_request;
+        CesiumAsync::Promise<MappedIOContent> m_promise;
+    };
+
+    LocalFileManager::LocalFileManager()
+    {
+        CesiumSchedulerConfiguration schedulerConfiguration;
+        schedulerConfiguration.m_fileLane.m_threadCount = 2;
+        m_ownedScheduler = AZStd::make_unique<CesiumScheduler>(schedulerConfiguration);
+        m_scheduler = m_ownedScheduler.get();
+    }
+
+    LocalFileManager::LocalFileManager(CesiumScheduler& scheduler)
+        : m_scheduler{ &scheduler }
+    {
+    }
+
+    LocalFileManager::~LocalFileManager() noexcept
+    {
+        m_scheduledTasks.Wait();
     }
 
     AZStd::string LocalFileManager::GetParentPath(const AZStd::string& path)
@@ -76,6 +73,45 @@ namespace Cesium
     }
 
     IOContent LocalFileManager::GetFileContent(const IORequestParameter& request)
+    {
+        return ReadFileContent(GetAbsolutePath(request));
+    }
+
+    IOContent LocalFileManager::GetFileContent(IORequestParameter&& request)
+    {
+        return GetFileContent(request);
+    }
+
+    CesiumAsync::Future<IOContent> LocalFileManager::GetFileContentAsync(
+        const CesiumAsync::AsyncSystem& asyncSystem, const IORequestParameter& request)
+    {
+        auto promise = asyncSystem.createPromise<IOContent>();
+        m_scheduler->Submit(CesiumSchedulerLane::File, RequestHandler{ request, promise }, &m_scheduledTasks);
+        return promise.getFuture();
+    }
+
+    CesiumAsync::Future<IOContent> LocalFileManager::GetFileContentAsync(
+        const CesiumAsync::AsyncSystem& asyncSystem, IORequestParameter&& request)
+    {
+        auto promise = asyncSystem.createPromise<IOContent>();
+        m_scheduler->Submit(CesiumSchedulerLane::File, RequestHandler{ std::move(request), promise }, &m_scheduledTasks);
+        return promise.getFuture();
+    }
+
+    MappedIOContent LocalFileManager::GetMappedFileContent(const IORequestParameter& request)
+    {
+        return MapFileContent(GetAbsolutePath(request));
+    }
+
+    CesiumAsync::Future<MappedIOContent> LocalFileManager::GetMappedFileContentAsync(
+        const CesiumAsync::AsyncSystem& asyncSystem, IORequestParameter&& request)
+    {
+        auto promise = asyncSystem.createPromise<MappedIOContent>();
+        m_scheduler->Submit(CesiumSchedulerLane::File, MappedRequestHandler{ std::move(request), promise }, &m_scheduledTasks);
+        return promise.getFuture();
+    }
+
+    AZStd::string LocalFileManager::GetAbsolutePath(const IORequestParameter& request)
     {
         AZStd::string absolutePath;
         if (request.m_parentPath.empty())
@@ -91,6 +127,11 @@ namespace Cesium
             AZ::StringFunc::Path::Join(request.m_parentPath.c_str(), request.m_path.c_str(), absolutePath);
         }
 
+        return absolutePath;
+    }
+
+    IOContent LocalFileManager::ReadFileContent(const AZStd::string& absolutePath)
+    {
         AZ::IO::FileIOStream stream(absolutePath.c_str(), AZ::IO::OpenMode::ModeRead | AZ::IO::OpenMode::ModeBinary);
         if (!stream.IsOpen())
         {
@@ -104,27 +145,22 @@ namespace Cesium
         return content;
     }
 
-    IOContent LocalFileManager::GetFileContent(IORequestParameter&& request)
-    {
-        return GetFileContent(request);
-    }
-
-    CesiumAsync::Future<IOContent> LocalFileManager::GetFileContentAsync(
-        const CesiumAsync::AsyncSystem& asyncSystem, const IORequestParameter& request)
+    MappedIOContent LocalFileManager::MapFileContent(const AZStd::string& absolutePath)
     {
-        auto promise = asyncSystem.createPromise<IOContent>();
-        AZ::Job* job = aznew AZ::JobFunction<std::function<void()>>(RequestHandler{ request, promise }, true, m_ioJobContext.get());
-        job->Start();
-        return promise.getFuture();
-    }
+        // Only plain files on disk can be mapped. Aliased paths are resolved first, and files that only exist
+        // inside an archive fall back to the copying read below.
+        AZ::IO::FixedMaxPath resolvedPath;
+        AZ::IO::FileIOBase* fileIO = AZ::IO::FileIOBase::GetInstance();
+        if (fileIO && fileIO->ResolvePath(resolvedPath, absolutePath.c_str()) &&
+            AZ::IO::SystemFile::Length(resolvedPath.c_str()) >= MINIMUM_MAPPED_FILE_SIZE)
+        {
+            auto mappedFile = MappedFile::Open(resolvedPath.c_str());
+            if (mappedFile)
+            {
+                return MappedIOContent(std::move(mappedFile));
+            }
+        }
 
-    CesiumAsync::Future<IOContent> LocalFileManager::GetFileContentAsync(
-        const CesiumAsync::AsyncSystem& asyncSystem, IORequestParameter&& request)
-    {
-        auto promise = asyncSystem.createPromise<IOContent>();
-        AZ::Job* job =
-            aznew AZ::JobFunction<std::function<void()>>(RequestHandler{ std::move(request), promise }, true, m_ioJobContext.get());
-        job->Start();
-        return promise.getFuture();
+        return MappedIOContent(ReadFileContent(absolutePath));
     }
 } // namespace Cesium
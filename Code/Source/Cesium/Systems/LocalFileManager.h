@@ -1,27 +1,27 @@
 #pragma once
 
+#include "Cesium/Systems/CesiumScheduler.h"
 #include "Cesium/Systems/GenericIOManager.h"
 #include <AzCore/std/parallel/mutex.h>
 #include <AzCore/std/smart_ptr/unique_ptr.h>
 #include <CesiumAsync/AsyncSystem.h>
 #include <CesiumAsync/Future.h>
-
-namespace AZ
-{
-    class JobManager;
-    class JobContext;
-    class Job;
-} // namespace AZ
+#include <cstdint>
 
 namespace Cesium
 {
     class LocalFileManager final : public GenericIOManager
     {
         struct RequestHandler;
+        struct MappedRequestHandler;
 
     public:
         LocalFileManager();
 
+        explicit LocalFileManager(CesiumScheduler& scheduler);
+
+        ~LocalFileManager() noexcept;
+
         AZStd::string GetParentPath(const AZStd::string& path) override;
 
         IOContent GetFileContent(const IORequestParameter& request) override;
@@ -34,8 +34,23 @@ namespace Cesium
         CesiumAsync::Future<IOContent> GetFileContentAsync(
             const CesiumAsync::AsyncSystem& asyncSystem, IORequestParameter&& request) override;
 
+        MappedIOContent GetMappedFileContent(const IORequestParameter& request) override;
+
+        CesiumAsync::Future<MappedIOContent> GetMappedFileContentAsync(
+            const CesiumAsync::AsyncSystem& asyncSystem, IORequestParameter&& request) override;
+
     private:
-        AZStd::unique_ptr<AZ::JobManager> m_ioJobManager;
-        AZStd::unique_ptr<AZ::JobContext> m_ioJobContext;
+        static AZStd::string GetAbsolutePath(const IORequestParameter& request);
+
+        static IOContent ReadFileContent(const AZStd::string& absolutePath);
+
+        static MappedIOContent MapFileContent(const AZStd::string& absolutePath);
+
+        // Small files are cheaper to copy than to map, and most tiles of a tileset are small.
+        static constexpr std::uint64_t MINIMUM_MAPPED_FILE_SIZE = 1024 * 1024;
+
+        AZStd::unique_ptr<CesiumScheduler> m_ownedScheduler;
+        CesiumScheduler* m_scheduler;
+        CesiumSchedulerTaskGroup m_scheduledTasks;
     };
 } // namespace Cesium
@@ -0,0 +1,109 @@
+#include "Cesium/Systems/MappedFile.h"
+#include <AzCore/PlatformDef.h>
+#include <AzCore/Debug/Trace.h>
+#include <cstdint>
+
+#if defined(AZ_PLATFORM_WINDOWS)
+#include <AzCore/PlatformIncl.h>
+#include <AzCore/std/string/conversions.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Cesium
+{
+#if defined(AZ_PLATFORM_WINDOWS)
+    AZStd::unique_ptr<MappedFile> MappedFile::Open(const AZStd::string& path)
+    {
+        AZStd::wstring widePath;
+        AZStd::to_wstring(widePath, path.c_str());
+        HANDLE file = CreateFileW(
+            widePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return nullptr;
+        }
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart <= 0 ||
+            static_cast<std::uint64_t>(fileSize.QuadPart) > static_cast<std::uint64_t>(SIZE_MAX))
+        {
+            CloseHandle(file);
+            return nullptr;
+        }
+
+        // The view keeps the mapping alive, so both handles can be closed once the view is created.
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (mapping == nullptr)
+        {
+            return nullptr;
+        }
+
+        void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);
+        if (data == nullptr)
+        {
+            AZ_Warning("Cesium", false, "Failed to map file %s", path.c_str());
+            return nullptr;
+        }
+
+        return AZStd::unique_ptr<MappedFile>(
+            new MappedFile(static_cast<const std::byte*>(data), static_cast<std::size_t>(fileSize.QuadPart)));
+    }
+
+    MappedFile::~MappedFile() noexcept
+    {
+        UnmapViewOfFile(m_data);
+    }
+#else
+    AZStd::unique_ptr<MappedFile> MappedFile::Open(const AZStd::string& path)
+    {
+        int file = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (file < 0)
+        {
+            return nullptr;
+        }
+
+        struct stat fileStat;
+        if (fstat(file, &fileStat) != 0 || !S_ISREG(fileStat.st_mode) || fileStat.st_size <= 0)
+        {
+            close(file);
+            return nullptr;
+        }
+
+        // The mapping holds its own reference to the file, so the descriptor can be closed right away.
+        std::size_t fileSize = static_cast<std::size_t>(fileStat.st_size);
+        void* data = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, file, 0);
+        close(file);
+        if (data == MAP_FAILED)
+        {
+            AZ_Warning("Cesium", false, "Failed to map file %s", path.c_str());
+            return nullptr;
+        }
+
+        // Tile payloads are parsed front to back, so ask for aggressive read-ahead.
+        posix_madvise(data, fileSize, POSIX_MADV_SEQUENTIAL);
+        return AZStd::unique_ptr<MappedFile>(new MappedFile(static_cast<const std::byte*>(data), fileSize));
+    }
+
+    MappedFile::~MappedFile() noexcept
+    {
+        munmap(const_cast<std::byte*>(m_data), m_size);
+    }
+#endif
+
+    MappedFile::MappedFile(const std::byte* data, std::size_t size)
+        : m_data{ data }
+        , m_size{ size }
+    {
+    }
+
+    gsl::span<const std::byte> MappedFile::GetData() const
+    {
+        return gsl::span<const std::byte>(m_data, m_size);
+    }
+} // namespace Cesium
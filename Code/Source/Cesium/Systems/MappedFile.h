@@ -0,0 +1,32 @@
+#pragma once
+
+#include <AzCore/std/smart_ptr/unique_ptr.h>
+#include <AzCore/std/string/string.h>
+#include <gsl/span>
+#include <cstddef>
+
+namespace Cesium
+{
+    // Read-only memory mapping of a file on disk. Pages are faulted in by the OS on access instead of being copied into
+    // an intermediate buffer, so large local files are only resident once while they are parsed.
+    // The mapping is released when the object is destroyed.
+    class MappedFile final
+    {
+    public:
+        static AZStd::unique_ptr<MappedFile> Open(const AZStd::string& path);
+
+        MappedFile(const MappedFile&) = delete;
+
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        ~MappedFile() noexcept;
+
+        gsl::span<const std::byte> GetData() const;
+
+    private:
+        MappedFile(const std::byte* data, std::size_t size);
+
+        const std::byte* m_data;
+        std::size_t m_size;
+    };
+} // namespace Cesium
@@ -1,28 +1,40 @@
 #include "Cesium/Systems/TaskProcessor.h"
-#include <AzCore/Jobs/JobFunction.h>
+#include "Cesium/Systems/HttpAssetAccessor.h"
 
 namespace Cesium
 {
     TaskProcessor::TaskProcessor()
+        : m_ownedScheduler{ AZStd::make_unique<CesiumScheduler>() }
+        , m_scheduler{ m_ownedScheduler.get() }
+    {
+    }
+
+    TaskProcessor::TaskProcessor(CesiumScheduler& scheduler)
+        : m_scheduler{ &scheduler }
     {
-        AZ::JobManagerDesc jobDesc;
-        for (size_t i = 0; i < AZStd::thread::hardware_concurrency(); ++i)
-        {
-            jobDesc.m_workerThreads.push_back({ static_cast<int>(i) });
-        }
-        m_jobManager = AZStd::make_unique<AZ::JobManager>(jobDesc);
-        m_jobContext = AZStd::make_unique<AZ::JobContext>(*m_jobManager);
     }
 
     TaskProcessor::~TaskProcessor() noexcept
     {
-        m_jobContext.reset();
-        m_jobManager.reset();
+        m_ownedScheduler.reset();
     }
 
     void TaskProcessor::startTask(std::function<void()> task)
     {
-        AZ::Job* job = aznew AZ::JobFunction<std::function<void()>>(task, true, nullptr);
-        job->Start();
+        // tasks started under a request scope run under it as well, so the requests they make belong to the same scope
+        HttpAssetAccessor::RequestScope requestScope = HttpAssetAccessor::GetCurrentRequestScope();
+        if (requestScope.m_scopeId == 0)
+        {
+            m_scheduler->Submit(CesiumSchedulerLane::Compute, std::move(task));
+            return;
+        }
+
+        m_scheduler->Submit(
+            CesiumSchedulerLane::Compute,
+            [task = std::move(task), requestScope]()
+            {
+                HttpAssetAccessor::RequestScopeGuard scopeGuard(requestScope);
+                task();
+            });
     }
 } // namespace Cesium
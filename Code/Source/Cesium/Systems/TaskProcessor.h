@@ -1,7 +1,6 @@
 #pragma once
 
-#include <AzCore/Jobs/JobManager.h>
-#include <AzCore/Jobs/JobContext.h>
+#include "Cesium/Systems/CesiumScheduler.h"
 #include <AzCore/std/smart_ptr/unique_ptr.h>
 #include <CesiumAsync/ITaskProcessor.h>
 
@@ -12,12 +11,14 @@ namespace Cesium
     public:
         TaskProcessor();
 
+        explicit TaskProcessor(CesiumScheduler& scheduler);
+
         ~TaskProcessor() noexcept;
 
         void startTask(std::function<void()> task) override;
 
     private:
-        AZStd::unique_ptr<AZ::JobManager> m_jobManager;
-        AZStd::unique_ptr<AZ::JobContext> m_jobContext;
+        AZStd::unique_ptr<CesiumScheduler> m_ownedScheduler;
+        CesiumScheduler* m_scheduler;
     };
 } // namespace Cesium
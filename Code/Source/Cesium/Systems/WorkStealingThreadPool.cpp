@@ -0,0 +1,339 @@
+#include "Cesium/Systems/WorkStealingThreadPool.h"
+#include "Cesium/Systems/CesiumScheduler.h"
+#include <AzCore/Debug/Trace.h>
+#include <AzCore/std/algorithm.h>
+#include <AzCore/std/chrono/chrono.h>
+#include <AzCore/std/parallel/scoped_lock.h>
+
+namespace Cesium
+{
+    namespace
+    {
+        thread_local const WorkStealingThreadPool* s_currentPool = nullptr;
+        thread_local std::uint32_t s_currentWorkerIndex = 0;
+    } // namespace
+
+    PooledTask::~PooledTask() noexcept
+    {
+        if (m_callable)
+        {
+            m_destroy(m_callable, m_callable == static_cast<void*>(m_inlineStorage));
+        }
+    }
+
+    void PooledTask::Run()
+    {
+        m_invoke(m_callable);
+    }
+
+    CesiumSchedulerTaskGroup* PooledTask::GetTaskGroup() const
+    {
+        return m_taskGroup;
+    }
+
+    WorkStealingThreadPool::TaskDeque::TaskDeque()
+        : m_buffer(256, nullptr)
+        , m_head{ 0 }
+        , m_size{ 0 }
+    {
+    }
+
+    void WorkStealingThreadPool::TaskDeque::PushBack(PooledTask* task)
+    {
+        if (m_size == m_buffer.size())
+        {
+            Grow();
+        }
+
+        m_buffer[(m_head + m_size) & (m_buffer.size() - 1)] = task;
+        ++m_size;
+    }
+
+    PooledTask* WorkStealingThreadPool::TaskDeque::PopBack()
+    {
+        if (m_size == 0)
+        {
+            return nullptr;
+        }
+
+        --m_size;
+        return m_buffer[(m_head + m_size) & (m_buffer.size() - 1)];
+    }
+
+    std::size_t WorkStealingThreadPool::TaskDeque::StealFront(PooledTask** tasks, std::size_t maximumCount)
+    {
+        // take half of the tasks, so the victim keeps the newest ones that are likely still in its cache
+        std::size_t count = AZStd::min((m_size + 1) / 2, maximumCount);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            tasks[i] = m_buffer[m_head];
+            m_head = (m_head + 1) & (m_buffer.size() - 1);
+        }
+
+        m_size -= count;
+        return count;
+    }
+
+    void WorkStealingThreadPool::TaskDeque::Grow()
+    {
+        // the capacity stays a power of two, so the ring buffer can be indexed with a mask
+        AZStd::vector<PooledTask*> buffer(m_buffer.size() * 2, nullptr);
+        for (std::size_t i = 0; i < m_size; ++i)
+        {
+            buffer[i] = m_buffer[(m_head + i) & (m_buffer.size() - 1)];
+        }
+
+        m_buffer = std::move(buffer);
+        m_head = 0;
+    }
+
+    WorkStealingThreadPool::WorkStealingThreadPool(std::uint32_t threadCount, std::int32_t firstCore)
+        : m_nextWorker{ 0 }
+        , m_queuedTasks{ 0 }
+        , m_runningTasks{ 0 }
+        , m_completedTasks{ 0 }
+        , m_busyNanoseconds{ 0 }
+        , m_sleepingWorkers{ 0 }
+        , m_stopping{ false }
+    {
+        threadCount = AZStd::max(threadCount, 1u);
+        m_workers.reserve(threadCount);
+        for (std::uint32_t i = 0; i < threadCount; ++i)
+        {
+            m_workers.emplace_back(AZStd::make_unique<Worker>());
+        }
+
+        // workers only start once every deque exists, since any of them can be stolen from
+        for (std::uint32_t i = 0; i < threadCount; ++i)
+        {
+            AZStd::thread_desc threadDesc;
+            threadDesc.m_name = "Cesium Compute Worker";
+            std::int32_t core = firstCore + static_cast<std::int32_t>(i);
+            if (firstCore >= 0)
+            {
+                // the affinity is a bit mask, so cores past its width can't be pinned
+                AZ_Warning("Cesium", core < AFFINITY_MASK_BITS, "Compute worker %u can't be pinned to core %d", i, core);
+                if (core < AFFINITY_MASK_BITS)
+                {
+                    threadDesc.m_cpuId = static_cast<decltype(threadDesc.m_cpuId)>(1u << core);
+                }
+            }
+
+            m_workers[i]->m_thread = AZStd::thread(
+                threadDesc,
+                [this, i]()
+                {
+                    WorkerLoop(i);
+                });
+        }
+    }
+
+    WorkStealingThreadPool::~WorkStealingThreadPool() noexcept
+    {
+        {
+            AZStd::scoped_lock<AZStd::mutex> lock(m_sleepMutex);
+            m_stopping.store(true);
+            m_sleepCondition.notify_all();
+        }
+
+        for (auto& worker : m_workers)
+        {
+            worker->m_thread.join();
+        }
+    }
+
+    void WorkStealingThreadPool::Submit(PooledTask* task)
+    {
+        std::uint32_t workerIndex = GetCurrentWorkerIndex();
+        if (workerIndex == NO_WORKER)
+        {
+            workerIndex = m_nextWorker.fetch_add(1, std::memory_order_relaxed) % m_workers.size();
+        }
+
+        // the task is counted before it is visible, so a worker that takes it right away never drops the count below zero
+        m_queuedTasks.fetch_add(1);
+        Worker& worker = *m_workers[workerIndex];
+        {
+            AZStd::scoped_lock<AZStd::spin_mutex> lock(worker.m_mutex);
+            worker.m_tasks.PushBack(task);
+        }
+
+        WakeWorkers(1);
+    }
+
+    void WorkStealingThreadPool::SubmitBatch(PooledTask* const* tasks, std::size_t count)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        // a worker keeps its own batch and lets idle workers steal from it. Other threads hand every worker an
+        // equal slice, so each deque is locked once per batch
+        m_queuedTasks.fetch_add(count);
+        std::uint32_t workerIndex = GetCurrentWorkerIndex();
+        if (workerIndex != NO_WORKER)
+        {
+            Worker& worker = *m_workers[workerIndex];
+            AZStd::scoped_lock<AZStd::spin_mutex> lock(worker.m_mutex);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                worker.m_tasks.PushBack(tasks[i]);
+            }
+        }
+        else
+        {
+            std::size_t sliceSize = (count + m_workers.size() - 1) / m_workers.size();
+            std::uint32_t firstWorker = m_nextWorker.fetch_add(1, std::memory_order_relaxed);
+            for (std::size_t sliceBegin = 0, slice = 0; sliceBegin < count; sliceBegin += sliceSize, ++slice)
+            {
+                Worker& worker = *m_workers[(firstWorker + slice) % m_workers.size()];
+                std::size_t sliceEnd = AZStd::min(sliceBegin + sliceSize, count);
+                AZStd::scoped_lock<AZStd::spin_mutex> lock(worker.m_mutex);
+                for (std::size_t i = sliceBegin; i < sliceEnd; ++i)
+                {
+                    worker.m_tasks.PushBack(tasks[i]);
+                }
+            }
+        }
+
+        WakeWorkers(count);
+    }
+
+    std::uint32_t WorkStealingThreadPool::GetThreadCount() const
+    {
+        return static_cast<std::uint32_t>(m_workers.size());
+    }
+
+    WorkStealingThreadPoolStatistics WorkStealingThreadPool::GetStatistics() const
+    {
+        WorkStealingThreadPoolStatistics statistics;
+        statistics.m_queuedTasks = m_queuedTasks.load(std::memory_order_relaxed);
+        statistics.m_runningTasks = m_runningTasks.load(std::memory_order_relaxed);
+        statistics.m_completedTasks = m_completedTasks.load(std::memory_order_relaxed);
+        statistics.m_busyNanoseconds = m_busyNanoseconds.load(std::memory_order_relaxed);
+        return statistics;
+    }
+
+    void WorkStealingThreadPool::WorkerLoop(std::uint32_t workerIndex)
+    {
+        s_currentPool = this;
+        s_currentWorkerIndex = workerIndex;
+        while (true)
+        {
+            PooledTask* task = TakeTask(workerIndex);
+            if (task)
+            {
+                RunTask(task);
+                continue;
+            }
+
+            // the sleeping count is published before the queue is checked, and submitters publish the queue before
+            // they check the sleeping count, so a submitted task always either wakes a worker or is seen by it
+            AZStd::unique_lock<AZStd::mutex> lock(m_sleepMutex);
+            m_sleepingWorkers.fetch_add(1);
+            m_sleepCondition.wait(
+                lock,
+                [this]()
+                {
+                    return m_queuedTasks.load() != 0 || m_stopping.load();
+                });
+            m_sleepingWorkers.fetch_sub(1);
+            if (m_stopping.load() && m_queuedTasks.load() == 0)
+            {
+                break;
+            }
+        }
+
+        s_currentPool = nullptr;
+    }
+
+    PooledTask* WorkStealingThreadPool::TakeTask(std::uint32_t workerIndex)
+    {
+        Worker& worker = *m_workers[workerIndex];
+        {
+            AZStd::scoped_lock<AZStd::spin_mutex> lock(worker.m_mutex);
+            if (PooledTask* task = worker.m_tasks.PopBack())
+            {
+                // the task counts as running before it stops counting as queued, so the pool never looks idle in between
+                m_runningTasks.fetch_add(1);
+                m_queuedTasks.fetch_sub(1);
+                return task;
+            }
+        }
+
+        PooledTask* stolenTasks[MAXIMUM_STEAL_COUNT];
+        for (std::size_t offset = 1; offset < m_workers.size(); ++offset)
+        {
+            Worker& victim = *m_workers[(workerIndex + offset) % m_workers.size()];
+            std::size_t stolenCount = 0;
+            {
+                AZStd::scoped_lock<AZStd::spin_mutex> lock(victim.m_mutex);
+                stolenCount = victim.m_tasks.StealFront(stolenTasks, MAXIMUM_STEAL_COUNT);
+            }
+
+            if (stolenCount == 0)
+            {
+                continue;
+            }
+
+            // run the oldest stolen task now, and keep the rest in order behind it
+            if (stolenCount > 1)
+            {
+                AZStd::scoped_lock<AZStd::spin_mutex> lock(worker.m_mutex);
+                for (std::size_t i = stolenCount - 1; i > 0; --i)
+                {
+                    worker.m_tasks.PushBack(stolenTasks[i]);
+                }
+            }
+
+            m_runningTasks.fetch_add(1);
+            m_queuedTasks.fetch_sub(1);
+            return stolenTasks[0];
+        }
+
+        return nullptr;
+    }
+
+    void WorkStealingThreadPool::RunTask(PooledTask* task)
+    {
+        auto start = AZStd::chrono::steady_clock::now();
+
+        task->Run();
+        CesiumSchedulerTaskGroup* taskGroup = task->GetTaskGroup();
+        delete task;
+
+        auto busyTime = AZStd::chrono::duration_cast<AZStd::chrono::nanoseconds>(AZStd::chrono::steady_clock::now() - start);
+        m_busyNanoseconds.fetch_add(static_cast<std::uint64_t>(busyTime.count()), std::memory_order_relaxed);
+        m_completedTasks.fetch_add(1, std::memory_order_relaxed);
+        if (taskGroup)
+        {
+            taskGroup->CompleteTask();
+        }
+
+        m_runningTasks.fetch_sub(1);
+    }
+
+    void WorkStealingThreadPool::WakeWorkers(std::size_t taskCount)
+    {
+        if (m_sleepingWorkers.load() == 0)
+        {
+            return;
+        }
+
+        AZStd::scoped_lock<AZStd::mutex> lock(m_sleepMutex);
+        if (taskCount > 1)
+        {
+            m_sleepCondition.notify_all();
+        }
+        else
+        {
+            m_sleepCondition.notify_one();
+        }
+    }
+
+    std::uint32_t WorkStealingThreadPool::GetCurrentWorkerIndex() const
+    {
+        return s_currentPool == this ? s_currentWorkerIndex : NO_WORKER;
+    }
+} // namespace Cesium
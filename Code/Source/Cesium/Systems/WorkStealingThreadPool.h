@@ -0,0 +1,172 @@
+#pragma once
+
+#include <AzCore/Memory/PoolAllocator.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/parallel/condition_variable.h>
+#include <AzCore/std/parallel/mutex.h>
+#include <AzCore/std/parallel/spin_mutex.h>
+#include <AzCore/std/parallel/thread.h>
+#include <AzCore/std/smart_ptr/unique_ptr.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Cesium
+{
+    class CesiumSchedulerTaskGroup;
+
+    // Task node drawn from the thread pool allocator. Callables up to INLINE_STORAGE_SIZE bytes, which includes a moved
+    // std::function, are stored in the node itself, so submitting a task does not touch the general purpose heap.
+    class PooledTask final
+    {
+    public:
+        AZ_CLASS_ALLOCATOR(PooledTask, AZ::ThreadPoolAllocator);
+
+        template<typename Function>
+        static PooledTask* Create(Function&& function, CesiumSchedulerTaskGroup* taskGroup);
+
+        PooledTask(const PooledTask&) = delete;
+
+        PooledTask& operator=(const PooledTask&) = delete;
+
+        ~PooledTask() noexcept;
+
+        void Run();
+
+        CesiumSchedulerTaskGroup* GetTaskGroup() const;
+
+    private:
+        PooledTask() = default;
+
+        static constexpr std::size_t INLINE_STORAGE_SIZE = 64;
+
+        alignas(std::max_align_t) unsigned char m_inlineStorage[INLINE_STORAGE_SIZE];
+        void* m_callable{ nullptr };
+        void (*m_invoke)(void* callable){ nullptr };
+        void (*m_destroy)(void* callable, bool isInline){ nullptr };
+        CesiumSchedulerTaskGroup* m_taskGroup{ nullptr };
+    };
+
+    struct WorkStealingThreadPoolStatistics final
+    {
+        std::uint64_t m_queuedTasks{ 0 };
+        std::uint64_t m_runningTasks{ 0 };
+        std::uint64_t m_completedTasks{ 0 };
+        std::uint64_t m_busyNanoseconds{ 0 };
+    };
+
+    // Fixed set of workers that each own a deque of tasks. A worker pushes the tasks it submits onto its own deque and
+    // runs them newest first, which keeps continuations on the thread whose cache holds their data. Idle workers steal
+    // half of the oldest tasks of another worker at once. Tasks submitted from outside the pool are spread round robin
+    // over the workers, so there is no single queue every thread contends on.
+    class WorkStealingThreadPool final
+    {
+        class TaskDeque
+        {
+        public:
+            TaskDeque();
+
+            void PushBack(PooledTask* task);
+
+            PooledTask* PopBack();
+
+            std::size_t StealFront(PooledTask** tasks, std::size_t maximumCount);
+
+        private:
+            void Grow();
+
+            AZStd::vector<PooledTask*> m_buffer;
+            std::size_t m_head;
+            std::size_t m_size;
+        };
+
+        struct Worker
+        {
+            AZStd::spin_mutex m_mutex;
+            TaskDeque m_tasks;
+            AZStd::thread m_thread;
+        };
+
+    public:
+        WorkStealingThreadPool(std::uint32_t threadCount, std::int32_t firstCore);
+
+        WorkStealingThreadPool(const WorkStealingThreadPool&) = delete;
+
+        WorkStealingThreadPool& operator=(const WorkStealingThreadPool&) = delete;
+
+        // remaining tasks still run before the workers exit
+        ~WorkStealingThreadPool() noexcept;
+
+        void Submit(PooledTask* task);
+
+        void SubmitBatch(PooledTask* const* tasks, std::size_t count);
+
+        std::uint32_t GetThreadCount() const;
+
+        WorkStealingThreadPoolStatistics GetStatistics() const;
+
+    private:
+        void WorkerLoop(std::uint32_t workerIndex);
+
+        PooledTask* TakeTask(std::uint32_t workerIndex);
+
+        void RunTask(PooledTask* task);
+
+        void WakeWorkers(std::size_t taskCount);
+
+        std::uint32_t GetCurrentWorkerIndex() const;
+
+        static constexpr std::uint32_t NO_WORKER = ~0u;
+        static constexpr std::size_t MAXIMUM_STEAL_COUNT = 32;
+        static constexpr std::int32_t AFFINITY_MASK_BITS = 32;
+
+        AZStd::vector<AZStd::unique_ptr<Worker>> m_workers;
+        std::atomic<std::uint32_t> m_nextWorker;
+        std::atomic<std::uint64_t> m_queuedTasks;
+        std::atomic<std::uint64_t> m_runningTasks;
+        std::atomic<std::uint64_t> m_completedTasks;
+        std::atomic<std::uint64_t> m_busyNanoseconds;
+        std::atomic<std::uint32_t> m_sleepingWorkers;
+        std::atomic<bool> m_stopping;
+        AZStd::mutex m_sleepMutex;
+        AZStd::condition_variable m_sleepCondition;
+    };
+
+    template<typename Function>
+    PooledTask* PooledTask::Create(Function&& function, CesiumSchedulerTaskGroup* taskGroup)
+    {
+        using Callable = std::decay_t<Function>;
+
+        PooledTask* task = aznew PooledTask();
+        task->m_taskGroup = taskGroup;
+        task->m_invoke = [](void* callable)
+        {
+            (*static_cast<Callable*>(callable))();
+        };
+        task->m_destroy = [](void* callable, bool isInline)
+        {
+            if (isInline)
+            {
+                static_cast<Callable*>(callable)->~Callable();
+            }
+            else
+            {
+                delete static_cast<Callable*>(callable);
+            }
+        };
+
+        if constexpr (sizeof(Callable) <= INLINE_STORAGE_SIZE && alignof(Callable) <= alignof(std::max_align_t))
+        {
+            task->m_callable = new (task->m_inlineStorage) Callable(std::forward<Function>(function));
+        }
+        else
+        {
+            task->m_callable = new Callable(std::forward<Function>(function));
+        }
+
+        return task;
+    }
+} // namespace Cesium
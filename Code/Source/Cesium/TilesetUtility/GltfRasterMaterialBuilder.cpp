@@ -1,7 +1,6 @@
 #include "Cesium/TilesetUtility/GltfRasterMaterialBuilder.h"
 #include "Cesium/Systems/CesiumSystem.h"
 #include "Cesium/Systems/CriticalAssetManager.h"
-#include <Atom/RPI.Reflect/Material/MaterialAssetCreator.h>
 #include <Atom/RPI.Public/Material/Material.h>
 #include <Atom/RPI.Reflect/Material/MaterialPropertyValue.h>
 
@@ -24,6 +23,14 @@ namespace Cesium
         m_pbrMaterialBuilder.OverrideMaterialType(materialType);
     }
 
+    void GltfRasterMaterialBuilder::CreateTextures(
+        const CesiumGltf::Model& model,
+        const AZStd::vector<const CesiumGltf::Material*>& materials,
+        AZStd::unordered_map<TextureId, GltfLoadTexture>& textureCache)
+    {
+        m_pbrMaterialBuilder.CreateTextures(model, materials, textureCache);
+    }
+
     void GltfRasterMaterialBuilder::Create(
         const CesiumGltf::Model& model,
         const CesiumGltf::Material& material,
@@ -42,81 +49,56 @@ namespace Cesium
             GltfShaderVertexAttribute(AZ::RHI::ShaderSemantic("UV", 3), AZ::Name("m_raster_uv1"), AZ::RHI::Format::R32G32_FLOAT));
     }
 
-    AZ::Data::Asset<AZ::RPI::MaterialAsset> GltfRasterMaterialBuilder::CreateRasterMaterial(
-        std::uint32_t rasterLayer,
-        const AZ::Data::Asset<AZ::RPI::ImageAsset>& raster,
-        std::uint32_t textureUv,
-        const AZ::Vector4& uvTranslateScale,
-        const AZ::Data::Asset<AZ::RPI::MaterialAsset>& parent)
+    void GltfRasterMaterialBuilder::SetCompactVertexLayout(bool compactVertexLayout)
     {
-        if (!parent || !parent.IsReady())
-        {
-            AZ_Error("Cesium", false, "Parent MaterialAsset is null or not ready. Cannot create raster material.");
-            return {};
-        }
-
-        auto materialTypeAsset = parent->GetMaterialTypeAsset();
-        if (!materialTypeAsset || !materialTypeAsset.IsReady())
-        {
-            AZ_Error("Cesium", false, "MaterialTypeAsset from parent is null or not ready. Cannot create raster material.");
-            return {};
-        }
-
-        AZStd::string prefix = AZStd::string::format("raster%d", rasterLayer);
-
-        AZ::RPI::MaterialAssetCreator materialCreator;
-        materialCreator.Begin(AZ::Uuid::CreateRandom(), materialTypeAsset);
-        materialCreator.SetPropertyValue(AZ::Name(prefix + ".textureMap"), raster);
-        materialCreator.SetPropertyValue(AZ::Name(prefix + ".useTexture"), true);
-        materialCreator.SetPropertyValue(AZ::Name(prefix + ".textureMapUv"), textureUv);
-        materialCreator.SetPropertyValue(AZ::Name(prefix + ".uvTranslateScale"), uvTranslateScale);
-
-        AZ::Data::Asset<AZ::RPI::MaterialAsset> materialAsset;
-        materialCreator.End(materialAsset);
+        m_pbrMaterialBuilder.SetCompactVertexLayout(compactVertexLayout);
+    }
 
-        return materialAsset;
+    void GltfRasterMaterialBuilder::SetTextureCompression(GltfTextureCompression textureCompression)
+    {
+        m_pbrMaterialBuilder.SetTextureCompression(textureCompression);
     }
 
-    bool GltfRasterMaterialBuilder::SetRasterForMaterial(
+    void GltfRasterMaterialBuilder::SetRasterForMaterial(
         std::uint32_t rasterLayer,
         const AZ::Data::Instance<AZ::RPI::Image>& raster,
         std::uint32_t textureUv,
         const AZ::Vector4& uvTranslateScale,
+        const AZ::Vector4& uvClamp,
         AZ::Data::Instance<AZ::RPI::Material>& material)
     {
-        AZStd::string prefix = AZStd::string::format("raster%d", rasterLayer);
-
-        auto rasterMapIndex = material->FindPropertyIndex(AZ::Name(prefix + ".textureMap"));
-        material->SetPropertyValue(rasterMapIndex, raster);
-
-        auto useRasterMapIndex = material->FindPropertyIndex(AZ::Name(prefix + ".useTexture"));
-        material->SetPropertyValue(useRasterMapIndex, true);
-
-        auto textureMapUvIndex = material->FindPropertyIndex(AZ::Name(prefix + ".textureMapUv"));
-        material->SetPropertyValue(textureMapUvIndex, textureUv);
-
-        auto uvTranslateScaleIndex = material->FindPropertyIndex(AZ::Name(prefix + ".uvTranslateScale"));
-        material->SetPropertyValue(uvTranslateScaleIndex, uvTranslateScale);
-
-        return material->Compile();
+        RasterLayerProperties properties = GetRasterLayerProperties(rasterLayer, material);
+        material->SetPropertyValue(properties.m_textureMap, raster);
+        material->SetPropertyValue(properties.m_useTexture, true);
+        material->SetPropertyValue(properties.m_textureMapUv, textureUv);
+        material->SetPropertyValue(properties.m_uvTranslateScale, uvTranslateScale);
+        material->SetPropertyValue(properties.m_uvClamp, uvClamp);
     }
 
-    bool GltfRasterMaterialBuilder::UnsetRasterForMaterial(std::uint32_t rasterLayer, AZ::Data::Instance<AZ::RPI::Material>& material)
+    void GltfRasterMaterialBuilder::UnsetRasterForMaterial(std::uint32_t rasterLayer, AZ::Data::Instance<AZ::RPI::Material>& material)
     {
-        AZStd::string prefix = AZStd::string::format("raster%d", rasterLayer);
-
-        auto rasterMapIndex = material->FindPropertyIndex(AZ::Name(prefix + ".textureMap"));
-        material->SetPropertyValue(rasterMapIndex, AZ::RPI::MaterialPropertyValue(AZ::Data::Asset<AZ::RPI::ImageAsset>()));
-
-        auto useRasterMapIndex = material->FindPropertyIndex(AZ::Name(prefix + ".useTexture"));
-        material->SetPropertyValue(useRasterMapIndex, false);
-
-        auto textureMapUvIndex = material->FindPropertyIndex(AZ::Name(prefix + ".textureMapUv"));
-        material->SetPropertyValue(textureMapUvIndex, static_cast<std::uint32_t>(0));
+        RasterLayerProperties properties = GetRasterLayerProperties(rasterLayer, material);
+        material->SetPropertyValue(properties.m_textureMap, AZ::RPI::MaterialPropertyValue(AZ::Data::Asset<AZ::RPI::ImageAsset>()));
+        material->SetPropertyValue(properties.m_useTexture, false);
+        material->SetPropertyValue(properties.m_textureMapUv, static_cast<std::uint32_t>(0));
+        material->SetPropertyValue(properties.m_uvTranslateScale, AZ::Vector4(0.0, 0.0, 1.0, 1.0));
+        material->SetPropertyValue(properties.m_uvClamp, AZ::Vector4(0.0, 0.0, 1.0, 1.0));
+    }
 
-        auto uvTranslateScaleIndex = material->FindPropertyIndex(AZ::Name(prefix + ".uvTranslateScale"));
-        material->SetPropertyValue(uvTranslateScaleIndex, AZ::Vector4(0.0, 0.0, 1.0, 1.0));
+    RasterLayerProperties GltfRasterMaterialBuilder::GetRasterLayerProperties(
+        std::uint32_t rasterLayer, const AZ::Data::Instance<AZ::RPI::Material>& material)
+    {
+        const CriticalAssetManager& criticalAssetManager = CesiumInterface::Get()->GetCriticalAssetManager();
+        const AZ::Data::Asset<AZ::RPI::MaterialTypeAsset>& rasterMaterialType = criticalAssetManager.m_rasterMaterialType;
+        if (rasterMaterialType.IsReady() &&
+            material->GetMaterialPropertiesLayout() == rasterMaterialType->GetMaterialPropertiesLayout())
+        {
+            return criticalAssetManager.m_rasterMaterialProperties.GetLayer(rasterLayer);
+        }
 
-        return material->Compile();
+        // a material type set through OverrideMaterialType has indices of its own
+        RasterMaterialProperties properties;
+        properties.Build(*material);
+        return properties.GetLayer(rasterLayer);
     }
 } // namespace Cesium
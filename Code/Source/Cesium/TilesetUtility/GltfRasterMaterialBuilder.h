@@ -2,6 +2,7 @@
 
 #include "Cesium/Gltf/GltfPBRMaterialBuilder.h"
 #include "Cesium/Gltf/GltfMaterialBuilder.h"
+#include "Cesium/TilesetUtility/RasterMaterialProperties.h"
 #include <Atom/RPI.Public/Material/Material.h>
 #include <Atom/RPI.Reflect/Material/MaterialAsset.h>
 #include <Atom/RPI.Reflect/Image/ImageAsset.h>
@@ -20,31 +21,39 @@ namespace Cesium
 
         void OverrideMaterialType(const AZ::Data::Asset<AZ::RPI::MaterialTypeAsset>& materialType) override;
 
+        void CreateTextures(
+            const CesiumGltf::Model& model,
+            const AZStd::vector<const CesiumGltf::Material*>& materials,
+            AZStd::unordered_map<TextureId, GltfLoadTexture>& textureCache) override;
+
         void Create(
             const CesiumGltf::Model& model,
             const CesiumGltf::Material& material,
             AZStd::unordered_map<TextureId, GltfLoadTexture>& textureCache,
             GltfLoadMaterial& result) override;
 
-        AZ::Data::Asset<AZ::RPI::MaterialAsset> CreateRasterMaterial(
-            std::uint32_t rasterLayer,
-            const AZ::Data::Asset<AZ::RPI::ImageAsset>& raster,
-            std::uint32_t textureUv,
-            const AZ::Vector4& uvTranslateScale,
-            const AZ::Data::Asset<AZ::RPI::MaterialAsset>& parent);
+        void SetCompactVertexLayout(bool compactVertexLayout);
+
+        void SetTextureCompression(GltfTextureCompression textureCompression);
 
-        bool SetRasterForMaterial(
+        // Attaching and detaching only write the raster properties of the material instance, and the caller compiles it.
+        // None of the raster properties selects a shader variant, so the compile is a write to the material SRG
+        void SetRasterForMaterial(
             std::uint32_t rasterLayer,
             const AZ::Data::Instance<AZ::RPI::Image>& raster,
             std::uint32_t textureUv,
             const AZ::Vector4& uvTranslateScale,
+            const AZ::Vector4& uvClamp,
             AZ::Data::Instance<AZ::RPI::Material>& material);
 
-        bool UnsetRasterForMaterial(std::uint32_t rasterLayer, AZ::Data::Instance<AZ::RPI::Material>& material);
+        void UnsetRasterForMaterial(std::uint32_t rasterLayer, AZ::Data::Instance<AZ::RPI::Material>& material);
 
-        static constexpr std::uint32_t MAX_RASTER_LAYERS = 2;
+        static constexpr std::uint32_t MAX_RASTER_LAYERS = RasterMaterialProperties::LAYER_COUNT;
 
     private:
+        static RasterLayerProperties GetRasterLayerProperties(
+            std::uint32_t rasterLayer, const AZ::Data::Instance<AZ::RPI::Material>& material);
+
         GltfPBRMaterialBuilder m_pbrMaterialBuilder;
         AZ::Data::Asset<AZ::RPI::MaterialTypeAsset> m_overrideMaterialTypeAsset;
     };
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <AzCore/std/containers/span.h>
+#include <AzCore/std/containers/vector.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace Cesium
+{
+    // Mesh handles of the models of a tileset, laid out as a structure of arrays: the handles of every model sit next to
+    // each other in one array, and the range and visibility of each model live in arrays of their own. SetVisible only
+    // records the models whose visibility changes, so Apply walks the handles of those models and nothing else.
+    template<typename Handle>
+    class MeshVisibilityTable final
+    {
+    public:
+        using Slot = std::uint32_t;
+
+        static constexpr Slot INVALID_SLOT = ~Slot(0);
+
+        // handles must stay at the same address until the slot is removed. visible is the state they are already in
+        Slot Add(AZStd::span<const Handle* const> handles, bool visible)
+        {
+            Slot slot;
+            if (m_freeSlots.empty())
+            {
+                slot = static_cast<Slot>(m_firstHandles.size());
+                m_firstHandles.emplace_back();
+                m_handleCounts.emplace_back();
+                m_requestedVisible.emplace_back();
+                m_appliedVisible.emplace_back();
+                m_pending.emplace_back();
+            }
+            else
+            {
+                slot = m_freeSlots.back();
+                m_freeSlots.pop_back();
+            }
+
+            m_firstHandles[slot] = static_cast<std::uint32_t>(m_handles.size());
+            m_handleCounts[slot] = static_cast<std::uint32_t>(handles.size());
+            m_requestedVisible[slot] = visible;
+            m_appliedVisible[slot] = visible;
+            m_pending[slot] = false;
+            m_handles.insert(m_handles.end(), handles.begin(), handles.end());
+            return slot;
+        }
+
+        void Remove(Slot slot)
+        {
+            m_freeHandleCount += m_handleCounts[slot];
+            m_handleCounts[slot] = 0;
+            m_pending[slot] = false;
+            m_freeSlots.emplace_back(slot);
+
+            // the handles of removed slots are left in place until they make up most of the array
+            if (m_freeHandleCount > MINIMUM_COMPACT_HANDLE_COUNT && m_freeHandleCount * 2 > m_handles.size())
+            {
+                Compact();
+            }
+        }
+
+        void SetVisible(Slot slot, bool visible)
+        {
+            m_requestedVisible[slot] = visible;
+            if (!m_pending[slot] && m_appliedVisible[slot] != visible)
+            {
+                m_pending[slot] = true;
+                m_changedSlots.emplace_back(slot);
+            }
+        }
+
+        bool IsVisible(Slot slot) const
+        {
+            return m_requestedVisible[slot] != 0;
+        }
+
+        // calls apply(handle, visible) for every handle of the models whose visibility changed since the last call, and
+        // returns how many handles that was
+        template<typename ApplyFunction>
+        std::size_t Apply(ApplyFunction&& apply)
+        {
+            std::size_t appliedHandleCount = 0;
+            for (Slot slot : m_changedSlots)
+            {
+                // slots are recorded once per Apply, removed ones are no longer pending and those set back are unchanged
+                if (!m_pending[slot])
+                {
+                    continue;
+                }
+
+                m_pending[slot] = false;
+                bool visible = m_requestedVisible[slot] != 0;
+                if (m_appliedVisible[slot] == visible)
+                {
+                    continue;
+                }
+
+                m_appliedVisible[slot] = visible;
+                const Handle* const* handle = m_handles.data() + m_firstHandles[slot];
+                const Handle* const* handleEnd = handle + m_handleCounts[slot];
+                for (; handle != handleEnd; ++handle)
+                {
+                    apply(**handle, visible);
+                }
+
+                appliedHandleCount += m_handleCounts[slot];
+            }
+
+            m_changedSlots.clear();
+            return appliedHandleCount;
+        }
+
+        std::size_t GetHandleCount() const
+        {
+            return m_handles.size() - m_freeHandleCount;
+        }
+
+    private:
+        void Compact()
+        {
+            AZStd::vector<const Handle*> handles;
+            handles.reserve(m_handles.size() - m_freeHandleCount);
+            for (Slot slot = 0; slot < m_firstHandles.size(); ++slot)
+            {
+                auto first = m_handles.begin() + m_firstHandles[slot];
+                m_firstHandles[slot] = static_cast<std::uint32_t>(handles.size());
+                handles.insert(handles.end(), first, first + m_handleCounts[slot]);
+            }
+
+            m_handles = std::move(handles);
+            m_freeHandleCount = 0;
+        }
+
+        static constexpr std::size_t MINIMUM_COMPACT_HANDLE_COUNT = 1024;
+
+        AZStd::vector<const Handle*> m_handles;
+        AZStd::vector<std::uint32_t> m_firstHandles;
+        AZStd::vector<std::uint32_t> m_handleCounts;
+        AZStd::vector<std::uint8_t> m_requestedVisible;
+        AZStd::vector<std::uint8_t> m_appliedVisible;
+        AZStd::vector<std::uint8_t> m_pending;
+        AZStd::vector<Slot> m_freeSlots;
+        AZStd::vector<Slot> m_changedSlots;
+        std::size_t m_freeHandleCount{ 0 };
+    };
+} // namespace Cesium
@@ -0,0 +1,109 @@
+#include "Cesium/TilesetUtility/RasterAtlasSlotAllocator.h"
+#include <AzCore/Debug/Trace.h>
+
+namespace Cesium
+{
+    RasterAtlasSlotAllocator::RasterAtlasSlotAllocator(std::uint32_t slotsPerRow, std::uint32_t maxPageCount)
+        : m_slotsPerRow{ slotsPerRow }
+        , m_maxPageCount{ maxPageCount }
+        , m_usedSlotCount{ 0 }
+        , m_pageCount{ 0 }
+    {
+        AZ_Assert(slotsPerRow > 0, "An atlas page needs at least one slot");
+    }
+
+    RasterAtlasSlot RasterAtlasSlotAllocator::Allocate(bool& newPage)
+    {
+        newPage = false;
+        std::uint32_t pageIndex = RasterAtlasSlot::INVALID_PAGE;
+        for (std::uint32_t i = 0; i < m_pages.size(); ++i)
+        {
+            const Page& page = m_pages[i];
+            if (page.m_inUse && !page.m_freeSlots.empty())
+            {
+                pageIndex = i;
+                break;
+            }
+
+            if (!page.m_inUse && pageIndex == RasterAtlasSlot::INVALID_PAGE)
+            {
+                pageIndex = i;
+            }
+        }
+
+        if (pageIndex == RasterAtlasSlot::INVALID_PAGE)
+        {
+            if (m_pages.size() >= m_maxPageCount)
+            {
+                return {};
+            }
+
+            pageIndex = static_cast<std::uint32_t>(m_pages.size());
+            m_pages.emplace_back();
+        }
+
+        Page& page = m_pages[pageIndex];
+        if (!page.m_inUse)
+        {
+            // the free slots are stored backward, so slots are taken in row order
+            std::uint32_t slotsPerPage = GetSlotsPerPage();
+            page.m_freeSlots.resize(slotsPerPage);
+            for (std::uint32_t i = 0; i < slotsPerPage; ++i)
+            {
+                page.m_freeSlots[i] = slotsPerPage - i - 1;
+            }
+
+            page.m_inUse = true;
+            ++m_pageCount;
+            newPage = true;
+        }
+
+        RasterAtlasSlot slot;
+        slot.m_page = pageIndex;
+        slot.m_index = page.m_freeSlots.back();
+        page.m_freeSlots.pop_back();
+        ++page.m_usedSlotCount;
+        ++m_usedSlotCount;
+        return slot;
+    }
+
+    bool RasterAtlasSlotAllocator::Free(const RasterAtlasSlot& slot)
+    {
+        AZ_Assert(slot.IsValid() && slot.m_page < m_pages.size(), "The slot was not allocated by this allocator");
+        Page& page = m_pages[slot.m_page];
+        page.m_freeSlots.emplace_back(slot.m_index);
+        --page.m_usedSlotCount;
+        --m_usedSlotCount;
+        if (page.m_usedSlotCount > 0)
+        {
+            return false;
+        }
+
+        page.m_freeSlots = {};
+        page.m_inUse = false;
+        --m_pageCount;
+        return true;
+    }
+
+    void RasterAtlasSlotAllocator::GetSlotRect(const RasterAtlasSlot& slot, float& offsetU, float& offsetV, float& size) const
+    {
+        size = 1.0f / static_cast<float>(m_slotsPerRow);
+        offsetU = static_cast<float>(slot.m_index % m_slotsPerRow) * size;
+        offsetV = static_cast<float>(slot.m_index / m_slotsPerRow) * size;
+    }
+
+    std::uint32_t RasterAtlasSlotAllocator::GetSlotsPerPage() const
+    {
+        return m_slotsPerRow * m_slotsPerRow;
+    }
+
+    std::uint32_t RasterAtlasSlotAllocator::GetUsedSlotCount() const
+    {
+        return m_usedSlotCount;
+    }
+
+    std::uint32_t RasterAtlasSlotAllocator::GetPageCount() const
+    {
+        return m_pageCount;
+    }
+} // namespace Cesium
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <AzCore/std/containers/vector.h>
+#include <cstdint>
+
+namespace Cesium
+{
+    struct RasterAtlasSlot final
+    {
+        static constexpr std::uint32_t INVALID_PAGE = ~std::uint32_t(0);
+
+        bool IsValid() const
+        {
+            return m_page != INVALID_PAGE;
+        }
+
+        std::uint32_t m_page{ INVALID_PAGE };
+        std::uint32_t m_index{ 0 };
+    };
+
+    // Hands out the square slots of atlas pages, which are grids of slotsPerRow x slotsPerRow slots. Slots are taken from
+    // the lowest page that has one free, so tiles gather in as few pages as possible and the pages they leave can be
+    // released once empty.
+    class RasterAtlasSlotAllocator final
+    {
+    public:
+        RasterAtlasSlotAllocator(std::uint32_t slotsPerRow, std::uint32_t maxPageCount);
+
+        // returns an invalid slot when every slot of maxPageCount pages is taken. newPage is set when the slot is the first
+        // one taken from its page, so the page must be created
+        RasterAtlasSlot Allocate(bool& newPage);
+
+        // returns true when the page of the slot has no slot in use left, so the page can be released
+        bool Free(const RasterAtlasSlot& slot);
+
+        // offset and size of the slot in the UV space of its page
+        void GetSlotRect(const RasterAtlasSlot& slot, float& offsetU, float& offsetV, float& size) const;
+
+        std::uint32_t GetSlotsPerPage() const;
+
+        std::uint32_t GetUsedSlotCount() const;
+
+        std::uint32_t GetPageCount() const;
+
+    private:
+        struct Page
+        {
+            AZStd::vector<std::uint32_t> m_freeSlots;
+            std::uint32_t m_usedSlotCount{ 0 };
+            bool m_inUse{ false };
+        };
+
+        std::uint32_t m_slotsPerRow;
+        std::uint32_t m_maxPageCount;
+        std::uint32_t m_usedSlotCount;
+        std::uint32_t m_pageCount;
+        AZStd::vector<Page> m_pages;
+    };
+} // namespace Cesium
@@ -0,0 +1,114 @@
+#include "Cesium/TilesetUtility/RasterCompositor.h"
+#include "Cesium/Gltf/GltfMipGenerator.h"
+#include <AzCore/std/algorithm.h>
+#include <cmath>
+
+namespace Cesium
+{
+    namespace
+    {
+        // bilinear sample of source at texel coordinates x, y, which are clamped to the texel centers at the edges. Colors are
+        // decoded to linear before they are filtered, like the sampler of an sRGB texture does
+        void SampleBilinear(const RasterCompositeSource& source, float x, float y, float* texel)
+        {
+            float maxX = static_cast<float>(source.m_width - 1);
+            float maxY = static_cast<float>(source.m_height - 1);
+            x = AZStd::clamp(x, 0.0f, maxX);
+            y = AZStd::clamp(y, 0.0f, maxY);
+            std::uint32_t x0 = static_cast<std::uint32_t>(x);
+            std::uint32_t y0 = static_cast<std::uint32_t>(y);
+            std::uint32_t x1 = AZStd::min(x0 + 1, source.m_width - 1);
+            std::uint32_t y1 = AZStd::min(y0 + 1, source.m_height - 1);
+            float weightX = x - static_cast<float>(x0);
+            float weightY = y - static_cast<float>(y0);
+            const std::uint8_t* pixels = reinterpret_cast<const std::uint8_t*>(source.m_pixels.data());
+            const std::uint8_t* t00 = pixels + (static_cast<std::size_t>(y0) * source.m_width + x0) * 4;
+            const std::uint8_t* t01 = pixels + (static_cast<std::size_t>(y0) * source.m_width + x1) * 4;
+            const std::uint8_t* t10 = pixels + (static_cast<std::size_t>(y1) * source.m_width + x0) * 4;
+            const std::uint8_t* t11 = pixels + (static_cast<std::size_t>(y1) * source.m_width + x1) * 4;
+            for (std::uint32_t c = 0; c < 3; ++c)
+            {
+                float v00 = GltfMipGenerator::SrgbToLinear(t00[c]);
+                float v01 = GltfMipGenerator::SrgbToLinear(t01[c]);
+                float v10 = GltfMipGenerator::SrgbToLinear(t10[c]);
+                float v11 = GltfMipGenerator::SrgbToLinear(t11[c]);
+                float top = v00 + (v01 - v00) * weightX;
+                float bottom = v10 + (v11 - v10) * weightX;
+                texel[c] = top + (bottom - top) * weightY;
+            }
+
+            float topAlpha = t00[3] + (t01[3] - t00[3]) * weightX;
+            float bottomAlpha = t10[3] + (t11[3] - t10[3]) * weightX;
+            texel[3] = (topAlpha + (bottomAlpha - topAlpha) * weightY) / 255.0f;
+        }
+    } // namespace
+
+    AZStd::vector<std::byte> RasterCompositor::Composite(AZStd::span<const RasterCompositeLayer> layers, std::uint32_t size)
+    {
+        AZStd::vector<float> composite(static_cast<std::size_t>(size) * size * 4, 0.0f);
+        for (const RasterCompositeLayer& layer : layers)
+        {
+            const RasterCompositeSource* source = layer.m_source.get();
+            if (!source || source->m_width == 0 || source->m_height == 0)
+            {
+                continue;
+            }
+
+            // The shader samples a raster at uv * scale + translate and flips V, and the composite is attached with the
+            // identity transform, so composite texel (x, y) is tile uv ((x + 0.5) / size, 1 - (y + 0.5) / size)
+            float translateU = layer.m_uvTranslateScale.GetX();
+            float translateV = layer.m_uvTranslateScale.GetY();
+            float scaleU = layer.m_uvTranslateScale.GetZ();
+            float scaleV = layer.m_uvTranslateScale.GetW();
+            for (std::uint32_t y = 0; y < size; ++y)
+            {
+                float tileV = 1.0f - (static_cast<float>(y) + 0.5f) / static_cast<float>(size);
+                float rasterV = 1.0f - (tileV * scaleV + translateV);
+                if (rasterV < 0.0f || rasterV > 1.0f)
+                {
+                    continue;
+                }
+
+                float* row = composite.data() + static_cast<std::size_t>(y) * size * 4;
+                for (std::uint32_t x = 0; x < size; ++x)
+                {
+                    float tileU = (static_cast<float>(x) + 0.5f) / static_cast<float>(size);
+                    float rasterU = tileU * scaleU + translateU;
+                    if (rasterU < 0.0f || rasterU > 1.0f)
+                    {
+                        continue;
+                    }
+
+                    float texel[4];
+                    SampleBilinear(
+                        *source, rasterU * static_cast<float>(source->m_width) - 0.5f,
+                        rasterV * static_cast<float>(source->m_height) - 0.5f, texel);
+
+                    // alpha over the layers below, in linear space like the shader blends bound rasters
+                    float* destination = row + x * 4;
+                    float alpha = texel[3];
+                    for (std::uint32_t c = 0; c < 3; ++c)
+                    {
+                        destination[c] = texel[c] * alpha + destination[c] * (1.0f - alpha);
+                    }
+
+                    destination[3] = alpha + destination[3] * (1.0f - alpha);
+                }
+            }
+        }
+
+        // colors are encoded back to sRGB, since the composite is uploaded as an sRGB image
+        AZStd::vector<std::byte> result(composite.size());
+        for (std::size_t i = 0; i < composite.size(); i += 4)
+        {
+            for (std::size_t c = 0; c < 3; ++c)
+            {
+                result[i + c] = static_cast<std::byte>(GltfMipGenerator::LinearToSrgb(composite[i + c]));
+            }
+
+            result[i + 3] = static_cast<std::byte>(static_cast<std::uint8_t>(AZStd::clamp(composite[i + 3], 0.0f, 1.0f) * 255.0f + 0.5f));
+        }
+
+        return result;
+    }
+} // namespace Cesium
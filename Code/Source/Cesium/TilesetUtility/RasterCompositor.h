@@ -0,0 +1,37 @@
+#pragma once
+
+#include <AzCore/Math/Vector4.h>
+#include <AzCore/std/containers/span.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/smart_ptr/shared_ptr.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace Cesium
+{
+    // Top level of a raster overlay tile kept on the CPU for compositing. Texels are 8 bit sRGB RGBA
+    struct RasterCompositeSource final
+    {
+        AZStd::vector<std::byte> m_pixels;
+        std::uint32_t m_width{ 0 };
+        std::uint32_t m_height{ 0 };
+    };
+
+    // A raster attached to a tile, with the uvTranslateScale it was attached with
+    struct RasterCompositeLayer final
+    {
+        AZStd::shared_ptr<const RasterCompositeSource> m_source;
+        AZ::Vector4 m_uvTranslateScale;
+    };
+
+    // Blends any number of rasters attached to a tile with the same texture coordinates into one image, so the shader samples
+    // one texture per texture coordinate set no matter how many overlays are stacked
+    class RasterCompositor final
+    {
+    public:
+        // Returns size x size sRGB texels of the layers blended bottom to top with alpha over in linear space. The result
+        // covers the whole tile and is attached with a uvTranslateScale of (0, 0, 1, 1). Layers are sampled bilinearly where
+        // their raster covers the tile and are transparent elsewhere
+        static AZStd::vector<std::byte> Composite(AZStd::span<const RasterCompositeLayer> layers, std::uint32_t size);
+    };
+} // namespace Cesium
@@ -0,0 +1,32 @@
+#include "Cesium/TilesetUtility/RasterMaterialProperties.h"
+#include <AzCore/Debug/Trace.h>
+#include <AzCore/std/string/string.h>
+
+namespace Cesium
+{
+    bool RasterMaterialProperties::IsValid() const
+    {
+        for (const RasterLayerProperties& layerProperties : m_layers)
+        {
+            if (!layerProperties.m_textureMap.IsValid() || !layerProperties.m_useTexture.IsValid() ||
+                !layerProperties.m_textureMapUv.IsValid() || !layerProperties.m_uvTranslateScale.IsValid() ||
+                !layerProperties.m_uvClamp.IsValid())
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    const RasterLayerProperties& RasterMaterialProperties::GetLayer(std::uint32_t layer) const
+    {
+        AZ_Assert(layer < LAYER_COUNT, "Raster layer %u is out of range", layer);
+        return m_layers[layer];
+    }
+
+    AZ::Name RasterMaterialProperties::GetPropertyName(std::uint32_t layer, const char* property)
+    {
+        return AZ::Name(AZStd::string::format("raster%u.%s", layer, property));
+    }
+} // namespace Cesium
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <Atom/RPI.Reflect/Material/MaterialPropertyDescriptor.h>
+#include <AzCore/Name/Name.h>
+#include <AzCore/std/containers/array.h>
+#include <cstdint>
+
+namespace Cesium
+{
+    struct RasterLayerProperties final
+    {
+        AZ::RPI::MaterialPropertyIndex m_textureMap;
+        AZ::RPI::MaterialPropertyIndex m_useTexture;
+        AZ::RPI::MaterialPropertyIndex m_textureMapUv;
+        AZ::RPI::MaterialPropertyIndex m_uvTranslateScale;
+        AZ::RPI::MaterialPropertyIndex m_uvClamp;
+    };
+
+    // Indices of the properties of every raster layer of a material type. They are found by name once, so attaching and
+    // detaching rasters set material properties without formatting or interning any string
+    class RasterMaterialProperties final
+    {
+    public:
+        static constexpr std::uint32_t LAYER_COUNT = 2;
+
+        // properties is anything that finds a property index by name, e.g. a MaterialPropertiesLayout or a Material
+        template<typename Properties>
+        void Build(const Properties& properties)
+        {
+            for (std::uint32_t layer = 0; layer < LAYER_COUNT; ++layer)
+            {
+                RasterLayerProperties& layerProperties = m_layers[layer];
+                layerProperties.m_textureMap = properties.FindPropertyIndex(GetPropertyName(layer, "textureMap"));
+                layerProperties.m_useTexture = properties.FindPropertyIndex(GetPropertyName(layer, "useTexture"));
+                layerProperties.m_textureMapUv = properties.FindPropertyIndex(GetPropertyName(layer, "textureMapUv"));
+                layerProperties.m_uvTranslateScale = properties.FindPropertyIndex(GetPropertyName(layer, "uvTranslateScale"));
+                layerProperties.m_uvClamp = properties.FindPropertyIndex(GetPropertyName(layer, "uvClamp"));
+            }
+        }
+
+        // true when every property of every layer was found
+        bool IsValid() const;
+
+        const RasterLayerProperties& GetLayer(std::uint32_t layer) const;
+
+        // name of a property of the raster group of a layer, e.g. "raster1.uvClamp"
+        static AZ::Name GetPropertyName(std::uint32_t layer, const char* property);
+
+    private:
+        AZStd::array<RasterLayerProperties, LAYER_COUNT> m_layers;
+    };
+} // namespace Cesium
@@ -0,0 +1,113 @@
+#include "Cesium/TilesetUtility/RasterOverlayAtlas.h"
+#include <Atom/RHI.Reflect/ImageDescriptor.h>
+#include <Atom/RHI.Reflect/ImageSubresource.h>
+#include <Atom/RHI/ImagePool.h>
+#include <Atom/RPI.Public/Image/AttachmentImagePool.h>
+#include <Atom/RPI.Public/Image/ImageSystemInterface.h>
+#include <AzCore/Debug/Trace.h>
+#include <AzCore/std/string/string.h>
+
+namespace Cesium
+{
+    RasterOverlayAtlas::RasterOverlayAtlas(AZ::RHI::Format format)
+        : m_format{ format }
+        , m_allocator{ SLOTS_PER_ROW, MAX_PAGE_COUNT }
+    {
+    }
+
+    RasterAtlasSlot RasterOverlayAtlas::Insert(const std::byte* pixelData, const AZStd::vector<GltfImageMip>& mips)
+    {
+        AZ_Assert(
+            mips.size() >= MIP_COUNT && mips.front().m_width == SLOT_SIZE && mips.front().m_height == SLOT_SIZE,
+            "Only tiles of the slot size with every level of the atlas can be inserted");
+
+        bool newPage = false;
+        RasterAtlasSlot slot = m_allocator.Allocate(newPage);
+        if (!slot.IsValid())
+        {
+            return slot;
+        }
+
+        if (newPage)
+        {
+            if (m_pages.size() <= slot.m_page)
+            {
+                m_pages.resize(slot.m_page + 1);
+            }
+
+            m_pages[slot.m_page] = CreatePage(slot.m_page);
+            if (!m_pages[slot.m_page])
+            {
+                m_allocator.Free(slot);
+                return {};
+            }
+        }
+
+        AZ::RPI::AttachmentImage& page = *m_pages[slot.m_page];
+        std::uint32_t column = slot.m_index % SLOTS_PER_ROW;
+        std::uint32_t row = slot.m_index / SLOTS_PER_ROW;
+        for (std::uint32_t mip = 0; mip < MIP_COUNT; ++mip)
+        {
+            const GltfImageMip& imageMip = mips[mip];
+            AZ::RHI::ImageUpdateRequest request;
+            request.m_image = page.GetRHIImage();
+            request.m_imageSubresource = AZ::RHI::ImageSubresource{ static_cast<std::uint16_t>(mip), 0 };
+            request.m_imageSubresourcePixelOffset = AZ::RHI::Origin((column * SLOT_SIZE) >> mip, (row * SLOT_SIZE) >> mip, 0);
+            request.m_sourceData = pixelData + imageMip.m_byteOffset;
+            request.m_sourceSubresourceLayout =
+                AZ::RHI::GetImageSubresourceLayout(AZ::RHI::Size(imageMip.m_width, imageMip.m_height, 1), m_format);
+            page.UpdateImageContents(request);
+        }
+
+        return slot;
+    }
+
+    void RasterOverlayAtlas::Remove(const RasterAtlasSlot& slot)
+    {
+        // materials still drawing with the page keep it alive until they are released too
+        if (m_allocator.Free(slot))
+        {
+            m_pages[slot.m_page] = nullptr;
+        }
+    }
+
+    const AZ::Data::Instance<AZ::RPI::AttachmentImage>& RasterOverlayAtlas::GetPage(const RasterAtlasSlot& slot) const
+    {
+        return m_pages[slot.m_page];
+    }
+
+    AZ::Vector4 RasterOverlayAtlas::GetUvTranslateScale(const RasterAtlasSlot& slot, const AZ::Vector4& uvTranslateScale) const
+    {
+        float offsetU = 0.0f;
+        float offsetV = 0.0f;
+        float size = 0.0f;
+        m_allocator.GetSlotRect(slot, offsetU, offsetV, size);
+
+        // the shader flips V after translating and scaling, so the slot is addressed from the bottom of the page
+        return AZ::Vector4(
+            offsetU + uvTranslateScale.GetX() * size, 1.0f - offsetV - size + uvTranslateScale.GetY() * size,
+            uvTranslateScale.GetZ() * size, uvTranslateScale.GetW() * size);
+    }
+
+    AZ::Vector4 RasterOverlayAtlas::GetUvClamp(const RasterAtlasSlot& slot) const
+    {
+        float offsetU = 0.0f;
+        float offsetV = 0.0f;
+        float size = 0.0f;
+        m_allocator.GetSlotRect(slot, offsetU, offsetV, size);
+        return AZ::Vector4(offsetU, offsetV, offsetU + size, offsetV + size);
+    }
+
+    AZ::Data::Instance<AZ::RPI::AttachmentImage> RasterOverlayAtlas::CreatePage(std::uint32_t page) const
+    {
+        AZ::RHI::ImageDescriptor imageDesc = AZ::RHI::ImageDescriptor::Create2D(
+            AZ::RHI::ImageBindFlags::ShaderRead | AZ::RHI::ImageBindFlags::CopyWrite, PAGE_SIZE, PAGE_SIZE, m_format);
+        imageDesc.m_mipLevels = static_cast<std::uint16_t>(MIP_COUNT);
+
+        AZ::Data::Instance<AZ::RPI::AttachmentImagePool> pool = AZ::RPI::ImageSystemInterface::Get()->GetSystemAttachmentPool();
+        AZ::Name imageName(AZStd::string::format("CesiumRasterAtlas_%p_%u", static_cast<const void*>(this), page));
+        AZ::Data::Instance<AZ::RPI::AttachmentImage> image = AZ::RPI::AttachmentImage::Create(*pool, imageDesc, imageName);
+        AZ_Error("Cesium", image, "Failed to create a raster overlay atlas page");
+        return image;
+    }
+} // namespace Cesium
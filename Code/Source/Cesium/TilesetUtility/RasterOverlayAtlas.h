@@ -0,0 +1,50 @@
+#pragma once
+
+#include "Cesium/Gltf/GltfMipGenerator.h"
+#include "Cesium/TilesetUtility/RasterAtlasSlotAllocator.h"
+#include <Atom/RHI.Reflect/Format.h>
+#include <Atom/RPI.Public/Image/AttachmentImage.h>
+#include <AzCore/Math/Vector4.h>
+#include <AzCore/std/containers/vector.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace Cesium
+{
+    // Raster overlay tiles of one format packed into the slots of a few large pages, so the tiles of a page share one
+    // texture instead of each being a streaming image of its own. Tiles must be SLOT_SIZE x SLOT_SIZE with at least
+    // MIP_COUNT levels, the levels below that are dropped so every level stays aligned to compression blocks.
+    class RasterOverlayAtlas final
+    {
+    public:
+        static constexpr std::uint32_t SLOT_SIZE = 256;
+        static constexpr std::uint32_t SLOTS_PER_ROW = 8;
+        static constexpr std::uint32_t PAGE_SIZE = SLOT_SIZE * SLOTS_PER_ROW;
+        static constexpr std::uint32_t MAX_PAGE_COUNT = 8;
+        static constexpr std::uint32_t MIP_COUNT = 7;
+
+        explicit RasterOverlayAtlas(AZ::RHI::Format format);
+
+        // uploads the tile into a free slot. Returns an invalid slot when every page is full or a page cannot be created
+        RasterAtlasSlot Insert(const std::byte* pixelData, const AZStd::vector<GltfImageMip>& mips);
+
+        // the page of the slot is released once its last tile is removed
+        void Remove(const RasterAtlasSlot& slot);
+
+        const AZ::Data::Instance<AZ::RPI::AttachmentImage>& GetPage(const RasterAtlasSlot& slot) const;
+
+        // narrows the uvTranslateScale of a tile, which addresses the whole tile image, down to the slot of the tile
+        AZ::Vector4 GetUvTranslateScale(const RasterAtlasSlot& slot, const AZ::Vector4& uvTranslateScale) const;
+
+        // the rect of the slot in its page. The shader insets it by half a texel of the level it samples, so filtering
+        // never reads the neighbouring tiles at any level
+        AZ::Vector4 GetUvClamp(const RasterAtlasSlot& slot) const;
+
+    private:
+        AZ::Data::Instance<AZ::RPI::AttachmentImage> CreatePage(std::uint32_t page) const;
+
+        AZ::RHI::Format m_format;
+        RasterAtlasSlotAllocator m_allocator;
+        AZStd::vector<AZ::Data::Instance<AZ::RPI::AttachmentImage>> m_pages;
+    };
+} // namespace Cesium
@@ -2,11 +2,16 @@
 #include "Cesium/TilesetUtility/GltfRasterMaterialBuilder.h"
 #include "Cesium/Gltf/GltfModelBuilder.h"
 #include "Cesium/Gltf/GltfLoadContext.h"
+#include "Cesium/Gltf/GltfMipGenerator.h"
+#include "Cesium/Gltf/GltfPBRMaterialBuilder.h"
+#include "Cesium/Systems/CesiumProfiler.h"
+#include "Cesium/Systems/CesiumSystem.h"
 #include <Atom/Feature/Mesh/MeshFeatureProcessorInterface.h>
-#include <Atom/RPI.Reflect/Image/StreamingImageAssetCreator.h>
-#include <Atom/RPI.Reflect/Image/ImageMipChainAssetCreator.h>
+#include <Atom/RPI.Reflect/Image/StreamingImageAsset.h>
 #include <AzCore/std/smart_ptr/unique_ptr.h>
 #include <AzCore/std/algorithm.h>
+#include <AzCore/std/chrono/chrono.h>
+#include <AzCore/std/parallel/scoped_lock.h>
 #include <glm/gtc/matrix_transform.hpp>
 
 // Window 10 wingdi.h header defines OPAQUE macro which mess up with CesiumGltf::Material::AlphaMode::OPAQUE.
@@ -28,22 +33,59 @@
 
 namespace Cesium
 {
-    RenderResourcesPreparer::RenderResourcesPreparer(AZ::Render::MeshFeatureProcessorInterface* meshFeatureProcessor)
-        : m_meshFeatureProcessor{ meshFeatureProcessor }
-        , m_transform{ 1.0 }
+    namespace
     {
-        m_freeRasterLayers.reserve(GltfRasterMaterialBuilder::MAX_RASTER_LAYERS);
-        for (std::uint32_t i = 0; i < GltfRasterMaterialBuilder::MAX_RASTER_LAYERS; ++i)
+        RasterLayerBinding CreateRasterLayerBinding(
+            std::uint32_t layer, std::uint32_t textureCoordinateIndex, const RasterOverlay& rasterOverlay, const AZ::Vector4& uvTranslateScale)
         {
-            m_freeRasterLayers.emplace_back(i);
+            RasterLayerBinding binding{ layer, textureCoordinateIndex, uvTranslateScale, AZ::Vector4{ 0.0f, 0.0f, 1.0f, 1.0f },
+                                        rasterOverlay.m_image };
+            if (rasterOverlay.m_atlas)
+            {
+                binding.m_uvTranslateScale = rasterOverlay.m_atlas->GetUvTranslateScale(rasterOverlay.m_atlasSlot, uvTranslateScale);
+                binding.m_uvClamp = rasterOverlay.m_atlas->GetUvClamp(rasterOverlay.m_atlasSlot);
+            }
+
+            return binding;
+        }
+
+        bool IsSameRasters(const AZStd::vector<TileRasterAttachment>& lhs, const AZStd::vector<TileRasterAttachment>& rhs)
+        {
+            return AZStd::equal(
+                lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+                [](const TileRasterAttachment& lhsRaster, const TileRasterAttachment& rhsRaster)
+                {
+                    return lhsRaster.m_order == rhsRaster.m_order && lhsRaster.m_rasterOverlay == rhsRaster.m_rasterOverlay &&
+                        lhsRaster.m_textureCoordinateIndex == rhsRaster.m_textureCoordinateIndex &&
+                        lhsRaster.m_uvTranslateScale == rhsRaster.m_uvTranslateScale;
+                });
         }
+    } // namespace
 
+    RenderResourcesPreparer::RenderResourcesPreparer(
+        AZ::Render::MeshFeatureProcessorInterface* meshFeatureProcessor,
+        bool compactVertexLayout,
+        GltfTextureCompression textureCompression,
+        bool smoothMissingNormals)
+        : m_meshFeatureProcessor{ meshFeatureProcessor }
+        , m_compactVertexLayout{ compactVertexLayout }
+        , m_textureCompression{ textureCompression }
+        , m_smoothMissingNormals{ smoothMissingNormals }
+        , m_transform{ 1.0 }
+        , m_modelSequence{ 0 }
+        , m_prepareInMainThreadNanoseconds{ 0 }
+        , m_attachRasterNanoseconds{ 0 }
+        , m_loadedModelCount{ 0 }
+        , m_nextRasterOverlayOrder{ 0 }
+        , m_nextRasterCompositeGeneration{ 0 }
+    {
         AZ::TickBus::Handler::BusConnect();
     }
 
     RenderResourcesPreparer::~RenderResourcesPreparer() noexcept
     {
         AZ::TickBus::Handler::BusDisconnect();
+        m_rasterCompositeTasks.Wait();
 
         for (auto& intrusiveModel : m_intrusiveModels)
         {
@@ -51,10 +93,20 @@ namespace Cesium
             auto handler = std::move(intrusiveModel.m_self);
             handler.Free();
         }
+
+        // the images and materials only this tileset used are not going to be found again. The caches are gone already
+        // when the tileset outlives the Cesium system, e.g. during shutdown
+        if (auto cesiumSystem = CesiumInterface::Get())
+        {
+            cesiumSystem->GetImageAssetCache().ReleaseUnreferenced();
+            cesiumSystem->GetMaterialAssetCache().ReleaseUnreferenced();
+        }
     }
 
     void RenderResourcesPreparer::OnTick([[maybe_unused]] float deltaTime, [[maybe_unused]] AZ::ScriptTimePoint time)
     {
+        ProcessRasterComposites();
+
         auto it = AZStd::remove_if(
             m_compileMaterialsQueue.begin(), m_compileMaterialsQueue.end(),
             [](auto& material)
@@ -66,11 +118,13 @@ namespace Cesium
 
     void RenderResourcesPreparer::SetTransform(const glm::dmat4& transform)
     {
+        CESIUM_PROFILE_SCOPE("RenderResourcesPreparer::SetTransform");
         m_transform = transform;
-        for (auto& intrusiveModel : m_intrusiveModels)
-        {
-            intrusiveModel.m_model.SetTransform(transform);
-        }
+        m_tileTransforms.ChangeTransform(
+            [this](IntrusiveGltfModel* intrusiveModel)
+            {
+                ApplyTransform(*intrusiveModel);
+            });
     }
 
     const glm::dmat4& RenderResourcesPreparer::GetTransform() const
@@ -78,50 +132,145 @@ namespace Cesium
         return m_transform;
     }
 
-    void RenderResourcesPreparer::SetVisible(void* renderResources, bool visible)
+    void RenderResourcesPreparer::UpdateVisibility(
+        AZStd::span<void* const> renderResourcesToHide, AZStd::span<void* const> renderResourcesToShow)
+    {
+        for (void* renderResources : renderResourcesToHide)
+        {
+            RequestVisible(renderResources, false);
+        }
+
+        for (void* renderResources : renderResourcesToShow)
+        {
+            RequestVisible(renderResources, true);
+        }
+
+        m_meshVisibility.Apply(
+            [this](const AZ::Render::MeshFeatureProcessorInterface::MeshHandle& meshHandle, bool visible)
+            {
+                m_meshFeatureProcessor->SetVisible(meshHandle, visible);
+            });
+    }
+
+    void RenderResourcesPreparer::RequestVisible(void* renderResources, bool visible)
     {
+        // models that are not created yet pick the visibility up when FinalizeModel creates them
         if (renderResources)
         {
             IntrusiveGltfModel* intrusiveModel = reinterpret_cast<IntrusiveGltfModel*>(renderResources);
-            if (intrusiveModel->m_model.IsVisible() != visible)
+            intrusiveModel->m_visible = visible;
+            if (intrusiveModel->m_visibilitySlot != TileMeshVisibilityTable::INVALID_SLOT)
             {
-                intrusiveModel->m_model.SetVisible(visible);
+                m_tileTransforms.SetVisible(
+                    intrusiveModel->m_transformSlot, visible,
+                    [this](IntrusiveGltfModel* shownModel)
+                    {
+                        ApplyTransform(*shownModel);
+                    });
+                m_meshVisibility.SetVisible(intrusiveModel->m_visibilitySlot, visible);
             }
         }
     }
 
-    bool RenderResourcesPreparer::AddRasterLayer(const Cesium3DTilesSelection::RasterOverlay* rasterOverlay)
+    void RenderResourcesPreparer::ApplyTransform(IntrusiveGltfModel& intrusiveModel) const
     {
-        if (m_freeRasterLayers.empty())
+        intrusiveModel.m_model->SetTransform(m_transform);
+    }
+
+    void RenderResourcesPreparer::ProcessMainThreadWork(double timeLimitInMilliseconds)
+    {
+        if (m_pendingModels.empty())
         {
-            return false;
+            return;
         }
 
-        if (m_rasterOverlayLayers.find(rasterOverlay) == m_rasterOverlayLayers.end())
+        CESIUM_PROFILE_SCOPE("RenderResourcesPreparer::ProcessMainThreadWork");
+        AZStd::sort(
+            m_pendingModels.begin(), m_pendingModels.end(),
+            [](const IntrusiveGltfModel* lhs, const IntrusiveGltfModel* rhs)
+            {
+                if (lhs->m_visible != rhs->m_visible)
+                {
+                    return lhs->m_visible;
+                }
+
+                if (lhs->m_geometricError != rhs->m_geometricError)
+                {
+                    return lhs->m_geometricError > rhs->m_geometricError;
+                }
+
+                return lhs->m_sequence < rhs->m_sequence;
+            });
+
+        // at least one tile is finalized every frame, so the queue always drains
+        auto start = AZStd::chrono::steady_clock::now();
+        std::size_t processedCount = 0;
+        while (processedCount < m_pendingModels.size())
         {
-            m_rasterOverlayLayers.insert(AZStd::make_pair(rasterOverlay, m_freeRasterLayers.back()));
-            m_freeRasterLayers.pop_back();
+            IntrusiveGltfModel& intrusiveModel = *m_pendingModels[processedCount];
+            intrusiveModel.m_queued = false;
+            FinalizeModel(intrusiveModel);
+            ++processedCount;
+
+            auto elapsedTime = AZStd::chrono::duration<double, AZStd::milli>(AZStd::chrono::steady_clock::now() - start);
+            if (timeLimitInMilliseconds > 0.0 && elapsedTime.count() >= timeLimitInMilliseconds)
+            {
+                break;
+            }
         }
 
-        return true;
+        m_pendingModels.erase(m_pendingModels.begin(), m_pendingModels.begin() + processedCount);
+    }
+
+    std::size_t RenderResourcesPreparer::GetPendingMainThreadWorkCount() const
+    {
+        return m_pendingModels.size();
+    }
+
+    RenderResourcesPreparerStatistics RenderResourcesPreparer::GetStatistics()
+    {
+        RenderResourcesPreparerStatistics statistics;
+        statistics.m_prepareInMainThreadNanoseconds = m_prepareInMainThreadNanoseconds;
+        statistics.m_attachRasterNanoseconds = m_attachRasterNanoseconds;
+
+        AZStd::scoped_lock<AZStd::mutex> lock(m_loadStatisticsMutex);
+        statistics.m_loadedModelCount = m_loadedModelCount;
+        statistics.m_loadStatistics = m_loadStatistics;
+        return statistics;
+    }
+
+    void RenderResourcesPreparer::ResetMainThreadStatistics()
+    {
+        m_prepareInMainThreadNanoseconds = 0;
+        m_attachRasterNanoseconds = 0;
+    }
+
+    void RenderResourcesPreparer::AddRasterLayer(const Cesium3DTilesSelection::RasterOverlay* rasterOverlay)
+    {
+        if (m_rasterOverlayOrders.find(rasterOverlay) == m_rasterOverlayOrders.end())
+        {
+            m_rasterOverlayOrders.emplace(rasterOverlay, m_nextRasterOverlayOrder++);
+        }
     }
 
     void RenderResourcesPreparer::RemoveRasterLayer(const Cesium3DTilesSelection::RasterOverlay* rasterOverlay)
     {
-        auto layerIt = m_rasterOverlayLayers.find(rasterOverlay);
-        if (layerIt == m_rasterOverlayLayers.end())
+        auto orderIt = m_rasterOverlayOrders.find(rasterOverlay);
+        if (orderIt == m_rasterOverlayOrders.end())
         {
             return;
         }
 
-        m_rasterOverlayLayers.erase(layerIt);
-        m_freeRasterLayers.emplace_back(layerIt->second);
+        m_rasterOverlayOrders.erase(orderIt);
     }
 
     void* RenderResourcesPreparer::prepareInLoadThread(const CesiumGltf::Model& model, const glm::dmat4& transform)
     {
+        CESIUM_PROFILE_SCOPE("RenderResourcesPreparer::prepareInLoadThread");
+
         // set option for model loaders. Especially RTC
         GltfModelBuilderOption option{ transform };
+        option.m_smoothMissingNormals = m_smoothMissingNormals;
         AZStd::optional<glm::dvec3> rtc = GetRTCFromGltf(model);
         if (rtc)
         {
@@ -130,22 +279,37 @@ namespace Cesium
 
         // build model
         AZStd::unique_ptr<GltfLoadModel> loadModel = AZStd::make_unique<GltfLoadModel>();
-        GltfModelBuilder builder(AZStd::make_unique<GltfRasterMaterialBuilder>());
+        AZStd::unique_ptr<GltfRasterMaterialBuilder> materialBuilder = AZStd::make_unique<GltfRasterMaterialBuilder>();
+        materialBuilder->SetCompactVertexLayout(m_compactVertexLayout);
+        materialBuilder->SetTextureCompression(m_textureCompression);
+        GltfModelBuilder builder(std::move(materialBuilder));
         builder.Create(model, option, *loadModel);
+
+        {
+            const GltfLoadStatistics& modelStatistics = loadModel->m_statistics;
+            AZStd::scoped_lock<AZStd::mutex> lock(m_loadStatisticsMutex);
+            ++m_loadedModelCount;
+            m_loadStatistics.m_materialNanoseconds += modelStatistics.m_materialNanoseconds;
+            m_loadStatistics.m_attributeNanoseconds += modelStatistics.m_attributeNanoseconds;
+            m_loadStatistics.m_tangentNanoseconds += modelStatistics.m_tangentNanoseconds;
+            m_loadStatistics.m_meshAssetNanoseconds += modelStatistics.m_meshAssetNanoseconds;
+        }
+
         return loadModel.release();
     }
 
-    void* RenderResourcesPreparer::prepareInMainThread([[maybe_unused]] Cesium3DTilesSelection::Tile& tile, void* pLoadThreadResult)
+    void* RenderResourcesPreparer::prepareInMainThread(Cesium3DTilesSelection::Tile& tile, void* pLoadThreadResult)
     {
+        CESIUM_PROFILE_SCOPE("RenderResourcesPreparer::prepareInMainThread");
+        StageTimer stageTimer(m_prepareInMainThreadNanoseconds);
         if (pLoadThreadResult)
         {
-            // we destroy loadModel after main thread is done
+            // the model is created later by the main thread work queue, which destroys loadModel once it is done
             AZStd::unique_ptr<GltfLoadModel> loadModel{ reinterpret_cast<GltfLoadModel*>(pLoadThreadResult) };
-            auto handle = m_intrusiveModels.emplace(GltfModel(m_meshFeatureProcessor, *loadModel));
+            auto handle = m_intrusiveModels.emplace(std::move(loadModel), tile.getGeometricError(), m_modelSequence++);
             IntrusiveGltfModel& intrusiveModel = *handle;
             intrusiveModel.m_self = std::move(handle);
-            intrusiveModel.m_model.SetTransform(m_transform);
-            intrusiveModel.m_model.SetVisible(false);
+            QueueMainThreadWork(intrusiveModel);
             return &intrusiveModel;
         }
 
@@ -164,8 +328,23 @@ namespace Cesium
         if (pMainThreadResult)
         {
             IntrusiveGltfModel* intrusiveModel = reinterpret_cast<IntrusiveGltfModel*>(pMainThreadResult);
-            auto handler = std::move(intrusiveModel->m_self); // move the handler out before free it. Otherwise, stack overflow
-            handler.Free();
+            if (intrusiveModel->m_queued)
+            {
+                m_pendingModels.erase(AZStd::find(m_pendingModels.begin(), m_pendingModels.end(), intrusiveModel));
+            }
+
+            if (intrusiveModel->m_visibilitySlot != TileMeshVisibilityTable::INVALID_SLOT)
+            {
+                m_meshVisibility.Remove(intrusiveModel->m_visibilitySlot);
+                m_tileTransforms.Remove(intrusiveModel->m_transformSlot);
+            }
+
+            for (TileRasterLayer& rasterLayer : intrusiveModel->m_rasterLayers)
+            {
+                ReleaseRasterComposite(rasterLayer);
+            }
+
+            FreeModel(*intrusiveModel);
         }
     }
 
@@ -173,37 +352,68 @@ namespace Cesium
     {
         if (!image.pixelData.empty() && image.width != 0 && image.height != 0)
         {
-            // image has 4 channels, so we just copy the data over
-            AZ::RHI::ImageDescriptor imageDesc;
-            imageDesc.m_bindFlags = AZ::RHI::ImageBindFlags::ShaderRead;
-            imageDesc.m_dimension = AZ::RHI::ImageDimension::Image2D;
-            imageDesc.m_size = AZ::RHI::Size(image.width, image.height, 1);
-            imageDesc.m_format = AZ::RHI::Format::R8G8B8A8_UNORM_SRGB;
-
-            AZ::RHI::DeviceImageSubresourceLayout deviceImageSubresourceLayout =
-                AZ::RHI::GetImageSubresourceLayout(imageDesc, AZ::RHI::ImageSubresource{});
-
-            // Create mip chain
-            AZ::RPI::ImageMipChainAssetCreator mipChainCreator;
-            mipChainCreator.Begin(AZ::Uuid::CreateRandom(), 1, 1);
-            mipChainCreator.BeginMip(deviceImageSubresourceLayout);
-            mipChainCreator.AddSubImage(image.pixelData.data(), image.pixelData.size());
-            mipChainCreator.EndMip();
-            AZ::Data::Asset<AZ::RPI::ImageMipChainAsset> mipChainAsset;
-            mipChainCreator.End(mipChainAsset);
-
-            // Create streaming image
-            AZ::RPI::StreamingImageAssetCreator imageCreator;
-            imageCreator.Begin(AZ::Uuid::CreateRandom());
-            imageCreator.SetImageDescriptor(imageDesc);
-            imageCreator.AddMipChainAsset(*mipChainAsset);
-
-            AZ::Data::Asset<AZ::RPI::StreamingImageAsset> imageAsset;
-            imageCreator.End(imageAsset);
+            // image has 4 channels, so the mips are generated straight from a copy of it, and block compressed when possible.
+            // Tiles no larger than an atlas slot are resized to fill one, so they all go into the atlas with the same levels
+            std::uint32_t width = static_cast<std::uint32_t>(image.width);
+            std::uint32_t height = static_cast<std::uint32_t>(image.height);
+            bool fitsAtlasSlot = width <= RasterOverlayAtlas::SLOT_SIZE && height <= RasterOverlayAtlas::SLOT_SIZE;
+            AZStd::vector<std::byte> pixels;
+            if (fitsAtlasSlot && (width != RasterOverlayAtlas::SLOT_SIZE || height != RasterOverlayAtlas::SLOT_SIZE))
+            {
+                pixels = GltfMipGenerator::Resize(
+                    image.pixelData.data(), width, height, 4, true, RasterOverlayAtlas::SLOT_SIZE, RasterOverlayAtlas::SLOT_SIZE);
+                width = RasterOverlayAtlas::SLOT_SIZE;
+                height = RasterOverlayAtlas::SLOT_SIZE;
+            }
+            else
+            {
+                pixels.assign(image.pixelData.begin(), image.pixelData.end());
+            }
+
+            // every tile keeps a copy to composite, since an overlay added later may share its texture coordinates. Composites
+            // fill an atlas slot, so larger tiles keep a copy of that size
+            auto compositeSource = AZStd::make_shared<RasterCompositeSource>();
+            if (fitsAtlasSlot)
+            {
+                compositeSource->m_pixels = pixels;
+                compositeSource->m_width = width;
+                compositeSource->m_height = height;
+            }
+            else
+            {
+                compositeSource->m_pixels = GltfMipGenerator::Resize(
+                    pixels.data(), width, height, 4, true, RasterOverlayAtlas::SLOT_SIZE, RasterOverlayAtlas::SLOT_SIZE);
+                compositeSource->m_width = RasterOverlayAtlas::SLOT_SIZE;
+                compositeSource->m_height = RasterOverlayAtlas::SLOT_SIZE;
+            }
+
+            AZStd::vector<GltfImageMip> mips = GltfMipGenerator::GenerateMips(pixels, width, height, 4, true);
+
+            AZStd::vector<std::byte> compressed;
+            AZStd::vector<GltfImageMip> compressedMips;
+            AZ::RHI::Format format = AZ::RHI::Format::R8G8B8A8_UNORM_SRGB;
+            if (GltfTextureCompressor::CompressRGBA(
+                    pixels.data(), mips, m_textureCompression, true, compressed, compressedMips, format))
+            {
+                pixels = std::move(compressed);
+                mips = std::move(compressedMips);
+            }
+
+            if (fitsAtlasSlot)
+            {
+                auto rasterOverlay = new RasterOverlay();
+                rasterOverlay->m_compositeSource = std::move(compositeSource);
+                rasterOverlay->m_atlasPixels = std::move(pixels);
+                rasterOverlay->m_atlasMips = std::move(mips);
+                rasterOverlay->m_atlasFormat = format;
+                return rasterOverlay;
+            }
 
+            AZ::Data::Asset<AZ::RPI::StreamingImageAsset> imageAsset = GltfPBRMaterialBuilder::Create2DImage(pixels.data(), mips, format);
             if (imageAsset)
             {
                 auto rasterOverlay = new RasterOverlay();
+                rasterOverlay->m_compositeSource = std::move(compositeSource);
                 rasterOverlay->m_imageAsset = std::move(imageAsset);
                 return rasterOverlay;
             }
@@ -218,7 +428,37 @@ namespace Cesium
         if (pLoadThreadResult)
         {
             auto rasterOverlay = reinterpret_cast<RasterOverlay*>(pLoadThreadResult);
-            rasterOverlay->m_image = AZ::RPI::StreamingImage::FindOrCreate(rasterOverlay->m_imageAsset);
+            if (!rasterOverlay->m_atlasPixels.empty())
+            {
+                RasterOverlayAtlas& atlas = GetRasterAtlas(rasterOverlay->m_atlasFormat);
+                RasterAtlasSlot slot = atlas.Insert(rasterOverlay->m_atlasPixels.data(), rasterOverlay->m_atlasMips);
+                if (slot.IsValid())
+                {
+                    rasterOverlay->m_atlas = &atlas;
+                    rasterOverlay->m_atlasSlot = slot;
+                    rasterOverlay->m_image = atlas.GetPage(slot);
+                }
+                else
+                {
+                    rasterOverlay->m_imageAsset = GltfPBRMaterialBuilder::Create2DImage(
+                        rasterOverlay->m_atlasPixels.data(), rasterOverlay->m_atlasMips, rasterOverlay->m_atlasFormat);
+                }
+
+                rasterOverlay->m_atlasPixels = {};
+                rasterOverlay->m_atlasMips = {};
+            }
+
+            if (!rasterOverlay->m_atlas)
+            {
+                if (!rasterOverlay->m_imageAsset)
+                {
+                    delete rasterOverlay;
+                    return nullptr;
+                }
+
+                rasterOverlay->m_image = AZ::RPI::StreamingImage::FindOrCreate(rasterOverlay->m_imageAsset);
+            }
+
             return rasterOverlay;
         }
 
@@ -239,6 +479,11 @@ namespace Cesium
         if (pMainThreadResult)
         {
             RasterOverlay* rasterOverlay = reinterpret_cast<RasterOverlay*>(pMainThreadResult);
+            if (rasterOverlay->m_atlas)
+            {
+                rasterOverlay->m_atlas->Remove(rasterOverlay->m_atlasSlot);
+            }
+
             delete rasterOverlay;
         }
     }
@@ -251,108 +496,425 @@ namespace Cesium
         const glm::dvec2& translation,
         const glm::dvec2& scale)
     {
+        CESIUM_PROFILE_SCOPE("RenderResourcesPreparer::attachRasterInMainThread");
+        StageTimer stageTimer(m_attachRasterNanoseconds);
         if (tile.getState() == Cesium3DTilesSelection::Tile::LoadState::Done)
         {
             void* tileRenderResource = tile.getRendererResources();
             if (tileRenderResource && mainThreadRasterResources)
             {
-                // find the layer of the raster
+                // find the stacking order of the raster
                 const auto& currentRasterOverlay = rasterTile.getOverlay();
-                auto layerIt = m_rasterOverlayLayers.find(&currentRasterOverlay);
-                if (layerIt == m_rasterOverlayLayers.end())
+                auto orderIt = m_rasterOverlayOrders.find(&currentRasterOverlay);
+                if (orderIt == m_rasterOverlayOrders.end())
                 {
                     return;
                 }
-                std::uint32_t layer = layerIt->second;
+                std::uint64_t order = orderIt->second;
 
+                // the rasters of a tile are kept sorted by stacking order, and a raster replaces the earlier one of its overlay
                 IntrusiveGltfModel* intrusiveGltfModel = reinterpret_cast<IntrusiveGltfModel*>(tileRenderResource);
-                RasterOverlay* rasterOverlay = reinterpret_cast<RasterOverlay*>(mainThreadRasterResources);
-                GltfRasterMaterialBuilder materialBuilder;
-                GltfModel& model = intrusiveGltfModel->m_model;
-                for (auto& material : model.GetMaterials())
-                {
-                    if (!material.m_material)
+                TileRasterAttachment raster{ order, static_cast<std::uint32_t>(overlayTextureCoordinateID),
+                                             AZ::Vector4{ static_cast<float>(translation.x), static_cast<float>(translation.y),
+                                                          static_cast<float>(scale.x), static_cast<float>(scale.y) },
+                                             reinterpret_cast<RasterOverlay*>(mainThreadRasterResources) };
+                auto& rasters = intrusiveGltfModel->m_rasters;
+                auto rasterIt = AZStd::find_if(
+                    rasters.begin(), rasters.end(),
+                    [order](const TileRasterAttachment& attachedRaster)
                     {
-                        continue;
-                    }
-
-                    AZ::Vector4 uvTranslateScale{ static_cast<float>(translation.x), static_cast<float>(translation.y),
-                                                  static_cast<float>(scale.x), static_cast<float>(scale.y) };
-
-                    // Just update material with raster if the current material can compile, so material can be updated right away
-                    // in the next frame. Otherwise, we create the new material with the attached raster, so that the primitive is
-                    // updated with the new material in the next frame. If we only update the material and not create new material
-                    // the terrain can be rendered with old material if that material is still compiling and flickering can happen
-                    bool canCompile = material.m_material->CanCompile();
-                    if (canCompile)
-                    {
-                        canCompile = materialBuilder.SetRasterForMaterial(
-                            layer, rasterOverlay->m_image, static_cast<std::uint32_t>(overlayTextureCoordinateID), uvTranslateScale,
-                            material.m_material);
-                    }
+                        return attachedRaster.m_order == order;
+                    });
+                if (rasterIt != rasters.end())
+                {
+                    *rasterIt = raster;
+                }
+                else
+                {
+                    rasters.insert(
+                        AZStd::upper_bound(
+                            rasters.begin(), rasters.end(), raster,
+                            [](const TileRasterAttachment& lhs, const TileRasterAttachment& rhs)
+                            {
+                                return lhs.m_order < rhs.m_order;
+                            }),
+                        raster);
+                }
 
-                    if (!canCompile)
-                    {
-                        auto materialAsset = materialBuilder.CreateRasterMaterial(
-                            layer, rasterOverlay->m_imageAsset, static_cast<std::uint32_t>(overlayTextureCoordinateID), uvTranslateScale,
-                            material.m_material->GetAsset());
-                        material.m_material = AZ::RPI::Material::FindOrCreate(materialAsset);
-                    }
+                // attaching only writes material properties, so the rasters of a created model are bound right away. The
+                // model of a tile that is not created yet binds them when the main thread work queue creates it
+                if (intrusiveGltfModel->m_model)
+                {
+                    RefreshRasterLayers(*intrusiveGltfModel);
+                    return;
+                }
+
+                QueueMainThreadWork(*intrusiveGltfModel);
+            }
+        }
+    }
+
+    void RenderResourcesPreparer::RefreshRasterLayers(IntrusiveGltfModel& intrusiveModel)
+    {
+        // group the rasters by texture coordinates. The rasters are sorted by stacking order, so the texture coordinates of
+        // the bottom overlay take the first material layer
+        AZStd::array<AZStd::vector<TileRasterAttachment>, RasterMaterialProperties::LAYER_COUNT> groups;
+        for (const TileRasterAttachment& raster : intrusiveModel.m_rasters)
+        {
+            auto groupIt = AZStd::find_if(
+                groups.begin(), groups.end(),
+                [&raster](const AZStd::vector<TileRasterAttachment>& group)
+                {
+                    return group.empty() || group.front().m_textureCoordinateIndex == raster.m_textureCoordinateIndex;
+                });
+            if (groupIt == groups.end())
+            {
+                AZ_Warning(
+                    "Cesium", false, "Overlays of a tile use more than %u texture coordinate sets. The extra ones are not drawn",
+                    RasterMaterialProperties::LAYER_COUNT);
+                continue;
+            }
+
+            groupIt->emplace_back(raster);
+        }
+
+        GltfModel& model = *intrusiveModel.m_model;
+        for (std::uint32_t layer = 0; layer < RasterMaterialProperties::LAYER_COUNT; ++layer)
+        {
+            TileRasterLayer& rasterLayer = intrusiveModel.m_rasterLayers[layer];
+            AZStd::vector<TileRasterAttachment>& group = groups[layer];
+            if (IsSameRasters(group, rasterLayer.m_boundRasters))
+            {
+                continue;
+            }
+
+            rasterLayer.m_boundRasters = std::move(group);
+            if (rasterLayer.m_boundRasters.empty())
+            {
+                ReleaseRasterComposite(rasterLayer);
+                if (rasterLayer.m_textureCoordinateIndex != TileRasterLayer::UNBOUND)
+                {
+                    DetachRaster(model, layer);
+                    rasterLayer.m_textureCoordinateIndex = TileRasterLayer::UNBOUND;
                 }
 
-                for (auto& mesh : model.GetMeshes())
+                continue;
+            }
+
+            const auto& boundRasters = rasterLayer.m_boundRasters;
+            if (boundRasters.size() > 1)
+            {
+                RequestRasterComposite(intrusiveModel, layer);
+                continue;
+            }
+
+            const TileRasterAttachment& raster = boundRasters.front();
+            AttachRaster(
+                model,
+                CreateRasterLayerBinding(layer, raster.m_textureCoordinateIndex, *raster.m_rasterOverlay, raster.m_uvTranslateScale));
+            ReleaseRasterComposite(rasterLayer);
+            rasterLayer.m_textureCoordinateIndex = static_cast<std::int32_t>(raster.m_textureCoordinateIndex);
+        }
+    }
+
+    void RenderResourcesPreparer::RequestRasterComposite(IntrusiveGltfModel& intrusiveModel, std::uint32_t layer)
+    {
+        // a newer request makes the one in flight outdated
+        TileRasterLayer& rasterLayer = intrusiveModel.m_rasterLayers[layer];
+        if (rasterLayer.m_compositeGeneration != 0)
+        {
+            m_rasterCompositeRequests.erase(rasterLayer.m_compositeGeneration);
+        }
+
+        std::uint64_t generation = ++m_nextRasterCompositeGeneration;
+        rasterLayer.m_compositeGeneration = generation;
+        m_rasterCompositeRequests.emplace(generation, RasterCompositeRequest{ &intrusiveModel, layer });
+
+        // the sources are shared with the raster tiles, so the composite holds on to them even if the tiles are freed first
+        AZStd::vector<RasterCompositeLayer> compositeLayers;
+        compositeLayers.reserve(rasterLayer.m_boundRasters.size());
+        for (const TileRasterAttachment& raster : rasterLayer.m_boundRasters)
+        {
+            compositeLayers.emplace_back(RasterCompositeLayer{ raster.m_rasterOverlay->m_compositeSource, raster.m_uvTranslateScale });
+        }
+
+        GltfTextureCompression textureCompression = m_textureCompression;
+        CesiumInterface::Get()->GetScheduler().Submit(
+            CesiumSchedulerLane::Compute,
+            [this, generation, textureCompression, compositeLayers = std::move(compositeLayers)]()
+            {
+                CESIUM_PROFILE_SCOPE("RenderResourcesPreparer::CompositeRasters");
+                // a composite fills an atlas slot
+                std::uint32_t size = RasterOverlayAtlas::SLOT_SIZE;
+                RasterCompositeResult result{ generation, RasterCompositor::Composite(compositeLayers, size), {},
+                                              AZ::RHI::Format::R8G8B8A8_UNORM_SRGB };
+                result.m_mips = GltfMipGenerator::GenerateMips(result.m_pixels, size, size, 4, true);
+
+                AZStd::vector<std::byte> compressed;
+                AZStd::vector<GltfImageMip> compressedMips;
+                if (GltfTextureCompressor::CompressRGBA(
+                        result.m_pixels.data(), result.m_mips, textureCompression, true, compressed, compressedMips, result.m_format))
                 {
-                    for (auto& primitive : mesh.m_primitives)
-                    {
-                        model.UpdateMaterialForPrimitive(primitive);
-                    }
+                    result.m_pixels = std::move(compressed);
+                    result.m_mips = std::move(compressedMips);
                 }
+
+                AZStd::scoped_lock<AZStd::mutex> lock(m_rasterCompositeResultsMutex);
+                m_rasterCompositeResults.emplace_back(std::move(result));
+            },
+            &m_rasterCompositeTasks);
+    }
+
+    void RenderResourcesPreparer::ProcessRasterComposites()
+    {
+        AZStd::vector<RasterCompositeResult> results;
+        {
+            AZStd::scoped_lock<AZStd::mutex> lock(m_rasterCompositeResultsMutex);
+            results.swap(m_rasterCompositeResults);
+        }
+
+        for (RasterCompositeResult& result : results)
+        {
+            auto requestIt = m_rasterCompositeRequests.find(result.m_generation);
+            if (requestIt == m_rasterCompositeRequests.end())
+            {
+                continue;
+            }
+
+            RasterCompositeRequest request = requestIt->second;
+            m_rasterCompositeRequests.erase(requestIt);
+            TileRasterLayer& rasterLayer = request.m_intrusiveModel->m_rasterLayers[request.m_layer];
+            rasterLayer.m_compositeGeneration = 0;
+
+            // composites have the size of an atlas slot, so they only need an image of their own when the atlas is full
+            auto composite = AZStd::make_unique<RasterOverlay>();
+            RasterOverlayAtlas& atlas = GetRasterAtlas(result.m_format);
+            RasterAtlasSlot slot = atlas.Insert(result.m_pixels.data(), result.m_mips);
+            if (slot.IsValid())
+            {
+                composite->m_atlas = &atlas;
+                composite->m_atlasSlot = slot;
+                composite->m_image = atlas.GetPage(slot);
+            }
+            else
+            {
+                composite->m_imageAsset = GltfPBRMaterialBuilder::Create2DImage(result.m_pixels.data(), result.m_mips, result.m_format);
+                if (!composite->m_imageAsset)
+                {
+                    continue;
+                }
+
+                composite->m_image = AZ::RPI::StreamingImage::FindOrCreate(composite->m_imageAsset);
+            }
+
+            std::uint32_t textureCoordinateIndex = rasterLayer.m_boundRasters.front().m_textureCoordinateIndex;
+            AttachRaster(
+                *request.m_intrusiveModel->m_model,
+                CreateRasterLayerBinding(request.m_layer, textureCoordinateIndex, *composite, AZ::Vector4{ 0.0f, 0.0f, 1.0f, 1.0f }));
+            ReleaseRasterComposite(rasterLayer);
+            rasterLayer.m_composite = std::move(composite);
+            rasterLayer.m_textureCoordinateIndex = static_cast<std::int32_t>(textureCoordinateIndex);
+        }
+    }
+
+    void RenderResourcesPreparer::ReleaseRasterComposite(TileRasterLayer& rasterLayer)
+    {
+        if (rasterLayer.m_compositeGeneration != 0)
+        {
+            m_rasterCompositeRequests.erase(rasterLayer.m_compositeGeneration);
+            rasterLayer.m_compositeGeneration = 0;
+        }
+
+        if (rasterLayer.m_composite)
+        {
+            if (rasterLayer.m_composite->m_atlas)
+            {
+                rasterLayer.m_composite->m_atlas->Remove(rasterLayer.m_composite->m_atlasSlot);
             }
+
+            rasterLayer.m_composite.reset();
         }
     }
 
+    void RenderResourcesPreparer::AttachRaster(GltfModel& model, const RasterLayerBinding& raster)
+    {
+        GltfRasterMaterialBuilder materialBuilder;
+        bool materialReplaced = false;
+        for (auto& material : model.GetMaterials())
+        {
+            if (!material.m_material)
+            {
+                continue;
+            }
+
+            // the tile takes an instance of its own the first time a raster is attached to it. From then on attaching and
+            // detaching only update the properties of that instance, and the meshes keep drawing with it
+            if (material.m_sharedInstance)
+            {
+                material.m_material = AZ::RPI::Material::Create(material.m_material->GetAsset());
+                material.m_sharedInstance = false;
+                materialReplaced = true;
+                if (!material.m_material)
+                {
+                    continue;
+                }
+            }
+
+            materialBuilder.SetRasterForMaterial(
+                raster.m_layer, raster.m_image, raster.m_textureCoordinateIndex, raster.m_uvTranslateScale, raster.m_uvClamp,
+                material.m_material);
+            CompileMaterial(material.m_material);
+        }
+
+        if (materialReplaced)
+        {
+            for (auto& mesh : model.GetMeshes())
+            {
+                for (auto& primitive : mesh.m_primitives)
+                {
+                    model.UpdateMaterialForPrimitive(primitive);
+                }
+            }
+        }
+    }
+
+    void RenderResourcesPreparer::CompileMaterial(AZ::Data::Instance<AZ::RPI::Material>& material)
+    {
+        // a material can only compile once per frame, so a raster replaced in the same frame compiles in the next tick
+        if (!material->Compile())
+        {
+            m_compileMaterialsQueue.emplace_back(material);
+        }
+    }
+
+    RasterOverlayAtlas& RenderResourcesPreparer::GetRasterAtlas(AZ::RHI::Format format)
+    {
+        auto atlasIt = m_rasterAtlases.find(format);
+        if (atlasIt == m_rasterAtlases.end())
+        {
+            atlasIt = m_rasterAtlases.emplace(format, AZStd::make_unique<RasterOverlayAtlas>(format)).first;
+        }
+
+        return *atlasIt->second;
+    }
+
     void RenderResourcesPreparer::detachRasterInMainThread(
         const Cesium3DTilesSelection::Tile& tile,
         [[maybe_unused]] std::int32_t overlayTextureCoordinateID,
         const Cesium3DTilesSelection::RasterOverlayTile& rasterTile,
         void* mainThreadRasterResources) noexcept
     {
+        CESIUM_PROFILE_SCOPE("RenderResourcesPreparer::detachRasterInMainThread");
+        StageTimer stageTimer(m_attachRasterNanoseconds);
         if (tile.getState() == Cesium3DTilesSelection::Tile::LoadState::Done)
         {
             void* tileRenderResource = tile.getRendererResources();
             if (tileRenderResource && mainThreadRasterResources)
             {
-                // find the layer of the raster
+                // find the stacking order of the raster
                 const auto& currentRasterOverlay = rasterTile.getOverlay();
-                auto layerIt = m_rasterOverlayLayers.find(&currentRasterOverlay);
-                if (layerIt == m_rasterOverlayLayers.end())
+                auto orderIt = m_rasterOverlayOrders.find(&currentRasterOverlay);
+                if (orderIt == m_rasterOverlayOrders.end())
                 {
                     return;
                 }
-                std::uint32_t layer = layerIt->second;
+                std::uint64_t order = orderIt->second;
 
+                // a raster of the same overlay that replaced this one is kept
                 IntrusiveGltfModel* intrusiveGltfModel = reinterpret_cast<IntrusiveGltfModel*>(tileRenderResource);
-                GltfRasterMaterialBuilder materialBuilder;
-                GltfModel& model = intrusiveGltfModel->m_model;
-                for (auto& material : model.GetMaterials())
+                RasterOverlay* rasterOverlay = reinterpret_cast<RasterOverlay*>(mainThreadRasterResources);
+                auto& rasters = intrusiveGltfModel->m_rasters;
+                rasters.erase(
+                    AZStd::remove_if(
+                        rasters.begin(), rasters.end(),
+                        [order, rasterOverlay](const TileRasterAttachment& attachedRaster)
+                        {
+                            return attachedRaster.m_order == order && attachedRaster.m_rasterOverlay == rasterOverlay;
+                        }),
+                    rasters.end());
+                if (intrusiveGltfModel->m_model)
                 {
-                    if (!material.m_material)
-                    {
-                        continue;
-                    }
+                    RefreshRasterLayers(*intrusiveGltfModel);
+                }
+            }
+        }
+    }
 
-                    bool compile = materialBuilder.UnsetRasterForMaterial(layer, material.m_material);
+    void RenderResourcesPreparer::DetachRaster(GltfModel& model, std::uint32_t layer)
+    {
+        GltfRasterMaterialBuilder materialBuilder;
+        for (auto& material : model.GetMaterials())
+        {
+            // a shared instance never had a raster attached
+            if (!material.m_material || material.m_sharedInstance)
+            {
+                continue;
+            }
 
-                    // it's not guaranteed that the material will be able to compile right away, so we add it to the queue to compile later
-                    if (!compile)
-                    {
-                        m_compileMaterialsQueue.emplace_back(material.m_material);
-                    }
+            // the compile is left to the next tick, so a raster that replaces this one in the same frame is attached
+            // without the tile showing no raster in between
+            materialBuilder.UnsetRasterForMaterial(layer, material.m_material);
+            m_compileMaterialsQueue.emplace_back(material.m_material);
+        }
+    }
+
+    void RenderResourcesPreparer::QueueMainThreadWork(IntrusiveGltfModel& intrusiveModel)
+    {
+        if (!intrusiveModel.m_queued)
+        {
+            intrusiveModel.m_queued = true;
+            m_pendingModels.emplace_back(&intrusiveModel);
+        }
+    }
+
+    void RenderResourcesPreparer::FinalizeModel(IntrusiveGltfModel& intrusiveModel)
+    {
+        StageTimer stageTimer(m_prepareInMainThreadNanoseconds);
+        if (!intrusiveModel.m_model)
+        {
+            CESIUM_PROFILE_SCOPE("RenderResourcesPreparer::CreateModel");
+            intrusiveModel.m_model.emplace(m_meshFeatureProcessor, *intrusiveModel.m_loadModel);
+            intrusiveModel.m_loadModel.reset();
+            intrusiveModel.m_model->SetTransform(m_transform);
+        }
+
+        GltfModel& model = *intrusiveModel.m_model;
+        if (!intrusiveModel.m_rasters.empty())
+        {
+            CESIUM_PROFILE_SCOPE("RenderResourcesPreparer::AttachRaster");
+            stageTimer.SwitchTo(m_attachRasterNanoseconds);
+            RefreshRasterLayers(intrusiveModel);
+            stageTimer.SwitchTo(m_prepareInMainThreadNanoseconds);
+        }
+
+        // the visibility and transform tables keep the meshes up to date from here on
+        if (intrusiveModel.m_visibilitySlot == TileMeshVisibilityTable::INVALID_SLOT)
+        {
+            if (model.IsVisible() != intrusiveModel.m_visible)
+            {
+                model.SetVisible(intrusiveModel.m_visible);
+            }
+
+            m_meshHandleScratch.clear();
+            for (const GltfMesh& mesh : model.GetMeshes())
+            {
+                for (const GltfPrimitive& primitive : mesh.m_primitives)
+                {
+                    m_meshHandleScratch.emplace_back(&primitive.m_meshHandle);
                 }
             }
+
+            intrusiveModel.m_visibilitySlot = m_meshVisibility.Add(m_meshHandleScratch, intrusiveModel.m_visible);
+            intrusiveModel.m_transformSlot = m_tileTransforms.Add(&intrusiveModel, intrusiveModel.m_visible);
         }
     }
 
+    void RenderResourcesPreparer::FreeModel(IntrusiveGltfModel& intrusiveModel)
+    {
+        auto handler = std::move(intrusiveModel.m_self); // move the handler out before free it. Otherwise, stack overflow
+        handler.Free();
+    }
+
     AZStd::optional<glm::dvec3> RenderResourcesPreparer::GetRTCFromGltf(const CesiumGltf::Model& model)
     {
         const CesiumUtility::JsonValue& extras = model.extras;
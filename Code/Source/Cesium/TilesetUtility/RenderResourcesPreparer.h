@@ -1,6 +1,14 @@
 #pragma once
 
 #include "Cesium/Gltf/GltfModel.h"
+#include "Cesium/Gltf/GltfLoadContext.h"
+#include "Cesium/Gltf/GltfTextureCompressor.h"
+#include "Cesium/Systems/CesiumScheduler.h"
+#include "Cesium/TilesetUtility/MeshVisibilityTable.h"
+#include "Cesium/TilesetUtility/RasterCompositor.h"
+#include "Cesium/TilesetUtility/RasterMaterialProperties.h"
+#include "Cesium/TilesetUtility/RasterOverlayAtlas.h"
+#include "Cesium/TilesetUtility/TileTransformTable.h"
 #include <Atom/RPI.Public/Material/Material.h>
 #include <Atom/RPI.Public/Image/StreamingImage.h>
 #include <Atom/RPI.Reflect/Image/StreamingImageAsset.h>
@@ -8,8 +16,14 @@
 #include <AzCore/Component/TickBus.h>
 #include <AzCore/Asset/AssetCommon.h>
 #include <AzCore/std/optional.h>
+#include <AzCore/std/containers/array.h>
+#include <AzCore/std/containers/span.h>
 #include <AzCore/std/containers/vector.h>
 #include <AzCore/std/containers/map.h>
+#include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/parallel/mutex.h>
+#include <AzCore/std/smart_ptr/shared_ptr.h>
+#include <AzCore/std/smart_ptr/unique_ptr.h>
 #include <Cesium3DTilesSelection/IPrepareRendererResources.h>
 #include <glm/glm.hpp>
 
@@ -33,41 +47,147 @@ namespace Cesium3DTilesSelection
 
 namespace Cesium
 {
+    using TileMeshVisibilityTable = MeshVisibilityTable<AZ::Render::MeshFeatureProcessorInterface::MeshHandle>;
+
+    // A raster tile is either an image of its own, or a slot of the atlas of its format. The texels of a tile that fits a
+    // slot are kept from the load thread until the main thread uploads them, and the tile falls back to an image of its
+    // own when the atlas is full. The top level is kept on the CPU as well, at most the size of a slot, so tiles that
+    // stack overlays on the same texture coordinates can composite them, including overlays added after the tile loaded
     struct RasterOverlay
     {
-        AZ::Data::Instance<AZ::RPI::StreamingImage> m_image;
+        AZStd::shared_ptr<const RasterCompositeSource> m_compositeSource;
+        AZ::Data::Instance<AZ::RPI::Image> m_image;
         AZ::Data::Asset<AZ::RPI::StreamingImageAsset> m_imageAsset;
+        AZStd::vector<std::byte> m_atlasPixels;
+        AZStd::vector<GltfImageMip> m_atlasMips;
+        AZ::RHI::Format m_atlasFormat{ AZ::RHI::Format::Unknown };
+        RasterOverlayAtlas* m_atlas{ nullptr };
+        RasterAtlasSlot m_atlasSlot;
+    };
+
+    // what a raster layer of the tile materials samples
+    struct RasterLayerBinding
+    {
+        std::uint32_t m_layer;
+        std::uint32_t m_textureCoordinateIndex;
+        AZ::Vector4 m_uvTranslateScale;
+        AZ::Vector4 m_uvClamp;
+        AZ::Data::Instance<AZ::RPI::Image> m_image;
+    };
+
+    // a raster attached to a tile. m_order is the stacking order of its overlay and m_uvTranslateScale is in tile space
+    struct TileRasterAttachment
+    {
+        std::uint64_t m_order;
+        std::uint32_t m_textureCoordinateIndex;
+        AZ::Vector4 m_uvTranslateScale;
+        RasterOverlay* m_rasterOverlay;
+    };
+
+    // A raster layer of the tile materials. It samples the only raster attached with its texture coordinates, or the
+    // composite of all of them. m_boundRasters are the rasters of the current binding or composite request, so a layer is
+    // only bound or composited again when one of them changes, and it keeps its current image until a new composite arrives
+    struct TileRasterLayer
+    {
+        static constexpr std::int32_t UNBOUND = -1;
+
+        std::int32_t m_textureCoordinateIndex{ UNBOUND };
+        AZStd::vector<TileRasterAttachment> m_boundRasters;
+        std::uint64_t m_compositeGeneration{ 0 };
+        AZStd::unique_ptr<RasterOverlay> m_composite;
     };
 
+    // Render resources of a tile. The GltfModel is only created when the main thread work queue reaches the tile,
+    // so the model is empty until then and the visibility and rasters requested in the meantime are kept here.
     struct IntrusiveGltfModel
     {
-        IntrusiveGltfModel(GltfModel&& model)
-            : m_model{ std::move(model) }
+        IntrusiveGltfModel(AZStd::unique_ptr<GltfLoadModel>&& loadModel, double geometricError, std::uint64_t sequence)
+            : m_loadModel{ std::move(loadModel) }
+            , m_geometricError{ geometricError }
+            , m_sequence{ sequence }
+            , m_visible{ false }
+            , m_queued{ false }
+            , m_visibilitySlot{ TileMeshVisibilityTable::INVALID_SLOT }
+            , m_transformSlot{ TileTransformTable<IntrusiveGltfModel>::INVALID_SLOT }
         {
         }
 
-        GltfModel m_model;
+        AZStd::optional<GltfModel> m_model;
+        AZStd::unique_ptr<GltfLoadModel> m_loadModel;
+        AZStd::vector<TileRasterAttachment> m_rasters;
+        AZStd::array<TileRasterLayer, RasterMaterialProperties::LAYER_COUNT> m_rasterLayers;
+        double m_geometricError;
+        std::uint64_t m_sequence;
+        bool m_visible;
+        bool m_queued;
+        TileMeshVisibilityTable::Slot m_visibilitySlot;
+        TileTransformTable<IntrusiveGltfModel>::Slot m_transformSlot;
         AZ::StableDynamicArrayHandle<IntrusiveGltfModel> m_self;
     };
 
+    struct RasterCompositeRequest
+    {
+        IntrusiveGltfModel* m_intrusiveModel;
+        std::uint32_t m_layer;
+    };
+
+    struct RasterCompositeResult
+    {
+        std::uint64_t m_generation;
+        AZStd::vector<std::byte> m_pixels;
+        AZStd::vector<GltfImageMip> m_mips;
+        AZ::RHI::Format m_format;
+    };
+
+    struct RenderResourcesPreparerStatistics final
+    {
+        // main thread nanoseconds since the last ResetMainThreadStatistics. Creating the model of a tile counts as
+        // preparing it, even when the work queue does it after prepareInMainThread returned
+        std::uint64_t m_prepareInMainThreadNanoseconds{ 0 };
+        std::uint64_t m_attachRasterNanoseconds{ 0 };
+
+        // models built by the load threads since the preparer was created and the time spent on them
+        std::uint64_t m_loadedModelCount{ 0 };
+        GltfLoadStatistics m_loadStatistics;
+    };
+
     class RenderResourcesPreparer
         : public Cesium3DTilesSelection::IPrepareRendererResources
         , public AZ::TickBus::Handler
     {
     public:
-        RenderResourcesPreparer(AZ::Render::MeshFeatureProcessorInterface* meshFeatureProcessor);
+        RenderResourcesPreparer(
+            AZ::Render::MeshFeatureProcessorInterface* meshFeatureProcessor,
+            bool compactVertexLayout,
+            GltfTextureCompression textureCompression,
+            bool smoothMissingNormals);
 
         ~RenderResourcesPreparer() noexcept;
 
         void OnTick(float deltaTime, AZ::ScriptTimePoint time) override;
 
+        // moves the visible tiles right away, the hidden ones take the transform when they are shown again
         void SetTransform(const glm::dmat4& transform);
 
         const glm::dmat4& GetTransform() const;
 
-        void SetVisible(void* renderResources, bool visible);
+        // applies the visibility changes of a frame in one pass. Only the meshes of models whose visibility actually
+        // changes are touched, so render resources that are already in the requested state cost a lookup
+        void UpdateVisibility(AZStd::span<void* const> renderResourcesToHide, AZStd::span<void* const> renderResourcesToShow);
+
+        // Creates the models of loaded tiles and attaches their rasters until the time limit is used up. Visible tiles
+        // go first, then the coarsest ones, so holes are filled before detail is added. A limit of 0 runs all the work
+        void ProcessMainThreadWork(double timeLimitInMilliseconds);
+
+        std::size_t GetPendingMainThreadWorkCount() const;
+
+        RenderResourcesPreparerStatistics GetStatistics();
+
+        void ResetMainThreadStatistics();
 
-        bool AddRasterLayer(const Cesium3DTilesSelection::RasterOverlay* rasterOverlay);
+        // overlays added later are drawn on top of the earlier ones. Any number of overlays can be added: the overlays
+        // attached to a tile with the same texture coordinates are composited into one image in the background
+        void AddRasterLayer(const Cesium3DTilesSelection::RasterOverlay* rasterOverlay);
 
         void RemoveRasterLayer(const Cesium3DTilesSelection::RasterOverlay* rasterOverlay);
 
@@ -103,14 +223,65 @@ namespace Cesium
     private:
         AZStd::optional<glm::dvec3> GetRTCFromGltf(const CesiumGltf::Model& model);
 
+        void QueueMainThreadWork(IntrusiveGltfModel& intrusiveModel);
+
+        void RequestVisible(void* renderResources, bool visible);
+
+        void ApplyTransform(IntrusiveGltfModel& intrusiveModel) const;
+
+        void FinalizeModel(IntrusiveGltfModel& intrusiveModel);
+
+        void AttachRaster(GltfModel& model, const RasterLayerBinding& raster);
+
+        void DetachRaster(GltfModel& model, std::uint32_t layer);
+
+        // binds the rasters attached to the tile to the material layers, one layer per texture coordinate set
+        void RefreshRasterLayers(IntrusiveGltfModel& intrusiveModel);
+
+        void RequestRasterComposite(IntrusiveGltfModel& intrusiveModel, std::uint32_t layer);
+
+        void ProcessRasterComposites();
+
+        void ReleaseRasterComposite(TileRasterLayer& rasterLayer);
+
+        void CompileMaterial(AZ::Data::Instance<AZ::RPI::Material>& material);
+
+        RasterOverlayAtlas& GetRasterAtlas(AZ::RHI::Format format);
+
+        static void FreeModel(IntrusiveGltfModel& intrusiveModel);
+
         static constexpr char CESIUM_RTC_CENTER_EXTRA[] = "RTC_CENTER";
 
         AZ::Render::MeshFeatureProcessorInterface* m_meshFeatureProcessor;
+        bool m_compactVertexLayout;
+        GltfTextureCompression m_textureCompression;
+        bool m_smoothMissingNormals;
         AZ::StableDynamicArray<IntrusiveGltfModel> m_intrusiveModels;
+        TileMeshVisibilityTable m_meshVisibility;
+        TileTransformTable<IntrusiveGltfModel> m_tileTransforms;
+        AZStd::vector<const AZ::Render::MeshFeatureProcessorInterface::MeshHandle*> m_meshHandleScratch;
         glm::dmat4 m_transform;
+        std::uint64_t m_modelSequence;
+        AZStd::vector<IntrusiveGltfModel*> m_pendingModels;
+        std::uint64_t m_prepareInMainThreadNanoseconds;
+        std::uint64_t m_attachRasterNanoseconds;
+
+        AZStd::mutex m_loadStatisticsMutex;
+        std::uint64_t m_loadedModelCount;
+        GltfLoadStatistics m_loadStatistics;
 
         AZStd::vector<AZ::Data::Instance<AZ::RPI::Material>> m_compileMaterialsQueue;
-        AZStd::map<const Cesium3DTilesSelection::RasterOverlay*, std::uint32_t> m_rasterOverlayLayers;
-        AZStd::vector<std::uint32_t> m_freeRasterLayers;
+        AZStd::map<const Cesium3DTilesSelection::RasterOverlay*, std::uint64_t> m_rasterOverlayOrders;
+        std::uint64_t m_nextRasterOverlayOrder;
+        AZStd::map<AZ::RHI::Format, AZStd::unique_ptr<RasterOverlayAtlas>> m_rasterAtlases;
+
+        // composites run on the compute lane. Each request has a generation of its own, and a finished composite is only
+        // bound when its generation is still in m_rasterCompositeRequests, so outdated results and those of freed tiles
+        // are dropped
+        std::uint64_t m_nextRasterCompositeGeneration;
+        AZStd::unordered_map<std::uint64_t, RasterCompositeRequest> m_rasterCompositeRequests;
+        AZStd::mutex m_rasterCompositeResultsMutex;
+        AZStd::vector<RasterCompositeResult> m_rasterCompositeResults;
+        CesiumSchedulerTaskGroup m_rasterCompositeTasks;
     };
 } // namespace Cesium
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <AzCore/std/containers/vector.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace Cesium
+{
+    // Tracks which models of a tileset hold the current tileset transform. A transform change only reaches the visible
+    // models right away, hidden ones are brought up to date when they are shown again, so an origin shift costs as much as
+    // the tiles on screen instead of every tile in the cache.
+    template<typename Model>
+    class TileTransformTable final
+    {
+    public:
+        using Slot = std::uint32_t;
+
+        static constexpr Slot INVALID_SLOT = ~Slot(0);
+
+        // the model must already hold the current transform
+        Slot Add(Model* model, bool visible)
+        {
+            Slot slot;
+            if (m_freeSlots.empty())
+            {
+                slot = static_cast<Slot>(m_models.size());
+                m_models.emplace_back();
+                m_transformVersions.emplace_back();
+                m_visibleIndices.emplace_back();
+            }
+            else
+            {
+                slot = m_freeSlots.back();
+                m_freeSlots.pop_back();
+            }
+
+            m_models[slot] = model;
+            m_transformVersions[slot] = m_transformVersion;
+            m_visibleIndices[slot] = NOT_VISIBLE;
+            if (visible)
+            {
+                AddVisible(slot);
+            }
+
+            return slot;
+        }
+
+        void Remove(Slot slot)
+        {
+            RemoveVisible(slot);
+            m_models[slot] = nullptr;
+            m_freeSlots.emplace_back(slot);
+        }
+
+        // calls applyTransform(model) before a model that missed transform changes is shown
+        template<typename ApplyFunction>
+        void SetVisible(Slot slot, bool visible, ApplyFunction&& applyTransform)
+        {
+            if (!visible)
+            {
+                RemoveVisible(slot);
+                return;
+            }
+
+            if (m_transformVersions[slot] != m_transformVersion)
+            {
+                m_transformVersions[slot] = m_transformVersion;
+                applyTransform(m_models[slot]);
+            }
+
+            AddVisible(slot);
+        }
+
+        // calls applyTransform(model) for every visible model, and returns how many that was
+        template<typename ApplyFunction>
+        std::size_t ChangeTransform(ApplyFunction&& applyTransform)
+        {
+            ++m_transformVersion;
+            for (Slot slot : m_visibleSlots)
+            {
+                m_transformVersions[slot] = m_transformVersion;
+                applyTransform(m_models[slot]);
+            }
+
+            return m_visibleSlots.size();
+        }
+
+        std::size_t GetVisibleCount() const
+        {
+            return m_visibleSlots.size();
+        }
+
+    private:
+        void AddVisible(Slot slot)
+        {
+            if (m_visibleIndices[slot] == NOT_VISIBLE)
+            {
+                m_visibleIndices[slot] = static_cast<std::uint32_t>(m_visibleSlots.size());
+                m_visibleSlots.emplace_back(slot);
+            }
+        }
+
+        void RemoveVisible(Slot slot)
+        {
+            std::uint32_t visibleIndex = m_visibleIndices[slot];
+            if (visibleIndex == NOT_VISIBLE)
+            {
+                return;
+            }
+
+            Slot lastSlot = m_visibleSlots.back();
+            m_visibleSlots[visibleIndex] = lastSlot;
+            m_visibleIndices[lastSlot] = visibleIndex;
+            m_visibleSlots.pop_back();
+            m_visibleIndices[slot] = NOT_VISIBLE;
+        }
+
+        static constexpr std::uint32_t NOT_VISIBLE = ~std::uint32_t(0);
+
+        AZStd::vector<Model*> m_models;
+        AZStd::vector<std::uint64_t> m_transformVersions;
+        AZStd::vector<std::uint32_t> m_visibleIndices;
+        AZStd::vector<Slot> m_visibleSlots;
+        AZStd::vector<Slot> m_freeSlots;
+        std::uint64_t m_transformVersion{ 0 };
+    };
+} // namespace Cesium
@@ -7,6 +7,7 @@ namespace Cesium
 {
     TilesetCameraConfigurations::TilesetCameraConfigurations()
         : m_transform{ 1.0 }
+        , m_ecefTransform{ 1.0 }
     {
     }
 
@@ -20,6 +21,11 @@ namespace Cesium
         return m_transform;
     }
 
+    void TilesetCameraConfigurations::SetEcefTransform(const glm::dmat4& ecefTransform)
+    {
+        m_ecefTransform = ecefTransform;
+    }
+
     const std::vector<Cesium3DTilesSelection::ViewState>& TilesetCameraConfigurations::UpdateAndGetViewStates()
     {
         m_viewStates.clear();
@@ -44,6 +50,28 @@ namespace Cesium
         return m_viewStates;
     }
 
+    const std::vector<Cesium3DTilesSelection::ViewState>& TilesetCameraConfigurations::GetViewStatesWithPrefetch(
+        AZStd::span<const TilesetPrefetchView> prefetchViews)
+    {
+        m_viewStatesWithPrefetch.assign(m_viewStates.begin(), m_viewStates.end());
+        if (m_viewStates.empty())
+        {
+            return m_viewStatesWithPrefetch;
+        }
+
+        const Cesium3DTilesSelection::ViewState& camera = m_viewStates.front();
+        for (const TilesetPrefetchView& prefetchView : prefetchViews)
+        {
+            glm::dvec3 position = m_ecefTransform * glm::dvec4{ prefetchView.m_position, 1.0 };
+            glm::dvec3 direction = glm::normalize(glm::dvec3(m_ecefTransform * glm::dvec4{ prefetchView.m_direction, 0.0 }));
+            glm::dvec3 up = glm::normalize(glm::dvec3(m_ecefTransform * glm::dvec4{ prefetchView.m_up, 0.0 }));
+            m_viewStatesWithPrefetch.emplace_back(Cesium3DTilesSelection::ViewState::create(
+                position, direction, up, camera.getViewportSize(), camera.getHorizontalFieldOfView(), camera.getVerticalFieldOfView()));
+        }
+
+        return m_viewStatesWithPrefetch;
+    }
+
     Cesium3DTilesSelection::ViewState TilesetCameraConfigurations::GetViewState(
         const AZ::RPI::ViewportContextPtr& viewportContextPtr, const glm::dmat4& transform)
     {
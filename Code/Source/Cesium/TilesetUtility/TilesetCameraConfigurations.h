@@ -1,6 +1,8 @@
 #pragma once
 
+#include <Cesium/EBus/TilesetComponentBus.h>
 #include <Atom/RPI.Public/Base.h>
+#include <AzCore/std/containers/span.h>
 #include <Cesium3DTilesSelection/ViewState.h>
 #include <glm/glm.hpp>
 #include <vector>
@@ -16,14 +18,24 @@ namespace Cesium
 
         const glm::dmat4& GetTransform() const;
 
+        // transform from ECEF to the tileset, which places the prefetch views
+        void SetEcefTransform(const glm::dmat4& ecefTransform);
+
         const std::vector<Cesium3DTilesSelection::ViewState>& UpdateAndGetViewStates();
 
+        // the view states of the last UpdateAndGetViewStates, followed by one for each prefetch view. Prefetch views borrow
+        // the viewport and field of view of the first camera
+        const std::vector<Cesium3DTilesSelection::ViewState>& GetViewStatesWithPrefetch(
+            AZStd::span<const TilesetPrefetchView> prefetchViews);
+
     private:
         static Cesium3DTilesSelection::ViewState GetViewState(
             const AZ::RPI::ViewportContextPtr& viewportContextPtr, const glm::dmat4& transform);
 
         glm::dmat4 m_transform;
+        glm::dmat4 m_ecefTransform;
         std::vector<Cesium3DTilesSelection::ViewState> m_viewStates;
+        std::vector<Cesium3DTilesSelection::ViewState> m_viewStatesWithPrefetch;
     };
 
 } // namespace Cesium
\ No newline at end of file
@@ -16,7 +16,8 @@ namespace Cesium
                 ->Version(0)
                 ->Field("MouseSensitivity", &GeoReferenceCameraControllerEditor::m_mouseSensitivity)
                 ->Field("PanningSpeed", &GeoReferenceCameraControllerEditor::m_panningSpeed)
-                ->Field("MovementSpeed", &GeoReferenceCameraControllerEditor::m_movementSpeed);
+                ->Field("MovementSpeed", &GeoReferenceCameraControllerEditor::m_movementSpeed)
+                ->Field("PrefetchViewCount", &GeoReferenceCameraControllerEditor::m_prefetchViewCount);
 
             AZ::EditContext* editContext = serializeContext->GetEditContext();
             if (editContext)
@@ -34,7 +35,10 @@ namespace Cesium
                         AZ::Edit::UIHandlers::Default, &GeoReferenceCameraControllerEditor::m_mouseSensitivity, "Mouse Sensitivity", "")
                     ->DataElement(AZ::Edit::UIHandlers::Default, &GeoReferenceCameraControllerEditor::m_panningSpeed, "Panning Speed", "")
                     ->DataElement(
-                        AZ::Edit::UIHandlers::Default, &GeoReferenceCameraControllerEditor::m_movementSpeed, "Movement Speed", "");
+                        AZ::Edit::UIHandlers::Default, &GeoReferenceCameraControllerEditor::m_movementSpeed, "Movement Speed", "")
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default, &GeoReferenceCameraControllerEditor::m_prefetchViewCount, "Prefetch View Count",
+                        "Number of views along the remaining flight path whose tiles are loaded ahead of the camera. Zero disables it");
             }
         }
     }
@@ -68,6 +72,7 @@ namespace Cesium
         controller->SetMouseSensitivity(m_mouseSensitivity);
         controller->SetPanningSpeed(m_panningSpeed);
         controller->SetMovementSpeed(m_movementSpeed);
+        controller->SetPrefetchViewCount(m_prefetchViewCount);
         controller->Deactivate();
     }
 
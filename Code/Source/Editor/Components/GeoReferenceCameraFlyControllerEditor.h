@@ -37,5 +37,6 @@ namespace Cesium
         double m_mouseSensitivity{ 40.0 };
         double m_panningSpeed{ 5.0 };
         double m_movementSpeed{ 5.0 };
+        std::uint32_t m_prefetchViewCount{ 4 };
     };
 } // namespace Cesium
@@ -97,7 +97,20 @@ namespace Cesium
                         AZ::Edit::UIHandlers::Default, &TilesetConfiguration::m_loadingDescendantLimit, "Loading Descendant Limit", "")
                     ->DataElement(AZ::Edit::UIHandlers::CheckBox, &TilesetConfiguration::m_preloadAncestors, "Preload Ancestors", "")
                     ->DataElement(AZ::Edit::UIHandlers::CheckBox, &TilesetConfiguration::m_preloadSiblings, "Preload Siblings", "")
-                    ->DataElement(AZ::Edit::UIHandlers::CheckBox, &TilesetConfiguration::m_forbidHole, "Forbid Hole", "");
+                    ->DataElement(AZ::Edit::UIHandlers::CheckBox, &TilesetConfiguration::m_forbidHole, "Forbid Hole", "")
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default, &TilesetConfiguration::m_mainThreadLoadingTimeLimit, "Main Thread Loading Time Limit",
+                        "Milliseconds per frame spent creating render resources of loaded tiles. Zero disables the limit")
+                    ->Attribute(AZ::Edit::Attributes::Min, 0.0)
+                    ->Attribute(AZ::Edit::Attributes::Suffix, "ms")
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default, &TilesetConfiguration::m_prefetchMaximumRequests, "Prefetch Maximum Requests",
+                        "Requests in flight above which tiles of prefetch views are not requested. Zero disables prefetching")
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default, &TilesetConfiguration::m_prefetchCacheShare, "Prefetch Cache Share",
+                        "Share of the cache size prefetched tiles may use on top of it")
+                    ->Attribute(AZ::Edit::Attributes::Min, 0.0)
+                    ->Attribute(AZ::Edit::Attributes::Max, 1.0);
 
                 editContext->Class<TilesetRenderConfiguration>("Render", "")
                     ->ClassElement(AZ::Edit::ClassElements::EditorData, "")
@@ -105,7 +118,16 @@ namespace Cesium
                     ->Attribute(AZ::Edit::Attributes::AutoExpand, true)
                     ->DataElement(
                         AZ::Edit::UIHandlers::CheckBox, &TilesetRenderConfiguration::m_generateMissingNormalAsSmooth,
-                        "Generate Missing Normal As Smooth", "");
+                        "Generate Missing Normal As Smooth", "")
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::CheckBox, &TilesetRenderConfiguration::m_compactVertexLayout, "Compact Vertex Layout",
+                        "Store tile meshes with quantized positions, normals and UVs. This roughly halves their GPU memory")
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::ComboBox, &TilesetRenderConfiguration::m_textureCompression, "Texture Compression",
+                        "Block compress tile and raster textures while loading. Quality takes longer than Fast but keeps more detail")
+                    ->EnumAttribute(TilesetTextureCompression::None, "None")
+                    ->EnumAttribute(TilesetTextureCompression::Fast, "Fast")
+                    ->EnumAttribute(TilesetTextureCompression::Quality, "Quality");
             }
         }
     }
@@ -0,0 +1,221 @@
+#include "Cesium/Systems/CesiumScheduler.h"
+#include <AzCore/Jobs/JobContext.h>
+#include <AzCore/Jobs/JobManager.h>
+#include <AzCore/std/parallel/thread.h>
+#include <AzCore/UnitTest/TestTypes.h>
+#include <atomic>
+#include <functional>
+#include <future>
+#include <vector>
+
+class CesiumSchedulerTest : public UnitTest::LeakDetectionFixture
+{
+public:
+    void SetUp() override
+    {
+        UnitTest::LeakDetectionFixture::SetUp();
+    }
+
+    void TearDown() override
+    {
+        UnitTest::LeakDetectionFixture::TearDown();
+    }
+};
+
+TEST_F(CesiumSchedulerTest, RunTasksInBothLanes)
+{
+    Cesium::CesiumSchedulerConfiguration configuration;
+    configuration.m_ioLane.m_threadCount = 3;
+    configuration.m_computeLane.m_threadCount = 2;
+    Cesium::CesiumScheduler scheduler(configuration);
+    ASSERT_EQ(scheduler.GetThreadCount(Cesium::CesiumSchedulerLane::IO), 3u);
+    ASSERT_EQ(scheduler.GetThreadCount(Cesium::CesiumSchedulerLane::Compute), 2u);
+
+    std::promise<AZStd::thread::id> ioPromise;
+    std::promise<AZStd::thread::id> computePromise;
+    scheduler.Submit(
+        Cesium::CesiumSchedulerLane::IO,
+        [&ioPromise]()
+        {
+            ioPromise.set_value(AZStd::this_thread::get_id());
+        });
+    scheduler.Submit(
+        Cesium::CesiumSchedulerLane::Compute,
+        [&computePromise]()
+        {
+            computePromise.set_value(AZStd::this_thread::get_id());
+        });
+
+    AZStd::thread::id ioThread = ioPromise.get_future().get();
+    AZStd::thread::id computeThread = computePromise.get_future().get();
+    ASSERT_NE(ioThread, AZStd::this_thread::get_id());
+    ASSERT_NE(computeThread, AZStd::this_thread::get_id());
+    ASSERT_NE(ioThread, computeThread);
+}
+
+TEST_F(CesiumSchedulerTest, DrainWaitsForWorkHandedToOtherLanes)
+{
+    Cesium::CesiumSchedulerConfiguration configuration;
+    configuration.m_ioLane.m_threadCount = 2;
+    configuration.m_computeLane.m_threadCount = 2;
+    Cesium::CesiumScheduler scheduler(configuration);
+
+    // every task hands the next one to the other lane, so no lane is busy the whole time
+    std::atomic<int> completedTasks{ 0 };
+    std::function<void(int)> runChain = [&](int remainingTasks)
+    {
+        ++completedTasks;
+        if (remainingTasks > 0)
+        {
+            scheduler.Submit(
+                remainingTasks % 2 == 0 ? Cesium::CesiumSchedulerLane::IO : Cesium::CesiumSchedulerLane::Compute,
+                [&runChain, remainingTasks]()
+                {
+                    runChain(remainingTasks - 1);
+                });
+        }
+    };
+
+    scheduler.Submit(
+        Cesium::CesiumSchedulerLane::Compute,
+        [&runChain]()
+        {
+            runChain(20);
+        });
+    scheduler.Drain();
+    ASSERT_EQ(completedTasks.load(), 21);
+}
+
+TEST_F(CesiumSchedulerTest, FileLaneDoesNotWaitBehindIO)
+{
+    Cesium::CesiumSchedulerConfiguration configuration;
+    configuration.m_ioLane.m_threadCount = 1;
+    configuration.m_fileLane.m_threadCount = 1;
+    configuration.m_computeLane.m_threadCount = 1;
+    Cesium::CesiumScheduler scheduler(configuration);
+    ASSERT_EQ(scheduler.GetThreadCount(Cesium::CesiumSchedulerLane::File), 1u);
+
+    // occupy the only I/O worker until the file task has run
+    std::promise<void> filePromise;
+    std::shared_future<void> fileDone = filePromise.get_future().share();
+    scheduler.Submit(
+        Cesium::CesiumSchedulerLane::IO,
+        [fileDone]()
+        {
+            fileDone.wait();
+        });
+    scheduler.Submit(
+        Cesium::CesiumSchedulerLane::File,
+        [&filePromise]()
+        {
+            filePromise.set_value();
+        });
+
+    ASSERT_EQ(fileDone.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+}
+
+TEST_F(CesiumSchedulerTest, WaitForTaskGroup)
+{
+    Cesium::CesiumSchedulerConfiguration configuration;
+    configuration.m_computeLane.m_threadCount = 4;
+    Cesium::CesiumScheduler scheduler(configuration);
+
+    std::atomic<std::uint32_t> completedTasks{ 0 };
+    Cesium::CesiumSchedulerTaskGroup taskGroup;
+    for (std::uint32_t i = 0; i < 100; ++i)
+    {
+        scheduler.Submit(
+            Cesium::CesiumSchedulerLane::Compute,
+            [&completedTasks]()
+            {
+                completedTasks.fetch_add(1);
+            },
+            &taskGroup);
+    }
+
+    taskGroup.Wait();
+    ASSERT_EQ(completedTasks.load(), 100u);
+
+    auto statistics = scheduler.GetStatistics(Cesium::CesiumSchedulerLane::Compute);
+    ASSERT_EQ(statistics.m_threadCount, 4u);
+    ASSERT_EQ(statistics.m_queuedTasks, 0u);
+    ASSERT_EQ(statistics.m_completedTasks, 100u);
+    ASSERT_GE(statistics.m_utilization, 0.0f);
+    ASSERT_LE(statistics.m_utilization, 1.0f);
+}
+
+TEST_F(CesiumSchedulerTest, UseGlobalJobContext)
+{
+    AZ::JobManagerDesc managerDesc;
+    managerDesc.m_workerThreads.push_back(AZ::JobManagerThreadDesc());
+    managerDesc.m_workerThreads.push_back(AZ::JobManagerThreadDesc());
+    AZ::JobManager* jobManager = aznew AZ::JobManager(managerDesc);
+    AZ::JobContext* jobContext = aznew AZ::JobContext(*jobManager);
+    AZ::JobContext::SetGlobalContext(jobContext);
+
+    {
+        Cesium::CesiumSchedulerConfiguration configuration;
+        configuration.m_useGlobalJobContext = true;
+        Cesium::CesiumScheduler scheduler(configuration);
+        ASSERT_EQ(scheduler.GetThreadCount(Cesium::CesiumSchedulerLane::Compute), 2u);
+
+        std::promise<void> promise;
+        scheduler.Submit(
+            Cesium::CesiumSchedulerLane::Compute,
+            [&promise]()
+            {
+                promise.set_value();
+            });
+        promise.get_future().get();
+    }
+
+    AZ::JobContext::SetGlobalContext(nullptr);
+    delete jobContext;
+    delete jobManager;
+}
+
+TEST_F(CesiumSchedulerTest, ParallelForRunsEveryItemOnce)
+{
+    Cesium::CesiumSchedulerConfiguration configuration;
+    configuration.m_computeLane.m_threadCount = 4;
+    Cesium::CesiumScheduler scheduler(configuration);
+
+    std::vector<std::atomic<std::uint32_t>> runs(1000);
+    scheduler.ParallelFor(
+        Cesium::CesiumSchedulerLane::Compute,
+        runs.size(),
+        [&runs](std::size_t i)
+        {
+            runs[i].fetch_add(1);
+        });
+
+    for (const auto& run : runs)
+    {
+        ASSERT_EQ(run.load(), 1u);
+    }
+}
+
+TEST_F(CesiumSchedulerTest, NestedParallelForDoesNotDeadlock)
+{
+    // every worker waits on its own ParallelFor, so the inner items only finish because the callers run them
+    Cesium::CesiumSchedulerConfiguration configuration;
+    configuration.m_computeLane.m_threadCount = 2;
+    Cesium::CesiumScheduler scheduler(configuration);
+
+    std::atomic<std::uint32_t> completedItems{ 0 };
+    scheduler.ParallelFor(
+        Cesium::CesiumSchedulerLane::Compute,
+        8,
+        [&scheduler, &completedItems](std::size_t)
+        {
+            scheduler.ParallelFor(
+                Cesium::CesiumSchedulerLane::Compute,
+                16,
+                [&completedItems](std::size_t)
+                {
+                    completedItems.fetch_add(1);
+                });
+        });
+
+    ASSERT_EQ(completedItems.load(), 128u);
+}
@@ -0,0 +1,87 @@
+#include "Cesium/Systems/ContentAssetCache.h"
+#include <AzCore/Memory/SystemAllocator.h>
+#include <AzCore/UnitTest/TestTypes.h>
+#include <cstdint>
+
+namespace
+{
+    class TestContentAsset final : public AZ::Data::AssetData
+    {
+    public:
+        AZ_RTTI(TestContentAsset, "{F174137A-D981-420E-A64F-3BB417CC118E}", AZ::Data::AssetData);
+        AZ_CLASS_ALLOCATOR(TestContentAsset, AZ::SystemAllocator);
+
+        TestContentAsset()
+            : AZ::Data::AssetData(AZ::Data::AssetId(AZ::Uuid::CreateRandom()), AZ::Data::AssetData::AssetStatus::Ready)
+        {
+        }
+    };
+
+    AZ::Data::Asset<TestContentAsset> CreateTestAsset()
+    {
+        return AZ::Data::Asset<TestContentAsset>(aznew TestContentAsset(), AZ::Data::AssetLoadBehavior::Default);
+    }
+
+    Cesium::ContentKey HashValues(std::uint32_t first, std::uint32_t second)
+    {
+        Cesium::ContentHasher hasher;
+        hasher.AddValue(first);
+        hasher.AddValue(second);
+        return hasher.Finish();
+    }
+} // namespace
+
+class ContentAssetCacheTest : public UnitTest::LeakDetectionFixture
+{
+public:
+    void SetUp() override
+    {
+        UnitTest::LeakDetectionFixture::SetUp();
+    }
+
+    void TearDown() override
+    {
+        UnitTest::LeakDetectionFixture::TearDown();
+    }
+};
+
+TEST_F(ContentAssetCacheTest, TestSameContentHasSameKey)
+{
+    ASSERT_EQ(HashValues(1, 2), HashValues(1, 2));
+    ASSERT_NE(HashValues(1, 2), HashValues(2, 1));
+    ASSERT_EQ(HashValues(1, 2).size(), 40u);
+}
+
+TEST_F(ContentAssetCacheTest, TestStoreKeepsFirstAsset)
+{
+    Cesium::ContentAssetCache<TestContentAsset> cache;
+    Cesium::ContentKey key = HashValues(1, 2);
+    ASSERT_FALSE(cache.Find(key));
+
+    AZ::Data::Asset<TestContentAsset> first = CreateTestAsset();
+    AZ::Data::Asset<TestContentAsset> second = CreateTestAsset();
+    ASSERT_EQ(cache.Store(key, first).GetId(), first.GetId());
+
+    // a thread that built the same content later gets the asset stored first
+    ASSERT_EQ(cache.Store(key, second).GetId(), first.GetId());
+    ASSERT_EQ(cache.Find(key).GetId(), first.GetId());
+    ASSERT_EQ(cache.GetSize(), 1u);
+
+    cache.Clear();
+    ASSERT_EQ(cache.GetSize(), 0u);
+}
+
+TEST_F(ContentAssetCacheTest, TestReleaseUnreferencedKeepsAssetsInUse)
+{
+    Cesium::ContentAssetCache<TestContentAsset> cache;
+    Cesium::ContentKey usedKey = HashValues(1, 2);
+    Cesium::ContentKey unusedKey = HashValues(3, 4);
+    AZ::Data::Asset<TestContentAsset> used = cache.Store(usedKey, CreateTestAsset());
+    cache.Store(unusedKey, CreateTestAsset());
+    ASSERT_EQ(cache.GetSize(), 2u);
+
+    cache.ReleaseUnreferenced();
+    ASSERT_EQ(cache.GetSize(), 1u);
+    ASSERT_EQ(cache.Find(usedKey).GetId(), used.GetId());
+    ASSERT_FALSE(cache.Find(unusedKey));
+}
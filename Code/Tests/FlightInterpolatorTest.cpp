@@ -0,0 +1,79 @@
+#include "Cesium/Math/GeoReferenceInterpolator.h"
+#include "Cesium/Math/LinearInterpolator.h"
+#include <AzCore/UnitTest/TestTypes.h>
+#include <CesiumGeospatial/Cartographic.h>
+#include <CesiumGeospatial/Ellipsoid.h>
+
+namespace
+{
+    glm::dvec3 ToEcef(double longitudeDegrees, double latitudeDegrees, double height)
+    {
+        return CesiumGeospatial::Ellipsoid::WGS84.cartographicToCartesian(
+            CesiumGeospatial::Cartographic::fromDegrees(longitudeDegrees, latitudeDegrees, height));
+    }
+} // namespace
+
+class FlightInterpolatorTest : public UnitTest::LeakDetectionFixture
+{
+public:
+    void SetUp() override
+    {
+        UnitTest::LeakDetectionFixture::SetUp();
+    }
+
+    void TearDown() override
+    {
+        UnitTest::LeakDetectionFixture::TearDown();
+    }
+};
+
+TEST_F(FlightInterpolatorTest, TestSampleMatchesUpdate)
+{
+    glm::dvec3 begin = ToEcef(-75.0, 40.0, 100.0);
+    glm::dvec3 destination = ToEcef(-74.0, 41.0, 200.0);
+    Cesium::GeoReferenceInterpolator interpolator(begin, glm::dvec3{ 1.0, 0.0, 0.0 }, destination, glm::dvec3{ 0.0, 1.0, 0.0 });
+    while (!interpolator.IsStop())
+    {
+        interpolator.Update(0.25f);
+
+        glm::dvec3 position{};
+        glm::dquat orientation{};
+        interpolator.Sample(interpolator.GetProgress(), position, orientation);
+        ASSERT_EQ(position, interpolator.GetCurrentPosition());
+        ASSERT_EQ(orientation, interpolator.GetCurrentOrientation());
+    }
+
+    ASSERT_DOUBLE_EQ(interpolator.GetProgress(), 1.0);
+}
+
+TEST_F(FlightInterpolatorTest, TestSampleDoesNotMoveAlongTheFlight)
+{
+    glm::dvec3 begin = ToEcef(-75.0, 40.0, 100.0);
+    glm::dvec3 destination = ToEcef(10.0, 50.0, 100.0);
+    Cesium::GeoReferenceInterpolator interpolator(begin, glm::dvec3{ 1.0, 0.0, 0.0 }, destination, glm::dvec3{ 0.0, 1.0, 0.0 });
+    interpolator.Update(0.5f);
+    double progress = interpolator.GetProgress();
+    glm::dvec3 currentPosition = interpolator.GetCurrentPosition();
+
+    glm::dvec3 position{};
+    glm::dquat orientation{};
+    interpolator.Sample(1.0, position, orientation);
+    ASSERT_DOUBLE_EQ(interpolator.GetProgress(), progress);
+    ASSERT_EQ(interpolator.GetCurrentPosition(), currentPosition);
+    ASSERT_FALSE(interpolator.IsStop());
+}
+
+TEST_F(FlightInterpolatorTest, TestLinearSampleEndsAtDestination)
+{
+    glm::dvec3 begin{ 1000.0, 0.0, 0.0 };
+    glm::dvec3 destination{ 0.0, 2000.0, 500.0 };
+    Cesium::LinearInterpolator interpolator(begin, glm::dvec3{ 1.0, 0.0, 0.0 }, destination, glm::dvec3{ 0.0, 1.0, 0.0 });
+
+    glm::dvec3 position{};
+    glm::dquat orientation{};
+    interpolator.Sample(0.0, position, orientation);
+    ASSERT_EQ(position, begin);
+    interpolator.Sample(1.0, position, orientation);
+    ASSERT_EQ(position, destination);
+    ASSERT_DOUBLE_EQ(interpolator.GetProgress(), 0.0);
+}
@@ -0,0 +1,111 @@
+#include "Cesium/Gltf/GltfMipGenerator.h"
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzCore/std/containers/vector.h>
+#include <cstdint>
+
+class GltfMipGeneratorTest : public UnitTest::LeakDetectionFixture
+{
+public:
+    void SetUp() override
+    {
+        UnitTest::LeakDetectionFixture::SetUp();
+    }
+
+    void TearDown() override
+    {
+        UnitTest::LeakDetectionFixture::TearDown();
+    }
+
+    static std::uint8_t GetTexel(const AZStd::vector<std::byte>& pixels, const Cesium::GltfImageMip& mip, std::size_t index)
+    {
+        return static_cast<std::uint8_t>(pixels[mip.m_byteOffset + index]);
+    }
+};
+
+TEST_F(GltfMipGeneratorTest, TestMipsAreLaidOutDownToOneTexel)
+{
+    ASSERT_EQ(Cesium::GltfMipGenerator::GetMipCount(1, 1), 1u);
+    ASSERT_EQ(Cesium::GltfMipGenerator::GetMipCount(256, 256), 9u);
+    ASSERT_EQ(Cesium::GltfMipGenerator::GetMipCount(8, 2), 4u);
+    ASSERT_EQ(Cesium::GltfMipGenerator::GetMipCount(5, 3), 3u);
+
+    AZStd::vector<std::byte> pixels(8 * 2 * 4, std::byte{ 0 });
+    AZStd::vector<Cesium::GltfImageMip> mips = Cesium::GltfMipGenerator::GenerateMips(pixels, 8, 2, 4, true);
+    ASSERT_EQ(mips.size(), 4u);
+
+    static constexpr std::uint32_t expectedWidths[] = { 8, 4, 2, 1 };
+    std::size_t byteOffset = 0;
+    for (std::size_t i = 0; i < mips.size(); ++i)
+    {
+        ASSERT_EQ(mips[i].m_width, expectedWidths[i]);
+        ASSERT_EQ(mips[i].m_height, i == 0 ? 2u : 1u);
+        ASSERT_EQ(mips[i].m_byteOffset, byteOffset);
+        ASSERT_EQ(mips[i].m_byteSize, static_cast<std::size_t>(mips[i].m_width) * mips[i].m_height * 4);
+        byteOffset += mips[i].m_byteSize;
+    }
+
+    ASSERT_EQ(pixels.size(), byteOffset);
+}
+
+TEST_F(GltfMipGeneratorTest, TestLinearBoxFilter)
+{
+    // 3x3 texels halve to a single texel, which averages the top left 2x2 texels
+    AZStd::vector<std::byte> pixels{ std::byte{ 0 }, std::byte{ 1 }, std::byte{ 100 }, std::byte{ 2 }, std::byte{ 4 },
+                                     std::byte{ 100 }, std::byte{ 100 }, std::byte{ 100 }, std::byte{ 100 } };
+    AZStd::vector<Cesium::GltfImageMip> mips = Cesium::GltfMipGenerator::GenerateMips(pixels, 3, 3, 1, false);
+    ASSERT_EQ(mips.size(), 2u);
+    ASSERT_EQ(mips[1].m_width, 1u);
+    ASSERT_EQ(mips[1].m_height, 1u);
+
+    // (0 + 1 + 2 + 4) / 4 rounded to nearest
+    ASSERT_EQ(GetTexel(pixels, mips[1], 0), 2u);
+
+    // the top mip is left as it is
+    ASSERT_EQ(GetTexel(pixels, mips[0], 2), 100u);
+}
+
+TEST_F(GltfMipGeneratorTest, TestSrgbColorIsAveragedInLinearSpace)
+{
+    // black and white texels with transparent and opaque alpha
+    AZStd::vector<std::byte> texels;
+    for (std::uint8_t value : { 0, 255, 255, 0 })
+    {
+        texels.insert(texels.end(), { std::byte{ value }, std::byte{ value }, std::byte{ value }, std::byte{ value } });
+    }
+
+    AZStd::vector<std::byte> srgbPixels = texels;
+    AZStd::vector<Cesium::GltfImageMip> srgbMips = Cesium::GltfMipGenerator::GenerateMips(srgbPixels, 2, 2, 4, true);
+    AZStd::vector<std::byte> linearPixels = texels;
+    AZStd::vector<Cesium::GltfImageMip> linearMips = Cesium::GltfMipGenerator::GenerateMips(linearPixels, 2, 2, 4, false);
+    ASSERT_EQ(srgbMips.size(), 2u);
+    ASSERT_EQ(linearMips.size(), 2u);
+
+    // half of the light is 0.5 in linear space, which encodes to 188 in sRGB rather than the 128 of averaging the bytes
+    for (std::size_t c = 0; c < 3; ++c)
+    {
+        ASSERT_EQ(GetTexel(srgbPixels, srgbMips[1], c), 188u);
+        ASSERT_EQ(GetTexel(linearPixels, linearMips[1], c), 128u);
+    }
+
+    // alpha is coverage, so it is averaged as it is
+    ASSERT_EQ(GetTexel(srgbPixels, srgbMips[1], 3), 128u);
+    ASSERT_EQ(GetTexel(linearPixels, linearMips[1], 3), 128u);
+}
+
+TEST_F(GltfMipGeneratorTest, TestResizeInterpolatesBetweenTexelCenters)
+{
+    // a 2x1 ramp doubled to 4x1: the outer texels repeat the edges, the inner ones are a quarter of the way in
+    AZStd::vector<std::byte> pixels{ std::byte{ 0 }, std::byte{ 200 } };
+    AZStd::vector<std::byte> resized = Cesium::GltfMipGenerator::Resize(pixels.data(), 2, 1, 1, false, 4, 2);
+    ASSERT_EQ(resized.size(), 8u);
+
+    static constexpr std::uint8_t expectedRow[] = { 0, 50, 150, 200 };
+    for (std::size_t i = 0; i < resized.size(); ++i)
+    {
+        ASSERT_EQ(static_cast<std::uint8_t>(resized[i]), expectedRow[i % 4]);
+    }
+
+    // resizing to the same size leaves the texels as they are
+    AZStd::vector<std::byte> same = Cesium::GltfMipGenerator::Resize(pixels.data(), 2, 1, 1, true, 2, 1);
+    ASSERT_EQ(same, pixels);
+}
@@ -0,0 +1,268 @@
+#include "Cesium/Gltf/GltfTextureCompressor.h"
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzCore/std/containers/vector.h>
+#include <array>
+#include <cstdint>
+
+class GltfTextureCompressorTest : public UnitTest::LeakDetectionFixture
+{
+public:
+    void SetUp() override
+    {
+        UnitTest::LeakDetectionFixture::SetUp();
+    }
+
+    void TearDown() override
+    {
+        UnitTest::LeakDetectionFixture::TearDown();
+    }
+
+    static std::array<std::uint8_t, 3> DecodeRGB565(std::uint16_t color)
+    {
+        std::uint32_t r = (color >> 11) & 0x1F;
+        std::uint32_t g = (color >> 5) & 0x3F;
+        std::uint32_t b = color & 0x1F;
+        return { static_cast<std::uint8_t>((r << 3) | (r >> 2)), static_cast<std::uint8_t>((g << 2) | (g >> 4)),
+                 static_cast<std::uint8_t>((b << 3) | (b >> 2)) };
+    }
+
+    // decodes a block in the four color mode to 16 RGB pixels
+    static std::array<std::uint8_t, 48> DecodeBC1Block(const std::uint8_t* block)
+    {
+        std::uint16_t color0 = static_cast<std::uint16_t>(block[0] | (block[1] << 8));
+        std::uint16_t color1 = static_cast<std::uint16_t>(block[2] | (block[3] << 8));
+        std::array<std::array<std::uint8_t, 3>, 4> palette;
+        palette[0] = DecodeRGB565(color0);
+        palette[1] = DecodeRGB565(color1);
+        for (std::size_t c = 0; c < 3; ++c)
+        {
+            palette[2][c] = static_cast<std::uint8_t>((2 * palette[0][c] + palette[1][c]) / 3);
+            palette[3][c] = static_cast<std::uint8_t>((palette[0][c] + 2 * palette[1][c]) / 3);
+        }
+
+        std::uint32_t indices = block[4] | (block[5] << 8) | (block[6] << 16) | (static_cast<std::uint32_t>(block[7]) << 24);
+        std::array<std::uint8_t, 48> pixels;
+        for (std::size_t i = 0; i < 16; ++i)
+        {
+            const auto& color = palette[(indices >> (i * 2)) & 0x3];
+            pixels[i * 3] = color[0];
+            pixels[i * 3 + 1] = color[1];
+            pixels[i * 3 + 2] = color[2];
+        }
+
+        return pixels;
+    }
+
+    static std::array<std::uint8_t, 16> DecodeBC4Block(const std::uint8_t* block)
+    {
+        std::uint32_t value0 = block[0];
+        std::uint32_t value1 = block[1];
+        std::array<std::uint32_t, 8> palette{ value0, value1, 0, 0, 0, 0, 0, 255 };
+        if (value0 > value1)
+        {
+            for (std::uint32_t i = 1; i < 7; ++i)
+            {
+                palette[i + 1] = ((7 - i) * value0 + i * value1 + 3) / 7;
+            }
+        }
+        else
+        {
+            for (std::uint32_t i = 1; i < 5; ++i)
+            {
+                palette[i + 1] = ((5 - i) * value0 + i * value1 + 2) / 5;
+            }
+        }
+
+        std::uint64_t indices = 0;
+        for (std::size_t i = 0; i < 6; ++i)
+        {
+            indices |= static_cast<std::uint64_t>(block[2 + i]) << (i * 8);
+        }
+
+        std::array<std::uint8_t, 16> values;
+        for (std::size_t i = 0; i < 16; ++i)
+        {
+            values[i] = static_cast<std::uint8_t>(palette[(indices >> (i * 3)) & 0x7]);
+        }
+
+        return values;
+    }
+
+    static std::uint32_t SquaredError(const std::uint8_t* expected, const std::uint8_t* actual, std::size_t count)
+    {
+        std::uint32_t error = 0;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            std::int32_t difference = static_cast<std::int32_t>(expected[i]) - static_cast<std::int32_t>(actual[i]);
+            error += static_cast<std::uint32_t>(difference * difference);
+        }
+
+        return error;
+    }
+};
+
+TEST_F(GltfTextureCompressorTest, TestBC1BlockReproducesTwoColors)
+{
+    // black and white are exact in RGB565, so a block of only those two decodes losslessly
+    std::array<std::uint8_t, 64> rgba;
+    std::array<std::uint8_t, 48> expected;
+    for (std::size_t i = 0; i < 16; ++i)
+    {
+        std::uint8_t value = i % 3 == 0 ? 255 : 0;
+        rgba[i * 4] = rgba[i * 4 + 1] = rgba[i * 4 + 2] = value;
+        rgba[i * 4 + 3] = 255;
+        expected[i * 3] = expected[i * 3 + 1] = expected[i * 3 + 2] = value;
+    }
+
+    for (bool refine : { false, true })
+    {
+        std::array<std::uint8_t, 8> block;
+        Cesium::GltfTextureCompressor::EncodeBC1Block(rgba.data(), refine, block.data());
+
+        // the first endpoint must be the larger one, otherwise BC1 decodes the block in the three color mode
+        std::uint16_t color0 = static_cast<std::uint16_t>(block[0] | (block[1] << 8));
+        std::uint16_t color1 = static_cast<std::uint16_t>(block[2] | (block[3] << 8));
+        ASSERT_GT(color0, color1);
+        ASSERT_EQ(DecodeBC1Block(block.data()), expected);
+    }
+}
+
+TEST_F(GltfTextureCompressorTest, TestBC1QualityIsNotWorseThanFast)
+{
+    std::array<std::uint8_t, 64> rgba;
+    std::array<std::uint8_t, 48> rgb;
+    for (std::size_t i = 0; i < 16; ++i)
+    {
+        // the channels don't vary together, so the corners of their bounding box are poor endpoints
+        rgb[i * 3] = rgba[i * 4] = static_cast<std::uint8_t>(20 + i * 13);
+        rgb[i * 3 + 1] = rgba[i * 4 + 1] = static_cast<std::uint8_t>(200 - i * 7 + (i % 4) * 5);
+        rgb[i * 3 + 2] = rgba[i * 4 + 2] = static_cast<std::uint8_t>(90 + (i % 5) * 11);
+        rgba[i * 4 + 3] = 255;
+    }
+
+    std::array<std::uint8_t, 8> fastBlock;
+    std::array<std::uint8_t, 8> qualityBlock;
+    Cesium::GltfTextureCompressor::EncodeBC1Block(rgba.data(), false, fastBlock.data());
+    Cesium::GltfTextureCompressor::EncodeBC1Block(rgba.data(), true, qualityBlock.data());
+    std::uint32_t fastError = SquaredError(rgb.data(), DecodeBC1Block(fastBlock.data()).data(), rgb.size());
+    std::uint32_t qualityError = SquaredError(rgb.data(), DecodeBC1Block(qualityBlock.data()).data(), rgb.size());
+    ASSERT_LE(qualityError, fastError);
+}
+
+TEST_F(GltfTextureCompressorTest, TestBC4Block)
+{
+    // two values are always hit exactly by the endpoints
+    std::array<std::uint8_t, 16> twoValues;
+    for (std::size_t i = 0; i < 16; ++i)
+    {
+        twoValues[i] = i < 8 ? 10 : 240;
+    }
+
+    std::array<std::uint8_t, 8> block;
+    Cesium::GltfTextureCompressor::EncodeBC4Block(twoValues.data(), false, block.data());
+    ASSERT_EQ(DecodeBC4Block(block.data()), twoValues);
+
+    // with 0 and 255 in the block, the quality preset may use the mode that stores them exactly
+    std::array<std::uint8_t, 16> withExtremes;
+    for (std::size_t i = 0; i < 16; ++i)
+    {
+        withExtremes[i] = i == 0 ? 0 : (i == 15 ? 255 : static_cast<std::uint8_t>(100 + i * 2));
+    }
+
+    std::array<std::uint8_t, 8> fastBlock;
+    std::array<std::uint8_t, 8> qualityBlock;
+    Cesium::GltfTextureCompressor::EncodeBC4Block(withExtremes.data(), false, fastBlock.data());
+    Cesium::GltfTextureCompressor::EncodeBC4Block(withExtremes.data(), true, qualityBlock.data());
+    std::uint32_t fastError = SquaredError(withExtremes.data(), DecodeBC4Block(fastBlock.data()).data(), 16);
+    std::uint32_t qualityError = SquaredError(withExtremes.data(), DecodeBC4Block(qualityBlock.data()).data(), 16);
+    ASSERT_LT(qualityError, fastError);
+}
+
+TEST_F(GltfTextureCompressorTest, TestCompressRGBAPicksFormatByAlpha)
+{
+    static constexpr std::uint32_t width = 8;
+    static constexpr std::uint32_t height = 4;
+    AZStd::vector<std::byte> pixels(width * height * 4, std::byte{ 255 });
+    AZStd::vector<std::byte> compressed;
+    AZ::RHI::Format format = AZ::RHI::Format::Unknown;
+
+    // opaque images use BC1
+    ASSERT_TRUE(Cesium::GltfTextureCompressor::CompressRGBA(
+        pixels.data(), width, height, Cesium::GltfTextureCompression::Fast, compressed, format));
+    ASSERT_EQ(format, AZ::RHI::Format::BC1_UNORM_SRGB);
+    ASSERT_EQ(compressed.size(), 2 * Cesium::GltfTextureCompressor::BC1_BLOCK_BYTES);
+
+    // a single translucent pixel switches the whole image to BC3
+    pixels[7] = std::byte{ 128 };
+    ASSERT_TRUE(Cesium::GltfTextureCompressor::CompressRGBA(
+        pixels.data(), width, height, Cesium::GltfTextureCompression::Quality, compressed, format));
+    ASSERT_EQ(format, AZ::RHI::Format::BC3_UNORM_SRGB);
+    ASSERT_EQ(compressed.size(), 2 * Cesium::GltfTextureCompressor::BC3_BLOCK_BYTES);
+
+    // the alpha block comes first, and keeps the translucent pixel
+    std::array<std::uint8_t, 16> alpha = DecodeBC4Block(reinterpret_cast<const std::uint8_t*>(compressed.data()));
+    ASSERT_EQ(alpha[1], 128u);
+    ASSERT_EQ(alpha[0], 255u);
+}
+
+TEST_F(GltfTextureCompressorTest, TestCompressRejectsPartialBlocks)
+{
+    AZStd::vector<std::byte> pixels(6 * 4 * 4, std::byte{ 0 });
+    AZStd::vector<std::byte> compressed;
+    AZ::RHI::Format format = AZ::RHI::Format::Unknown;
+    ASSERT_FALSE(
+        Cesium::GltfTextureCompressor::CompressRGBA(pixels.data(), 6, 4, Cesium::GltfTextureCompression::Fast, compressed, format));
+    ASSERT_FALSE(
+        Cesium::GltfTextureCompressor::CompressR(pixels.data(), 4, 6, Cesium::GltfTextureCompression::Quality, compressed, format));
+    ASSERT_FALSE(
+        Cesium::GltfTextureCompressor::CompressR(pixels.data(), 4, 4, Cesium::GltfTextureCompression::None, compressed, format));
+    ASSERT_TRUE(compressed.empty());
+    ASSERT_EQ(format, AZ::RHI::Format::Unknown);
+
+    ASSERT_TRUE(
+        Cesium::GltfTextureCompressor::CompressR(pixels.data(), 4, 4, Cesium::GltfTextureCompression::Fast, compressed, format));
+    ASSERT_EQ(format, AZ::RHI::Format::BC4_UNORM);
+    ASSERT_EQ(compressed.size(), Cesium::GltfTextureCompressor::BC4_BLOCK_BYTES);
+}
+
+TEST_F(GltfTextureCompressorTest, TestCompressMipChain)
+{
+    // only the top mip needs whole blocks, the 2x2 and 1x1 mips are stored as a partial block each
+    AZStd::vector<std::byte> pixels(8 * 8 * 4, std::byte{ 255 });
+    AZStd::vector<Cesium::GltfImageMip> mips = Cesium::GltfMipGenerator::GenerateMips(pixels, 8, 8, 4, true);
+    AZStd::vector<std::byte> compressed;
+    AZStd::vector<Cesium::GltfImageMip> compressedMips;
+    AZ::RHI::Format format = AZ::RHI::Format::Unknown;
+    ASSERT_TRUE(Cesium::GltfTextureCompressor::CompressRGBA(
+        pixels.data(), mips, Cesium::GltfTextureCompression::Fast, true, compressed, compressedMips, format));
+    ASSERT_EQ(format, AZ::RHI::Format::BC1_UNORM_SRGB);
+    ASSERT_EQ(compressedMips.size(), 4u);
+
+    static constexpr std::size_t expectedBlocks[] = { 4, 1, 1, 1 };
+    std::size_t byteOffset = 0;
+    for (std::size_t i = 0; i < compressedMips.size(); ++i)
+    {
+        ASSERT_EQ(compressedMips[i].m_width, mips[i].m_width);
+        ASSERT_EQ(compressedMips[i].m_height, mips[i].m_height);
+        ASSERT_EQ(compressedMips[i].m_byteOffset, byteOffset);
+        ASSERT_EQ(compressedMips[i].m_byteSize, expectedBlocks[i] * Cesium::GltfTextureCompressor::BC1_BLOCK_BYTES);
+        byteOffset += compressedMips[i].m_byteSize;
+    }
+
+    ASSERT_EQ(compressed.size(), byteOffset);
+}
+
+TEST_F(GltfTextureCompressorTest, TestCompressLinearRGBA)
+{
+    // packed material channels are sampled as they are stored, so they must not be decoded as sRGB
+    AZStd::vector<std::byte> pixels(4 * 4 * 4, std::byte{ 255 });
+    pixels[3] = std::byte{ 0 };
+    AZStd::vector<Cesium::GltfImageMip> mips = Cesium::GltfMipGenerator::GenerateMips(pixels, 4, 4, 4, false);
+    AZStd::vector<std::byte> compressed;
+    AZStd::vector<Cesium::GltfImageMip> compressedMips;
+    AZ::RHI::Format format = AZ::RHI::Format::Unknown;
+    ASSERT_TRUE(Cesium::GltfTextureCompressor::CompressRGBA(
+        pixels.data(), mips, Cesium::GltfTextureCompression::Fast, false, compressed, compressedMips, format));
+    ASSERT_EQ(format, AZ::RHI::Format::BC3_UNORM);
+    ASSERT_EQ(compressedMips.size(), mips.size());
+}
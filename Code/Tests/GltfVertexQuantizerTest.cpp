@@ -0,0 +1,103 @@
+#include "Cesium/Gltf/GltfVertexQuantizer.h"
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzCore/std/containers/vector.h>
+#include <algorithm>
+#include <cmath>
+
+class GltfVertexQuantizerTest : public UnitTest::LeakDetectionFixture
+{
+public:
+    void SetUp() override
+    {
+        UnitTest::LeakDetectionFixture::SetUp();
+    }
+
+    void TearDown() override
+    {
+        UnitTest::LeakDetectionFixture::TearDown();
+    }
+
+    static float FromSnorm16(std::int16_t value)
+    {
+        return std::max(static_cast<float>(value) / 32767.0f, -1.0f);
+    }
+
+    static void AssertDirection(const glm::vec3& direction, const glm::vec3& expected, float tolerance)
+    {
+        ASSERT_NEAR(direction.x, expected.x, tolerance);
+        ASSERT_NEAR(direction.y, expected.y, tolerance);
+        ASSERT_NEAR(direction.z, expected.z, tolerance);
+    }
+};
+
+TEST_F(GltfVertexQuantizerTest, TestOctahedronRoundTrip)
+{
+    AZStd::vector<glm::vec3> directions{
+        { 0.0f, 0.0f, 1.0f },  { 0.0f, 0.0f, -1.0f }, { 1.0f, 0.0f, 0.0f },   { 0.0f, -1.0f, 0.0f },
+        { 1.0f, 2.0f, -3.0f }, { -4.0f, 1.0f, 0.5f }, { -1.0f, -1.0f, -1.0f }, { 0.3f, -0.2f, -0.9f },
+    };
+
+    for (const glm::vec3& direction : directions)
+    {
+        glm::vec3 expected = glm::normalize(direction);
+        glm::vec2 encoded = Cesium::GltfVertexQuantizer::EncodeOctahedron(expected);
+        ASSERT_LE(std::abs(encoded.x), 1.0f);
+        ASSERT_LE(std::abs(encoded.y), 1.0f);
+        AssertDirection(Cesium::GltfVertexQuantizer::DecodeOctahedron(encoded), expected, 1e-5f);
+    }
+}
+
+TEST_F(GltfVertexQuantizerTest, TestQuantizePositions)
+{
+    AZStd::vector<glm::vec3> positions{ { -2.0f, 1.0f, 3.0f }, { 2.0f, 2.0f, 3.0f }, { 0.0f, 1.5f, 3.0f } };
+    AZStd::vector<std::uint16_t> quantized(positions.size() * 4);
+    Cesium::GltfVertexQuantizer::QuantizePositions(
+        positions.data(), positions.size(), glm::vec3(-2.0f, 1.0f, 3.0f), 4.0f, quantized.data());
+
+    // positions are restored by minimum + quantized / 65535 * scale
+    for (std::size_t i = 0; i < positions.size(); ++i)
+    {
+        glm::vec3 restored =
+            glm::vec3(-2.0f, 1.0f, 3.0f) + glm::vec3(quantized[i * 4], quantized[i * 4 + 1], quantized[i * 4 + 2]) / 65535.0f * 4.0f;
+        AssertDirection(restored, positions[i], 4.0f / 65535.0f);
+        ASSERT_EQ(quantized[i * 4 + 3], 0u);
+    }
+
+    ASSERT_EQ(quantized[4], 65535u);
+    ASSERT_EQ(quantized[2], 0u);
+}
+
+TEST_F(GltfVertexQuantizerTest, TestEncodeNormalsAndTangents)
+{
+    AZStd::vector<glm::vec3> normals{ { 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, 1.0f }, { 0.0f, 1.0f, 0.0f } };
+    AZStd::vector<glm::vec4> tangents{ { 1.0f, 0.0f, 0.0f, 1.0f }, { 1.0f, 0.0f, 0.0f, -1.0f }, { 0.0f, -1.0f, 0.0f, -1.0f } };
+    AZStd::vector<std::int16_t> encoded(normals.size() * 4);
+    Cesium::GltfVertexQuantizer::EncodeNormalsAndTangents(normals.data(), tangents.data(), normals.size(), encoded.data());
+
+    // mirrors DecodeCompactVertexNormal in CompactVertexLayout.azsli
+    for (std::size_t i = 0; i < normals.size(); ++i)
+    {
+        glm::vec4 packed(FromSnorm16(encoded[i * 4]), FromSnorm16(encoded[i * 4 + 1]), FromSnorm16(encoded[i * 4 + 2]),
+                         FromSnorm16(encoded[i * 4 + 3]));
+        float bitangentSign = packed.w < 0.0f ? -1.0f : 1.0f;
+        glm::vec3 normal = Cesium::GltfVertexQuantizer::DecodeOctahedron(glm::vec2(packed.x, packed.y));
+        glm::vec3 tangent = Cesium::GltfVertexQuantizer::DecodeOctahedron(glm::vec2(packed.z, std::abs(packed.w) * 2.0f - 1.0f));
+        AssertDirection(normal, normals[i], 1e-3f);
+        AssertDirection(tangent, glm::vec3(tangents[i]), 1e-3f);
+        ASSERT_EQ(bitangentSign, tangents[i].w);
+    }
+}
+
+TEST_F(GltfVertexQuantizerTest, TestQuantizeUVs)
+{
+    AZStd::vector<glm::vec2> uvs{ { 0.0f, 1.0f }, { 0.5f, 0.25f } };
+    AZStd::vector<std::uint16_t> quantized(uvs.size() * 2);
+    ASSERT_TRUE(Cesium::GltfVertexQuantizer::QuantizeUVs(uvs.data(), uvs.size(), quantized.data()));
+    AZStd::vector<std::uint16_t> expected{ 0, 65535, 32768, 16384 };
+    ASSERT_EQ(quantized, expected);
+
+    // repeating UVs cannot be normalized
+    uvs.push_back(glm::vec2(1.5f, 0.0f));
+    quantized.resize(uvs.size() * 2);
+    ASSERT_FALSE(Cesium::GltfVertexQuantizer::QuantizeUVs(uvs.data(), uvs.size(), quantized.data()));
+}
@@ -0,0 +1,240 @@
+#include "Cesium/Gltf/GltfVertexStreamPacker.h"
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzCore/std/containers/vector.h>
+
+// Window 10 wingdi.h header defines OPAQUE macro which mess up with CesiumGltf::Material::AlphaMode::OPAQUE.
+// This only happens with unity build
+#include <AzCore/PlatformDef.h>
+#ifdef AZ_COMPILER_MSVC
+#pragma push_macro("OPAQUE")
+#undef OPAQUE
+#endif
+
+#include <CesiumGltf/Model.h>
+
+#ifdef AZ_COMPILER_MSVC
+#pragma pop_macro("OPAQUE")
+#endif
+
+#include <algorithm>
+
+class GltfVertexStreamPackerTest : public UnitTest::LeakDetectionFixture
+{
+public:
+    void SetUp() override
+    {
+        UnitTest::LeakDetectionFixture::SetUp();
+    }
+
+    void TearDown() override
+    {
+        UnitTest::LeakDetectionFixture::TearDown();
+    }
+
+    // appends the values to a new bufferView. A non zero stride leaves the bytes after each element as padding
+    template<typename T>
+    static std::int32_t AddBufferView(CesiumGltf::Model& model, const std::vector<T>& values, std::int64_t stride = 0)
+    {
+        if (model.buffers.empty())
+        {
+            model.buffers.emplace_back();
+        }
+
+        std::vector<std::byte>& data = model.buffers.front().cesium.data;
+        CesiumGltf::BufferView& bufferView = model.bufferViews.emplace_back();
+        bufferView.buffer = 0;
+        bufferView.byteOffset = static_cast<std::int64_t>(data.size());
+        bufferView.byteLength = static_cast<std::int64_t>(values.size() * sizeof(T));
+        data.insert(
+            data.end(), reinterpret_cast<const std::byte*>(values.data()), reinterpret_cast<const std::byte*>(values.data() + values.size()));
+        if (stride > 0)
+        {
+            bufferView.byteStride = stride;
+        }
+
+        return static_cast<std::int32_t>(model.bufferViews.size() - 1);
+    }
+
+    static CesiumGltf::Accessor& AddAccessor(
+        CesiumGltf::Model& model,
+        std::int32_t bufferView,
+        std::int32_t componentType,
+        const std::string& type,
+        std::int64_t count,
+        bool normalized = false)
+    {
+        CesiumGltf::Accessor& accessor = model.accessors.emplace_back();
+        accessor.bufferView = bufferView;
+        accessor.componentType = componentType;
+        accessor.type = type;
+        accessor.count = count;
+        accessor.normalized = normalized;
+        return accessor;
+    }
+};
+
+TEST_F(GltfVertexStreamPackerTest, TestPackTightlyPackedFloat3)
+{
+    CesiumGltf::Model model;
+    std::vector<float> positions{ 0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f };
+    std::int32_t bufferView = AddBufferView(model, positions);
+    const CesiumGltf::Accessor& accessor =
+        AddAccessor(model, bufferView, CesiumGltf::AccessorSpec::ComponentType::FLOAT, CesiumGltf::AccessorSpec::Type::VEC3, 3);
+
+    Cesium::GltfAccessorStream stream = Cesium::GltfVertexStreamPacker::GetAccessorStream(model, accessor);
+    ASSERT_TRUE(stream.IsValid());
+    ASSERT_EQ(stream.m_count, 3u);
+    ASSERT_EQ(stream.m_stride, 12u);
+
+    AZStd::vector<float> packed(9, -1.0f);
+    Cesium::GltfVertexStreamPacker::Pack(stream, AZ::RHI::Format::R32G32B32_FLOAT, reinterpret_cast<std::byte*>(packed.data()));
+    for (std::size_t i = 0; i < positions.size(); ++i)
+    {
+        ASSERT_EQ(packed[i], positions[i]);
+    }
+}
+
+TEST_F(GltfVertexStreamPackerTest, TestPackInterleavedFloat3)
+{
+    // positions interleaved with a float2 uv, so elements are 20 bytes apart
+    CesiumGltf::Model model;
+    std::vector<float> vertices{ 0.0f, 1.0f, 2.0f, 0.5f, 0.5f, 3.0f, 4.0f, 5.0f, 0.25f, 0.25f };
+    std::int32_t bufferView = AddBufferView(model, vertices, 20);
+    CesiumGltf::Accessor& uvAccessor =
+        AddAccessor(model, bufferView, CesiumGltf::AccessorSpec::ComponentType::FLOAT, CesiumGltf::AccessorSpec::Type::VEC2, 2);
+    uvAccessor.byteOffset = 12;
+    const CesiumGltf::Accessor& positionAccessor =
+        AddAccessor(model, bufferView, CesiumGltf::AccessorSpec::ComponentType::FLOAT, CesiumGltf::AccessorSpec::Type::VEC3, 2);
+
+    Cesium::GltfAccessorStream positions = Cesium::GltfVertexStreamPacker::GetAccessorStream(model, positionAccessor);
+    ASSERT_TRUE(positions.IsValid());
+    ASSERT_EQ(positions.m_stride, 20u);
+
+    AZStd::vector<float> packedPositions(6, -1.0f);
+    Cesium::GltfVertexStreamPacker::PackFloat(positions, 3, packedPositions.data());
+    AZStd::vector<float> expectedPositions{ 0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f };
+    ASSERT_EQ(packedPositions, expectedPositions);
+
+    Cesium::GltfAccessorStream uvs = Cesium::GltfVertexStreamPacker::GetAccessorStream(model, model.accessors[0]);
+    ASSERT_TRUE(uvs.IsValid());
+
+    AZStd::vector<float> packedUvs(4, -1.0f);
+    Cesium::GltfVertexStreamPacker::PackFloat(uvs, 2, packedUvs.data());
+    AZStd::vector<float> expectedUvs{ 0.5f, 0.5f, 0.25f, 0.25f };
+    ASSERT_EQ(packedUvs, expectedUvs);
+}
+
+TEST_F(GltfVertexStreamPackerTest, TestPackNormalizedComponents)
+{
+    // enough components to go through the SIMD kernels and the scalar tail
+    CesiumGltf::Model model;
+    std::vector<std::uint16_t> unsignedShorts;
+    std::vector<std::int8_t> signedBytes;
+    for (std::int32_t i = 0; i < 33; ++i)
+    {
+        unsignedShorts.push_back(static_cast<std::uint16_t>(i * 2000));
+        signedBytes.push_back(static_cast<std::int8_t>(i * 8 - 128));
+    }
+
+    std::int32_t shortBufferView = AddBufferView(model, unsignedShorts);
+    std::int32_t byteBufferView = AddBufferView(model, signedBytes);
+    AddAccessor(
+        model, shortBufferView, CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_SHORT, CesiumGltf::AccessorSpec::Type::VEC3, 11, true);
+    AddAccessor(model, byteBufferView, CesiumGltf::AccessorSpec::ComponentType::BYTE, CesiumGltf::AccessorSpec::Type::VEC3, 11, true);
+
+    Cesium::GltfAccessorStream shorts = Cesium::GltfVertexStreamPacker::GetAccessorStream(model, model.accessors[0]);
+    ASSERT_TRUE(Cesium::GltfVertexStreamPacker::CanPackFloat(shorts));
+
+    AZStd::vector<float> packed(33);
+    Cesium::GltfVertexStreamPacker::PackFloat(shorts, 3, packed.data());
+    for (std::size_t i = 0; i < packed.size(); ++i)
+    {
+        ASSERT_NEAR(packed[i], static_cast<float>(unsignedShorts[i]) / 65535.0f, 1e-6f);
+    }
+
+    Cesium::GltfAccessorStream bytes = Cesium::GltfVertexStreamPacker::GetAccessorStream(model, model.accessors[1]);
+    ASSERT_TRUE(Cesium::GltfVertexStreamPacker::CanPackFloat(bytes));
+
+    Cesium::GltfVertexStreamPacker::PackFloat(bytes, 3, packed.data());
+    for (std::size_t i = 0; i < packed.size(); ++i)
+    {
+        ASSERT_NEAR(packed[i], std::max(static_cast<float>(signedBytes[i]) / 127.0f, -1.0f), 1e-6f);
+    }
+}
+
+TEST_F(GltfVertexStreamPackerTest, TestPackGatheredByIndices)
+{
+    CesiumGltf::Model model;
+    std::vector<std::uint8_t> uvs{ 0, 1, 10, 11, 20, 21 };
+    std::int32_t bufferView = AddBufferView(model, uvs);
+    AddAccessor(model, bufferView, CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_BYTE, CesiumGltf::AccessorSpec::Type::VEC2, 3, true);
+
+    Cesium::GltfAccessorStream stream = Cesium::GltfVertexStreamPacker::GetAccessorStream(model, model.accessors[0]);
+    ASSERT_TRUE(stream.IsValid());
+
+    // normalized UVs keep their format, so they are copied as they are stored
+    std::uint32_t indices[] = { 2, 0, 1, 2 };
+    AZStd::vector<std::uint8_t> packed(8);
+    Cesium::GltfVertexStreamPacker::Pack(stream, AZ::RHI::Format::R8G8_UNORM, reinterpret_cast<std::byte*>(packed.data()), indices, 4);
+    AZStd::vector<std::uint8_t> expected{ 20, 21, 0, 1, 10, 11, 20, 21 };
+    ASSERT_EQ(packed, expected);
+}
+
+TEST_F(GltfVertexStreamPackerTest, TestPackIndices)
+{
+    CesiumGltf::Model model;
+    std::vector<std::uint16_t> indices;
+    for (std::uint16_t i = 0; i < 21; ++i)
+    {
+        indices.push_back(static_cast<std::uint16_t>(60000 + i));
+    }
+
+    std::int32_t bufferView = AddBufferView(model, indices);
+    AddAccessor(model, bufferView, CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_SHORT, CesiumGltf::AccessorSpec::Type::SCALAR, 21);
+
+    Cesium::GltfAccessorStream stream = Cesium::GltfVertexStreamPacker::GetAccessorStream(model, model.accessors[0]);
+    ASSERT_TRUE(Cesium::GltfVertexStreamPacker::CanPackIndices(stream));
+
+    AZStd::vector<std::uint32_t> packed(indices.size());
+    Cesium::GltfVertexStreamPacker::PackIndices(stream, packed.data());
+    for (std::size_t i = 0; i < indices.size(); ++i)
+    {
+        ASSERT_EQ(packed[i], static_cast<std::uint32_t>(indices[i]));
+    }
+}
+
+TEST_F(GltfVertexStreamPackerTest, TestPackIndicesAs16Bit)
+{
+    CesiumGltf::Model model;
+    std::vector<std::uint32_t> indices{ 0, 1, 65534, 70000 };
+    std::vector<std::uint8_t> byteIndices{ 3, 2, 1 };
+    std::int32_t bufferView = AddBufferView(model, indices);
+    AddAccessor(model, bufferView, CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_INT, CesiumGltf::AccessorSpec::Type::SCALAR, 4);
+    std::int32_t byteBufferView = AddBufferView(model, byteIndices);
+    AddAccessor(model, byteBufferView, CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_BYTE, CesiumGltf::AccessorSpec::Type::SCALAR, 3);
+
+    // int indices that do not fit saturate
+    AZStd::vector<std::uint16_t> packed(4);
+    Cesium::GltfVertexStreamPacker::PackIndices(
+        Cesium::GltfVertexStreamPacker::GetAccessorStream(model, model.accessors[0]), packed.data());
+    AZStd::vector<std::uint16_t> expected{ 0, 1, 65534, 65535 };
+    ASSERT_EQ(packed, expected);
+
+    packed.resize(3);
+    Cesium::GltfVertexStreamPacker::PackIndices(
+        Cesium::GltfVertexStreamPacker::GetAccessorStream(model, model.accessors[1]), packed.data());
+    AZStd::vector<std::uint16_t> expectedBytes{ 3, 2, 1 };
+    ASSERT_EQ(packed, expectedBytes);
+}
+
+TEST_F(GltfVertexStreamPackerTest, TestAccessorOutsideBufferView)
+{
+    CesiumGltf::Model model;
+    std::vector<float> positions{ 0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f };
+    std::int32_t bufferView = AddBufferView(model, positions);
+    AddAccessor(model, bufferView, CesiumGltf::AccessorSpec::ComponentType::FLOAT, CesiumGltf::AccessorSpec::Type::VEC3, 3);
+    AddAccessor(model, 5, CesiumGltf::AccessorSpec::ComponentType::FLOAT, CesiumGltf::AccessorSpec::Type::VEC3, 1);
+
+    ASSERT_FALSE(Cesium::GltfVertexStreamPacker::GetAccessorStream(model, model.accessors[0]).IsValid());
+    ASSERT_FALSE(Cesium::GltfVertexStreamPacker::GetAccessorStream(model, model.accessors[1]).IsValid());
+}
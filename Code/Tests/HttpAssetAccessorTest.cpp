@@ -47,3 +47,79 @@ TEST_F(HttpAssetAccessorTest, TestPost)
     ASSERT_EQ(completedRequest->response()->statusCode(), 200);
     ASSERT_EQ(completedRequest->method(), "POST");
 }
+
+TEST_F(HttpAssetAccessorTest, TestRequestScopeStatistics)
+{
+    // we don't care about worker thread in this test
+    CesiumAsync::AsyncSystem asyncSystem{ nullptr };
+    Cesium::HttpManager httpManager;
+
+    Cesium::HttpAssetAccessor accessor(&httpManager);
+    accessor.BeginRequestScope(1, 0);
+    auto completedRequestFuture = accessor.requestAsset(asyncSystem, "https://httpbin.org/ip");
+    accessor.EndRequestScope();
+    auto completedRequest = completedRequestFuture.wait();
+    ASSERT_NE(completedRequest, nullptr);
+
+    Cesium::HttpRequestScopeStatistics statistics = accessor.GetRequestScopeStatistics(1);
+    ASSERT_EQ(statistics.m_inFlightRequests, 0u);
+    ASSERT_EQ(statistics.m_completedRequests, 1u);
+
+    // requests made outside of the scope are not counted
+    accessor.requestAsset(asyncSystem, "https://httpbin.org/ip").wait();
+    statistics = accessor.GetRequestScopeStatistics(1);
+    ASSERT_EQ(statistics.m_completedRequests, 1u);
+
+    // the count is dropped once the scope is cancelled
+    accessor.CancelRequestScope(1);
+    statistics = accessor.GetRequestScopeStatistics(1);
+    ASSERT_EQ(statistics.m_completedRequests, 0u);
+
+    // a scope that is cancelled while its request is in flight is gone once the request finishes
+    accessor.BeginRequestScope(2, 0);
+    auto cancelledRequestFuture = accessor.requestAsset(asyncSystem, "https://httpbin.org/ip");
+    accessor.EndRequestScope();
+    accessor.CancelRequestScope(2);
+    ASSERT_NE(cancelledRequestFuture.wait(), nullptr);
+    statistics = accessor.GetRequestScopeStatistics(2);
+    ASSERT_EQ(statistics.m_inFlightRequests, 0u);
+    ASSERT_EQ(statistics.m_completedRequests, 0u);
+}
+
+TEST_F(HttpAssetAccessorTest, TestRequestScopeGuard)
+{
+    // requests outside of any scope have the neutral priority
+    Cesium::HttpAssetAccessor::RequestScope requestScope = Cesium::HttpAssetAccessor::GetCurrentRequestScope();
+    ASSERT_EQ(requestScope.m_scopeId, 0u);
+    ASSERT_EQ(requestScope.m_priority, Cesium::HttpAssetAccessor::DEFAULT_REQUEST_PRIORITY);
+
+    {
+        Cesium::HttpAssetAccessor::RequestScopeGuard scopeGuard({ 3, 7 });
+        requestScope = Cesium::HttpAssetAccessor::GetCurrentRequestScope();
+        ASSERT_EQ(requestScope.m_scopeId, 3u);
+        ASSERT_EQ(requestScope.m_priority, 7);
+    }
+
+    // the previous scope is current again once the guard is gone
+    requestScope = Cesium::HttpAssetAccessor::GetCurrentRequestScope();
+    ASSERT_EQ(requestScope.m_scopeId, 0u);
+}
+
+TEST_F(HttpAssetAccessorTest, TestCancelledScopeCancelsFollowUpRequests)
+{
+    // we don't care about worker thread in this test
+    CesiumAsync::AsyncSystem asyncSystem{ nullptr };
+    Cesium::HttpManager httpManager;
+
+    Cesium::HttpAssetAccessor accessor(&httpManager);
+    accessor.BeginRequestScope(4, 0);
+    accessor.EndRequestScope();
+    accessor.CancelRequestScope(4);
+
+    // a continuation of the cancelled scope requests more content, e.g. a subtree
+    Cesium::HttpAssetAccessor::RequestScopeGuard scopeGuard({ 4, 0 });
+    auto cancelledRequest = accessor.requestAsset(asyncSystem, "https://httpbin.org/ip").wait();
+    ASSERT_NE(cancelledRequest, nullptr);
+    ASSERT_EQ(cancelledRequest->response(), nullptr);
+    ASSERT_EQ(accessor.GetRequestScopeStatistics(4).m_inFlightRequests, 0u);
+}
@@ -1,6 +1,17 @@
+#include "Cesium/Systems/HttpContentDecoder.h"
 #include "Cesium/Systems/HttpManager.h"
+#include "Cesium/Systems/HttpResponseBodyStream.h"
 #include <AzCore/Memory/PoolAllocator.h>
 #include <AzCore/UnitTest/TestTypes.h>
+#include <aws/core/utils/memory/stl/AWSStringStream.h>
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <zlib.h>
+
+#if defined(HAVE_BENCHMARK)
+#include <benchmark/benchmark.h>
+#endif
 
 class HttpManagerTest : public UnitTest::LeakDetectionFixture
 {
@@ -30,6 +41,137 @@ TEST_F(HttpManagerTest, AddValidRequest)
     ASSERT_EQ(completedRequest.m_request->GetMethod(), Aws::Http::HttpMethod::HTTP_GET);
 }
 
+TEST_F(HttpManagerTest, CancelRequest)
+{
+    // we don't care about worker thread in this test
+    CesiumAsync::AsyncSystem asyncSystem{ nullptr };
+    Cesium::HttpManagerConfiguration configuration;
+    configuration.m_maxInFlightRequests = 1;
+    Cesium::HttpManager httpManager(configuration);
+
+    Cesium::HttpRequestParameter slowParameter("https://httpbin.org/delay/1", Aws::Http::HttpMethod::HTTP_GET);
+    auto slowRequestFuture = httpManager.AddRequest(asyncSystem, std::move(slowParameter));
+
+    Cesium::HttpRequestParameter parameter("https://httpbin.org/ip", Aws::Http::HttpMethod::HTTP_GET);
+    parameter.m_requestId = Cesium::HttpManager::GenerateRequestId();
+    Cesium::HttpRequestId requestId = parameter.m_requestId;
+    auto cancelledRequestFuture = httpManager.AddRequest(asyncSystem, std::move(parameter));
+    ASSERT_TRUE(httpManager.CancelRequest(requestId));
+
+    auto cancelledRequest = cancelledRequestFuture.wait();
+    ASSERT_TRUE(cancelledRequest.m_cancelled);
+    ASSERT_EQ(cancelledRequest.m_response, nullptr);
+    ASSERT_FALSE(httpManager.CancelRequest(requestId));
+
+    auto slowRequest = slowRequestFuture.wait();
+    ASSERT_FALSE(slowRequest.m_cancelled);
+}
+
+TEST_F(HttpManagerTest, ShutdownCancelsQueuedAndNewRequests)
+{
+    // we don't care about worker thread in this test
+    CesiumAsync::AsyncSystem asyncSystem{ nullptr };
+    Cesium::HttpManagerConfiguration configuration;
+    configuration.m_maxInFlightRequests = 1;
+    Cesium::HttpManager httpManager(configuration);
+
+    Cesium::HttpRequestParameter slowParameter("https://httpbin.org/delay/1", Aws::Http::HttpMethod::HTTP_GET);
+    auto slowRequestFuture = httpManager.AddRequest(asyncSystem, std::move(slowParameter));
+    Cesium::HttpRequestParameter queuedParameter("https://httpbin.org/ip", Aws::Http::HttpMethod::HTTP_GET);
+    auto queuedRequestFuture = httpManager.AddRequest(asyncSystem, std::move(queuedParameter));
+
+    httpManager.Shutdown();
+    ASSERT_TRUE(queuedRequestFuture.wait().m_cancelled);
+
+    Cesium::HttpRequestParameter newParameter("https://httpbin.org/ip", Aws::Http::HttpMethod::HTTP_GET);
+    ASSERT_TRUE(httpManager.AddRequest(asyncSystem, std::move(newParameter)).wait().m_cancelled);
+    slowRequestFuture.wait();
+}
+
+TEST_F(HttpManagerTest, ResponseBodyStream)
+{
+    Cesium::HttpResponseBodyStream stream;
+    stream.Reserve(16);
+    stream.write("tile", 4);
+    stream.write(" content", 8);
+
+    Cesium::IOContent content = stream.TakeContent();
+    ASSERT_EQ(content.size(), 12u);
+    ASSERT_EQ(std::memcmp(content.data(), "tile content", content.size()), 0);
+}
+
+TEST_F(HttpManagerTest, ResponseBodyStreamDecodesGzip)
+{
+    std::string text(100000, 'a');
+    for (std::size_t i = 0; i < text.size(); i += 7)
+    {
+        text[i] = 'b';
+    }
+
+    z_stream zs;
+    std::memset(&zs, 0, sizeof(zs));
+    ASSERT_EQ(deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, MAX_WBITS + 16, 8, Z_DEFAULT_STRATEGY), Z_OK);
+    Cesium::IOContent encoded(deflateBound(&zs, static_cast<uLong>(text.size())));
+    zs.next_in = reinterpret_cast<Bytef*>(text.data());
+    zs.avail_in = static_cast<uInt>(text.size());
+    zs.next_out = reinterpret_cast<Bytef*>(encoded.data());
+    zs.avail_out = static_cast<uInt>(encoded.size());
+    ASSERT_EQ(deflate(&zs, Z_FINISH), Z_STREAM_END);
+    encoded.resize(zs.total_out);
+    deflateEnd(&zs);
+
+    // the encoding is only known after the first chunk arrives
+    Cesium::HttpResponseBodyStream stream;
+    stream.write(reinterpret_cast<const char*>(encoded.data()), 10);
+    stream.SetContentEncoding("gzip");
+    stream.Reserve(encoded.size());
+    for (std::size_t offset = 10; offset < encoded.size(); offset += 100)
+    {
+        std::size_t count = std::min<std::size_t>(100, encoded.size() - offset);
+        stream.write(reinterpret_cast<const char*>(encoded.data() + offset), static_cast<std::streamsize>(count));
+    }
+
+    Cesium::IOContent content = stream.TakeContent();
+    ASSERT_EQ(content.size(), text.size());
+    ASSERT_EQ(std::memcmp(content.data(), text.data(), text.size()), 0);
+    ASSERT_EQ(Cesium::HttpContentDecoder::GetDecodedSizeHint(encoded), text.size());
+}
+
+TEST_F(HttpManagerTest, DecodeGzipMembersSplitAtChunkBoundary)
+{
+    auto gzip = [](const std::string& text)
+    {
+        z_stream zs;
+        std::memset(&zs, 0, sizeof(zs));
+        deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, MAX_WBITS + 16, 8, Z_DEFAULT_STRATEGY);
+        Cesium::IOContent encoded(deflateBound(&zs, static_cast<uLong>(text.size())));
+        zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(text.data()));
+        zs.avail_in = static_cast<uInt>(text.size());
+        zs.next_out = reinterpret_cast<Bytef*>(encoded.data());
+        zs.avail_out = static_cast<uInt>(encoded.size());
+        deflate(&zs, Z_FINISH);
+        encoded.resize(zs.total_out);
+        deflateEnd(&zs);
+        return encoded;
+    };
+
+    Cesium::IOContent encoded = gzip("first member ");
+    std::size_t firstMemberSize = encoded.size();
+    Cesium::IOContent secondMember = gzip("second member");
+    encoded.insert(encoded.end(), secondMember.begin(), secondMember.end());
+
+    // the first chunk ends exactly at the end of the first member, or within the magic bytes of the second one
+    for (std::size_t split : { firstMemberSize, firstMemberSize + 1 })
+    {
+        Cesium::HttpContentDecoder decoder("gzip");
+        Cesium::IOContent content;
+        ASSERT_TRUE(decoder.Decode(encoded.data(), split, content));
+        ASSERT_TRUE(decoder.Decode(encoded.data() + split, encoded.size() - split, content));
+        ASSERT_TRUE(decoder.IsFinished());
+        ASSERT_EQ(std::string(reinterpret_cast<const char*>(content.data()), content.size()), "first member second member");
+    }
+}
+
 TEST_F(HttpManagerTest, GetParentPath)
 {
     // we don't care about io thread in this test
@@ -64,3 +206,95 @@ TEST_F(HttpManagerTest, GetFileContentAsync)
 
     ASSERT_FALSE(content.empty());
 }
+
+#if defined(HAVE_BENCHMARK)
+namespace Benchmark
+{
+    // Compares reading the response body back out of the default AWS string stream in 256 bytes steps with
+    // writing it directly into the preallocated IOContent of HttpResponseBodyStream
+    class HttpResponseBodyBenchmark : public ::benchmark::Fixture
+    {
+    public:
+        void SetUp(const ::benchmark::State& state) override
+        {
+            m_body.resize(static_cast<std::size_t>(state.range(0)));
+            for (std::size_t i = 0; i < m_body.size(); ++i)
+            {
+                m_body[i] = static_cast<char>(i);
+            }
+        }
+
+        void TearDown([[maybe_unused]] const ::benchmark::State& state) override
+        {
+            m_body = {};
+        }
+
+        // http clients hand the body to the response stream in chunks of at most 16 KB
+        void WriteBody(Aws::IOStream& stream) const
+        {
+            constexpr std::size_t chunkSize = 16384;
+            for (std::size_t offset = 0; offset < m_body.size(); offset += chunkSize)
+            {
+                std::size_t count = std::min(chunkSize, m_body.size() - offset);
+                stream.write(m_body.data() + offset, static_cast<std::streamsize>(count));
+            }
+        }
+
+        static Cesium::IOContent ReadWithFixedSizeLoop(Aws::IOStream& stream)
+        {
+            std::size_t readSoFar = 0;
+            const std::size_t maxRead = 256;
+            Cesium::IOContent content;
+            while (stream)
+            {
+                content.resize(readSoFar + maxRead);
+                stream.read(reinterpret_cast<char*>(content.data() + readSoFar), maxRead);
+                readSoFar += maxRead;
+            }
+
+            return content;
+        }
+
+        AZStd::vector<char> m_body;
+    };
+
+    BENCHMARK_DEFINE_F(HttpResponseBodyBenchmark, FixedSizeReadLoop)(benchmark::State& state)
+    {
+        for ([[maybe_unused]] auto _ : state)
+        {
+            Aws::StringStream stream;
+            WriteBody(stream);
+            Cesium::IOContent content = ReadWithFixedSizeLoop(stream);
+            benchmark::DoNotOptimize(content.data());
+        }
+
+        state.SetBytesProcessed(state.iterations() * state.range(0));
+    }
+
+    BENCHMARK_DEFINE_F(HttpResponseBodyBenchmark, ResponseBodyStream)(benchmark::State& state)
+    {
+        for ([[maybe_unused]] auto _ : state)
+        {
+            Cesium::HttpResponseBodyStream stream;
+            stream.Reserve(m_body.size());
+            WriteBody(stream);
+            Cesium::IOContent content = stream.TakeContent();
+            benchmark::DoNotOptimize(content.data());
+        }
+
+        state.SetBytesProcessed(state.iterations() * state.range(0));
+    }
+
+    BENCHMARK_REGISTER_F(HttpResponseBodyBenchmark, FixedSizeReadLoop)
+        ->Arg(64 * 1024)
+        ->Arg(1024 * 1024)
+        ->Arg(16 * 1024 * 1024)
+        ->Unit(benchmark::kMicrosecond);
+
+    BENCHMARK_REGISTER_F(HttpResponseBodyBenchmark, ResponseBodyStream)
+        ->Arg(64 * 1024)
+        ->Arg(1024 * 1024)
+        ->Arg(16 * 1024 * 1024)
+        ->Unit(benchmark::kMicrosecond);
+} // namespace Benchmark
+#endif
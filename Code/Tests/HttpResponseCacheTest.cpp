@@ -0,0 +1,206 @@
+#include "Cesium/Systems/HttpResponseCache.h"
+#include <AzCore/IO/SystemFile.h>
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzTest/Utils.h>
+#include <cstring>
+
+class HttpResponseCacheTest : public UnitTest::LeakDetectionFixture
+{
+public:
+    void SetUp() override
+    {
+        UnitTest::LeakDetectionFixture::SetUp();
+    }
+
+    void TearDown() override
+    {
+        UnitTest::LeakDetectionFixture::TearDown();
+    }
+
+    static Cesium::IOContent CreateContent(const char* text)
+    {
+        Cesium::IOContent content(std::strlen(text));
+        std::memcpy(content.data(), text, content.size());
+        return content;
+    }
+
+    static bool WriteFile(const char* directory, const char* fileName, const Cesium::IOContent& content)
+    {
+        AZ::IO::SystemFile file;
+        AZStd::string filePath = AZStd::string::format("%s/%s", directory, fileName);
+        if (!file.Open(filePath.c_str(), AZ::IO::SystemFile::SF_OPEN_CREATE | AZ::IO::SystemFile::SF_OPEN_WRITE_ONLY))
+        {
+            return false;
+        }
+
+        return file.Write(content.data(), content.size()) == content.size();
+    }
+};
+
+TEST_F(HttpResponseCacheTest, TestStoreAndFind)
+{
+    AZ::Test::ScopedAutoTempDirectory tempDirectory;
+    Cesium::HttpResponseCache cache(tempDirectory.GetDirectory(), 1024);
+
+    CesiumAsync::HttpHeaders headers{ { "Cache-Control", "public, max-age=3600" }, { "Content-Encoding", "gzip" } };
+    Cesium::IOContent content = CreateContent("tile content");
+    ASSERT_TRUE(cache.Store("https://example.com/tile.b3dm", 200, "application/octet-stream", headers, content));
+
+    auto cachedResponse = cache.Find("https://example.com/tile.b3dm");
+    ASSERT_TRUE(cachedResponse.has_value());
+    ASSERT_TRUE(cachedResponse->m_isFresh);
+    ASSERT_EQ(cachedResponse->m_statusCode, 200);
+    ASSERT_EQ(cachedResponse->m_contentType, "application/octet-stream");
+    ASSERT_EQ(cachedResponse->m_headers.find("Content-Encoding"), cachedResponse->m_headers.end());
+    ASSERT_EQ(Cesium::HttpResponseCache::ReadBlob(cachedResponse->m_blobPath), content);
+    ASSERT_FALSE(cache.Find("https://example.com/other.b3dm").has_value());
+}
+
+TEST_F(HttpResponseCacheTest, TestCacheability)
+{
+    ASSERT_FALSE(Cesium::HttpResponseCache::IsCacheable({}));
+    ASSERT_FALSE(Cesium::HttpResponseCache::IsCacheable({ { "Cache-Control", "no-store" }, { "ETag", "\"abc\"" } }));
+    ASSERT_TRUE(Cesium::HttpResponseCache::IsCacheable({ { "Cache-Control", "max-age=60" } }));
+    ASSERT_TRUE(Cesium::HttpResponseCache::IsCacheable({ { "ETag", "\"abc\"" } }));
+    ASSERT_TRUE(Cesium::HttpResponseCache::IsCacheable({ { "Last-Modified", "Wed, 21 Oct 2015 07:28:00 GMT" } }));
+
+    // bodies are stored decoded, so only responses varying on other request headers are not cached
+    ASSERT_TRUE(Cesium::HttpResponseCache::IsCacheable({ { "ETag", "\"abc\"" }, { "Vary", "Accept-Encoding" } }));
+    ASSERT_FALSE(Cesium::HttpResponseCache::IsCacheable({ { "ETag", "\"abc\"" }, { "Vary", "accept-encoding, Origin" } }));
+    ASSERT_FALSE(Cesium::HttpResponseCache::IsCacheable({ { "ETag", "\"abc\"" }, { "Vary", "*" } }));
+
+    ASSERT_EQ(Cesium::HttpResponseCache::CalculateExpiryTime({ { "Cache-Control", "public, max-age=60" } }, 100), 160);
+    ASSERT_EQ(Cesium::HttpResponseCache::CalculateExpiryTime({ { "Cache-Control", "no-cache, max-age=60" } }, 100), 100);
+    ASSERT_EQ(Cesium::HttpResponseCache::CalculateExpiryTime({ { "ETag", "\"abc\"" } }, 100), 100);
+}
+
+TEST_F(HttpResponseCacheTest, TestCacheKey)
+{
+    const std::string url = "https://example.com/tile";
+    ASSERT_EQ(Cesium::HttpResponseCache::CreateCacheKey(url, {}), "https://example.com/tile");
+    ASSERT_EQ(Cesium::HttpResponseCache::CreateCacheKey(url, { { "User-Agent", "test" } }), "https://example.com/tile");
+
+    // requests with different credentials get different entries, without the credentials ending up in the key
+    AZStd::string firstKey = Cesium::HttpResponseCache::CreateCacheKey(url, { { "Authorization", "Bearer first" } });
+    AZStd::string secondKey = Cesium::HttpResponseCache::CreateCacheKey(url, { { "authorization", "Bearer second" } });
+    ASSERT_NE(firstKey, "https://example.com/tile");
+    ASSERT_NE(firstKey, secondKey);
+    ASSERT_EQ(firstKey.find("first"), AZStd::string::npos);
+}
+
+TEST_F(HttpResponseCacheTest, TestRevalidate)
+{
+    AZ::Test::ScopedAutoTempDirectory tempDirectory;
+    Cesium::HttpResponseCache cache(tempDirectory.GetDirectory(), 1024);
+
+    CesiumAsync::HttpHeaders headers{ { "ETag", "\"v1\"" } };
+    ASSERT_TRUE(cache.Store("https://example.com/tileset.json", 200, "application/json", headers, CreateContent("{}")));
+
+    auto staleResponse = cache.Find("https://example.com/tileset.json");
+    ASSERT_TRUE(staleResponse.has_value());
+    ASSERT_FALSE(staleResponse->m_isFresh);
+
+    ASSERT_TRUE(cache.Revalidate("https://example.com/tileset.json", { { "Cache-Control", "max-age=3600" }, { "ETag", "\"v2\"" } }));
+    auto revalidatedResponse = cache.Find("https://example.com/tileset.json");
+    ASSERT_TRUE(revalidatedResponse.has_value());
+    ASSERT_TRUE(revalidatedResponse->m_isFresh);
+    ASSERT_EQ(revalidatedResponse->m_headers.at("ETag"), "\"v2\"");
+}
+
+TEST_F(HttpResponseCacheTest, TestEvictLeastRecentlyUsed)
+{
+    AZ::Test::ScopedAutoTempDirectory tempDirectory;
+    Cesium::HttpResponseCache cache(tempDirectory.GetDirectory(), 16);
+
+    CesiumAsync::HttpHeaders headers{ { "Cache-Control", "max-age=3600" } };
+    ASSERT_TRUE(cache.Store("https://example.com/0", 200, "", headers, CreateContent("aaaaaaaa")));
+    ASSERT_TRUE(cache.Store("https://example.com/1", 200, "", headers, CreateContent("bbbbbbbb")));
+
+    // same payload is only stored once
+    ASSERT_TRUE(cache.Store("https://example.com/2", 200, "", headers, CreateContent("bbbbbbbb")));
+    ASSERT_EQ(cache.GetCurrentBytes(), 16u);
+
+    // touch the first entry, so the second and third entries are evicted
+    ASSERT_TRUE(cache.Find("https://example.com/0").has_value());
+    ASSERT_TRUE(cache.Store("https://example.com/3", 200, "", headers, CreateContent("cccccccc")));
+    ASSERT_EQ(cache.GetCurrentBytes(), 16u);
+    ASSERT_TRUE(cache.Find("https://example.com/0").has_value());
+    ASSERT_FALSE(cache.Find("https://example.com/1").has_value());
+    ASSERT_FALSE(cache.Find("https://example.com/2").has_value());
+    ASSERT_TRUE(cache.Find("https://example.com/3").has_value());
+
+    cache.SetMaximumBytes(0);
+    ASSERT_EQ(cache.GetCurrentBytes(), 0u);
+    ASSERT_FALSE(cache.Find("https://example.com/0").has_value());
+}
+
+TEST_F(HttpResponseCacheTest, TestPersistIndex)
+{
+    AZ::Test::ScopedAutoTempDirectory tempDirectory;
+    Cesium::IOContent content = CreateContent("persisted content");
+    {
+        Cesium::HttpResponseCache cache(tempDirectory.GetDirectory(), 1024);
+        CesiumAsync::HttpHeaders headers{ { "Cache-Control", "max-age=3600" } };
+        ASSERT_TRUE(cache.Store("https://example.com/persisted", 200, "text/plain", headers, content));
+    }
+
+    Cesium::HttpResponseCache cache(tempDirectory.GetDirectory(), 1024);
+    ASSERT_EQ(cache.GetCurrentBytes(), content.size());
+    auto cachedResponse = cache.Find("https://example.com/persisted");
+    ASSERT_TRUE(cachedResponse.has_value());
+    ASSERT_TRUE(cachedResponse->m_isFresh);
+    ASSERT_EQ(cachedResponse->m_contentType, "text/plain");
+    ASSERT_EQ(Cesium::HttpResponseCache::ReadBlob(cachedResponse->m_blobPath), content);
+}
+
+TEST_F(HttpResponseCacheTest, TestFlushSavesRecentlyUsedOrder)
+{
+    AZ::Test::ScopedAutoTempDirectory tempDirectory;
+    {
+        Cesium::HttpResponseCache cache(tempDirectory.GetDirectory(), 16);
+        CesiumAsync::HttpHeaders headers{ { "Cache-Control", "max-age=3600" } };
+        ASSERT_TRUE(cache.Store("https://example.com/0", 200, "", headers, CreateContent("aaaaaaaa")));
+        ASSERT_TRUE(cache.Store("https://example.com/1", 200, "", headers, CreateContent("bbbbbbbb")));
+        cache.Flush();
+
+        // a cache hit alone only changes the order, which is saved when the cache is flushed
+        ASSERT_TRUE(cache.Find("https://example.com/0").has_value());
+    }
+
+    // the entry that was not touched is the least recently used one after loading the index again
+    Cesium::HttpResponseCache cache(tempDirectory.GetDirectory(), 8);
+    ASSERT_TRUE(cache.Find("https://example.com/0").has_value());
+    ASSERT_FALSE(cache.Find("https://example.com/1").has_value());
+}
+
+TEST_F(HttpResponseCacheTest, TestSkipMalformedIndexEntries)
+{
+    AZ::Test::ScopedAutoTempDirectory tempDirectory;
+    Cesium::IOContent content = CreateContent("blob content");
+    const char* blobName = "0123456789abcdef0123456789abcdef01234567";
+    const char* index = R"({ "version": 1, "entries": [
+        { "url": 1, "blob": "0123456789abcdef0123456789abcdef01234567", "status": 200, "contentType": "", "expiry": 0, "headers": {} },
+        { "url": "https://example.com/status", "blob": "0123456789abcdef0123456789abcdef01234567", "status": "200",
+          "contentType": "", "expiry": 0, "headers": {} },
+        { "url": "https://example.com/headers", "blob": "0123456789abcdef0123456789abcdef01234567", "status": 200,
+          "contentType": "", "expiry": 0, "headers": { "ETag": 1 } },
+        { "url": "https://example.com/expiry", "blob": "0123456789abcdef0123456789abcdef01234567", "status": 200,
+          "contentType": "", "expiry": "0", "headers": {} },
+        { "url": "https://example.com/path", "blob": "../index", "status": 200, "contentType": "", "expiry": 0, "headers": {} },
+        { "url": "https://example.com/valid", "blob": "0123456789abcdef0123456789abcdef01234567", "status": 200,
+          "contentType": "text/plain", "expiry": 0, "headers": { "ETag": "\"1\"" } } ] })";
+
+    ASSERT_TRUE(WriteFile(tempDirectory.GetDirectory(), "index.json", CreateContent(index)));
+    ASSERT_TRUE(WriteFile(tempDirectory.GetDirectory(), AZStd::string::format("%s.blob", blobName).c_str(), content));
+
+    Cesium::HttpResponseCache cache(tempDirectory.GetDirectory(), 1024);
+    ASSERT_EQ(cache.GetCurrentBytes(), content.size());
+    ASSERT_FALSE(cache.Find("https://example.com/status").has_value());
+    ASSERT_FALSE(cache.Find("https://example.com/headers").has_value());
+    ASSERT_FALSE(cache.Find("https://example.com/expiry").has_value());
+    ASSERT_FALSE(cache.Find("https://example.com/path").has_value());
+    auto cachedResponse = cache.Find("https://example.com/valid");
+    ASSERT_TRUE(cachedResponse.has_value());
+    ASSERT_EQ(cachedResponse->m_contentType, "text/plain");
+    ASSERT_EQ(Cesium::HttpResponseCache::ReadBlob(cachedResponse->m_blobPath), content);
+}
@@ -0,0 +1,90 @@
+#include "Cesium/Systems/GenericIOManager.h"
+#include "Cesium/Systems/MappedFile.h"
+#include <AzCore/IO/SystemFile.h>
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzTest/Utils.h>
+#include <cstring>
+
+class MappedFileTest : public UnitTest::LeakDetectionFixture
+{
+public:
+    void SetUp() override
+    {
+        UnitTest::LeakDetectionFixture::SetUp();
+    }
+
+    void TearDown() override
+    {
+        UnitTest::LeakDetectionFixture::TearDown();
+    }
+
+    static Cesium::IOContent CreateContent(std::size_t size)
+    {
+        Cesium::IOContent content(size);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            content[i] = static_cast<std::byte>(i % 251);
+        }
+
+        return content;
+    }
+
+    static void WriteFile(const AZStd::string& path, const Cesium::IOContent& content)
+    {
+        AZ::IO::SystemFile file;
+        ASSERT_TRUE(file.Open(
+            path.c_str(), AZ::IO::SystemFile::SF_OPEN_CREATE | AZ::IO::SystemFile::SF_OPEN_WRITE_ONLY));
+        ASSERT_EQ(file.Write(content.data(), content.size()), content.size());
+        file.Close();
+    }
+};
+
+TEST_F(MappedFileTest, TestMapFile)
+{
+    AZ::Test::ScopedAutoTempDirectory tempDirectory;
+    AZStd::string path = AZStd::string(tempDirectory.GetDirectory()) + "/tile.glb";
+    Cesium::IOContent content = CreateContent(3 * 1024 * 1024 + 17);
+    WriteFile(path, content);
+
+    auto mappedFile = Cesium::MappedFile::Open(path);
+    ASSERT_NE(mappedFile, nullptr);
+
+    gsl::span<const std::byte> data = mappedFile->GetData();
+    ASSERT_EQ(data.size(), content.size());
+    ASSERT_EQ(std::memcmp(data.data(), content.data(), content.size()), 0);
+}
+
+TEST_F(MappedFileTest, TestMapInvalidFile)
+{
+    AZ::Test::ScopedAutoTempDirectory tempDirectory;
+    AZStd::string emptyPath = AZStd::string(tempDirectory.GetDirectory()) + "/empty.glb";
+    WriteFile(emptyPath, {});
+
+    ASSERT_EQ(Cesium::MappedFile::Open(emptyPath), nullptr);
+    ASSERT_EQ(Cesium::MappedFile::Open(AZStd::string(tempDirectory.GetDirectory()) + "/missing.glb"), nullptr);
+}
+
+TEST_F(MappedFileTest, TestMappedIOContent)
+{
+    AZ::Test::ScopedAutoTempDirectory tempDirectory;
+    AZStd::string path = AZStd::string(tempDirectory.GetDirectory()) + "/tile.glb";
+    Cesium::IOContent content = CreateContent(4096);
+    WriteFile(path, content);
+
+    Cesium::MappedIOContent mappedContent(Cesium::MappedFile::Open(path));
+    ASSERT_TRUE(mappedContent.IsMapped());
+    ASSERT_EQ(mappedContent.GetData().size(), content.size());
+    ASSERT_EQ(std::memcmp(mappedContent.GetData().data(), content.data(), content.size()), 0);
+
+    // moving the content keeps the mapping alive
+    Cesium::MappedIOContent movedContent = std::move(mappedContent);
+    ASSERT_TRUE(movedContent.IsMapped());
+    ASSERT_EQ(std::memcmp(movedContent.GetData().data(), content.data(), content.size()), 0);
+
+    Cesium::MappedIOContent ownedContent(Cesium::IOContent(content));
+    ASSERT_FALSE(ownedContent.IsMapped());
+    ASSERT_EQ(ownedContent.GetData().size(), content.size());
+    ASSERT_EQ(std::memcmp(ownedContent.GetData().data(), content.data(), content.size()), 0);
+
+    ASSERT_TRUE(Cesium::MappedIOContent().IsEmpty());
+}
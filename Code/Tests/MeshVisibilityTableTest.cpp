@@ -0,0 +1,151 @@
+#include "Cesium/TilesetUtility/MeshVisibilityTable.h"
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzCore/std/containers/vector.h>
+
+namespace
+{
+    using TestVisibilityTable = Cesium::MeshVisibilityTable<int>;
+
+    struct AppliedHandle
+    {
+        int m_handle;
+        bool m_visible;
+    };
+
+    AZStd::vector<const int*> GetHandlePointers(const AZStd::vector<int>& handles)
+    {
+        AZStd::vector<const int*> pointers;
+        for (const int& handle : handles)
+        {
+            pointers.emplace_back(&handle);
+        }
+
+        return pointers;
+    }
+
+    AZStd::vector<AppliedHandle> Apply(TestVisibilityTable& table)
+    {
+        AZStd::vector<AppliedHandle> applied;
+        table.Apply(
+            [&applied](int handle, bool visible)
+            {
+                applied.emplace_back(AppliedHandle{ handle, visible });
+            });
+
+        return applied;
+    }
+} // namespace
+
+class MeshVisibilityTableTest : public UnitTest::LeakDetectionFixture
+{
+public:
+    void SetUp() override
+    {
+        UnitTest::LeakDetectionFixture::SetUp();
+    }
+
+    void TearDown() override
+    {
+        UnitTest::LeakDetectionFixture::TearDown();
+    }
+};
+
+TEST_F(MeshVisibilityTableTest, TestApplyOnlyChangedModels)
+{
+    AZStd::vector<int> firstHandles{ 1, 2, 3 };
+    AZStd::vector<int> secondHandles{ 4, 5 };
+    TestVisibilityTable table;
+    TestVisibilityTable::Slot first = table.Add(GetHandlePointers(firstHandles), false);
+    TestVisibilityTable::Slot second = table.Add(GetHandlePointers(secondHandles), true);
+
+    // the second model is already visible, so showing it again changes nothing
+    table.SetVisible(first, true);
+    table.SetVisible(second, true);
+    AZStd::vector<AppliedHandle> applied = Apply(table);
+    ASSERT_EQ(applied.size(), 3u);
+    for (std::size_t i = 0; i < applied.size(); ++i)
+    {
+        ASSERT_EQ(applied[i].m_handle, firstHandles[i]);
+        ASSERT_TRUE(applied[i].m_visible);
+    }
+
+    ASSERT_TRUE(Apply(table).empty());
+}
+
+TEST_F(MeshVisibilityTableTest, TestChangesThatCancelOutAreSkipped)
+{
+    AZStd::vector<int> handles{ 1, 2 };
+    TestVisibilityTable table;
+    TestVisibilityTable::Slot slot = table.Add(GetHandlePointers(handles), false);
+    table.SetVisible(slot, true);
+    table.SetVisible(slot, false);
+    table.SetVisible(slot, true);
+    ASSERT_EQ(Apply(table).size(), 2u);
+
+    table.SetVisible(slot, false);
+    table.SetVisible(slot, true);
+    ASSERT_TRUE(Apply(table).empty());
+    ASSERT_TRUE(table.IsVisible(slot));
+}
+
+TEST_F(MeshVisibilityTableTest, TestRemovedSlotsAreReused)
+{
+    AZStd::vector<int> firstHandles{ 1, 2, 3 };
+    AZStd::vector<int> secondHandles{ 4 };
+    TestVisibilityTable table;
+    TestVisibilityTable::Slot first = table.Add(GetHandlePointers(firstHandles), false);
+    table.SetVisible(first, true);
+    table.Remove(first);
+    ASSERT_EQ(table.GetHandleCount(), 0u);
+
+    // the pending change of the removed model must not reach the model that takes its slot
+    TestVisibilityTable::Slot second = table.Add(GetHandlePointers(secondHandles), false);
+    ASSERT_EQ(second, first);
+    ASSERT_TRUE(Apply(table).empty());
+
+    table.SetVisible(second, true);
+    AZStd::vector<AppliedHandle> applied = Apply(table);
+    ASSERT_EQ(applied.size(), 1u);
+    ASSERT_EQ(applied[0].m_handle, 4);
+    ASSERT_EQ(table.GetHandleCount(), 1u);
+}
+
+TEST_F(MeshVisibilityTableTest, TestCompactKeepsHandlesOfLiveModels)
+{
+    // enough models are removed to compact the handle array, and the remaining ones must still apply their own handles
+    static constexpr int MODEL_COUNT = 1024;
+    static constexpr int HANDLES_PER_MODEL = 4;
+    AZStd::vector<AZStd::vector<int>> handles(MODEL_COUNT);
+    AZStd::vector<TestVisibilityTable::Slot> slots;
+    TestVisibilityTable table;
+    for (int model = 0; model < MODEL_COUNT; ++model)
+    {
+        for (int i = 0; i < HANDLES_PER_MODEL; ++i)
+        {
+            handles[model].emplace_back(model * HANDLES_PER_MODEL + i);
+        }
+
+        slots.emplace_back(table.Add(GetHandlePointers(handles[model]), false));
+    }
+
+    for (int model = 0; model < MODEL_COUNT; model += 4)
+    {
+        table.Remove(slots[model]);
+        table.Remove(slots[model + 1]);
+        table.Remove(slots[model + 2]);
+    }
+
+    ASSERT_EQ(table.GetHandleCount(), static_cast<std::size_t>(MODEL_COUNT / 4 * HANDLES_PER_MODEL));
+    for (int model = 3; model < MODEL_COUNT; model += 4)
+    {
+        table.SetVisible(slots[model], true);
+    }
+
+    AZStd::vector<AppliedHandle> applied = Apply(table);
+    ASSERT_EQ(applied.size(), table.GetHandleCount());
+    for (const AppliedHandle& appliedHandle : applied)
+    {
+        ASSERT_EQ(appliedHandle.m_handle / HANDLES_PER_MODEL % 4, 3);
+        ASSERT_TRUE(appliedHandle.m_visible);
+    }
+}
@@ -0,0 +1,117 @@
+#include "Cesium/Gltf/NormalGenerator.h"
+#include <AzCore/UnitTest/TestTypes.h>
+
+class NormalGeneratorTest : public UnitTest::LeakDetectionFixture
+{
+public:
+    void SetUp() override
+    {
+        UnitTest::LeakDetectionFixture::SetUp();
+    }
+
+    void TearDown() override
+    {
+        UnitTest::LeakDetectionFixture::TearDown();
+    }
+
+    static void AssertNormal(const glm::vec3& normal, const glm::vec3& expected)
+    {
+        ASSERT_NEAR(normal.x, expected.x, 1e-5f);
+        ASSERT_NEAR(normal.y, expected.y, 1e-5f);
+        ASSERT_NEAR(normal.z, expected.z, 1e-5f);
+    }
+};
+
+TEST_F(NormalGeneratorTest, TestFlatQuad)
+{
+    AZStd::vector<glm::vec3> positions{ { 0.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 0.0f }, { 0.0f, 1.0f, 0.0f } };
+    AZStd::vector<std::uint32_t> indices{ 0, 1, 2, 0, 2, 3 };
+
+    AZStd::vector<glm::vec3> normals;
+    Cesium::NormalGenerator::Generate(indices, positions, 1.0f, normals);
+    ASSERT_EQ(normals.size(), indices.size());
+    for (const glm::vec3& normal : normals)
+    {
+        AssertNormal(normal, glm::vec3(0.0f, 0.0f, 1.0f));
+    }
+}
+
+TEST_F(NormalGeneratorTest, TestCreaseKeepsHardEdge)
+{
+    // two faces folded by 90 degrees along the shared edge from vertex 0 to vertex 1
+    AZStd::vector<glm::vec3> positions{ { 0.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f } };
+    AZStd::vector<std::uint32_t> indices{ 0, 1, 2, 1, 0, 3 };
+
+    AZStd::vector<glm::vec3> normals;
+    Cesium::NormalGenerator::Generate(indices, positions, 1.0f, normals);
+    ASSERT_EQ(normals.size(), indices.size());
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        AssertNormal(normals[i], glm::vec3(0.0f, 0.0f, 1.0f));
+        AssertNormal(normals[i + 3], glm::vec3(0.0f, 1.0f, 0.0f));
+    }
+
+    // with a crease angle above 90 degrees, the shared edge is smoothed
+    Cesium::NormalGenerator::Generate(indices, positions, 2.0f, normals);
+    AssertNormal(normals[0], glm::normalize(glm::vec3(0.0f, 1.0f, 1.0f)));
+    AssertNormal(normals[4], glm::normalize(glm::vec3(0.0f, 1.0f, 1.0f)));
+}
+
+TEST_F(NormalGeneratorTest, TestSeamVerticesAreSmoothed)
+{
+    // vertices 1 and 4 and vertices 2 and 5 are split at the same positions, e.g. by a UV seam
+    AZStd::vector<glm::vec3> positions{ { 0.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 0.0f },
+                                        { 2.0f, 0.0f, 0.5f }, { 1.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 0.0f } };
+    AZStd::vector<std::uint32_t> indices{ 0, 1, 2, 4, 3, 5 };
+
+    AZStd::vector<glm::vec3> normals;
+    Cesium::NormalGenerator::Generate(indices, positions, 1.0f, normals);
+    ASSERT_EQ(normals.size(), indices.size());
+    AssertNormal(normals[1], normals[3]);
+    AssertNormal(normals[2], normals[5]);
+    ASSERT_LT(normals[1].x, 0.0f);
+}
+
+TEST_F(NormalGeneratorTest, TestDegenerateFace)
+{
+    AZStd::vector<glm::vec3> positions{ { 0.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f }, { 2.0f, 0.0f, 0.0f } };
+    AZStd::vector<std::uint32_t> indices{ 0, 1, 2 };
+
+    AZStd::vector<glm::vec3> normals;
+    Cesium::NormalGenerator::Generate(indices, positions, 1.0f, normals);
+    ASSERT_EQ(normals.size(), indices.size());
+    for (const glm::vec3& normal : normals)
+    {
+        AssertNormal(normal, glm::vec3(0.0f, 1.0f, 0.0f));
+    }
+}
+
+TEST_F(NormalGeneratorTest, TestFlatNormalsKeepShallowEdge)
+{
+    // two faces folded by about 11 degrees along the shared edge from vertex 0 to vertex 1, which smooth normals would blend
+    AZStd::vector<glm::vec3> positions{ { 0.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, -1.0f, 0.2f } };
+    AZStd::vector<std::uint32_t> indices{ 0, 1, 2, 1, 0, 3 };
+
+    AZStd::vector<glm::vec3> normals;
+    Cesium::NormalGenerator::GenerateFlat(indices, positions, normals);
+    ASSERT_EQ(normals.size(), indices.size());
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        AssertNormal(normals[i], glm::vec3(0.0f, 0.0f, 1.0f));
+        AssertNormal(normals[i + 3], glm::normalize(glm::vec3(0.0f, 0.2f, 1.0f)));
+    }
+}
+
+TEST_F(NormalGeneratorTest, TestFlatDegenerateFace)
+{
+    AZStd::vector<glm::vec3> positions{ { 0.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f }, { 2.0f, 0.0f, 0.0f } };
+    AZStd::vector<std::uint32_t> indices{ 0, 1, 2 };
+
+    AZStd::vector<glm::vec3> normals;
+    Cesium::NormalGenerator::GenerateFlat(indices, positions, normals);
+    ASSERT_EQ(normals.size(), indices.size());
+    for (const glm::vec3& normal : normals)
+    {
+        AssertNormal(normal, glm::vec3(0.0f, 1.0f, 0.0f));
+    }
+}
@@ -0,0 +1,84 @@
+#include "Cesium/TilesetUtility/RasterAtlasSlotAllocator.h"
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzCore/std/containers/vector.h>
+
+class RasterAtlasSlotAllocatorTest : public UnitTest::LeakDetectionFixture
+{
+public:
+    void SetUp() override
+    {
+        UnitTest::LeakDetectionFixture::SetUp();
+    }
+
+    void TearDown() override
+    {
+        UnitTest::LeakDetectionFixture::TearDown();
+    }
+};
+
+TEST_F(RasterAtlasSlotAllocatorTest, TestSlotsFillPagesInOrder)
+{
+    Cesium::RasterAtlasSlotAllocator allocator(2, 2);
+    bool newPage = false;
+    for (std::uint32_t i = 0; i < 8; ++i)
+    {
+        Cesium::RasterAtlasSlot slot = allocator.Allocate(newPage);
+        ASSERT_TRUE(slot.IsValid());
+        ASSERT_EQ(slot.m_page, i / 4);
+        ASSERT_EQ(slot.m_index, i % 4);
+        ASSERT_EQ(newPage, i % 4 == 0);
+    }
+
+    // every slot of the maximum number of pages is taken
+    ASSERT_FALSE(allocator.Allocate(newPage).IsValid());
+    ASSERT_EQ(allocator.GetUsedSlotCount(), 8u);
+    ASSERT_EQ(allocator.GetPageCount(), 2u);
+}
+
+TEST_F(RasterAtlasSlotAllocatorTest, TestEmptyPageIsReleasedAndReused)
+{
+    Cesium::RasterAtlasSlotAllocator allocator(1, 2);
+    bool newPage = false;
+    Cesium::RasterAtlasSlot first = allocator.Allocate(newPage);
+    Cesium::RasterAtlasSlot second = allocator.Allocate(newPage);
+    ASSERT_EQ(second.m_page, 1u);
+
+    ASSERT_TRUE(allocator.Free(first));
+    ASSERT_EQ(allocator.GetPageCount(), 1u);
+
+    Cesium::RasterAtlasSlot reused = allocator.Allocate(newPage);
+    ASSERT_TRUE(newPage);
+    ASSERT_EQ(reused.m_page, first.m_page);
+}
+
+TEST_F(RasterAtlasSlotAllocatorTest, TestFreedSlotIsTakenBeforeANewPage)
+{
+    Cesium::RasterAtlasSlotAllocator allocator(2, 4);
+    bool newPage = false;
+    AZStd::vector<Cesium::RasterAtlasSlot> slots;
+    for (std::uint32_t i = 0; i < 4; ++i)
+    {
+        slots.emplace_back(allocator.Allocate(newPage));
+    }
+
+    ASSERT_FALSE(allocator.Free(slots[2]));
+    Cesium::RasterAtlasSlot slot = allocator.Allocate(newPage);
+    ASSERT_FALSE(newPage);
+    ASSERT_EQ(slot.m_page, 0u);
+    ASSERT_EQ(slot.m_index, 2u);
+}
+
+TEST_F(RasterAtlasSlotAllocatorTest, TestSlotRect)
+{
+    Cesium::RasterAtlasSlotAllocator allocator(4, 1);
+    Cesium::RasterAtlasSlot slot;
+    slot.m_page = 0;
+    slot.m_index = 6;
+    float offsetU = 0.0f;
+    float offsetV = 0.0f;
+    float size = 0.0f;
+    allocator.GetSlotRect(slot, offsetU, offsetV, size);
+    ASSERT_FLOAT_EQ(size, 0.25f);
+    ASSERT_FLOAT_EQ(offsetU, 0.5f);
+    ASSERT_FLOAT_EQ(offsetV, 0.25f);
+}
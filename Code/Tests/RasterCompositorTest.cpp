@@ -0,0 +1,95 @@
+#include "Cesium/TilesetUtility/RasterCompositor.h"
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzCore/std/containers/vector.h>
+#include <cstdint>
+
+class RasterCompositorTest : public UnitTest::LeakDetectionFixture
+{
+public:
+    void SetUp() override
+    {
+        UnitTest::LeakDetectionFixture::SetUp();
+    }
+
+    void TearDown() override
+    {
+        UnitTest::LeakDetectionFixture::TearDown();
+    }
+
+    static AZStd::shared_ptr<const Cesium::RasterCompositeSource> CreateSolidSource(
+        std::uint32_t width, std::uint32_t height, std::uint8_t red, std::uint8_t green, std::uint8_t blue, std::uint8_t alpha)
+    {
+        auto source = AZStd::make_shared<Cesium::RasterCompositeSource>();
+        source->m_width = width;
+        source->m_height = height;
+        for (std::uint32_t i = 0; i < width * height; ++i)
+        {
+            source->m_pixels.insert(
+                source->m_pixels.end(), { std::byte{ red }, std::byte{ green }, std::byte{ blue }, std::byte{ alpha } });
+        }
+
+        return source;
+    }
+
+    static std::uint8_t GetChannel(const AZStd::vector<std::byte>& pixels, std::uint32_t size, std::uint32_t x, std::uint32_t y, std::uint32_t c)
+    {
+        return static_cast<std::uint8_t>(pixels[(static_cast<std::size_t>(y) * size + x) * 4 + c]);
+    }
+};
+
+TEST_F(RasterCompositorTest, TestLayersAreBlendedBottomToTop)
+{
+    // an opaque red base with half transparent blue on top. The colors are blended in linear space, so half of full red
+    // is encoded as 187 rather than 127
+    AZStd::vector<Cesium::RasterCompositeLayer> layers{
+        { CreateSolidSource(4, 4, 255, 0, 0, 255), AZ::Vector4(0.0f, 0.0f, 1.0f, 1.0f) },
+        { CreateSolidSource(2, 2, 0, 0, 255, 128), AZ::Vector4(0.0f, 0.0f, 1.0f, 1.0f) },
+    };
+
+    AZStd::vector<std::byte> composite = Cesium::RasterCompositor::Composite(layers, 4);
+    ASSERT_EQ(composite.size(), 4u * 4u * 4u);
+    for (std::uint32_t y = 0; y < 4; ++y)
+    {
+        for (std::uint32_t x = 0; x < 4; ++x)
+        {
+            ASSERT_EQ(GetChannel(composite, 4, x, y, 0), 187u);
+            ASSERT_EQ(GetChannel(composite, 4, x, y, 1), 0u);
+            ASSERT_EQ(GetChannel(composite, 4, x, y, 2), 188u);
+            ASSERT_EQ(GetChannel(composite, 4, x, y, 3), 255u);
+        }
+    }
+}
+
+TEST_F(RasterCompositorTest, TestLayerOnlyCoversItsRasterRectangle)
+{
+    // the top layer's raster only covers the left half of the tile: uv 0 maps to raster u 0 and uv 0.5 to raster u 1
+    AZStd::vector<Cesium::RasterCompositeLayer> layers{
+        { CreateSolidSource(1, 1, 0, 255, 0, 255), AZ::Vector4(0.0f, 0.0f, 1.0f, 1.0f) },
+        { CreateSolidSource(1, 1, 255, 255, 255, 255), AZ::Vector4(0.0f, 0.0f, 2.0f, 1.0f) },
+    };
+
+    AZStd::vector<std::byte> composite = Cesium::RasterCompositor::Composite(layers, 4);
+    for (std::uint32_t y = 0; y < 4; ++y)
+    {
+        ASSERT_EQ(GetChannel(composite, 4, 0, y, 0), 255u);
+        ASSERT_EQ(GetChannel(composite, 4, 1, y, 0), 255u);
+        ASSERT_EQ(GetChannel(composite, 4, 2, y, 0), 0u);
+        ASSERT_EQ(GetChannel(composite, 4, 3, y, 0), 0u);
+    }
+}
+
+TEST_F(RasterCompositorTest, TestVIsFlippedLikeTheShader)
+{
+    // a 1x2 raster with a white top row and black bottom row. Tile v = 1 is the top of the composite and samples raster
+    // v = 0, the top row, after the flip
+    auto source = AZStd::make_shared<Cesium::RasterCompositeSource>();
+    source->m_width = 1;
+    source->m_height = 2;
+    source->m_pixels = { std::byte{ 255 }, std::byte{ 255 }, std::byte{ 255 }, std::byte{ 255 },
+                         std::byte{ 0 },   std::byte{ 0 },   std::byte{ 0 },   std::byte{ 255 } };
+    AZStd::vector<Cesium::RasterCompositeLayer> layers{ { source, AZ::Vector4(0.0f, 0.0f, 1.0f, 1.0f) } };
+
+    AZStd::vector<std::byte> composite = Cesium::RasterCompositor::Composite(layers, 2);
+    ASSERT_EQ(GetChannel(composite, 2, 0, 0, 0), 255u);
+    ASSERT_EQ(GetChannel(composite, 2, 0, 1, 0), 0u);
+}
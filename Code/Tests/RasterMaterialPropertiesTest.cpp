@@ -0,0 +1,183 @@
+#include "Cesium/TilesetUtility/RasterMaterialProperties.h"
+#include <AzCore/Math/Vector4.h>
+#include <AzCore/Name/NameDictionary.h>
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/string/string.h>
+
+#if defined(HAVE_BENCHMARK)
+#include <benchmark/benchmark.h>
+#endif
+
+namespace
+{
+    // finds property indices by name the way a MaterialPropertiesLayout does, and keeps one value per property
+    class TestMaterial
+    {
+    public:
+        static constexpr const char* const PROPERTIES[] = { "textureMap", "useTexture", "textureMapUv", "uvTranslateScale", "uvClamp" };
+
+        explicit TestMaterial(std::uint32_t layerCount)
+        {
+            for (std::uint32_t layer = 0; layer < layerCount; ++layer)
+            {
+                for (const char* property : PROPERTIES)
+                {
+                    AZ::RPI::MaterialPropertyIndex index{ static_cast<std::uint32_t>(m_values.size()) };
+                    m_indices.emplace(Cesium::RasterMaterialProperties::GetPropertyName(layer, property), index);
+                    m_values.emplace_back(AZ::Vector4::CreateZero());
+                }
+            }
+        }
+
+        AZ::RPI::MaterialPropertyIndex FindPropertyIndex(const AZ::Name& name) const
+        {
+            auto indexIt = m_indices.find(name);
+            return indexIt == m_indices.end() ? AZ::RPI::MaterialPropertyIndex{} : indexIt->second;
+        }
+
+        void SetPropertyValue(AZ::RPI::MaterialPropertyIndex index, const AZ::Vector4& value)
+        {
+            m_values[index.GetIndex()] = value;
+        }
+
+        AZStd::unordered_map<AZ::Name, AZ::RPI::MaterialPropertyIndex> m_indices;
+        AZStd::vector<AZ::Vector4> m_values;
+    };
+} // namespace
+
+class RasterMaterialPropertiesTest : public UnitTest::LeakDetectionFixture
+{
+public:
+    void SetUp() override
+    {
+        UnitTest::LeakDetectionFixture::SetUp();
+        AZ::NameDictionary::Create();
+    }
+
+    void TearDown() override
+    {
+        AZ::NameDictionary::Destroy();
+        UnitTest::LeakDetectionFixture::TearDown();
+    }
+};
+
+TEST_F(RasterMaterialPropertiesTest, TestPropertyNamesMatchTheMaterialType)
+{
+    ASSERT_EQ(Cesium::RasterMaterialProperties::GetPropertyName(0, "textureMap"), AZ::Name("raster0.textureMap"));
+    ASSERT_EQ(Cesium::RasterMaterialProperties::GetPropertyName(1, "uvClamp"), AZ::Name("raster1.uvClamp"));
+}
+
+TEST_F(RasterMaterialPropertiesTest, TestIndicesOfEveryLayerAreFound)
+{
+    TestMaterial material(Cesium::RasterMaterialProperties::LAYER_COUNT);
+    Cesium::RasterMaterialProperties properties;
+    properties.Build(material);
+    ASSERT_TRUE(properties.IsValid());
+
+    const Cesium::RasterLayerProperties& layer1 = properties.GetLayer(1);
+    ASSERT_EQ(layer1.m_textureMap, material.FindPropertyIndex(AZ::Name("raster1.textureMap")));
+    ASSERT_EQ(layer1.m_useTexture, material.FindPropertyIndex(AZ::Name("raster1.useTexture")));
+    ASSERT_EQ(layer1.m_textureMapUv, material.FindPropertyIndex(AZ::Name("raster1.textureMapUv")));
+    ASSERT_EQ(layer1.m_uvTranslateScale, material.FindPropertyIndex(AZ::Name("raster1.uvTranslateScale")));
+    ASSERT_EQ(layer1.m_uvClamp, material.FindPropertyIndex(AZ::Name("raster1.uvClamp")));
+}
+
+TEST_F(RasterMaterialPropertiesTest, TestMissingLayerIsInvalid)
+{
+    // a material type without the second raster layer
+    TestMaterial material(1);
+    Cesium::RasterMaterialProperties properties;
+    properties.Build(material);
+    ASSERT_FALSE(properties.IsValid());
+    ASSERT_TRUE(properties.GetLayer(0).m_uvClamp.IsValid());
+    ASSERT_FALSE(properties.GetLayer(1).m_textureMap.IsValid());
+}
+
+#if defined(HAVE_BENCHMARK)
+namespace Benchmark
+{
+    // Attaches a raster to range(0) tiles, writing the five raster properties of each tile's material. The name lookups
+    // are what attaching cost before the indices were cached when the material type loads
+    class RasterAttachBenchmark : public ::benchmark::Fixture
+    {
+    public:
+        void SetUp(const ::benchmark::State& state) override
+        {
+            AZ::NameDictionary::Create();
+            std::size_t tileCount = static_cast<std::size_t>(state.range(0));
+            m_materials.reserve(tileCount);
+            for (std::size_t i = 0; i < tileCount; ++i)
+            {
+                m_materials.emplace_back(Cesium::RasterMaterialProperties::LAYER_COUNT);
+            }
+
+            m_properties.Build(m_materials.front());
+        }
+
+        void TearDown([[maybe_unused]] const ::benchmark::State& state) override
+        {
+            m_materials = {};
+            AZ::NameDictionary::Destroy();
+        }
+
+        AZStd::vector<TestMaterial> m_materials;
+        Cesium::RasterMaterialProperties m_properties;
+    };
+
+    BENCHMARK_DEFINE_F(RasterAttachBenchmark, AttachByPropertyName)(benchmark::State& state)
+    {
+        AZ::Vector4 value = AZ::Vector4::CreateOne();
+        for ([[maybe_unused]] auto _ : state)
+        {
+            for (TestMaterial& material : m_materials)
+            {
+                AZStd::string prefix = AZStd::string::format("raster%d", 1);
+                material.SetPropertyValue(material.FindPropertyIndex(AZ::Name(prefix + ".textureMap")), value);
+                material.SetPropertyValue(material.FindPropertyIndex(AZ::Name(prefix + ".useTexture")), value);
+                material.SetPropertyValue(material.FindPropertyIndex(AZ::Name(prefix + ".textureMapUv")), value);
+                material.SetPropertyValue(material.FindPropertyIndex(AZ::Name(prefix + ".uvTranslateScale")), value);
+                material.SetPropertyValue(material.FindPropertyIndex(AZ::Name(prefix + ".uvClamp")), value);
+            }
+
+            benchmark::DoNotOptimize(m_materials.data());
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    BENCHMARK_DEFINE_F(RasterAttachBenchmark, AttachByCachedIndex)(benchmark::State& state)
+    {
+        AZ::Vector4 value = AZ::Vector4::CreateOne();
+        for ([[maybe_unused]] auto _ : state)
+        {
+            const Cesium::RasterLayerProperties& properties = m_properties.GetLayer(1);
+            for (TestMaterial& material : m_materials)
+            {
+                material.SetPropertyValue(properties.m_textureMap, value);
+                material.SetPropertyValue(properties.m_useTexture, value);
+                material.SetPropertyValue(properties.m_textureMapUv, value);
+                material.SetPropertyValue(properties.m_uvTranslateScale, value);
+                material.SetPropertyValue(properties.m_uvClamp, value);
+            }
+
+            benchmark::DoNotOptimize(m_materials.data());
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    BENCHMARK_REGISTER_F(RasterAttachBenchmark, AttachByPropertyName)
+        ->Arg(1024)
+        ->Arg(4 * 1024)
+        ->Arg(16 * 1024)
+        ->Unit(benchmark::kMicrosecond);
+
+    BENCHMARK_REGISTER_F(RasterAttachBenchmark, AttachByCachedIndex)
+        ->Arg(1024)
+        ->Arg(4 * 1024)
+        ->Arg(16 * 1024)
+        ->Unit(benchmark::kMicrosecond);
+} // namespace Benchmark
+#endif
@@ -3,7 +3,15 @@
 #include <AzCore/Jobs/JobManager.h>
 #include <AzCore/std/parallel/thread.h>
 #include <AzCore/UnitTest/TestTypes.h>
+#include <atomic>
+#include <chrono>
 #include <future>
+#include <thread>
+#include <vector>
+
+#if defined(HAVE_BENCHMARK)
+#include <benchmark/benchmark.h>
+#endif
 
 class TaskProcessorTest : public UnitTest::LeakDetectionFixture
 {
@@ -63,3 +71,209 @@ TEST_F(TaskProcessorTest, StartJobInAnotherThread)
         ASSERT_NE(future.get(), AZStd::this_thread::get_id());
     }
 }
+
+TEST_F(TaskProcessorTest, RunNestedAndBatchedTasks)
+{
+    Cesium::CesiumSchedulerConfiguration configuration;
+    configuration.m_computeLane.m_threadCount = 4;
+    Cesium::CesiumScheduler scheduler(configuration);
+    Cesium::TaskProcessor processor(scheduler);
+
+    // tasks started from a worker go to its own deque and are stolen by the others
+    std::atomic<std::uint32_t> completedTasks{ 0 };
+    Cesium::CesiumSchedulerTaskGroup taskGroup;
+    for (std::uint32_t i = 0; i < 64; ++i)
+    {
+        scheduler.Submit(
+            Cesium::CesiumSchedulerLane::Compute,
+            [&scheduler, &completedTasks, &taskGroup]()
+            {
+                for (std::uint32_t j = 0; j < 16; ++j)
+                {
+                    scheduler.Submit(
+                        Cesium::CesiumSchedulerLane::Compute,
+                        [&completedTasks]()
+                        {
+                            completedTasks.fetch_add(1);
+                        },
+                        &taskGroup);
+                }
+            },
+            &taskGroup);
+    }
+
+    AZStd::vector<std::function<void()>> batch;
+    for (std::uint32_t i = 0; i < 256; ++i)
+    {
+        batch.emplace_back(
+            [&completedTasks]()
+            {
+                completedTasks.fetch_add(1);
+            });
+    }
+    scheduler.SubmitBatch(Cesium::CesiumSchedulerLane::Compute, std::move(batch), &taskGroup);
+
+    taskGroup.Wait();
+    ASSERT_EQ(completedTasks.load(), 64u * 16u + 256u);
+
+    std::promise<void> promise;
+    processor.startTask(
+        [&promise]()
+        {
+            promise.set_value();
+        });
+    promise.get_future().get();
+}
+
+#if defined(HAVE_BENCHMARK)
+namespace Benchmark
+{
+    // Measures the task processor on the work stealing compute workers against the same tasks on O3DE's global job
+    // context. range(0) is the number of threads that submit tasks at the same time
+    class TaskProcessorBenchmark : public ::benchmark::Fixture
+    {
+    public:
+        void SetUp(const ::benchmark::State& state) override
+        {
+            AZ::JobManagerDesc managerDesc;
+            for (std::uint32_t i = 0; i < WORKER_COUNT; ++i)
+            {
+                managerDesc.m_workerThreads.push_back(AZ::JobManagerThreadDesc());
+            }
+
+            m_jobManager = aznew AZ::JobManager(managerDesc);
+            m_jobContext = aznew AZ::JobContext(*m_jobManager);
+            AZ::JobContext::SetGlobalContext(m_jobContext);
+
+            Cesium::CesiumSchedulerConfiguration configuration;
+            configuration.m_ioLane.m_threadCount = 1;
+            configuration.m_computeLane.m_threadCount = WORKER_COUNT;
+            configuration.m_useGlobalJobContext = state.range(1) != 0;
+            m_scheduler = AZStd::make_unique<Cesium::CesiumScheduler>(configuration);
+            m_processor = AZStd::make_unique<Cesium::TaskProcessor>(*m_scheduler);
+        }
+
+        void TearDown([[maybe_unused]] const ::benchmark::State& state) override
+        {
+            m_processor.reset();
+            m_scheduler.reset();
+            AZ::JobContext::SetGlobalContext(nullptr);
+            delete m_jobContext;
+            delete m_jobManager;
+        }
+
+        static constexpr std::uint32_t WORKER_COUNT = 4;
+        static constexpr std::uint32_t TASKS_PER_PRODUCER = 10000;
+
+        AZ::JobManager* m_jobManager;
+        AZ::JobContext* m_jobContext;
+        AZStd::unique_ptr<Cesium::CesiumScheduler> m_scheduler;
+        AZStd::unique_ptr<Cesium::TaskProcessor> m_processor;
+    };
+
+    BENCHMARK_DEFINE_F(TaskProcessorBenchmark, SubmitToRunLatency)(benchmark::State& state)
+    {
+        // the other producers keep the workers and their queues busy while the latency of one task is measured
+        std::atomic<bool> stopProducers{ false };
+        std::vector<std::thread> producers;
+        for (std::int64_t i = 1; i < state.range(0); ++i)
+        {
+            producers.emplace_back(
+                [this, &stopProducers]()
+                {
+                    std::atomic<std::uint32_t> pendingTasks{ 0 };
+                    while (!stopProducers.load(std::memory_order_relaxed))
+                    {
+                        if (pendingTasks.load(std::memory_order_relaxed) < 64)
+                        {
+                            pendingTasks.fetch_add(1, std::memory_order_relaxed);
+                            m_processor->startTask(
+                                [&pendingTasks]()
+                                {
+                                    pendingTasks.fetch_sub(1, std::memory_order_relaxed);
+                                });
+                        }
+                    }
+
+                    while (pendingTasks.load() != 0)
+                    {
+                        std::this_thread::yield();
+                    }
+                });
+        }
+
+        for ([[maybe_unused]] auto _ : state)
+        {
+            std::atomic<bool> ran{ false };
+            std::chrono::steady_clock::time_point runTime;
+            auto submitTime = std::chrono::steady_clock::now();
+            m_processor->startTask(
+                [&ran, &runTime]()
+                {
+                    runTime = std::chrono::steady_clock::now();
+                    ran.store(true, std::memory_order_release);
+                });
+
+            while (!ran.load(std::memory_order_acquire))
+            {
+                std::this_thread::yield();
+            }
+
+            state.SetIterationTime(std::chrono::duration<double>(runTime - submitTime).count());
+        }
+
+        stopProducers.store(true);
+        for (auto& producer : producers)
+        {
+            producer.join();
+        }
+    }
+
+    BENCHMARK_DEFINE_F(TaskProcessorBenchmark, ThroughputUnderContention)(benchmark::State& state)
+    {
+        std::size_t producerCount = static_cast<std::size_t>(state.range(0));
+        for ([[maybe_unused]] auto _ : state)
+        {
+            std::atomic<std::uint64_t> completedTasks{ 0 };
+            std::vector<std::thread> producers;
+            for (std::size_t i = 0; i < producerCount; ++i)
+            {
+                producers.emplace_back(
+                    [this, &completedTasks]()
+                    {
+                        for (std::uint32_t j = 0; j < TASKS_PER_PRODUCER; ++j)
+                        {
+                            m_processor->startTask(
+                                [&completedTasks]()
+                                {
+                                    completedTasks.fetch_add(1, std::memory_order_relaxed);
+                                });
+                        }
+                    });
+            }
+
+            for (auto& producer : producers)
+            {
+                producer.join();
+            }
+
+            while (completedTasks.load(std::memory_order_relaxed) != producerCount * TASKS_PER_PRODUCER)
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0) * TASKS_PER_PRODUCER);
+    }
+
+    // the second argument selects the global job context instead of the work stealing workers
+    BENCHMARK_REGISTER_F(TaskProcessorBenchmark, SubmitToRunLatency)
+        ->ArgsProduct({ { 1, 4 }, { 0, 1 } })
+        ->UseManualTime()
+        ->Unit(benchmark::kMicrosecond);
+
+    BENCHMARK_REGISTER_F(TaskProcessorBenchmark, ThroughputUnderContention)
+        ->ArgsProduct({ { 1, 4, 8 }, { 0, 1 } })
+        ->Unit(benchmark::kMillisecond);
+} // namespace Benchmark
+#endif
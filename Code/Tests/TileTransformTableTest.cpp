@@ -0,0 +1,197 @@
+#include "Cesium/TilesetUtility/TileTransformTable.h"
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzCore/std/containers/vector.h>
+
+#if defined(HAVE_BENCHMARK)
+#include <benchmark/benchmark.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+#endif
+
+namespace
+{
+    struct TestTileModel
+    {
+        std::uint32_t m_appliedCount{ 0 };
+    };
+
+    using TestTransformTable = Cesium::TileTransformTable<TestTileModel>;
+
+    void CountApply(TestTileModel* model)
+    {
+        ++model->m_appliedCount;
+    }
+} // namespace
+
+class TileTransformTableTest : public UnitTest::LeakDetectionFixture
+{
+public:
+    void SetUp() override
+    {
+        UnitTest::LeakDetectionFixture::SetUp();
+    }
+
+    void TearDown() override
+    {
+        UnitTest::LeakDetectionFixture::TearDown();
+    }
+};
+
+TEST_F(TileTransformTableTest, TestChangeOnlyReachesVisibleModels)
+{
+    TestTileModel visibleModel;
+    TestTileModel hiddenModel;
+    TestTransformTable table;
+    table.Add(&visibleModel, true);
+    table.Add(&hiddenModel, false);
+
+    ASSERT_EQ(table.ChangeTransform(CountApply), 1u);
+    ASSERT_EQ(visibleModel.m_appliedCount, 1u);
+    ASSERT_EQ(hiddenModel.m_appliedCount, 0u);
+}
+
+TEST_F(TileTransformTableTest, TestHiddenModelCatchesUpOnceWhenShown)
+{
+    TestTileModel model;
+    TestTransformTable table;
+    TestTransformTable::Slot slot = table.Add(&model, false);
+    table.ChangeTransform(CountApply);
+    table.ChangeTransform(CountApply);
+    table.ChangeTransform(CountApply);
+
+    // every missed change is covered by applying the latest transform once
+    table.SetVisible(slot, true, CountApply);
+    ASSERT_EQ(model.m_appliedCount, 1u);
+
+    // hiding and showing again without a change in between needs no update
+    table.SetVisible(slot, false, CountApply);
+    table.SetVisible(slot, true, CountApply);
+    ASSERT_EQ(model.m_appliedCount, 1u);
+    ASSERT_EQ(table.GetVisibleCount(), 1u);
+}
+
+TEST_F(TileTransformTableTest, TestRemoveKeepsOtherVisibleModels)
+{
+    TestTileModel models[3];
+    TestTransformTable table;
+    TestTransformTable::Slot slots[3];
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        slots[i] = table.Add(&models[i], true);
+    }
+
+    table.Remove(slots[0]);
+    ASSERT_EQ(table.GetVisibleCount(), 2u);
+    table.ChangeTransform(CountApply);
+    ASSERT_EQ(models[0].m_appliedCount, 0u);
+    ASSERT_EQ(models[1].m_appliedCount, 1u);
+    ASSERT_EQ(models[2].m_appliedCount, 1u);
+
+    // the free slot is reused, and the new model starts with the current transform
+    TestTileModel addedModel;
+    ASSERT_EQ(table.Add(&addedModel, false), slots[0]);
+    table.SetVisible(slots[0], true, CountApply);
+    ASSERT_EQ(addedModel.m_appliedCount, 0u);
+    ASSERT_EQ(table.GetVisibleCount(), 3u);
+}
+
+#if defined(HAVE_BENCHMARK)
+namespace Benchmark
+{
+    // Times an origin shift against the number of loaded tiles, with a fixed number of them on screen. Every updated tile
+    // pays for what GltfModel::SetTransform does per mesh: a matrix product and its decomposition into a rotation
+    class TileTransformBenchmark : public ::benchmark::Fixture
+    {
+    public:
+        static constexpr std::size_t VISIBLE_TILE_COUNT = 512;
+
+        struct BenchmarkTileModel
+        {
+            glm::dmat4 m_localTransform{ 1.0 };
+            glm::dvec3 m_translation{ 0.0 };
+            glm::dquat m_rotation{ 1.0, 0.0, 0.0, 0.0 };
+        };
+
+        void SetUp(const ::benchmark::State& state) override
+        {
+            std::size_t loadedTileCount = static_cast<std::size_t>(state.range(0));
+            m_models.resize(loadedTileCount);
+            for (std::size_t i = 0; i < loadedTileCount; ++i)
+            {
+                m_models[i].m_localTransform = glm::translate(glm::dmat4(1.0), glm::dvec3(static_cast<double>(i), 0.0, 0.0));
+                m_table.Add(&m_models[i], i < VISIBLE_TILE_COUNT);
+            }
+
+            m_transform = glm::dmat4(1.0);
+        }
+
+        void TearDown([[maybe_unused]] const ::benchmark::State& state) override
+        {
+            m_models = {};
+            m_table = {};
+        }
+
+        void ApplyTransform(BenchmarkTileModel& model) const
+        {
+            glm::dmat4 transform = m_transform * model.m_localTransform;
+            model.m_translation = glm::dvec3(transform[3]);
+            model.m_rotation = glm::quat_cast(glm::dmat3(transform));
+        }
+
+        void ShiftOrigin()
+        {
+            m_transform = glm::translate(m_transform, glm::dvec3(1.0, 0.0, 0.0));
+        }
+
+        AZStd::vector<BenchmarkTileModel> m_models;
+        Cesium::TileTransformTable<BenchmarkTileModel> m_table;
+        glm::dmat4 m_transform{ 1.0 };
+    };
+
+    BENCHMARK_DEFINE_F(TileTransformBenchmark, UpdateEveryLoadedTile)(benchmark::State& state)
+    {
+        for ([[maybe_unused]] auto _ : state)
+        {
+            ShiftOrigin();
+            for (BenchmarkTileModel& model : m_models)
+            {
+                ApplyTransform(model);
+            }
+
+            benchmark::DoNotOptimize(m_models.data());
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    BENCHMARK_DEFINE_F(TileTransformBenchmark, UpdateVisibleTiles)(benchmark::State& state)
+    {
+        for ([[maybe_unused]] auto _ : state)
+        {
+            ShiftOrigin();
+            m_table.ChangeTransform(
+                [this](BenchmarkTileModel* model)
+                {
+                    ApplyTransform(*model);
+                });
+
+            benchmark::DoNotOptimize(m_models.data());
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    BENCHMARK_REGISTER_F(TileTransformBenchmark, UpdateEveryLoadedTile)
+        ->Arg(1024)
+        ->Arg(8 * 1024)
+        ->Arg(64 * 1024)
+        ->Unit(benchmark::kMicrosecond);
+
+    BENCHMARK_REGISTER_F(TileTransformBenchmark, UpdateVisibleTiles)
+        ->Arg(1024)
+        ->Arg(8 * 1024)
+        ->Arg(64 * 1024)
+        ->Unit(benchmark::kMicrosecond);
+} // namespace Benchmark
+#endif
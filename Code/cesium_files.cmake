@@ -32,29 +32,54 @@ set(FILES
     Source/Cesium/Systems/GenericIOManager.cpp
     Source/Cesium/Systems/HttpManager.h
     Source/Cesium/Systems/HttpManager.cpp
+    Source/Cesium/Systems/HttpContentDecoder.h
+    Source/Cesium/Systems/HttpContentDecoder.cpp
+    Source/Cesium/Systems/HttpResponseBodyStream.h
+    Source/Cesium/Systems/HttpResponseBodyStream.cpp
     Source/Cesium/Systems/LocalFileManager.h
     Source/Cesium/Systems/LocalFileManager.cpp
+    Source/Cesium/Systems/MappedFile.h
+    Source/Cesium/Systems/MappedFile.cpp
     Source/Cesium/Systems/LoggerSink.h
     Source/Cesium/Systems/LoggerSink.cpp
     Source/Cesium/Systems/TaskProcessor.h
     Source/Cesium/Systems/TaskProcessor.cpp
+    Source/Cesium/Systems/WorkStealingThreadPool.h
+    Source/Cesium/Systems/WorkStealingThreadPool.cpp
     Source/Cesium/Systems/HttpAssetAccessor.h
     Source/Cesium/Systems/HttpAssetAccessor.cpp
+    Source/Cesium/Systems/HttpResponseCache.h
+    Source/Cesium/Systems/HttpResponseCache.cpp
     Source/Cesium/Systems/GenericAssetAccessor.h
     Source/Cesium/Systems/GenericAssetAccessor.cpp
     Source/Cesium/Systems/CriticalAssetManager.h
     Source/Cesium/Systems/CriticalAssetManager.cpp
+    Source/Cesium/Systems/ContentAssetCache.h
+    Source/Cesium/Systems/ContentAssetCache.cpp
+    Source/Cesium/Systems/CesiumScheduler.h
+    Source/Cesium/Systems/CesiumScheduler.cpp
+    Source/Cesium/Systems/CesiumProfiler.h
     Source/Cesium/Systems/CesiumSystem.h
     Source/Cesium/Systems/CesiumSystem.cpp
 
     Source/Cesium/Gltf/BitangentAndTangentGenerator.h
     Source/Cesium/Gltf/BitangentAndTangentGenerator.cpp
+    Source/Cesium/Gltf/NormalGenerator.h
+    Source/Cesium/Gltf/NormalGenerator.cpp
     Source/Cesium/Gltf/GltfLoadContext.h
     Source/Cesium/Gltf/GltfLoadContext.cpp
     Source/Cesium/Gltf/GltfModel.h
     Source/Cesium/Gltf/GltfModel.cpp
     Source/Cesium/Gltf/GltfPrimitiveBuilder.h
     Source/Cesium/Gltf/GltfPrimitiveBuilder.cpp
+    Source/Cesium/Gltf/GltfVertexStreamPacker.h
+    Source/Cesium/Gltf/GltfVertexStreamPacker.cpp
+    Source/Cesium/Gltf/GltfVertexQuantizer.h
+    Source/Cesium/Gltf/GltfVertexQuantizer.cpp
+    Source/Cesium/Gltf/GltfMipGenerator.h
+    Source/Cesium/Gltf/GltfMipGenerator.cpp
+    Source/Cesium/Gltf/GltfTextureCompressor.h
+    Source/Cesium/Gltf/GltfTextureCompressor.cpp
     Source/Cesium/Gltf/GltfMaterialBuilder.h
     Source/Cesium/Gltf/GltfMaterialBuilder.cpp
     Source/Cesium/Gltf/GltfPBRMaterialBuilder.h
@@ -66,8 +91,18 @@ set(FILES
     Source/Cesium/TilesetUtility/TilesetCameraConfigurations.cpp
     Source/Cesium/TilesetUtility/GltfRasterMaterialBuilder.h
     Source/Cesium/TilesetUtility/GltfRasterMaterialBuilder.cpp
+    Source/Cesium/TilesetUtility/MeshVisibilityTable.h
+    Source/Cesium/TilesetUtility/RasterAtlasSlotAllocator.h
+    Source/Cesium/TilesetUtility/RasterAtlasSlotAllocator.cpp
+    Source/Cesium/TilesetUtility/RasterCompositor.h
+    Source/Cesium/TilesetUtility/RasterCompositor.cpp
+    Source/Cesium/TilesetUtility/RasterMaterialProperties.h
+    Source/Cesium/TilesetUtility/RasterMaterialProperties.cpp
+    Source/Cesium/TilesetUtility/RasterOverlayAtlas.h
+    Source/Cesium/TilesetUtility/RasterOverlayAtlas.cpp
     Source/Cesium/TilesetUtility/RenderResourcesPreparer.h
     Source/Cesium/TilesetUtility/RenderResourcesPreparer.cpp
+    Source/Cesium/TilesetUtility/TileTransformTable.h
 
     Source/Cesium/EBus/CesiumSystemComponentBus.h
     Source/Cesium/EBus/CesiumSystemComponentBus.cpp
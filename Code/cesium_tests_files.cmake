@@ -1,7 +1,22 @@
 
 set(FILES
     Tests/CesiumTest.cpp
+    Tests/CesiumSchedulerTest.cpp
+    Tests/ContentAssetCacheTest.cpp
+    Tests/FlightInterpolatorTest.cpp
+    Tests/GltfVertexQuantizerTest.cpp
+    Tests/GltfMipGeneratorTest.cpp
+    Tests/GltfTextureCompressorTest.cpp
+    Tests/GltfVertexStreamPackerTest.cpp
     Tests/HttpManagerTest.cpp
     Tests/HttpAssetAccessorTest.cpp
+    Tests/HttpResponseCacheTest.cpp
+    Tests/MappedFileTest.cpp
+    Tests/MeshVisibilityTableTest.cpp
+    Tests/NormalGeneratorTest.cpp
+    Tests/RasterAtlasSlotAllocatorTest.cpp
+    Tests/RasterCompositorTest.cpp
+    Tests/RasterMaterialPropertiesTest.cpp
     Tests/TaskProcessorTest.cpp
+    Tests/TileTransformTableTest.cpp
 )